@@ -164,6 +164,21 @@ protected:
      * used to track evaluation times and print out messages
      */
     JobTimer* _jobTimer;
+    /**
+     * rewrites the operation graph before generating source code
+     * (not owned; might not be used)
+     */
+    GraphRewriter<Base>* _rewriter;
+    /**
+     * whether or not independent operations are reordered to reduce the
+     * number of temporary variables simultaneously in use
+     */
+    bool _scheduleOperations;
+    /**
+     * the maximum number of temporary variables simultaneously in use in
+     * the last generated source code
+     */
+    size_t _maxLiveTemporaries;
     /**
      * Auxiliary index declaration (might not be used)
      */
@@ -197,6 +212,22 @@ public:
      */
     inline bool isReuseVariableIDs() const;
 
+    /**
+     * Defines whether or not to reorder the operations in between changes
+     * of scope, loops, and atomic function calls so that fewer temporary
+     * variables are simultaneously in use.
+     * Operations which release the most temporary variables are preferred
+     * and the users of a variable are kept close to its creation.
+     * It is only useful when node IDs are reused.
+     */
+    inline void setScheduleOperations(bool schedule);
+
+    /**
+     * Whether or not operations are reordered to reduce the number of
+     * temporary variables simultaneously in use.
+     */
+    inline bool isScheduleOperations() const;
+
     /**
      * Marks the provided variables as being independent variables.
      *
@@ -262,6 +293,19 @@ public:
 
     inline void setJobTimer(JobTimer* jobTimer);
 
+    inline GraphRewriter<Base>* getGraphRewriter() const;
+
+    /**
+     * Defines an object used to rewrite the operations used by the
+     * dependent variables (e.g. strength reduction) at the beginning of
+     * generateCode().
+     * The operation nodes are modified in place.
+     *
+     * @param rewriter the graph rewriter (not owned) or null to disable
+     *                 rewriting
+     */
+    inline void setGraphRewriter(GraphRewriter<Base>* rewriter);
+
     /**
      * Determines whether or not the dependent variables will be set to zero
      * before executing the operation graph
@@ -423,6 +467,13 @@ public:
 
     size_t getTemporarySparseArraySize() const;
 
+    /**
+     * Provides the maximum number of temporary variables simultaneously in
+     * use in the last generated source code.
+     * It is only determined when node IDs are reused.
+     */
+    size_t getMaximumLiveTemporaryVariables() const;
+
     /**************************************************************************
      *                       Reusing handler and nodes
      *************************************************************************/
@@ -697,6 +748,44 @@ protected:
 
     inline void reduceTemporaryVariables(ArrayView<CGB>& dependent);
 
+    /**
+     * Reorders the operations in the evaluation queue (list scheduling) in
+     * order to reduce the number of temporary variables simultaneously in
+     * use.
+     * Only the operations in between scheduling barriers are reordered.
+     */
+    inline void scheduleOperations();
+
+    /**
+     * Reorders the operations in the evaluation queue in [begin, end).
+     *
+     * @param begin the first position in the evaluation queue
+     * @param end the position after the last operation
+     * @param preds the positions of the variables used by each operation
+     * @param succs the positions of the operations which use each variable
+     * @param newOrder the new evaluation queue
+     */
+    inline void scheduleOperations(size_t begin,
+                                   size_t end,
+                                   const std::vector<std::vector<size_t> >& preds,
+                                   const std::vector<std::vector<size_t> >& succs,
+                                   std::vector<Node*>& newOrder);
+
+    /**
+     * Determines the positions in the evaluation queue of the variables
+     * used (directly or through expressions without variables) by the
+     * operation at a given position.
+     */
+    inline void findScheduleDependencies(size_t pos,
+                                         Node& root,
+                                         std::vector<size_t>& preds);
+
+    /**
+     * Whether or not operations cannot be moved across this node in the
+     * evaluation queue.
+     */
+    inline static bool isScheduleBarrier(const Node& node);
+
     /**
      * Change operation order so that the total number of temporary variables is
      * reduced.
@@ -44,7 +44,10 @@ CodeHandler<Base>::CodeHandler(size_t varCount) :
         _minTemporaryVarID(0),
         _zeroDependents(false),
         _verbose(false),
-        _jobTimer(nullptr) {
+        _jobTimer(nullptr),
+        _rewriter(nullptr),
+        _scheduleOperations(false),
+        _maxLiveTemporaries(0) {
     _codeBlocks.reserve(varCount);
     //_variableOrder.reserve(1 + varCount / 3);
     _scopedVariableOrder[0].reserve(1 + varCount / 3);
@@ -72,6 +75,16 @@ inline bool CodeHandler<Base>::isReuseVariableIDs() const {
     return _reuseIDs;
 }
 
+template<class Base>
+inline void CodeHandler<Base>::setScheduleOperations(bool schedule) {
+    _scheduleOperations = schedule;
+}
+
+template<class Base>
+inline bool CodeHandler<Base>::isScheduleOperations() const {
+    return _scheduleOperations;
+}
+
 template<class Base>
 inline void CodeHandler<Base>::makeVariables(std::vector<AD<CGB> >& variables) {
     for (auto& v : variables) {
@@ -127,6 +140,16 @@ inline void CodeHandler<Base>::setJobTimer(JobTimer* jobTimer) {
     _jobTimer = jobTimer;
 }
 
+template<class Base>
+inline GraphRewriter<Base>* CodeHandler<Base>::getGraphRewriter() const {
+    return _rewriter;
+}
+
+template<class Base>
+inline void CodeHandler<Base>::setGraphRewriter(GraphRewriter<Base>* rewriter) {
+    _rewriter = rewriter;
+}
+
 template<class Base>
 inline bool CodeHandler<Base>::isZeroDependents() const {
     return _zeroDependents;
@@ -280,6 +303,10 @@ void CodeHandler<Base>::generateCode(std::ostream& out,
         beginTime = steady_clock::now();
     }
 
+    if (_rewriter != nullptr) {
+        _rewriter->rewrite(*this, dependent);
+    }
+
     _lang = &lang;
     _idCount = 1;
     _idArrayCount = 1;
@@ -331,6 +358,7 @@ void CodeHandler<Base>::generateCode(std::ostream& out,
     }
 
     _minTemporaryVarID = _idCount;
+    _maxLiveTemporaries = 0;
 
     /**
      * determine the number of times each variable is used
@@ -390,6 +418,13 @@ void CodeHandler<Base>::generateCode(std::ostream& out,
         CPPADCG_ASSERT_UNKNOWN(_variableOrder.size() == e)
     }
 
+    /**
+     * Reorder independent operations
+     */
+    if (_scheduleOperations) {
+        scheduleOperations();
+    }
+
     for (size_t p = 0; p < _variableOrder.size(); p++) {
         Node& arg = *_variableOrder[p];
         setEvaluationOrder(arg, p + 1);
@@ -463,6 +498,9 @@ void CodeHandler<Base>::generateCode(std::ostream& out,
     _alteredNodes.clear();
 
     if (_jobTimer != nullptr) {
+        _jobTimer->setJobCounter("nodes", _codeBlocks.size());
+        _jobTimer->setJobCounter("operations", _variableOrder.size());
+        _jobTimer->setJobCounter("temporaries", getTemporaryVariableCount());
         _jobTimer->finishedJob();
     } else if (_verbose) {
         OStreamConfigRestore osr(std::cout);
@@ -489,6 +527,11 @@ size_t CodeHandler<Base>::getTemporarySparseArraySize() const {
     return _idSparseArrayCount - 1;
 }
 
+template<class Base>
+size_t CodeHandler<Base>::getMaximumLiveTemporaryVariables() const {
+    return _maxLiveTemporaries;
+}
+
 template<class Base>
 void CodeHandler<Base>::reset() {
     for (Node* n : _codeBlocks) {
@@ -1668,6 +1711,7 @@ inline void CodeHandler<Base>::reduceTemporaryVariables(ArrayView<CGB>& dependen
      * Redefine temporary variable IDs
      */
     std::vector<size_t> freedVariables; // variable IDs no longer in use
+    size_t live = 0; // number of temporary variables in use
     _idCount = _minTemporaryVarID;
     ArrayIdCompresser<Base> arrayComp(_varId, _idArrayCount);
     ArrayIdCompresser<Base> sparseArrayComp(_varId, _idSparseArrayCount);
@@ -1679,6 +1723,7 @@ inline void CodeHandler<Base>::reduceTemporaryVariables(ArrayView<CGB>& dependen
         for (size_t r = 0; r < released.size(); r++) {
             if (isTemporary(*released[r])) {
                 freedVariables.push_back(_varId[*released[r]]);
+                live--;
             } else if (isTemporaryArray(*released[r])) {
                 arrayComp.addFreeArraySpace(*released[r]);
             } else if (isTemporarySparseArray(*released[r])) {
@@ -1696,6 +1741,9 @@ inline void CodeHandler<Base>::reduceTemporaryVariables(ArrayView<CGB>& dependen
                 freedVariables.pop_back();
                 _varId[var] = id;
             }
+            live++;
+            if (live > _maxLiveTemporaries)
+                _maxLiveTemporaries = live;
         } else if (isTemporaryArray(var)) {
             // a temporary array
             size_t arrayStart = arrayComp.reserveArraySpace(var);
@@ -1712,6 +1760,208 @@ inline void CodeHandler<Base>::reduceTemporaryVariables(ArrayView<CGB>& dependen
     _idSparseArrayCount = sparseArrayComp.getIdCount();
 }
 
+template<class Base>
+inline void CodeHandler<Base>::scheduleOperations() {
+    const size_t n = _variableOrder.size();
+
+    // the evaluation order is temporarily used to identify the nodes in the queue
+    for (size_t p = 0; p < n; ++p) {
+        setEvaluationOrder(*_variableOrder[p], p + 1);
+    }
+
+    /**
+     * determine the dependencies between the variables in the queue
+     */
+    std::vector<std::vector<size_t> > preds(n);
+    std::vector<std::vector<size_t> > succs(n);
+    for (size_t p = 0; p < n; ++p) {
+        startNewOperationTreeVisit();
+
+        for (const Arg& a : *_variableOrder[p]) {
+            if (a.getOperation() != nullptr) {
+                findScheduleDependencies(p, *a.getOperation(), preds[p]);
+            }
+        }
+
+        for (size_t d : preds[p]) {
+            succs[d].push_back(p);
+        }
+    }
+
+    /**
+     * reorder the operations in between barriers
+     */
+    std::vector<Node*> newOrder(_variableOrder);
+
+    size_t begin = 0;
+    for (size_t p = 0; p <= n; ++p) {
+        if (p == n || isScheduleBarrier(*_variableOrder[p])) {
+            scheduleOperations(begin, p, preds, succs, newOrder);
+            begin = p + 1;
+        }
+    }
+
+    _variableOrder.swap(newOrder);
+
+    for (size_t p = 0; p < n; ++p) {
+        setEvaluationOrder(*_variableOrder[p], 0);
+    }
+}
+
+template<class Base>
+inline void CodeHandler<Base>::scheduleOperations(size_t begin,
+                                                  size_t end,
+                                                  const std::vector<std::vector<size_t> >& preds,
+                                                  const std::vector<std::vector<size_t> >& succs,
+                                                  std::vector<Node*>& newOrder) {
+    if (end <= begin + 2)
+        return; // nothing to reorder
+
+    const size_t size = end - begin;
+
+    std::vector<size_t> pending(size, 0); // unscheduled arguments in this range
+    std::vector<size_t> remaining(size, 0); // unscheduled users in this range
+    std::vector<bool> pinned(size, false); // variables which cannot be released in this range
+    std::vector<bool> scheduled(size, false);
+    std::vector<int> score(size, 0); // released temporaries minus created temporaries
+    std::vector<size_t> readyStep(size, 0); // when an operation became ready
+
+    for (size_t p = begin; p < end; ++p) {
+        size_t i = p - begin;
+        for (size_t d : preds[p]) {
+            if (d >= begin)
+                pending[i]++;
+        }
+        for (size_t s : succs[p]) {
+            if (s < end)
+                remaining[i]++;
+            else
+                pinned[i] = true; // also used after this range
+        }
+        if (!isTemporary(*_variableOrder[p]))
+            pinned[i] = true; // dependents, arrays, ...
+    }
+
+    auto computeScore = [&](size_t i) {
+        size_t p = begin + i;
+        int sc = pinned[i] ? 0 : -1; // a new temporary variable
+        for (size_t d : preds[p]) {
+            if (d >= begin && !pinned[d - begin] && remaining[d - begin] == 1)
+                sc++; // last user of a temporary variable
+        }
+        score[i] = sc;
+    };
+
+    /**
+     * prefer operations which release more temporary variables and then
+     * the ones which use the most recently created variables
+     */
+    auto compare = [&](size_t a, size_t b) {
+        if (score[a] != score[b])
+            return score[a] > score[b];
+        if (readyStep[a] != readyStep[b])
+            return readyStep[a] > readyStep[b];
+        return a < b; // keep the original order
+    };
+    std::set<size_t, decltype(compare)> ready(compare);
+
+    for (size_t i = 0; i < size; ++i) {
+        if (pending[i] == 0) {
+            computeScore(i);
+            ready.insert(i);
+        }
+    }
+
+    for (size_t step = 1; step <= size; ++step) {
+        CPPADCG_ASSERT_UNKNOWN(!ready.empty())
+        size_t i = *ready.begin();
+        ready.erase(ready.begin());
+        scheduled[i] = true;
+
+        size_t p = begin + i;
+        newOrder[begin + step - 1] = _variableOrder[p];
+
+        for (size_t d : preds[p]) {
+            if (d < begin)
+                continue;
+            size_t di = d - begin;
+            remaining[di]--;
+            if (remaining[di] == 1 && !pinned[di]) {
+                // the last user now releases this temporary variable
+                for (size_t s : succs[d]) {
+                    size_t si = s - begin;
+                    if (s < end && !scheduled[si] && pending[si] == 0) {
+                        ready.erase(si);
+                        score[si]++;
+                        ready.insert(si);
+                    }
+                }
+            }
+        }
+
+        for (size_t s : succs[p]) {
+            if (s >= end)
+                continue;
+            size_t si = s - begin;
+            pending[si]--;
+            if (pending[si] == 0) {
+                readyStep[si] = step;
+                computeScore(si);
+                ready.insert(si);
+            }
+        }
+    }
+}
+
+template<class Base>
+inline void CodeHandler<Base>::findScheduleDependencies(size_t pos,
+                                                        Node& root,
+                                                        std::vector<size_t>& preds) {
+
+    auto analyse = [&](SimpleOperationStackData<Base>& stackEl,
+                       SimpleOperationStack<Base>& stack) {
+        auto& node = stackEl.node();
+
+        if (!isVisited(node)) {
+            markVisited(node);
+
+            size_t order = getEvaluationOrder(node);
+            if (order != 0) {
+                CPPADCG_ASSERT_UNKNOWN(order - 1 < pos)
+                preds.push_back(order - 1);
+            } else if (_varId[node] == 0) {
+                stack.pushNodeArguments(node);
+            }
+        }
+    };
+
+    depthFirstGraphNavigation(root, analyse, true);
+}
+
+template<class Base>
+inline bool CodeHandler<Base>::isScheduleBarrier(const Node& node) {
+    switch (node.getOperationType()) {
+        case CGOpCode::AtomicForward:
+        case CGOpCode::AtomicReverse:
+        case CGOpCode::CondResult:
+        case CGOpCode::DependentMultiAssign:
+        case CGOpCode::Else:
+        case CGOpCode::ElseIf:
+        case CGOpCode::EndIf:
+        case CGOpCode::IndexAssign:
+        case CGOpCode::LoopEnd:
+        case CGOpCode::LoopIndexedDep:
+        case CGOpCode::LoopIndexedTmp:
+        case CGOpCode::LoopStart:
+        case CGOpCode::Pri:
+        case CGOpCode::StartIf:
+        case CGOpCode::TmpDcl:
+            return true;
+        default:
+            return false;
+    }
+}
+
 template<class Base>
 inline void CodeHandler<Base>::reorderOperations(ArrayView<CGB>& dependent) {
     // determine the location of the last temporary variable used for each dependent
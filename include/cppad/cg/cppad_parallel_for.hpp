@@ -0,0 +1,130 @@
+#ifndef CPPAD_CG_CPPAD_PARALLEL_FOR_INCLUDED
+#define CPPAD_CG_CPPAD_PARALLEL_FOR_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Evaluates independent tasks which use CppAD (e.g. sparsity sweeps on
+ * different ADFun objects) with several threads.
+ *
+ * CppAD is placed in parallel execution mode while the tasks run and it is
+ * returned to sequential mode afterwards.
+ * Tasks must not share ADFun objects since their evaluation changes
+ * the internal state of the ADFun.
+ *
+ * @tparam Base the base type of the ADFun objects (e.g. CG<double>)
+ */
+template<class Base>
+class CppADParallelFor {
+public:
+
+    /**
+     * Calls a function for each index in [0, count).
+     * The tasks are evaluated sequentially if only one thread is requested
+     * or if CppAD is already configured for multithreading by the user.
+     * The first exception thrown by a task is rethrown after all threads
+     * finish.
+     *
+     * @param count the number of tasks
+     * @param threads the maximum number of threads (including the calling
+     *                thread)
+     * @param f the function called with the index of each task
+     */
+    template<class Function>
+    static void run(size_t count,
+                    size_t threads,
+                    Function f) {
+        size_t nThreads = std::min(threads, count);
+
+        if (nThreads <= 1 || CppAD::thread_alloc::num_threads() != 1) {
+            for (size_t i = 0; i < count; ++i)
+                f(i);
+            return;
+        }
+
+        CppAD::thread_alloc::parallel_setup(nThreads, &inParallel, &threadNum);
+        CppAD::parallel_ad<Base>();
+
+        std::atomic<size_t> next(0);
+        std::mutex errorMutex;
+        std::exception_ptr error;
+
+        auto work = [&](size_t thread) {
+            threadIndex() = thread;
+            for (size_t i = next++; i < count; i = next++) {
+                try {
+                    f(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (error == nullptr)
+                        error = std::current_exception();
+                    next = count; // skip the remaining tasks
+                }
+            }
+        };
+
+        parallelFlag() = true;
+
+        std::vector<std::thread> workers;
+        workers.reserve(nThreads - 1);
+        for (size_t t = 1; t < nThreads; ++t) {
+            workers.emplace_back(work, t);
+        }
+        work(0);
+
+        for (auto& w : workers) {
+            w.join();
+        }
+
+        parallelFlag() = false;
+
+        // back to sequential execution
+        for (size_t t = 1; t < nThreads; ++t) {
+            CppAD::thread_alloc::free_available(t);
+        }
+        CppAD::thread_alloc::parallel_setup(1, nullptr, nullptr);
+
+        if (error != nullptr)
+            std::rethrow_exception(error);
+    }
+
+private:
+
+    static std::atomic<bool>& parallelFlag() {
+        static std::atomic<bool> flag(false);
+        return flag;
+    }
+
+    static size_t& threadIndex() {
+        thread_local size_t index = 0;
+        return index;
+    }
+
+    static bool inParallel() {
+        return parallelFlag();
+    }
+
+    static size_t threadNum() {
+        return threadIndex();
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
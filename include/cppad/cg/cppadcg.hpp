@@ -55,6 +55,11 @@ static_assert(false,
 #include <cstring>
 #include <chrono>
 #include <thread>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <exception>
 #include <functional>
 
 // ---------------------------------------------------------------------------
@@ -127,6 +132,7 @@ static_assert(false,
 #include <cppad/cg/atomic_dependency_locator.hpp>
 #include <cppad/cg/variable_name_generator.hpp>
 #include <cppad/cg/job_timer.hpp>
+#include <cppad/cg/job_tracer.hpp>
 #include <cppad/cg/lang/language.hpp>
 #include <cppad/cg/lang/lang_stream_stack.hpp>
 #include <cppad/cg/scope_path_element.hpp>
@@ -174,6 +180,10 @@ static_assert(false,
 #include <cppad/cg/solver.hpp>
 #include <cppad/cg/collect_variable.hpp>
 #include <cppad/cg/graph_mod.hpp>
+#include <cppad/cg/graph_rewriter.hpp>
+#include <cppad/cg/graph_sparsity.hpp>
+#include <cppad/cg/structural_decomposition.hpp>
+#include <cppad/cg/cppad_parallel_for.hpp>
 #include <cppad/cg/operation_node_name_streambuf.hpp>
 
 // ---------------------------------------------------------------------------
@@ -209,11 +219,18 @@ static_assert(false,
 #include <cppad/cg/lang/c/lang_c_default_hessian_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_default_reverse2_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_custom_var_name_gen.hpp>
+#include <cppad/cg/lang/c/lang_c_mapped_dep_var_name_gen.hpp>
+#include <cppad/cg/lang/c/lang_c_masked_group_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_util.hpp>
 
+// C++ source code generation
+#include <cppad/cg/lang/cpp/language_cpp.hpp>
+
 //
 #include <cppad/cg/model/threadpool/multi_threading_type.hpp>
 #include <cppad/cg/model/threadpool/thread_pool_schedule_strategy.hpp>
+#include <cppad/cg/model/threadpool/thread_pool_executor.hpp>
+#include <cppad/cg/model/function_profile.hpp>
 #include <cppad/cg/model/external_function_wrapper.hpp>
 #include <cppad/cg/model/atomic_external_function_wrapper.hpp>
 #include <cppad/cg/model/generic_model_external_function_wrapper.hpp>
@@ -245,11 +262,17 @@ static_assert(false,
 #include <cppad/cg/model/model_library_c_source_gen_impl.hpp>
 
 #include <cppad/cg/model/model_c_source_gen_for0.hpp>
+#include <cppad/cg/model/model_c_source_gen_tasks.hpp>
+#include <cppad/cg/model/model_c_source_gen_blocks.hpp>
+#include <cppad/cg/model/model_c_source_gen_masked.hpp>
 #include <cppad/cg/model/model_c_source_gen_for1.hpp>
 #include <cppad/cg/model/model_c_source_gen_rev1.hpp>
 #include <cppad/cg/model/model_c_source_gen_rev2.hpp>
 #include <cppad/cg/model/model_c_source_gen_jac.hpp>
 #include <cppad/cg/model/model_c_source_gen_hes.hpp>
+#include <cppad/cg/model/model_c_source_gen_directional.hpp>
+#include <cppad/cg/model/model_c_source_gen_ordering.hpp>
+#include <cppad/cg/model/model_c_source_gen_cache.hpp>
 #include <cppad/cg/model/patterns/model_c_source_gen_loops.hpp>
 #include <cppad/cg/model/patterns/model_c_source_gen_loops_for0.hpp>
 #include <cppad/cg/model/patterns/model_c_source_gen_loops_for1.hpp>
@@ -261,6 +284,9 @@ static_assert(false,
 #include <cppad/cg/model/patterns/model_c_source_gen_loops_hess_r2.hpp>
 #include <cppad/cg/model/patterns/hessian_with_loops_info.hpp>
 
+// header-only C++ model generation
+#include <cppad/cg/model/model_cpp_header_gen.hpp>
+
 // automated dynamic library creation
 #include <cppad/cg/model/dynamic_lib/dynamiclib.hpp>
 #include <cppad/cg/model/dynamic_lib/dynamic_library_processor.hpp>
@@ -43,7 +43,7 @@ protected:
     /**
      * original sparsity pattern
      */
-    std::vector<bool> sparsity_;
+    std::vector<std::set<size_t> > sparsity_;
     // Bipartite graph ([equation i][variable j])
     std::vector<Vnode<Base>*> vnodes_;
     std::vector<Enode<Base>*> enodes_;
@@ -220,12 +220,12 @@ public:
         }
 
         // create the edges
-        sparsity_ = jacobianSparsity<vector<bool>, CGBase>(fun);
+        sparsity_ = jacobianSparsitySet<vector<std::set<size_t> >, CGBase>(fun);
 
         for (size_t i = 0; i < m; i++) {
-            for (size_t p = 0; p < n; p++) {
+            for (size_t p : sparsity_[i]) {
                 int j = tape2New[p];
-                if (j >= 0 && sparsity_[i * n + p]) {
+                if (j >= 0) {
                     enodes_[i]->addVariable(vnodes_[j]);
                 }
             }
@@ -381,6 +381,37 @@ public:
         }
     }
 
+    /**
+     * Uncolors the nodes visited by a search which started at an equation
+     * (colored nodes connected to the equation through colored equations).
+     * This is much faster than uncolorAll() when only a small part of the
+     * graph was visited.
+     *
+     * @param i the equation where the search started
+     */
+    inline void uncolor(Enode<Base>& i) {
+        std::vector<Enode<Base>*> stack;
+        if (i.isColored()) {
+            i.uncolor();
+            stack.push_back(&i);
+        }
+
+        while (!stack.empty()) {
+            Enode<Base>* ii = stack.back();
+            stack.pop_back();
+
+            for (Vnode<Base>* j : ii->variables()) {
+                j->uncolor();
+                for (Enode<Base>* k : j->equations()) {
+                    if (k->isColored()) {
+                        k->uncolor();
+                        stack.push_back(k);
+                    }
+                }
+            }
+        }
+    }
+
     inline Vnode<Base>* createDerivate(Vnode<Base>& j) {
         if (j.derivative() != nullptr)
             return j.derivative();
@@ -37,6 +37,7 @@ class DummyDerivatives : public DaeIndexReduction<Base> {
     using VectorB = Eigen::Matrix<Base, Eigen::Dynamic, 1>;
     using VectorCB = Eigen::Matrix<std::complex<Base>, Eigen::Dynamic, 1>;
     using MatrixB = Eigen::Matrix<Base, Eigen::Dynamic, Eigen::Dynamic>;
+    using SparseMatrixB = Eigen::SparseMatrix<Base>;
 protected:
     /**
      * Method used to identify the structural index
@@ -62,7 +63,7 @@ protected:
      * Jacobian sparsity pattern of the reduced system
      * (in the original variable order)
      */
-    std::vector<bool> jacSparsity_;
+    std::vector<std::set<size_t> > jacSparsity_;
     // the initial index of time derivatives
     size_t diffVarStart_;
     // the initial index of the differentiated equations
@@ -98,6 +99,12 @@ protected:
      * Avoid using these variables as dummy derivatives
      */
     std::set<std::string> avoidAsDummy_;
+    /**
+     * The minimum number of variables in an independent block of the
+     * Jacobian for which a sparse QR decomposition is used to select
+     * dummy derivatives (smaller blocks use a dense QR decomposition)
+     */
+    size_t sparseQRMinSize_;
 public:
 
     /**
@@ -125,7 +132,8 @@ public:
             reduceEquations_(true),
             generateSemiExplicitDae_(false),
             reorder_(true),
-            avoidConvertAlg2DifVars_(true) {
+            avoidConvertAlg2DifVars_(true),
+            sparseQRMinSize_(200) {
 
         for (Vnode<Base>* jj : idxIdentify.getGraph().variables()) {
             if (jj->antiDerivative() != nullptr) {
@@ -236,6 +244,22 @@ public:
         return avoidAsDummy_;
     }
 
+    inline size_t getSparseQRMinSize() const {
+        return sparseQRMinSize_;
+    }
+
+    /**
+     * Defines the minimum number of variables in an independent block of
+     * the Jacobian for which a sparse QR decomposition is used to select
+     * dummy derivatives.
+     * Smaller blocks use a dense QR decomposition with column pivoting.
+     *
+     * @param minSize the minimum number of variables
+     */
+    inline void setSparseQRMinSize(size_t minSize) {
+        sparseQRMinSize_ = minSize;
+    }
+
     inline std::unique_ptr<ADFun<CG<Base>>> reduceIndex(std::vector<DaeVarInfo>& newVarInfo,
                                                         std::vector<DaeEquationInfo>& newEqInfo) override {
 
@@ -1321,17 +1345,20 @@ protected:
         auto& vnodes = graph.variables();
         auto& enodes = graph.equations();
 
-        jacSparsity_ = jacobianReverseSparsity<vector<bool>, CGBase>(*reducedFun_); // in the original variable order
+        jacSparsity_ = jacobianReverseSparsitySet<vector<std::set<size_t> >, CGBase>(*reducedFun_); // in the original variable order
 
-        vector<size_t> row, col;
-        row.reserve((vnodes.size() - diffVarStart_) * (m - diffEqStart_));
-        col.reserve(row.capacity());
+        // the time derivative variables of interest (in the tape order)
+        vector<Vnode<Base>*> tape2Var(n, nullptr);
+        for (size_t j = diffVarStart_; j < vnodes.size(); j++) {
+            Vnode<Base>* jj = vnodes[j];
+            CPPADCG_ASSERT_UNKNOWN(jj->antiDerivative() != nullptr);
+            tape2Var[jj->tapeIndex()] = jj;
+        }
 
+        vector<size_t> row, col;
         for (size_t i = diffEqStart_; i < m; i++) {
-            for (size_t j = diffVarStart_; j < vnodes.size(); j++) {
-                CPPADCG_ASSERT_UNKNOWN(vnodes[j]->antiDerivative() != nullptr);
-                size_t t = vnodes[j]->tapeIndex();
-                if (jacSparsity_[i * n + t]) {
+            for (size_t t : jacSparsity_[i]) {
+                if (tape2Var[t] != nullptr) {
                     row.push_back(i);
                     col.push_back(t);
                 }
@@ -1348,31 +1375,26 @@ protected:
         reducedFun_->SparseJacobianReverse(indep, jacSparsity_,
                                            row, col, jac, work);
 
-        // resize and zero matrix
-        jacobian_.resize(m - diffEqStart_, vnodes.size() - diffVarStart_);
-
-        map<size_t, Vnode<Base>*> origIndex2var;
-        for (size_t j = diffVarStart_; j< vnodes.size(); j++) {
-            Vnode<Base>* jj = vnodes[j];
-            origIndex2var[jj->tapeIndex()] = jj;
-        }
-
         // normalize values
+        vector<Eigen::Triplet<Base> > elements;
+        elements.reserve(jac.size());
+
         for (size_t e = 0; e < jac.size(); e++) {
             Enode<Base>* eqOrig = enodes[row[e]]->originalEquation();
-            Vnode<Base>* vOrig = origIndex2var[col[e]]->originalVariable(graph.getOrigTimeDependentCount());
+            Vnode<Base>* vOrig = tape2Var[col[e]]->originalVariable(graph.getOrigTimeDependentCount());
 
             // normalized jacobian value
             Base normVal = jac[e].getValue() * normVar_[vOrig->tapeIndex()]
                     / normEq_[eqOrig->index()];
 
             size_t i = row[e]; // same order
-            size_t j = origIndex2var[col[e]]->index(); // different order than in model/tape
+            size_t j = tape2Var[col[e]]->index(); // different order than in model/tape
 
-            jacobian_.coeffRef(i - diffEqStart_, j - diffVarStart_) = normVal;
+            elements.emplace_back(i - diffEqStart_, j - diffVarStart_, normVal);
         }
 
-        jacobian_.makeCompressed();
+        jacobian_.resize(m - diffEqStart_, vnodes.size() - diffVarStart_);
+        jacobian_.setFromTriplets(elements.begin(), elements.end());
 
         if (this->verbosity_ >= Verbosity::High) {
             log() << "\npartial jacobian:\n" << jacobian_ << "\n\n";
@@ -1400,23 +1422,32 @@ protected:
             return;
         }
 
+        /**
+         * The position of each variable in the list of variables of interest
+         */
+        std::vector<long> col2Var(jacobian_.cols(), -1);
+        for (size_t j = 0; j < vars.size(); j++) {
+            col2Var[vars[j]->index() - diffVarStart_] = j;
+        }
+
         /**
          * Determine the columns/variables that must be removed
          */
+        std::vector<bool> notZero(vars.size(), false);
+        for (size_t i = 0; i < eqs.size(); i++) {
+            Enode<Base>* ii = eqs[i];
+            for (typename Eigen::SparseMatrix<Base, Eigen::RowMajor>::InnerIterator it(jacobian_, ii->index() - diffEqStart_); it; ++it) {
+                long j = col2Var[it.col()];
+                if (j >= 0 && it.value() != Base(0.0)) {
+                    notZero[j] = true;
+                }
+            }
+        }
+
         std::set<size_t> excludeCols;
         std::set<size_t> avoidCols;
         for (size_t j = 0; j < vars.size(); j++) {
-            Vnode<Base>* jj = vars[j];
-            bool notZero = false;
-            for (size_t i = 0; i < eqs.size(); i++) {
-                Enode<Base>* ii = eqs[i];
-                Base val = jacobian_.coeff(ii->index() - diffEqStart_, jj->index() - diffVarStart_);
-                if (val != Base(0.0)) {
-                    notZero = true;
-                    break;
-                }
-            }
-            if (!notZero) {
+            if (!notZero[j]) {
                 // all zeros: must not choose this column/variable
                 excludeCols.insert(j);
             } else if (avoidAsDummy_.find(vars[j]->name()) != avoidAsDummy_.end()) {
@@ -1434,62 +1465,75 @@ protected:
         }
 
         std::vector<Vnode<Base>* > varsLocal;
-
-        Eigen::ColPivHouseholderQR<MatrixB> qr;
+        // selected columns (in varsLocal) ordered by their pivots
+        std::vector<size_t> selected;
 
         auto orderColumns = [&]() {
             varsLocal.reserve(vars.size() - excludeCols.size());
+            std::vector<long> var2Local(vars.size(), -1);
             for (size_t j = 0; j < vars.size(); j++) {
                 if (excludeCols.find(j) == excludeCols.end()) {
+                    var2Local[j] = varsLocal.size();
                     varsLocal.push_back(vars[j]);
                 }
             }
 
-
-            work.setZero(eqs.size(), varsLocal.size());
-
-            // determine the rows that only contain a single nonzero (a single column)
+            // the structure of the Jacobian subset
+            std::vector<std::vector<size_t> > eqVars(eqs.size());
+            std::vector<std::vector<Base> > eqValues(eqs.size());
             for (size_t i = 0; i < eqs.size(); i++) {
                 Enode<Base>* ii = eqs[i];
-                for (size_t j = 0; j < varsLocal.size(); j++) {
-                    const Vnode<Base>* jj = varsLocal[j];
-                    Base val = jacobian_.coeff(ii->index() - diffEqStart_, jj->index() - diffVarStart_);
-                    if (val != Base(0.0)) {
-                        work(i, j) = val;
+                for (typename Eigen::SparseMatrix<Base, Eigen::RowMajor>::InnerIterator it(jacobian_, ii->index() - diffEqStart_); it; ++it) {
+                    long j = col2Var[it.col()];
+                    if (j >= 0 && var2Local[j] >= 0 && it.value() != Base(0.0)) {
+                        eqVars[i].push_back(var2Local[j]);
+                        eqValues[i].push_back(it.value());
                     }
                 }
             }
 
+            /**
+             * independent blocks
+             */
+            std::vector<size_t> eqBlock, varBlock;
+            size_t nBlocks = connectedComponents(eqVars, varsLocal.size(), eqBlock, varBlock);
+
+            std::vector<std::vector<size_t> > blockEqs(nBlocks), blockVars(nBlocks);
+            for (size_t i = 0; i < eqs.size(); i++)
+                blockEqs[eqBlock[i]].push_back(i);
+            for (size_t j = 0; j < varsLocal.size(); j++)
+                blockVars[varBlock[j]].push_back(j);
+
             if (this->verbosity_ >= Verbosity::High)
-                log() << "subset Jac:\n" << work << "\n";
+                log() << "independent blocks: " << nBlocks << "\n";
 
-            qr.compute(work);
+            selected.clear();
+            selected.reserve(eqs.size());
 
-            if (qr.info() != Eigen::Success) {
-                throw CGException("Failed to select dummy derivatives! "
-                                  "QR decomposition of a submatrix of the Jacobian failed!");
-            } else if (qr.rank() < work.rows()) {
-                throw CGException("Failed to select dummy derivatives! "
-                                  "The resulting system is probably singular for the provided data.");
-            }
+            std::vector<long> local2Block(varsLocal.size(), -1);
 
-            using PermutationMatrix = typename Eigen::ColPivHouseholderQR<MatrixB>::PermutationType;
-            using Indices = typename PermutationMatrix::IndicesType;
+            for (size_t b = 0; b < nBlocks; b++) {
+                const std::vector<size_t>& bEqs = blockEqs[b];
+                const std::vector<size_t>& bVars = blockVars[b];
+                if (bEqs.empty())
+                    continue;
 
-            const PermutationMatrix& p = qr.colsPermutation();
-            const Indices& indices = p.indices();
+                if (bEqs.size() > bVars.size()) {
+                    throw CGException("Failed to select dummy derivatives! "
+                                      "The resulting system is probably singular for the provided data.");
+                }
 
-            if (this->verbosity_ >= Verbosity::High) {
-                log() << "## matrix Q:\n";
-                MatrixB q = qr.matrixQ();
-                log() << q << "\n";
-                log() << "## matrix R:\n";
-                MatrixB r = qr.matrixR().template triangularView<Eigen::Upper>();
-                log() << r << "\n";
-                log() << "## matrix P: " << indices.transpose() << "\n";
+                for (size_t c = 0; c < bVars.size(); c++)
+                    local2Block[bVars[c]] = c;
+
+                if (bVars.size() < sparseQRMinSize_) {
+                    selectColumnsDense(bEqs, bVars, eqVars, eqValues, local2Block, work, selected);
+                } else {
+                    selectColumnsSparse(bEqs, bVars, eqVars, eqValues, local2Block, selected);
+                }
             }
 
-            if (indices.size() < work.rows()) {
+            if (selected.size() < eqs.size()) {
                 throw CGException("Failed to select dummy derivatives! "
                                   "The resulting system is probably singular for the provided data.");
             }
@@ -1514,17 +1558,14 @@ protected:
             orderColumns();
         }
 
-        const auto& p = qr.colsPermutation();
-        const auto& indices = p.indices();
-
         std::vector<Vnode<Base>* > newDummies;
         if (avoidConvertAlg2DifVars_) {
             auto& graph = idxIdentify_->getGraph();
             const auto& varInfo = graph.getOriginalVariableInfo();
 
             // add algebraic first
-            for (int i = 0; newDummies.size() < size_t(work.rows()) && i < qr.rank(); i++) {
-                Vnode<Base>* v = varsLocal[indices(i)];
+            for (size_t i = 0; newDummies.size() < eqs.size() && i < selected.size(); i++) {
+                Vnode<Base>* v = varsLocal[selected[i]];
                 CPPADCG_ASSERT_UNKNOWN(v->originalVariable() != nullptr);
                 size_t tape = v->originalVariable()->tapeIndex();
                 CPPADCG_ASSERT_UNKNOWN(tape < varInfo.size());
@@ -1534,8 +1575,8 @@ protected:
                 }
             }
             // add remaining
-            for (int i = 0; newDummies.size() < size_t(work.rows()); i++) {
-                Vnode<Base>* v = varsLocal[indices(i)];
+            for (size_t i = 0; newDummies.size() < eqs.size(); i++) {
+                Vnode<Base>* v = varsLocal[selected[i]];
                 CPPADCG_ASSERT_UNKNOWN(v->originalVariable() != nullptr);
                 size_t tape = v->originalVariable()->tapeIndex();
                 CPPADCG_ASSERT_UNKNOWN(tape < varInfo.size());
@@ -1547,8 +1588,8 @@ protected:
 
         } else {
             // use order provided by the householder column pivoting
-            for (int i = 0; i < work.rows(); i++) {
-                newDummies.push_back(varsLocal[indices(i)]);
+            for (size_t i = 0; i < eqs.size(); i++) {
+                newDummies.push_back(varsLocal[selected[i]]);
             }
         }
 
@@ -1567,6 +1608,125 @@ protected:
         dummyD_.insert(dummyD_.end(), newDummies.begin(), newDummies.end());
     }
 
+    /**
+     * Selects the variables of an independent block of the Jacobian using
+     * a dense QR decomposition with column pivoting.
+     *
+     * @param bEqs the equations in the block
+     * @param bVars the variables in the block
+     * @param eqVars the variables in each equation
+     * @param eqValues the Jacobian values of the variables in each equation
+     * @param local2Block the position of the variables in the block
+     * @param work a work matrix
+     * @param selected the selected variables (output)
+     */
+    inline void selectColumnsDense(const std::vector<size_t>& bEqs,
+                                   const std::vector<size_t>& bVars,
+                                   const std::vector<std::vector<size_t> >& eqVars,
+                                   const std::vector<std::vector<Base> >& eqValues,
+                                   const std::vector<long>& local2Block,
+                                   MatrixB& work,
+                                   std::vector<size_t>& selected) {
+        work.setZero(bEqs.size(), bVars.size());
+
+        for (size_t r = 0; r < bEqs.size(); r++) {
+            size_t i = bEqs[r];
+            for (size_t e = 0; e < eqVars[i].size(); e++) {
+                work(r, local2Block[eqVars[i][e]]) = eqValues[i][e];
+            }
+        }
+
+        if (this->verbosity_ >= Verbosity::High)
+            log() << "subset Jac:\n" << work << "\n";
+
+        Eigen::ColPivHouseholderQR<MatrixB> qr(work);
+
+        if (qr.info() != Eigen::Success) {
+            throw CGException("Failed to select dummy derivatives! "
+                              "QR decomposition of a submatrix of the Jacobian failed!");
+        } else if (qr.rank() < work.rows()) {
+            throw CGException("Failed to select dummy derivatives! "
+                              "The resulting system is probably singular for the provided data.");
+        }
+
+        using PermutationMatrix = typename Eigen::ColPivHouseholderQR<MatrixB>::PermutationType;
+        using Indices = typename PermutationMatrix::IndicesType;
+
+        const PermutationMatrix& p = qr.colsPermutation();
+        const Indices& indices = p.indices();
+
+        if (this->verbosity_ >= Verbosity::High) {
+            log() << "## matrix Q:\n";
+            MatrixB q = qr.matrixQ();
+            log() << q << "\n";
+            log() << "## matrix R:\n";
+            MatrixB r = qr.matrixR().template triangularView<Eigen::Upper>();
+            log() << r << "\n";
+            log() << "## matrix P: " << indices.transpose() << "\n";
+        }
+
+        if (indices.size() < work.rows()) {
+            throw CGException("Failed to select dummy derivatives! "
+                              "The resulting system is probably singular for the provided data.");
+        }
+
+        for (int k = 0; k < work.rows(); k++) {
+            selected.push_back(bVars[indices(k)]);
+        }
+    }
+
+    /**
+     * Selects the variables of an independent block of the Jacobian using
+     * a sparse QR decomposition (rank revealing with a fill reducing column
+     * ordering).
+     *
+     * @param bEqs the equations in the block
+     * @param bVars the variables in the block
+     * @param eqVars the variables in each equation
+     * @param eqValues the Jacobian values of the variables in each equation
+     * @param local2Block the position of the variables in the block
+     * @param selected the selected variables (output)
+     */
+    inline void selectColumnsSparse(const std::vector<size_t>& bEqs,
+                                    const std::vector<size_t>& bVars,
+                                    const std::vector<std::vector<size_t> >& eqVars,
+                                    const std::vector<std::vector<Base> >& eqValues,
+                                    const std::vector<long>& local2Block,
+                                    std::vector<size_t>& selected) {
+        std::vector<Eigen::Triplet<Base> > elements;
+        for (size_t r = 0; r < bEqs.size(); r++) {
+            size_t i = bEqs[r];
+            for (size_t e = 0; e < eqVars[i].size(); e++) {
+                elements.emplace_back(r, local2Block[eqVars[i][e]], eqValues[i][e]);
+            }
+        }
+
+        SparseMatrixB mat(bEqs.size(), bVars.size());
+        mat.setFromTriplets(elements.begin(), elements.end());
+        mat.makeCompressed();
+
+        if (this->verbosity_ >= Verbosity::High)
+            log() << "subset Jac (sparse): " << mat.rows() << "x" << mat.cols() << " with " << mat.nonZeros() << " elements\n";
+
+        Eigen::SparseQR<SparseMatrixB, Eigen::COLAMDOrdering<int> > qr;
+        qr.compute(mat);
+
+        if (qr.info() != Eigen::Success) {
+            throw CGException("Failed to select dummy derivatives! "
+                              "QR decomposition of a submatrix of the Jacobian failed!");
+        } else if (size_t(qr.rank()) < bEqs.size()) {
+            throw CGException("Failed to select dummy derivatives! "
+                              "The resulting system is probably singular for the provided data.");
+        }
+
+        // linearly dependent columns are placed at the end
+        const auto& indices = qr.colsPermutation().indices();
+
+        for (size_t k = 0; k < bEqs.size(); k++) {
+            selected.push_back(bVars[indices(k)]);
+        }
+    }
+
     inline static void printModel(std::ostream& out,
                                   CodeHandler<Base>& handler,
                                   const std::vector<CGBase>& res,
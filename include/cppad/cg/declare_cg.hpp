@@ -59,6 +59,9 @@ class CodeHandlerVector;
 template<class Base>
 class CG;
 
+template<class Base>
+class GraphRewriter;
+
 template<class Base>
 struct OperationPathNode;
 
@@ -292,6 +295,15 @@ enum class JacobianADMode {
     Forward, Reverse, Automatic
 };
 
+/**
+ * Order of the non-zero values of generated sparse matrices
+ */
+enum class SparseMatrixFormat {
+    Coordinate, // order of the row and column index arrays (COO)
+    CSR, // compressed sparse row (row major with increasing column indexes)
+    CSC // compressed sparse column (column major with increasing row indexes)
+};
+
 /**
  * Index pattern types
  */
@@ -56,6 +56,9 @@ class HessianWithLoopsEquationGroupInfo;
 template<class Base>
 class HessianRowGroup;
 
+template<class Base>
+class LoopReverseTwoGraph;
+
 class ArrayGroup;
 
 template<class Base>
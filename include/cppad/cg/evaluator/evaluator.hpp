@@ -37,21 +37,61 @@ class EvaluatorBase;
  * pattern (CRTP). Therefore the default behaviour can be overridden without
  * the use of virtual methods.
  *
- * This class should not be instantiated directly.
+ * The operation graph is traversed with an explicit stack so that the
+ * arguments of an operation are always evaluated before the operation
+ * itself (see isArgumentsFirstEvaluation()) and deep graphs do not lead to
+ * stack limit issues.
+ * The results are kept in contiguous arrays indexed by the node position in
+ * the code handler which are reused by subsequent evaluations.
  *
- * @todo implement nonrecursive algorithm (so that there will never be any stack limit issues)
+ * This class should not be instantiated directly.
  */
 template<class ScalarIn, class ScalarOut, class ActiveOut, class FinalEvaluatorType>
 class EvaluatorBase {
     friend FinalEvaluatorType;
 protected:
     using SourceCodePath = typename CodeHandler<ScalarIn>::SourceCodePath;
+    /**
+     * An element in the stack used to traverse the operation graph
+     */
+    struct StackElement {
+        OperationNode<ScalarIn>* node;
+        size_t nextArg; // the next argument to be visited
+    };
 protected:
     CodeHandler<ScalarIn>& handler_;
     const ActiveOut* indep_;
-    CodeHandlerVector<ScalarIn, std::unique_ptr<ActiveOut>> evals_;
-    std::map<size_t, std::vector<ActiveOut>* > evalsArrays_;
-    std::map<size_t, std::vector<ActiveOut>* > evalsSparseArrays_;
+    /**
+     * the evaluation results of each node
+     * (only valid if evalsStamp_ matches evalId_)
+     */
+    CodeHandlerVector<ScalarIn, ActiveOut> evals_;
+    /**
+     * the evaluation results of each array creation (dense or sparse)
+     * (only valid if evalsArraysStamp_ matches evalId_)
+     */
+    CodeHandlerVector<ScalarIn, std::vector<ActiveOut>> evalsArrays_;
+    /**
+     * the evaluation in which a node was evaluated
+     */
+    CodeHandlerVector<ScalarIn, size_t> evalsStamp_;
+    /**
+     * the evaluation in which an array was evaluated
+     */
+    CodeHandlerVector<ScalarIn, size_t> evalsArraysStamp_;
+    /**
+     * the evaluation in which a node was added to the traversal stack
+     */
+    CodeHandlerVector<ScalarIn, size_t> visitStamp_;
+    /**
+     * identifies the current evaluation (previous results are invalidated
+     * by changing this value instead of clearing the arrays)
+     */
+    size_t evalId_;
+    /**
+     * the stack used to traverse the operation graph
+     */
+    std::vector<StackElement> stack_;
     bool underEval_;
     size_t depth_;
     SourceCodePath path_;
@@ -64,6 +104,11 @@ public:
         handler_(handler),
         indep_(nullptr),
         evals_(handler),
+        evalsArrays_(handler),
+        evalsStamp_(handler),
+        evalsArraysStamp_(handler),
+        visitStamp_(handler),
+        evalId_(1),
         underEval_(false),
         depth_(0) { // not really required (but it avoids warnings)
     }
@@ -154,6 +199,10 @@ public:
 
         clear(); // clean-up from any previous call that might have failed
         evals_.adjustSize();
+        evalsArrays_.adjustSize();
+        evalsStamp_.adjustSize();
+        evalsArraysStamp_.adjustSize();
+        visitStamp_.adjustSize();
 
         depth_ = 0;
         path_.clear();
@@ -193,19 +242,30 @@ protected:
 
     /**
      * clean-up
+     * (invalidates previous results while keeping the allocated memory for
+     * the next evaluation)
      */
     inline void clear() {
-        evals_.clear();
+        evalId_++;
+        stack_.clear();
+    }
 
-        for (const auto& p : evalsArrays_) {
-            delete p.second;
-        }
-        evalsArrays_.clear();
+    /**
+     * Whether or not all the arguments of an operation can be evaluated
+     * before the operation itself using an explicit stack (no recursion).
+     * Evaluators which depend on the path from the dependent variables
+     * (depth_ and path_) or which do not evaluate all the arguments of an
+     * operation should return false.
+     */
+    inline bool isArgumentsFirstEvaluation() const {
+        return true;
+    }
 
-        for (const auto& p : evalsSparseArrays_) {
-            delete p.second;
-        }
-        evalsSparseArrays_.clear();
+    /**
+     * @return true if the node was already evaluated in the current evaluation
+     */
+    inline bool isEvaluated(const OperationNode<ScalarIn>& node) const {
+        return evalsStamp_[node] == evalId_;
     }
 
     inline void analyzeOutIndeps(const ActiveOut* indep,
@@ -218,10 +278,66 @@ protected:
             // parameter
             return ActiveOut(dep.getValue());
         } else {
+            FinalEvaluatorType& thisOps = static_cast<FinalEvaluatorType&>(*this);
+            if (thisOps.isArgumentsFirstEvaluation()) {
+                evalArgumentsFirst(*dep.getOperationNode());
+            }
             return evalOperations(*dep.getOperationNode());
         }
     }
 
+    /**
+     * Evaluates all the operations required by a node (but not the node
+     * itself) in depth-first post-order using an explicit stack.
+     * Arrays and atomic functions are only evaluated by the operations
+     * using them, but their arguments are determined here.
+     *
+     * @param root the node whose dependencies are evaluated
+     */
+    inline void evalArgumentsFirst(OperationNode<ScalarIn>& root) {
+        if (isEvaluated(root) || visitStamp_[root] == evalId_)
+            return;
+
+        CPPADCG_ASSERT_UNKNOWN(stack_.empty())
+        visitStamp_[root] = evalId_;
+        stack_.push_back(StackElement{&root, 0});
+
+        while (!stack_.empty()) {
+            // do not use a reference because the stack may be resized
+            OperationNode<ScalarIn>* node = stack_.back().node;
+            const std::vector<Argument<ScalarIn> >& args = node->getArguments();
+
+            size_t& a = stack_.back().nextArg;
+            while (a < args.size()) {
+                OperationNode<ScalarIn>* arg = args[a].getOperation();
+                a++;
+                if (arg != nullptr && !isEvaluated(*arg) && visitStamp_[*arg] != evalId_) {
+                    visitStamp_[*arg] = evalId_;
+                    stack_.push_back(StackElement{arg, 0});
+                    break;
+                }
+            }
+
+            if (stack_.back().node != node)
+                continue; // visit the argument first
+
+            // all arguments have been visited
+            stack_.pop_back();
+
+            if (node == &root)
+                break;
+
+            CGOpCode op = node->getOperationType();
+            if (op != CGOpCode::ArrayCreation &&
+                op != CGOpCode::SparseArrayCreation &&
+                op != CGOpCode::AtomicForward &&
+                op != CGOpCode::AtomicReverse) {
+                CPPADCG_ASSERT_UNKNOWN(depth_ == 0)
+                evalOperations(*node);
+            }
+        }
+    }
+
     inline ActiveOut evalArg(const std::vector<Argument<ScalarIn> >& args,
                              size_t pos) {
         return evalArg(args[pos], pos);
@@ -243,8 +359,8 @@ protected:
         CPPADCG_ASSERT_KNOWN(node.getHandlerPosition() < handler_.getManagedNodesCount(), "this node is not managed by the code handler")
 
         // check if this node was previously determined
-        if (evals_[node] != nullptr) {
-            return *evals_[node];
+        if (isEvaluated(node)) {
+            return evals_[node];
         }
 
         // first evaluation of this node
@@ -256,7 +372,7 @@ protected:
         ActiveOut result = thisOps.evalOperation(node);
 
         // save it for reuse
-        ActiveOut* resultPtr = saveEvaluation(node, ActiveOut(result));
+        ActiveOut* resultPtr = saveEvaluation(node, std::move(result));
 
         depth_--;
         path_.pop_back();
@@ -266,16 +382,34 @@ protected:
 
     inline ActiveOut* saveEvaluation(const OperationNode<ScalarIn>& node,
                                      ActiveOut&& result) {
-        std::unique_ptr<ActiveOut>& resultPtr = evals_[node];
-        CPPADCG_ASSERT_UNKNOWN(resultPtr == nullptr); // not supposed to override existing result
-        resultPtr.reset(new ActiveOut(std::move(result)));
+        CPPADCG_ASSERT_UNKNOWN(!isEvaluated(node)) // not supposed to override existing result
+        evalsStamp_[node] = evalId_;
 
-        ActiveOut* resultPtr2 = resultPtr.get(); // do not use a reference (just in case evals_ is resized)
+        ActiveOut* resultPtr = &evals_[node];
+        *resultPtr = std::move(result);
 
         FinalEvaluatorType& thisOps = static_cast<FinalEvaluatorType&>(*this);
-        thisOps.processActiveOut(node, *resultPtr2);
+        thisOps.processActiveOut(node, *resultPtr);
+
+        return resultPtr;
+    }
 
-        return resultPtr2;
+    /**
+     * Provides the storage for the elements of an array creation operation.
+     *
+     * @param node the array creation operation (dense or sparse)
+     * @param created set to true if the array was not determined yet in
+     *                the current evaluation
+     */
+    inline std::vector<ActiveOut>& getEvaluationArray(const OperationNode<ScalarIn>& node,
+                                                      bool& created) {
+        std::vector<ActiveOut>& array = evalsArrays_[node];
+        created = evalsArraysStamp_[node] != evalId_;
+        if (created) {
+            evalsArraysStamp_[node] = evalId_;
+            array.resize(node.getArguments().size()); // keeps the previously allocated memory
+        }
+        return array;
     }
 
     inline std::vector<ActiveOut>& evalArrayCreationOperation(const OperationNode<ScalarIn>& node) {
@@ -284,23 +418,20 @@ protected:
         CPPADCG_ASSERT_KNOWN(node.getHandlerPosition() < handler_.getManagedNodesCount(), "this node is not managed by the code handler")
 
         // check if this node was previously determined
-        auto it = evalsArrays_.find(node.getHandlerPosition());
-        if (it != evalsArrays_.end()) {
-            return *it->second;
+        bool created;
+        std::vector<ActiveOut>& resultArray = getEvaluationArray(node, created);
+        if (!created) {
+            return resultArray;
         }
 
         const std::vector<Argument<ScalarIn> >& args = node.getArguments();
-        auto* resultArray = new std::vector<ActiveOut>(args.size());
-
-        // save it for reuse
-        evalsArrays_[node.getHandlerPosition()] = resultArray;
 
         // define its elements
         for (size_t a = 0; a < args.size(); a++) {
-            (*resultArray)[a] = evalArg(args, a);
+            resultArray[a] = evalArg(args, a);
         }
 
-        return *resultArray;
+        return resultArray;
     }
 
     inline std::vector<ActiveOut>& evalSparseArrayCreationOperation(const OperationNode<ScalarIn>& node) {
@@ -309,23 +440,20 @@ protected:
         CPPADCG_ASSERT_KNOWN(node.getHandlerPosition() < handler_.getManagedNodesCount(), "this node is not managed by the code handler")
 
         // check if this node was previously determined
-        auto it = evalsSparseArrays_.find(node.getHandlerPosition());
-        if (it != evalsSparseArrays_.end()) {
-            return *it->second;
+        bool created;
+        std::vector<ActiveOut>& resultArray = getEvaluationArray(node, created);
+        if (!created) {
+            return resultArray;
         }
 
         const std::vector<Argument<ScalarIn> >& args = node.getArguments();
-        auto* resultArray = new std::vector<ActiveOut>(args.size());
-
-        // save it for reuse
-        evalsSparseArrays_[node.getHandlerPosition()] = resultArray;
 
         // define its elements
         for (size_t a = 0; a < args.size(); a++) {
-            (*resultArray)[a] = evalArg(args, a);
+            resultArray[a] = evalArg(args, a);
         }
 
-        return *resultArray;
+        return resultArray;
     }
 
 };
@@ -155,8 +155,8 @@ protected:
                              "Invalid operation type")
 
         // check if this node was previously determined
-        if (evals_[node] != nullptr) {
-            return; // *evals_[node];
+        if (this->isEvaluated(node)) {
+            return; // evals_[node];
         }
 
         const std::vector<size_t>& info = node.getInfo();
@@ -228,8 +228,8 @@ protected:
      */
     inline ActiveOut evalArrayElement(const NodeIn& node) {
         // check if this node was previously determined
-        if (evals_[node] != nullptr) {
-            return *evals_[node];
+        if (this->isEvaluated(node)) {
+            return evals_[node];
         }
 
         const std::vector<ArgIn>& args = node.getArguments();
@@ -245,7 +245,7 @@ protected:
         auto& thisOps = static_cast<FinalEvaluatorType&>(*this);
         const NodeIn& atomicNode = *args[1].getOperation();
         thisOps.evalAtomicOperation(atomicNode); // atomic operation
-        ArgOut atomicArg = *evals_[atomicNode]->getOperationNode();
+        ArgOut atomicArg = *evals_[atomicNode].getOperationNode();
 
         ActiveOut out(*outHandler_->makeNode(CGOpCode::ArrayElement, {index}, {arrayArg, atomicArg}));
 
@@ -271,18 +271,9 @@ protected:
                                std::vector<ScalarOut>& values,
                                bool& valuesDefined,
                                bool& allParameters) {
-        const std::vector<ActiveOut>* arrayActiveOut;
-        ActiveOut result;
+        ActiveOut result = makeArray(node);
 
-        if (node.getOperationType() == CGOpCode::ArrayCreation) {
-            result = makeDenseArray(node);
-            arrayActiveOut = this->evalsArrays_[node.getHandlerPosition()];
-        } else {
-            result = makeSparseArray(node);
-            arrayActiveOut = this->evalsSparseArrays_[node.getHandlerPosition()];
-        }
-
-        processArray(*arrayActiveOut, values, valuesDefined, allParameters);
+        processArray(this->evalsArrays_[node], values, valuesDefined, allParameters);
 
         return result;
     }
@@ -292,8 +283,8 @@ protected:
         CPPADCG_ASSERT_KNOWN(node.getHandlerPosition() < this->handler_.getManagedNodesCount(), "this node is not managed by the code handler")
 
         // check if this node was previously determined
-        if (evals_[node] != nullptr) {
-            return *evals_[node];
+        if (this->isEvaluated(node)) {
+            return evals_[node];
         }
 
         if (outHandler_ == nullptr) {
@@ -312,8 +303,8 @@ protected:
         CPPADCG_ASSERT_KNOWN(node.getHandlerPosition() < this->handler_.getManagedNodesCount(), "this node is not managed by the code handler")
 
         // check if this node was previously determined
-        if (evals_[node] != nullptr) {
-            return *evals_[node];
+        if (this->isEvaluated(node)) {
+            return evals_[node];
         }
 
         if (outHandler_ == nullptr) {
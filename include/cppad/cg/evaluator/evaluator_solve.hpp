@@ -133,6 +133,17 @@ public:
 
 protected:
 
+    /**
+     * The evaluation depends on the path to each operation (depth_ and
+     * path_) and therefore the operations must be evaluated recursively.
+     *
+     * @note overrides the default isArgumentsFirstEvaluation() even though
+     *        this method is not virtual (hides a method in EvaluatorBase)
+     */
+    inline bool isArgumentsFirstEvaluation() const {
+        return false;
+    }
+
     /**
      * @note overrides the default evalOperation() even though this method
      *        is not virtual (hides a method in EvaluatorOperations)
@@ -129,6 +129,19 @@ template<class VectorSet, class VectorSize>
 inline void generateSparsitySet(const VectorSize& row,
                                 const VectorSize& col,
                                 VectorSet& sparsity);
+
+template<class VectorSize>
+inline void sortSparsityIndexes(SparseMatrixFormat format,
+                                VectorSize& row,
+                                VectorSize& col);
+
+template<class VectorSize>
+inline void generateCompressedSparsityIndexes(SparseMatrixFormat format,
+                                              size_t outerSize,
+                                              const VectorSize& row,
+                                              const VectorSize& col,
+                                              std::vector<size_t>& ptr,
+                                              std::vector<size_t>& ind);
 }
 }
 
@@ -308,6 +308,91 @@ inline void generateSparsitySet(const VectorSize& row,
     }
 }
 
+/**
+ * Reorders the elements of a sparsity pattern so that they follow the
+ * storage order of a compressed sparse format.
+ *
+ * @param format CSR sorts elements by row and then by column, CSC sorts them
+ *               by column and then by row, and Coordinate keeps the current
+ *               order
+ * @param row the row index of each element
+ * @param col the column index of each element
+ */
+template<class VectorSize>
+inline void sortSparsityIndexes(SparseMatrixFormat format,
+                                VectorSize& row,
+                                VectorSize& col) {
+    assert(row.size() == col.size());
+
+    if (format == SparseMatrixFormat::Coordinate)
+        return;
+
+    size_t nnz = row.size();
+    std::vector<std::pair<size_t, size_t> > elements(nnz);
+    for (size_t e = 0; e < nnz; e++) {
+        if (format == SparseMatrixFormat::CSR)
+            elements[e] = std::make_pair(row[e], col[e]);
+        else
+            elements[e] = std::make_pair(col[e], row[e]);
+    }
+
+    // stable so that repeated elements keep their relative order
+    std::stable_sort(elements.begin(), elements.end());
+
+    for (size_t e = 0; e < nnz; e++) {
+        if (format == SparseMatrixFormat::CSR) {
+            row[e] = elements[e].first;
+            col[e] = elements[e].second;
+        } else {
+            col[e] = elements[e].first;
+            row[e] = elements[e].second;
+        }
+    }
+}
+
+/**
+ * Creates the index arrays of a compressed sparse format (CSR or CSC) from
+ * the row and column indexes of elements already sorted with
+ * sortSparsityIndexes().
+ *
+ * @param format CSR or CSC
+ * @param outerSize the number of rows (CSR) or columns (CSC)
+ * @param row the row index of each element
+ * @param col the column index of each element
+ * @param ptr the position of the first element of each row (CSR) or
+ *            column (CSC) with an additional last value equal to the number
+ *            of elements
+ * @param ind the column (CSR) or row (CSC) index of each element
+ */
+template<class VectorSize>
+inline void generateCompressedSparsityIndexes(SparseMatrixFormat format,
+                                              size_t outerSize,
+                                              const VectorSize& row,
+                                              const VectorSize& col,
+                                              std::vector<size_t>& ptr,
+                                              std::vector<size_t>& ind) {
+    CPPADCG_ASSERT_KNOWN(format != SparseMatrixFormat::Coordinate, "Invalid compressed sparse format")
+    assert(row.size() == col.size());
+
+    const VectorSize& outer = format == SparseMatrixFormat::CSR ? row : col;
+    const VectorSize& inner = format == SparseMatrixFormat::CSR ? col : row;
+
+    size_t nnz = row.size();
+    ptr.assign(outerSize + 1, 0);
+    ind.resize(nnz);
+
+    for (size_t e = 0; e < nnz; e++) {
+        CPPADCG_ASSERT_KNOWN(outer[e] < outerSize, "Invalid sparsity index")
+        CPPADCG_ASSERT_KNOWN(e == 0 || outer[e - 1] <= outer[e], "Sparsity elements are not sorted")
+        ptr[outer[e] + 1]++;
+        ind[e] = inner[e];
+    }
+
+    for (size_t o = 0; o < outerSize; o++) {
+        ptr[o + 1] += ptr[o];
+    }
+}
+
 } // END cg namespace
 } // END CppAD namespace
 
@@ -0,0 +1,556 @@
+#ifndef CPPAD_CG_GRAPH_REWRITER_INCLUDED
+#define CPPAD_CG_GRAPH_REWRITER_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A rule which replaces an operation by a cheaper equivalent expression.
+ * Rules modify the operation nodes in place (so that all the operations
+ * using them are also affected) and can create new nodes using the
+ * GraphRewriter.
+ */
+template<class Base>
+class RewriteRule {
+public:
+    /**
+     * @return a name used to identify the rule in reports
+     */
+    virtual const std::string& getName() const = 0;
+
+    /**
+     * Attempts to rewrite an operation.
+     *
+     * @param rewriter the object performing the rewrite (used to create and
+     *                 modify nodes)
+     * @param node the operation to be rewritten
+     * @return true if the operation was modified
+     */
+    virtual bool apply(GraphRewriter<Base>& rewriter,
+                       OperationNode<Base>& node) = 0;
+
+    inline virtual ~RewriteRule() = default;
+};
+
+/**
+ * Replaces powers with constant exponents:
+ *  - small integer exponents by repeated multiplications
+ *    (e.g. pow(x, 3) -> x * x * x, pow(x, -2) -> 1 / (x * x)),
+ *  - pow(x, 0.5) by sqrt(x),
+ *  - pow(x, -0.5) by 1 / sqrt(x),
+ *  - pow(x, 1.5) by x * sqrt(x).
+ */
+template<class Base>
+class PowRewriteRule : public RewriteRule<Base> {
+protected:
+    using Node = OperationNode<Base>;
+    using Arg = Argument<Base>;
+protected:
+    /**
+     * the largest absolute integer exponent replaced by multiplications
+     */
+    size_t _maxExponent;
+public:
+
+    inline explicit PowRewriteRule(size_t maxExponent = 4) :
+        _maxExponent(maxExponent) {
+    }
+
+    const std::string& getName() const override {
+        static const std::string name("pow");
+        return name;
+    }
+
+    bool apply(GraphRewriter<Base>& rewriter,
+               Node& node) override {
+        if (node.getOperationType() != CGOpCode::Pow)
+            return false;
+
+        const std::vector<Arg>& args = node.getArguments();
+        if (args[0].getOperation() == nullptr || args[1].getParameter() == nullptr)
+            return false; // only variables with constant exponents
+
+        const Arg x = args[0];
+        const Base e = *args[1].getParameter();
+
+        if (e == Base(0.5)) {
+            rewriter.setOperation(node, CGOpCode::Sqrt, {x});
+            return true;
+        } else if (e == Base(-0.5)) {
+            Arg s(*rewriter.makeNode(CGOpCode::Sqrt, {x}));
+            rewriter.setOperation(node, CGOpCode::Div, {Arg(Base(1)), s});
+            return true;
+        } else if (e == Base(1.5)) {
+            Arg s(*rewriter.makeNode(CGOpCode::Sqrt, {x}));
+            rewriter.setOperation(node, CGOpCode::Mul, {x, s});
+            return true;
+        }
+
+        for (size_t k = 1; k <= _maxExponent; ++k) {
+            if (e == Base(k)) {
+                if (k == 1)
+                    return false; // would require an alias
+                if (k % 2 == 0) {
+                    Arg h = makeIntegerPower(rewriter, x, k / 2);
+                    rewriter.setOperation(node, CGOpCode::Mul, {h, h});
+                } else {
+                    Arg r = makeIntegerPower(rewriter, x, k - 1);
+                    rewriter.setOperation(node, CGOpCode::Mul, {r, x});
+                }
+                return true;
+            } else if (e == -Base(k)) {
+                Arg d = makeIntegerPower(rewriter, x, k);
+                rewriter.setOperation(node, CGOpCode::Div, {Arg(Base(1)), d});
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+protected:
+
+    /**
+     * Creates the nodes for x^k using the minimum number of
+     * multiplications (exponentiation by squaring).
+     */
+    static inline Arg makeIntegerPower(GraphRewriter<Base>& rewriter,
+                                       const Arg& x,
+                                       size_t k) {
+        CPPADCG_ASSERT_UNKNOWN(k > 0)
+        if (k == 1)
+            return x;
+
+        Arg h = makeIntegerPower(rewriter, x, k / 2);
+        Arg sq(*rewriter.makeNode(CGOpCode::Mul, {h, h}));
+        if (k % 2 == 0)
+            return sq;
+        else
+            return Arg(*rewriter.makeNode(CGOpCode::Mul, {sq, x}));
+    }
+};
+
+/**
+ * Replaces divisions by a constant with a multiplication by its reciprocal
+ * (x / c -> x * (1 / c)).
+ * The results can differ from the division in the last bit unless the
+ * constant is a power of two.
+ */
+template<class Base>
+class DivisionRewriteRule : public RewriteRule<Base> {
+protected:
+    using Arg = Argument<Base>;
+public:
+
+    const std::string& getName() const override {
+        static const std::string name("division by constant");
+        return name;
+    }
+
+    bool apply(GraphRewriter<Base>& rewriter,
+               OperationNode<Base>& node) override {
+        if (node.getOperationType() != CGOpCode::Div)
+            return false;
+
+        const std::vector<Arg>& args = node.getArguments();
+        if (args[1].getParameter() == nullptr || *args[1].getParameter() == Base(0))
+            return false;
+
+        Arg a = args[0];
+        Base c = Base(1) / *args[1].getParameter();
+        rewriter.setOperation(node, CGOpCode::Mul, {a, Arg(c)});
+        return true;
+    }
+};
+
+/**
+ * Merges the product of two exponentials (exp(a) * exp(b) -> exp(a + b))
+ * when the exponentials are not used by any other operation.
+ */
+template<class Base>
+class ExpProductRewriteRule : public RewriteRule<Base> {
+protected:
+    using Node = OperationNode<Base>;
+    using Arg = Argument<Base>;
+public:
+
+    const std::string& getName() const override {
+        static const std::string name("exp product");
+        return name;
+    }
+
+    bool apply(GraphRewriter<Base>& rewriter,
+               Node& node) override {
+        if (node.getOperationType() != CGOpCode::Mul)
+            return false;
+
+        const std::vector<Arg>& args = node.getArguments();
+        Node* e1 = args[0].getOperation();
+        Node* e2 = args[1].getOperation();
+        if (e1 == nullptr || e2 == nullptr ||
+            e1->getOperationType() != CGOpCode::Exp ||
+            e2->getOperationType() != CGOpCode::Exp)
+            return false;
+
+        if (e1 == e2) {
+            if (rewriter.getUseCount(*e1) != 2)
+                return false;
+        } else if (rewriter.getUseCount(*e1) != 1 || rewriter.getUseCount(*e2) != 1) {
+            return false;
+        }
+
+        Arg sum(*rewriter.makeNode(CGOpCode::Add, {e1->getArguments()[0], e2->getArguments()[0]}));
+        rewriter.setOperation(node, CGOpCode::Exp, {sum});
+        return true;
+    }
+};
+
+/**
+ * Applies a set of rewrite rules to the operations used by the dependent
+ * variables of a CodeHandler.
+ * It can be used directly or by CodeHandler::generateCode() (see
+ * CodeHandler::setGraphRewriter()) in which case the graph is rewritten
+ * before generating source code.
+ *
+ * Paired sin(x)/cos(x) operations are not modified since they are already
+ * emitted with the same argument and C compilers combine them into a
+ * single sincos call.
+ */
+template<class Base>
+class GraphRewriter {
+public:
+    using Node = OperationNode<Base>;
+    using Arg = Argument<Base>;
+    using CGB = CG<Base>;
+protected:
+    /**
+     * the rules (not owned)
+     */
+    std::vector<RewriteRule<Base>*> _rules;
+    /**
+     * default rules (owned)
+     */
+    std::vector<std::unique_ptr<RewriteRule<Base>>> _defaultRules;
+    /**
+     * the handler being modified
+     */
+    CodeHandler<Base>* _handler;
+    /**
+     * the number of times each node is used (indexed by handler position)
+     */
+    std::vector<size_t> _useCount;
+    /**
+     * the number of operations of each type before rewriting
+     * (accumulated over all calls to rewrite())
+     */
+    std::map<CGOpCode, size_t> _countsBefore;
+    /**
+     * the number of operations of each type after rewriting
+     * (accumulated over all calls to rewrite())
+     */
+    std::map<CGOpCode, size_t> _countsAfter;
+    /**
+     * the number of times each rule was applied
+     */
+    std::map<std::string, size_t> _applications;
+public:
+
+    /**
+     * Creates a rewriter
+     *
+     * @param defaultRules whether or not to use the default rules
+     *                     (powers, division by constants, and products of
+     *                     exponentials)
+     */
+    inline explicit GraphRewriter(bool defaultRules = true) :
+        _handler(nullptr) {
+        if (defaultRules) {
+            _defaultRules.emplace_back(new PowRewriteRule<Base>());
+            _defaultRules.emplace_back(new DivisionRewriteRule<Base>());
+            _defaultRules.emplace_back(new ExpProductRewriteRule<Base>());
+            for (auto& r : _defaultRules)
+                _rules.push_back(r.get());
+        }
+    }
+
+    GraphRewriter(const GraphRewriter&) = delete;
+    GraphRewriter& operator=(const GraphRewriter&) = delete;
+
+    inline virtual ~GraphRewriter() = default;
+
+    /**
+     * Adds a new rule which is applied after the previously added rules.
+     *
+     * @param rule the rule (not owned; must exist while this object is used)
+     */
+    inline void addRule(RewriteRule<Base>& rule) {
+        _rules.push_back(&rule);
+    }
+
+    inline const std::vector<RewriteRule<Base>*>& getRules() const {
+        return _rules;
+    }
+
+    /**
+     * Rewrites the operations used by the dependent variables.
+     *
+     * @param handler the handler which owns the operations
+     * @param dependent the dependent variables
+     * @return the number of rewritten operations
+     */
+    inline size_t rewrite(CodeHandler<Base>& handler,
+                          ArrayView<CGB> dependent) {
+        _handler = &handler;
+
+        std::vector<Node*> order = postOrder(handler, dependent);
+
+        countOperations(order, _countsBefore);
+
+        /**
+         * determine the number of times each node is used
+         */
+        _useCount.assign(handler.getManagedNodesCount(), 0);
+        for (size_t i = 0; i < dependent.size(); ++i) {
+            if (dependent[i].getOperationNode() != nullptr)
+                _useCount[dependent[i].getOperationNode()->getHandlerPosition()]++;
+        }
+        for (Node* node : order) {
+            for (const Arg& a : node->getArguments()) {
+                if (a.getOperation() != nullptr)
+                    _useCount[a.getOperation()->getHandlerPosition()]++;
+            }
+        }
+
+        /**
+         * apply rules (arguments first)
+         */
+        size_t changed = 0;
+        for (Node* node : order) {
+            bool nodeChanged = false;
+            for (size_t pass = 0; pass < 10; ++pass) { // a rule might enable other rules
+                bool passChanged = false;
+                for (RewriteRule<Base>* rule : _rules) {
+                    if (rule->apply(*this, *node)) {
+                        _applications[rule->getName()]++;
+                        passChanged = true;
+                    }
+                }
+                if (!passChanged)
+                    break;
+                nodeChanged = true;
+            }
+            if (nodeChanged)
+                changed++;
+        }
+
+        order = postOrder(handler, dependent);
+        countOperations(order, _countsAfter);
+
+        _useCount.clear();
+        _handler = nullptr;
+
+        return changed;
+    }
+
+    /**
+     * Creates a new node in the code handler being rewritten.
+     */
+    inline Node* makeNode(CGOpCode op,
+                          std::vector<Arg>&& args) {
+        CPPADCG_ASSERT_UNKNOWN(_handler != nullptr)
+        for (const Arg& a : args)
+            addUse(a);
+
+        Node* node = _handler->makeNode(op, std::move(args));
+        _useCount.resize(_handler->getManagedNodesCount(), 0);
+        return node;
+    }
+
+    /**
+     * Changes the operation of an existing node.
+     */
+    inline void setOperation(Node& node,
+                             CGOpCode op,
+                             std::vector<Arg>&& args) {
+        for (const Arg& a : args)
+            addUse(a);
+        for (const Arg& a : node.getArguments())
+            removeUse(a);
+
+        node.setOperation(op, args);
+    }
+
+    /**
+     * @return the number of operations (and dependent variables) using
+     *         the result of a node
+     */
+    inline size_t getUseCount(const Node& node) const {
+        size_t p = node.getHandlerPosition();
+        return p < _useCount.size() ? _useCount[p] : 0;
+    }
+
+    /**
+     * @return the number of operations of each type used by the dependent
+     *         variables before rewriting
+     */
+    inline const std::map<CGOpCode, size_t>& getOperationCountsBefore() const {
+        return _countsBefore;
+    }
+
+    /**
+     * @return the number of operations of each type used by the dependent
+     *         variables after rewriting
+     */
+    inline const std::map<CGOpCode, size_t>& getOperationCountsAfter() const {
+        return _countsAfter;
+    }
+
+    /**
+     * @return the number of times each rule was applied
+     */
+    inline const std::map<std::string, size_t>& getRuleApplications() const {
+        return _applications;
+    }
+
+    /**
+     * Clears the operation counts and rule applications.
+     */
+    inline void resetReport() {
+        _countsBefore.clear();
+        _countsAfter.clear();
+        _applications.clear();
+    }
+
+    /**
+     * Prints the number of operations of each type before and after
+     * rewriting and the number of times each rule was applied.
+     */
+    inline void printReport(std::ostream& out) const {
+        std::set<CGOpCode> ops;
+        for (const auto& p : _countsBefore)
+            ops.insert(p.first);
+        for (const auto& p : _countsAfter)
+            ops.insert(p.first);
+
+        out << "operation  before  after\n";
+        size_t totalBefore = 0, totalAfter = 0;
+        for (CGOpCode op : ops) {
+            size_t b = count(_countsBefore, op);
+            size_t a = count(_countsAfter, op);
+            out << op << "  " << b << "  " << a << "\n";
+            totalBefore += b;
+            totalAfter += a;
+        }
+        out << "total  " << totalBefore << "  " << totalAfter << "\n";
+
+        for (const auto& p : _applications)
+            out << "rule '" << p.first << "' applied " << p.second << " times\n";
+    }
+
+    /**
+     * Determines the number of operations of each type used by the
+     * dependent variables.
+     */
+    static inline std::map<CGOpCode, size_t> countOperations(CodeHandler<Base>& handler,
+                                                             ArrayView<CGB> dependent) {
+        std::map<CGOpCode, size_t> counts;
+        countOperations(postOrder(handler, dependent), counts);
+        return counts;
+    }
+
+protected:
+
+    inline void addUse(const Arg& a) {
+        if (a.getOperation() != nullptr) {
+            size_t p = a.getOperation()->getHandlerPosition();
+            if (p >= _useCount.size())
+                _useCount.resize(p + 1, 0);
+            _useCount[p]++;
+        }
+    }
+
+    inline void removeUse(const Arg& a) {
+        if (a.getOperation() != nullptr) {
+            size_t p = a.getOperation()->getHandlerPosition();
+            if (p < _useCount.size() && _useCount[p] > 0)
+                _useCount[p]--;
+        }
+    }
+
+    static inline size_t count(const std::map<CGOpCode, size_t>& counts,
+                               CGOpCode op) {
+        auto it = counts.find(op);
+        return it != counts.end() ? it->second : 0;
+    }
+
+    static inline void countOperations(const std::vector<Node*>& order,
+                                       std::map<CGOpCode, size_t>& counts) {
+        for (const Node* node : order)
+            counts[node->getOperationType()]++;
+    }
+
+    /**
+     * Determines the operations used by the dependent variables in an
+     * order where arguments appear before the operations using them
+     * (without recursion).
+     */
+    static inline std::vector<Node*> postOrder(CodeHandler<Base>& handler,
+                                               ArrayView<CGB> dependent) {
+        std::vector<Node*> order;
+        std::vector<bool> visited(handler.getManagedNodesCount(), false);
+        std::vector<std::pair<Node*, size_t>> stack;
+
+        for (size_t i = 0; i < dependent.size(); ++i) {
+            Node* root = dependent[i].getOperationNode();
+            if (root == nullptr || visited[root->getHandlerPosition()])
+                continue;
+
+            visited[root->getHandlerPosition()] = true;
+            stack.emplace_back(root, 0);
+
+            while (!stack.empty()) {
+                Node* node = stack.back().first;
+                size_t& a = stack.back().second;
+                const std::vector<Arg>& args = node->getArguments();
+
+                Node* next = nullptr;
+                while (a < args.size() && next == nullptr) {
+                    Node* arg = args[a].getOperation();
+                    a++;
+                    if (arg != nullptr && !visited[arg->getHandlerPosition()]) {
+                        visited[arg->getHandlerPosition()] = true;
+                        next = arg;
+                    }
+                }
+
+                if (next != nullptr) {
+                    stack.emplace_back(next, 0);
+                } else {
+                    order.push_back(node);
+                    stack.pop_back();
+                }
+            }
+        }
+
+        return order;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
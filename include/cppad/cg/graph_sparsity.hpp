@@ -0,0 +1,585 @@
+#ifndef CPPAD_CG_GRAPH_SPARSITY_INCLUDED
+#define CPPAD_CG_GRAPH_SPARSITY_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Determines Jacobian and Hessian sparsity patterns directly from the
+ * operation graph of a CodeHandler (no CppAD sparsity sweeps).
+ *
+ * Jacobian sparsity is propagated through the graph with packed bit sets
+ * for blocks of independent variables, so that memory is proportional to
+ * the number of nodes times the block size.
+ * Hessian sparsity uses sorted lists with the independent variables of each
+ * node and adds the interactions introduced by each nonlinear operation
+ * which affects the selected equations.
+ *
+ * Blocks of independent variables (Jacobian) and equations (Hessian by
+ * equation) can be processed by several threads.
+ * The patterns are conservative in the same way as the ones from CppAD
+ * (e.g. both results of conditional expressions are considered).
+ * Operation graphs with loops are not supported.
+ */
+template<class Base>
+class GraphSparsity {
+public:
+    using Node = OperationNode<Base>;
+    using CGB = CG<Base>;
+    using SparsitySetType = std::vector<std::set<size_t> >;
+    using Word = std::uint64_t;
+private:
+    static const size_t WORD_BITS = 64;
+    static const size_t NONE = (std::numeric_limits<size_t>::max)();
+private:
+    /**
+     * the number of independent variables
+     */
+    size_t n_;
+    /**
+     * the operation nodes in topological order (arguments first)
+     */
+    std::vector<Node*> order_;
+    /**
+     * the position in order_ of the arguments of each node
+     * (NONE for parameters and arguments with no influence on the result
+     * derivatives such as the condition of a conditional expression)
+     */
+    std::vector<std::vector<size_t> > args_;
+    /**
+     * the independent variable index of each node in order_ (or NONE)
+     */
+    std::vector<size_t> indep_;
+    /**
+     * the position in order_ of each dependent variable (or NONE)
+     */
+    std::vector<size_t> dep_;
+    /**
+     * the sorted independent variables which affect each node
+     * (only determined for Hessians)
+     */
+    std::vector<std::vector<size_t> > vars_;
+    /**
+     * the number of words in the bit sets used for a block of independent
+     * variables
+     */
+    size_t blockWords_;
+    /**
+     * the maximum number of threads
+     */
+    size_t threads_;
+public:
+
+    /**
+     * Creates the sparsity engine for the operation graph of a handler.
+     *
+     * @param handler the handler which owns the operation graph and where
+     *                the independent variables were created
+     * @param dependent the dependent variables
+     * @throws CGException if the graph contains unsupported operations
+     *                     (e.g. loops)
+     */
+    inline GraphSparsity(CodeHandler<Base>& handler,
+                         const std::vector<CGB>& dependent) :
+            n_(handler.getIndependentVariableSize()),
+            dep_(dependent.size(), NONE),
+            blockWords_(16),
+            threads_(1) {
+        CodeHandlerVector<Base, size_t> position(handler); // position in order_ plus one
+        position.adjustSize();
+
+        /**
+         * topological order (non-recursive depth first)
+         */
+        std::vector<std::pair<Node*, size_t> > stack;
+
+        for (size_t i = 0; i < dependent.size(); ++i) {
+            Node* root = dependent[i].getOperationNode();
+            if (root == nullptr)
+                continue;
+
+            if (position[*root] == 0) {
+                stack.emplace_back(root, 0);
+
+                while (!stack.empty()) {
+                    Node* node = stack.back().first;
+                    size_t& a = stack.back().second;
+                    const std::vector<Argument<Base> >& args = node->getArguments();
+
+                    if (a < args.size()) {
+                        Node* arg = args[a].getOperation();
+                        ++a;
+                        if (arg != nullptr && position[*arg] == 0) {
+                            stack.emplace_back(arg, 0);
+                        }
+                    } else {
+                        order_.push_back(node);
+                        position[*node] = order_.size();
+                        stack.pop_back();
+                    }
+                }
+            }
+
+            dep_[i] = position[*root] - 1;
+        }
+
+        /**
+         * arguments and independent variables
+         */
+        args_.resize(order_.size());
+        indep_.resize(order_.size(), NONE);
+
+        for (size_t k = 0; k < order_.size(); ++k) {
+            const Node& node = *order_[k];
+            CGOpCode op = node.getOperationType();
+
+            if (op == CGOpCode::Inv) {
+                indep_[k] = handler.getIndependentVariableIndex(node);
+                continue;
+            }
+
+            checkSupported(op);
+
+            const std::vector<Argument<Base> >& args = node.getArguments();
+            args_[k].resize(args.size(), NONE);
+            for (size_t a = 0; a < args.size(); ++a) {
+                if (args[a].getOperation() != nullptr && isDerivativeArgument(op, a)) {
+                    args_[k][a] = position[*args[a].getOperation()] - 1;
+                }
+            }
+        }
+    }
+
+    GraphSparsity(const GraphSparsity&) = delete;
+
+    GraphSparsity& operator=(const GraphSparsity&) = delete;
+
+    /**
+     * Defines the number of 64 bit words used to propagate the Jacobian
+     * sparsity of a block of independent variables.
+     * Larger blocks require fewer graph traversals but more memory.
+     */
+    inline void setBlockWords(size_t words) {
+        CPPADCG_ASSERT_KNOWN(words > 0, "The block size must be positive")
+        blockWords_ = words;
+    }
+
+    inline size_t getBlockWords() const {
+        return blockWords_;
+    }
+
+    /**
+     * Defines the maximum number of threads used to determine sparsity
+     * patterns (1 means that no additional threads are created).
+     */
+    inline void setThreads(size_t threads) {
+        threads_ = threads == 0 ? 1 : threads;
+    }
+
+    inline size_t getThreads() const {
+        return threads_;
+    }
+
+    /**
+     * The number of operation nodes used by the dependent variables
+     */
+    inline size_t getNodeCount() const {
+        return order_.size();
+    }
+
+    /**
+     * Determines the Jacobian sparsity pattern.
+     *
+     * @return the columns of the non-zero elements in each row
+     */
+    inline SparsitySetType jacobianSparsity() const {
+        const size_t m = dep_.size();
+        const size_t blockBits = blockWords_ * WORD_BITS;
+        const size_t nBlocks = (n_ + blockBits - 1) / blockBits;
+
+        std::vector<std::vector<std::vector<size_t> > > blockRows(nBlocks);
+
+        parallelFor(nBlocks, [&](size_t b) {
+            blockRows[b] = jacobianBlock(b);
+        });
+
+        SparsitySetType jac(m);
+        for (size_t b = 0; b < nBlocks; ++b) {
+            for (size_t i = 0; i < m; ++i) {
+                const std::vector<size_t>& cols = blockRows[b][i];
+                jac[i].insert(cols.begin(), cols.end());
+            }
+        }
+
+        return jac;
+    }
+
+    /**
+     * Determines the sparsity pattern of the sum of the Hessians of all
+     * the dependent variables.
+     */
+    inline SparsitySetType hessianSparsity() {
+        std::set<size_t> equations;
+        for (size_t i = 0; i < dep_.size(); ++i)
+            equations.insert(i);
+        return hessianSparsity(equations);
+    }
+
+    /**
+     * Determines the sparsity pattern of the sum of the Hessians of a
+     * subset of the dependent variables.
+     *
+     * @param equations the dependent variable indexes
+     */
+    inline SparsitySetType hessianSparsity(const std::set<size_t>& equations) {
+        determineVariables();
+
+        std::vector<bool> active(order_.size(), false);
+        for (size_t i : equations) {
+            CPPADCG_ASSERT_KNOWN(i < dep_.size(), "Invalid dependent variable index")
+            if (dep_[i] != NONE)
+                active[dep_[i]] = true;
+        }
+
+        // reverse sweep (arguments are always before their users)
+        for (size_t k = order_.size(); k-- > 0;) {
+            if (!active[k])
+                continue;
+            for (size_t a : args_[k]) {
+                if (a != NONE)
+                    active[a] = true;
+            }
+        }
+
+        SparsitySetType hess(n_);
+        for (size_t k = 0; k < order_.size(); ++k) {
+            if (active[k])
+                addHessianContribution(k, hess);
+        }
+
+        return hess;
+    }
+
+    /**
+     * Determines the sparsity pattern of the Hessian of each dependent
+     * variable.
+     */
+    inline std::vector<SparsitySetType> hessianSparsityByEquation() {
+        determineVariables();
+
+        const size_t m = dep_.size();
+        std::vector<SparsitySetType> hess(m);
+
+        parallelFor(m, [&](size_t i) {
+            hess[i] = hessianSparsityOfEquation(i);
+        });
+
+        return hess;
+    }
+
+private:
+
+    /**
+     * Propagates the dependencies on a block of independent variables.
+     *
+     * @return the columns (in the block) of each row of the Jacobian
+     */
+    inline std::vector<std::vector<size_t> > jacobianBlock(size_t b) const {
+        const size_t w = blockWords_;
+        const size_t first = b * w * WORD_BITS;
+        const size_t last = std::min(first + w * WORD_BITS, n_);
+
+        std::vector<Word> bits(order_.size() * w, 0);
+
+        for (size_t k = 0; k < order_.size(); ++k) {
+            Word* bk = &bits[k * w];
+
+            size_t j = indep_[k];
+            if (j != NONE) {
+                if (j >= first && j < last)
+                    bk[(j - first) / WORD_BITS] |= Word(1) << ((j - first) % WORD_BITS);
+                continue;
+            }
+
+            for (size_t a : args_[k]) {
+                if (a == NONE)
+                    continue;
+                const Word* ba = &bits[a * w];
+                for (size_t l = 0; l < w; ++l)
+                    bk[l] |= ba[l];
+            }
+        }
+
+        std::vector<std::vector<size_t> > rows(dep_.size());
+        for (size_t i = 0; i < dep_.size(); ++i) {
+            if (dep_[i] == NONE)
+                continue;
+            const Word* bi = &bits[dep_[i] * w];
+            for (size_t l = 0; l < w; ++l) {
+                Word word = bi[l];
+                for (size_t bit = 0; word != 0; ++bit, word >>= 1) {
+                    if (word & 1)
+                        rows[i].push_back(first + l * WORD_BITS + bit);
+                }
+            }
+        }
+
+        return rows;
+    }
+
+    /**
+     * Determines the sorted list of independent variables which affect each
+     * node.
+     */
+    inline void determineVariables() {
+        if (!vars_.empty() || order_.empty())
+            return;
+
+        vars_.resize(order_.size());
+        std::vector<size_t> merged;
+
+        for (size_t k = 0; k < order_.size(); ++k) {
+            if (indep_[k] != NONE) {
+                vars_[k].push_back(indep_[k]);
+                continue;
+            }
+
+            for (size_t a : args_[k]) {
+                if (a == NONE || vars_[a].empty())
+                    continue;
+                merged.clear();
+                std::set_union(vars_[k].begin(), vars_[k].end(),
+                               vars_[a].begin(), vars_[a].end(),
+                               std::back_inserter(merged));
+                vars_[k].swap(merged);
+            }
+        }
+    }
+
+    inline SparsitySetType hessianSparsityOfEquation(size_t i) const {
+        SparsitySetType hess(n_);
+        if (dep_[i] == NONE)
+            return hess;
+
+        std::vector<bool> visited(order_.size(), false);
+        std::vector<size_t> stack(1, dep_[i]);
+        visited[dep_[i]] = true;
+
+        while (!stack.empty()) {
+            size_t k = stack.back();
+            stack.pop_back();
+
+            addHessianContribution(k, hess);
+
+            for (size_t a : args_[k]) {
+                if (a != NONE && !visited[a]) {
+                    visited[a] = true;
+                    stack.push_back(a);
+                }
+            }
+        }
+
+        return hess;
+    }
+
+    /**
+     * Adds the second order interactions introduced by an operation.
+     */
+    inline void addHessianContribution(size_t k,
+                                       SparsitySetType& hess) const {
+        const std::vector<size_t>& args = args_[k];
+        CGOpCode op = order_[k]->getOperationType();
+
+        switch (op) {
+            // linear operations
+            case CGOpCode::Inv:
+            case CGOpCode::Assign:
+            case CGOpCode::Abs:
+            case CGOpCode::Add:
+            case CGOpCode::Alias:
+            case CGOpCode::ArrayCreation:
+            case CGOpCode::SparseArrayCreation:
+            case CGOpCode::ArrayElement:
+            case CGOpCode::ComLt:
+            case CGOpCode::ComLe:
+            case CGOpCode::ComEq:
+            case CGOpCode::ComGe:
+            case CGOpCode::ComGt:
+            case CGOpCode::ComNe:
+            case CGOpCode::Pri:
+            case CGOpCode::Sign:
+            case CGOpCode::Sub:
+            case CGOpCode::UnMinus:
+                return;
+
+            case CGOpCode::Mul:
+                if (args[0] != NONE && args[1] != NONE)
+                    addInteractions(vars_[args[0]], vars_[args[1]], hess);
+                return;
+
+            case CGOpCode::Div:
+                if (args[1] != NONE) {
+                    addInteractions(vars_[args[1]], vars_[args[1]], hess);
+                    if (args[0] != NONE)
+                        addInteractions(vars_[args[0]], vars_[args[1]], hess);
+                }
+                return;
+
+            case CGOpCode::Acos:
+            case CGOpCode::Acosh:
+            case CGOpCode::Asin:
+            case CGOpCode::Asinh:
+            case CGOpCode::Atan:
+            case CGOpCode::Atanh:
+            case CGOpCode::Cosh:
+            case CGOpCode::Cos:
+            case CGOpCode::Erf:
+            case CGOpCode::Erfc:
+            case CGOpCode::Exp:
+            case CGOpCode::Expm1:
+            case CGOpCode::Log:
+            case CGOpCode::Log1p:
+            case CGOpCode::Sinh:
+            case CGOpCode::Sin:
+            case CGOpCode::Sqrt:
+            case CGOpCode::Tanh:
+            case CGOpCode::Tan:
+                if (args[0] != NONE)
+                    addInteractions(vars_[args[0]], vars_[args[0]], hess);
+                return;
+
+            default: {
+                // pow, atomic functions, ...: all arguments interact
+                std::vector<size_t> all, merged;
+                for (size_t a : args) {
+                    if (a == NONE)
+                        continue;
+                    merged.clear();
+                    std::set_union(all.begin(), all.end(),
+                                   vars_[a].begin(), vars_[a].end(),
+                                   std::back_inserter(merged));
+                    all.swap(merged);
+                }
+                addInteractions(all, all, hess);
+                return;
+            }
+        }
+    }
+
+    static inline void addInteractions(const std::vector<size_t>& vars1,
+                                       const std::vector<size_t>& vars2,
+                                       SparsitySetType& hess) {
+        for (size_t j : vars1) {
+            hess[j].insert(vars2.begin(), vars2.end());
+        }
+        if (&vars1 != &vars2) {
+            for (size_t j : vars2) {
+                hess[j].insert(vars1.begin(), vars1.end());
+            }
+        }
+    }
+
+    /**
+     * Whether or not the derivatives of an operation depend on an argument
+     */
+    static inline bool isDerivativeArgument(CGOpCode op,
+                                            size_t argument) {
+        switch (op) {
+            case CGOpCode::ComLt:
+            case CGOpCode::ComLe:
+            case CGOpCode::ComEq:
+            case CGOpCode::ComGe:
+            case CGOpCode::ComGt:
+            case CGOpCode::ComNe:
+                return argument >= 2; // only the results (not the comparison)
+            default:
+                return true;
+        }
+    }
+
+    static inline void checkSupported(CGOpCode op) {
+        switch (op) {
+            case CGOpCode::DependentMultiAssign:
+            case CGOpCode::DependentRefRhs:
+            case CGOpCode::IndexDeclaration:
+            case CGOpCode::Index:
+            case CGOpCode::IndexAssign:
+            case CGOpCode::LoopStart:
+            case CGOpCode::LoopIndexedIndep:
+            case CGOpCode::LoopIndexedDep:
+            case CGOpCode::LoopIndexedTmp:
+            case CGOpCode::LoopEnd:
+            case CGOpCode::TmpDcl:
+            case CGOpCode::Tmp:
+            case CGOpCode::IndexCondExpr:
+            case CGOpCode::StartIf:
+            case CGOpCode::ElseIf:
+            case CGOpCode::Else:
+            case CGOpCode::EndIf:
+            case CGOpCode::CondResult:
+                throw CGException("Unsupported operation in the sparsity determination from the operation graph: ", op);
+            default:
+                return;
+        }
+    }
+
+    /**
+     * Calls a function for each index in [0, count) using up to threads_
+     * threads.
+     */
+    template<class Function>
+    inline void parallelFor(size_t count,
+                            Function f) const {
+        size_t nThreads = std::min(threads_, count);
+
+        if (nThreads <= 1) {
+            for (size_t i = 0; i < count; ++i)
+                f(i);
+            return;
+        }
+
+        std::atomic<size_t> next(0);
+        auto work = [&]() {
+            for (size_t i = next++; i < count; i = next++) {
+                f(i);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(nThreads - 1);
+        for (size_t t = 0; t + 1 < nThreads; ++t) {
+            workers.emplace_back(work);
+        }
+        work();
+
+        for (auto& w : workers) {
+            w.join();
+        }
+    }
+
+};
+
+template<class Base>
+const size_t GraphSparsity<Base>::WORD_BITS;
+
+template<class Base>
+const size_t GraphSparsity<Base>::NONE;
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
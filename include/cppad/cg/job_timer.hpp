@@ -136,6 +136,18 @@ private:
      * Whether or not there are/were other jobs inside
      */
     bool _nestedJobs;
+    /**
+     * The thread which started the job
+     */
+    std::thread::id _threadId;
+    /**
+     * Peak resident memory of the process (bytes) when the job started
+     */
+    size_t _beginPeakMemory;
+    /**
+     * Named quantities associated with the job (e.g. number of operations)
+     */
+    std::map<std::string, size_t> _counters;
 public:
 
     inline Job(const JobType& type,
@@ -143,7 +155,9 @@ public:
         _type(&type),
         _name(name),
         _beginTime(std::chrono::steady_clock::now()),
-        _nestedJobs(false) {
+        _nestedJobs(false),
+        _threadId(std::this_thread::get_id()),
+        _beginPeakMemory(system::getPeakResidentMemory()) {
     }
 
     inline const JobType& getType()const {
@@ -158,6 +172,18 @@ public:
         return _beginTime;
     }
 
+    inline std::thread::id threadId() const {
+        return _threadId;
+    }
+
+    inline size_t beginPeakMemory() const {
+        return _beginPeakMemory;
+    }
+
+    inline const std::map<std::string, size_t>& counters() const {
+        return _counters;
+    }
+
     inline virtual ~Job() {
     }
 
@@ -165,7 +191,12 @@ public:
 };
 
 /**
- * A listener for job start/end events
+ * A listener for job start/end events.
+ * Events are provided with a copy of the stack of jobs of the thread which
+ * started/finished the job.
+ * Listeners are notified without holding the JobTimer lock (they may use
+ * the JobTimer), therefore events from jobs running in different threads
+ * can be delivered concurrently.
  */
 class JobListener {
 public:
@@ -175,10 +206,14 @@ public:
 
     virtual void jobEndended(const std::vector<Job>& job,
                              duration elapsed) = 0;
+
+    inline virtual ~JobListener() = default;
 };
 
 /**
- * Utility class used to print elapsed times of jobs
+ * Utility class used to print elapsed times of jobs.
+ * Jobs can be started and finished from different threads; each thread
+ * has its own stack of running jobs.
  */
 class JobTimer : public JobTypeHolder<> {
 protected:
@@ -189,9 +224,9 @@ protected:
     bool _verbose;
 private:
     /**
-     * saves the current job names
+     * saves the current jobs of each thread
      */
-    std::vector<Job> _jobs;
+    std::map<std::thread::id, std::vector<Job> > _jobs;
     /**
      *
      */
@@ -216,6 +251,11 @@ private:
      *
      */
     std::set<JobListener*> _listeners;
+    /**
+     * protects the jobs, the output and the listeners
+     * (it is not held while listeners are notified)
+     */
+    mutable std::mutex _mutex;
 public:
 
     JobTimer() :
@@ -241,41 +281,66 @@ public:
     }
 
     /**
-     * Provides the number of currently running jobs
+     * Provides the number of currently running jobs in the calling thread
      *
      * @return the number of running jobs
      */
     inline size_t getJobCount() const {
-        return _jobs.size();
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _jobs.find(std::this_thread::get_id());
+        return it != _jobs.end() ? it->second.size() : 0;
     }
 
     inline void addListener(JobListener& l) {
+        std::lock_guard<std::mutex> lock(_mutex);
         _listeners.insert(&l);
     }
 
     inline bool removeListener(JobListener& l) {
+        std::lock_guard<std::mutex> lock(_mutex);
         return _listeners.erase(&l) > 0;
     }
 
+    /**
+     * Associates a named quantity (e.g. the number of operations) to the
+     * current job of the calling thread which is provided to listeners.
+     *
+     * @param name the quantity name
+     * @param value the quantity value
+     */
+    inline void setJobCounter(const std::string& name,
+                              size_t value) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        std::vector<Job>& jobs = _jobs[std::this_thread::get_id()];
+        CPPADCG_ASSERT_UNKNOWN(!jobs.empty())
+
+        jobs.back()._counters[name] = value;
+    }
+
     inline void startingJob(const std::string& jobName,
                             const JobType& type = JobTypeHolder<>::DEFAULT,
                             const std::string& prefix = "") {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        std::vector<Job>& jobs = _jobs[std::this_thread::get_id()];
 
-        _jobs.push_back(Job(type, jobName));
+        jobs.push_back(Job(type, jobName));
 
         if (_verbose) {
             OStreamConfigRestore osr(std::cout);
 
-            Job& job = _jobs.back();
+            Job& job = jobs.back();
 
             size_t indent = 0;
-            if (_jobs.size() > 1) {
-                Job& parent = _jobs[_jobs.size() - 2]; // must be after adding job
+            if (jobs.size() > 1) {
+                Job& parent = jobs[jobs.size() - 2]; // must be after adding job
                 if (!parent._nestedJobs) {
                     parent._nestedJobs = true;
                     std::cout << "\n";
                 }
-                indent = _indent * (_jobs.size() - 1);
+                indent = _indent * (jobs.size() - 1);
             }
 
             _os.str("");
@@ -289,18 +354,29 @@ public:
             std::cout.fill(f); // restore fill character
         }
 
-        // notify listeners
-        for (JobListener* l : _listeners) {
-            l->jobStarted(_jobs);
+        if (_listeners.empty())
+            return;
+
+        // notify listeners outside the lock
+        std::vector<JobListener*> listeners(_listeners.begin(), _listeners.end());
+        std::vector<Job> jobsCopy(jobs);
+        lock.unlock();
+
+        for (JobListener* l : listeners) {
+            l->jobStarted(jobsCopy);
         }
     }
 
     inline void finishedJob() {
         using namespace std::chrono;
 
-        CPPADCG_ASSERT_UNKNOWN(_jobs.size() > 0);
+        std::unique_lock<std::mutex> lock(_mutex);
 
-        Job& job = _jobs.back();
+        auto itJobs = _jobs.find(std::this_thread::get_id());
+        CPPADCG_ASSERT_UNKNOWN(itJobs != _jobs.end() && !itJobs->second.empty())
+        std::vector<Job>& jobs = itJobs->second;
+
+        Job& job = jobs.back();
 
         std::chrono::steady_clock::duration elapsed = steady_clock::now() - job.beginTime();
 
@@ -309,8 +385,7 @@ public:
 
             if (job._nestedJobs) {
                 _os.str("");
-                if (!_jobs.empty())
-                    _os << std::string(_indent * (_jobs.size() - 1), ' ');
+                _os << std::string(_indent * (jobs.size() - 1), ' ');
                 _os << job.getType().getActionEndName() << " " << job.name() << " ...";
 
                 char f = std::cout.fill();
@@ -321,12 +396,21 @@ public:
             std::cout << " done [" << std::fixed << std::setprecision(3) << duration<float>(elapsed).count() << "]" << std::endl;
         }
 
-        // notify listeners
-        for (JobListener* l : _listeners) {
-            l->jobEndended(_jobs, elapsed);
-        }
+        std::vector<JobListener*> listeners(_listeners.begin(), _listeners.end());
+        std::vector<Job> jobsCopy;
+        if (!listeners.empty())
+            jobsCopy = jobs;
 
-        _jobs.pop_back();
+        jobs.pop_back();
+        if (jobs.empty())
+            _jobs.erase(itJobs);
+
+        lock.unlock();
+
+        // notify listeners outside the lock
+        for (JobListener* l : listeners) {
+            l->jobEndended(jobsCopy, elapsed);
+        }
     }
 
 };
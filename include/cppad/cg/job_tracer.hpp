@@ -0,0 +1,232 @@
+#ifndef CPPAD_CG_JOB_TRACER_INCLUDED
+#define CPPAD_CG_JOB_TRACER_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A completed job recorded by a JobTracer
+ */
+class JobTraceEvent {
+public:
+    /**
+     * Job name
+     */
+    std::string name;
+    /**
+     * The job type action name
+     */
+    std::string category;
+    /**
+     * Sequential index of the thread which executed the job
+     * (in order of appearance)
+     */
+    size_t thread;
+    /**
+     * Nesting level of the job in its thread
+     */
+    size_t depth;
+    /**
+     * Starting time in microseconds (relative to the tracer creation)
+     */
+    long long begin;
+    /**
+     * Duration in microseconds
+     */
+    long long duration;
+    /**
+     * Increase of the peak resident memory of the process (bytes) during
+     * the job
+     */
+    size_t peakMemoryDelta;
+    /**
+     * Named quantities associated with the job (e.g. number of operations)
+     */
+    std::map<std::string, size_t> counters;
+};
+
+/**
+ * A job listener which records all completed jobs so that they can be
+ * exported in the Chrome trace event format (chrome://tracing or
+ * https://ui.perfetto.dev).
+ *
+ * The same tracer can be registered in several JobTimers which are used
+ * by different threads.
+ */
+class JobTracer : public JobListener {
+protected:
+    /**
+     * time reference for all events
+     */
+    std::chrono::steady_clock::time_point _startTime;
+    /**
+     * completed jobs
+     */
+    std::vector<JobTraceEvent> _events;
+    /**
+     * sequential thread indexes
+     */
+    std::map<std::thread::id, size_t> _threads;
+    /**
+     * protects the events
+     */
+    mutable std::mutex _mutex;
+public:
+
+    inline JobTracer() :
+        _startTime(std::chrono::steady_clock::now()) {
+    }
+
+    inline virtual ~JobTracer() = default;
+
+    /**
+     * Provides a copy of the jobs completed so far.
+     */
+    inline std::vector<JobTraceEvent> getEvents() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _events;
+    }
+
+    /**
+     * Discards all recorded jobs.
+     */
+    inline void clear() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _events.clear();
+    }
+
+    inline void jobStarted(const std::vector<Job>& job) override {
+        // nothing to do: jobs are only recorded once they are completed
+    }
+
+    inline void jobEndended(const std::vector<Job>& job,
+                            duration elapsed) override {
+        using namespace std::chrono;
+
+        CPPADCG_ASSERT_UNKNOWN(!job.empty())
+        const Job& j = job.back();
+
+        size_t peakMemory = system::getPeakResidentMemory();
+
+        JobTraceEvent e;
+        e.name = j.name();
+        e.category = j.getType().getActionName();
+        e.depth = job.size() - 1;
+        e.begin = duration_cast<microseconds>(j.beginTime() - _startTime).count();
+        e.duration = duration_cast<microseconds>(elapsed).count();
+        e.peakMemoryDelta = peakMemory > j.beginPeakMemory() ? peakMemory - j.beginPeakMemory() : 0;
+        e.counters = j.counters();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _threads.find(j.threadId());
+        if (it == _threads.end()) {
+            it = _threads.emplace(j.threadId(), _threads.size()).first;
+        }
+        e.thread = it->second;
+
+        _events.push_back(std::move(e));
+    }
+
+    /**
+     * Writes all completed jobs in the Chrome trace event format (JSON).
+     *
+     * @param out the output stream
+     */
+    inline void writeChromeTrace(std::ostream& out) const {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        out << "{\"traceEvents\":[";
+        for (size_t i = 0; i < _events.size(); ++i) {
+            const JobTraceEvent& e = _events[i];
+            if (i > 0) out << ",";
+            out << "\n{\"name\":";
+            printJsonString(out, e.name);
+            out << ",\"cat\":";
+            printJsonString(out, e.category);
+            out << ",\"ph\":\"X\""
+                    ",\"ts\":" << e.begin <<
+                    ",\"dur\":" << e.duration <<
+                    ",\"pid\":1"
+                    ",\"tid\":" << e.thread <<
+                    ",\"args\":{\"depth\":" << e.depth <<
+                    ",\"peak_rss_delta\":" << e.peakMemoryDelta;
+            for (const auto& c : e.counters) {
+                out << ",";
+                printJsonString(out, c.first);
+                out << ":" << c.second;
+            }
+            out << "}}";
+        }
+        out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+
+    /**
+     * Saves all completed jobs to a file in the Chrome trace event
+     * format (JSON).
+     *
+     * @param file the file path
+     * @throws CGException if the file cannot be created
+     */
+    inline void saveChromeTrace(const std::string& file) const {
+        std::ofstream out(file.c_str());
+        if (!out.is_open()) {
+            throw CGException("Failed to create trace file '", file, "'");
+        }
+        writeChromeTrace(out);
+        if (out.fail()) {
+            throw CGException("Failed to write trace file '", file, "'");
+        }
+    }
+
+protected:
+
+    static inline void printJsonString(std::ostream& out,
+                                       const std::string& str) {
+        OStreamConfigRestore osr(out);
+
+        out << '"';
+        for (char c : str) {
+            switch (c) {
+                case '"':
+                    out << "\\\"";
+                    break;
+                case '\\':
+                    out << "\\\\";
+                    break;
+                case '\n':
+                    out << "\\n";
+                    break;
+                case '\t':
+                    out << "\\t";
+                    break;
+                default:
+                    if ((unsigned char) c < 0x20) {
+                        out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c);
+                    } else {
+                        out << c;
+                    }
+            }
+        }
+        out << '"';
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
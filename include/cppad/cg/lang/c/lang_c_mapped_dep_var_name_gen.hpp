@@ -0,0 +1,70 @@
+#ifndef CPPAD_CG_LANG_C_MAPPED_DEP_VAR_NAME_GEN_INCLUDED
+#define CPPAD_CG_LANG_C_MAPPED_DEP_VAR_NAME_GEN_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Creates variables names for the source code where the dependent
+ * variables are a subset of the elements of the output array.
+ * This allows the generation of functions which only assign some of the
+ * (non-consecutive) elements of the output array.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class LangCMappedDepVarNameGenerator : public LangCDefaultVariableNameGenerator<Base> {
+protected:
+    // the position in the output array of each dependent variable
+    std::vector<size_t> _depPositions;
+public:
+
+    /**
+     * @param depPositions the position in the output array of each
+     *                     dependent variable
+     * @param depName array name of the dependent variables
+     * @param indepName array name of the independent variables
+     * @param tmpName array name of the temporary variables
+     * @param tmpArrayName array name of the temporary array variables
+     */
+    inline explicit LangCMappedDepVarNameGenerator(std::vector<size_t> depPositions,
+                                                   std::string depName = "y",
+                                                   std::string indepName = "x",
+                                                   std::string tmpName = "v",
+                                                   std::string tmpArrayName = "array") :
+        LangCDefaultVariableNameGenerator<Base>(std::move(depName), std::move(indepName),
+                                                std::move(tmpName), std::move(tmpArrayName)),
+        _depPositions(std::move(depPositions)) {
+    }
+
+    inline virtual ~LangCMappedDepVarNameGenerator() = default;
+
+    inline const std::vector<size_t>& getDependentPositions() const {
+        return _depPositions;
+    }
+
+    inline std::string generateDependent(size_t index) override {
+        CPPADCG_ASSERT_KNOWN(index < _depPositions.size(), "Invalid dependent variable index")
+
+        return LangCDefaultVariableNameGenerator<Base>::generateDependent(_depPositions[index]);
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef CPPAD_CG_LANG_C_MASKED_GROUP_VAR_NAME_GEN_INCLUDED
+#define CPPAD_CG_LANG_C_MASKED_GROUP_VAR_NAME_GEN_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Creates variables names for the source code of a group of operations
+ * which exchanges intermediate values with other groups through an
+ * additional array.
+ * The first dependent variables are saved in the output array (at the
+ * provided positions) and the remaining ones in the shared array.
+ * The first independent variables are the model independent variables
+ * and the remaining ones are read from the shared array.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class LangCMaskedGroupVarNameGenerator : public LangCMappedDepVarNameGenerator<Base> {
+protected:
+    // the number of model independent variables
+    const size_t _n;
+    // the position in the shared array of each additional dependent variable
+    std::vector<size_t> _sharedOutPositions;
+    // the position in the shared array of each additional independent variable
+    std::vector<size_t> _sharedInPositions;
+    // array name of the shared values which are computed
+    const std::string _sharedOutName;
+    // array name of the shared values which are used
+    const std::string _sharedInName;
+public:
+
+    /**
+     * @param depPositions the position in the output array of the first
+     *                     dependent variables
+     * @param sharedOutPositions the position in the shared array of the
+     *                           remaining dependent variables
+     * @param n the number of model independent variables
+     * @param sharedInPositions the position in the shared array of the
+     *                          independent variables after the first n
+     * @param depName array name of the dependent variables
+     * @param sharedOutName array name of the shared values which are computed
+     * @param sharedInName array name of the shared values which are used
+     */
+    inline LangCMaskedGroupVarNameGenerator(std::vector<size_t> depPositions,
+                                            std::vector<size_t> sharedOutPositions,
+                                            size_t n,
+                                            std::vector<size_t> sharedInPositions,
+                                            std::string depName = "y",
+                                            std::string sharedOutName = "so",
+                                            std::string sharedInName = "si") :
+        LangCMappedDepVarNameGenerator<Base>(std::move(depPositions), std::move(depName)),
+        _n(n),
+        _sharedOutPositions(std::move(sharedOutPositions)),
+        _sharedInPositions(std::move(sharedInPositions)),
+        _sharedOutName(std::move(sharedOutName)),
+        _sharedInName(std::move(sharedInName)) {
+        this->_independent.push_back(FuncArgument(_sharedInName));
+        this->_dependent.push_back(FuncArgument(_sharedOutName));
+    }
+
+    inline virtual ~LangCMaskedGroupVarNameGenerator() = default;
+
+    inline std::string generateDependent(size_t index) override {
+        const size_t nDep = this->_depPositions.size();
+        if (index < nDep)
+            return LangCMappedDepVarNameGenerator<Base>::generateDependent(index);
+
+        CPPADCG_ASSERT_KNOWN(index - nDep < _sharedOutPositions.size(), "Invalid dependent variable index")
+
+        this->_ss.clear();
+        this->_ss.str("");
+        this->_ss << _sharedOutName << "[" << _sharedOutPositions[index - nDep] << "]";
+        return this->_ss.str();
+    }
+
+    inline std::string generateIndependent(const OperationNode<Base>& independent,
+                                           size_t id) override {
+        if (id <= _n)
+            return LangCMappedDepVarNameGenerator<Base>::generateIndependent(independent, id);
+
+        this->_ss.clear();
+        this->_ss.str("");
+        this->_ss << _sharedInName << "[" << getIndependentArrayIndex(independent, id) << "]";
+        return this->_ss.str();
+    }
+
+    const std::string& getIndependentArrayName(const OperationNode<Base>& indep,
+                                               size_t id) override {
+        if (id <= _n)
+            return this->_indepName;
+        return _sharedInName;
+    }
+
+    size_t getIndependentArrayIndex(const OperationNode<Base>& indep,
+                                    size_t id) override {
+        if (id <= _n)
+            return id - 1;
+
+        CPPADCG_ASSERT_KNOWN(id - _n - 1 < _sharedInPositions.size(), "Invalid independent variable index")
+        return _sharedInPositions[id - _n - 1];
+    }
+
+    bool isConsecutiveInIndepArray(const OperationNode<Base>& indepFirst,
+                                   size_t idFirst,
+                                   const OperationNode<Base>& indepSecond,
+                                   size_t idSecond) override {
+        if ((idFirst <= _n) != (idSecond <= _n))
+            return false;
+
+        return getIndependentArrayIndex(indepFirst, idFirst) + 1 == getIndependentArrayIndex(indepSecond, idSecond);
+    }
+
+    bool isInSameIndependentArray(const OperationNode<Base>& indep1,
+                                  size_t id1,
+                                  const OperationNode<Base>& indep2,
+                                  size_t id2) override {
+        return (id1 <= _n) == (id2 <= _n);
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
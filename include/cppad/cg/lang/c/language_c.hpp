@@ -38,6 +38,7 @@ public:
 public:
     static const std::string U_INDEX_TYPE;
     static const std::string ATOMICFUN_STRUCT_DEFINITION;
+    static const std::string PROFILE_STRUCT_DEFINITION;
 protected:
     static const std::string _C_COMP_OP_LT;
     static const std::string _C_COMP_OP_LE;
@@ -110,6 +111,12 @@ protected:
     std::vector<const LoopStartOperationNode<Base>*> _currentLoops;
     // the maximum precision used to print values
     size_t _parameterPrecision;
+    // whether or not to add call counters and timers to the generated functions
+    bool _profiling;
+    // whether or not to generate loops which can be more easily vectorized by the compiler
+    bool _loopVectorization;
+    // loops without dependencies between iterations (and the scalar temporary variables declared in their body)
+    std::map<const LoopStartOperationNode<Base>*, std::vector<std::string> > _vectorizableLoops;
 private:
     std::vector<std::string> funcArgDcl_;
     std::vector<std::string> localFuncArgDcl_;
@@ -142,7 +149,9 @@ public:
         _maxAssignmentsPerFunction(0),
         _maxOperationsPerAssignment((std::numeric_limits<size_t>::max)()),
         _sources(nullptr),
-        _parameterPrecision(std::numeric_limits<Base>::digits10) {
+        _parameterPrecision(std::numeric_limits<Base>::digits10),
+        _profiling(false),
+        _loopVectorization(false) {
     }
 
     inline virtual ~LanguageC() = default;
@@ -205,6 +214,10 @@ public:
         _functionName = functionName;
     }
 
+    virtual const std::string& getGenerateFunction() const {
+        return _functionName;
+    }
+
     virtual void setFunctionIndexArgument(const Node& funcArgIndex) {
         _funcArgIndexes.resize(1);
         _funcArgIndexes[0] = &funcArgIndex;
@@ -255,6 +268,54 @@ public:
         _sources = sources;
     }
 
+    /**
+     * Whether or not the generated functions count the number of calls and
+     * the time spent in them.
+     *
+     * @return true if profiling code is added to the generated functions
+     */
+    inline bool isProfiling() const {
+        return _profiling;
+    }
+
+    /**
+     * Defines whether or not the generated functions count the number of
+     * calls and the time spent in them.
+     * The counters are registered in a library-global table (see
+     * ModelLibraryCSourceGen) the first time each function is called.
+     *
+     * @param profiling true to add profiling code to the generated functions
+     */
+    inline void setProfiling(bool profiling) {
+        _profiling = profiling;
+    }
+
+    /**
+     * Whether or not loops without dependencies between iterations are
+     * generated so that they can be vectorized by the compiler.
+     *
+     * @return true if vectorization friendly loops are generated
+     */
+    inline bool isLoopVectorization() const {
+        return _loopVectorization;
+    }
+
+    /**
+     * Defines whether or not loops without dependencies between iterations
+     * should be generated so that they can be vectorized by the compiler.
+     * Temporary variables which are only used inside such loops are
+     * declared as scalars in the loop body (instead of using the temporary
+     * array), the loops are annotated with compiler specific directives
+     * stating that there are no dependencies between iterations, and the
+     * input and output arrays are declared with the restrict qualifier.
+     * The input and output arrays must therefore not overlap.
+     *
+     * @param vectorize true to generate vectorization friendly loops
+     */
+    inline void setLoopVectorization(bool vectorize) {
+        _loopVectorization = vectorize;
+    }
+
     /**
      * The maximum number of operations per variable assignment.
      *
@@ -421,7 +482,7 @@ public:
 
         _ss << _spaces << "//dependent variables\n";
         for (size_t i = 0; i < depArg.size(); i++) {
-            _ss << _spaces << argumentDeclaration(depArg[i]) << " = " << _outArgName << "[" << i << "];\n";
+            _ss << _spaces << ioArgumentDeclaration(depArg[i]) << " = " << _outArgName << "[" << i << "];\n";
         }
 
         std::string code = _ss.str();
@@ -436,7 +497,7 @@ public:
 
         _ss << _spaces << "//independent variables\n";
         for (size_t i = 0; i < indArg.size(); i++) {
-            _ss << _spaces << "const " << argumentDeclaration(indArg[i]) << " = " << _inArgName << "[" << i << "];\n";
+            _ss << _spaces << "const " << ioArgumentDeclaration(indArg[i]) << " = " << _inArgName << "[" << i << "];\n";
         }
 
         std::string code = _ss.str();
@@ -676,6 +737,7 @@ protected:
         localFuncArgs_ = "";
         auxArrayName_ = "";
         _currentLoops.clear();
+        _vectorizableLoops.clear();
         _atomicFuncArrays.clear();
         _streamStack.clear();
         _dependentIDs.clear();
@@ -805,6 +867,10 @@ protected:
                 }
             }
 
+            if (_loopVectorization) {
+                findVectorizableLoops(variableOrder);
+            }
+
             /**
              * Source code generation magic!
              */
@@ -865,6 +931,9 @@ protected:
                                  "The temporary variables must be saved in an array in order to generate multiple functions")
 
             _code << ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+            if (_profiling) {
+                _code << PROFILE_STRUCT_DEFINITION << "\n\n";
+            }
             // forward declarations
             std::string localFuncArgDcl2 = implode(localFuncArgDcl_, ", ");
             for (auto & localFuncName : localFuncNames) {
@@ -873,6 +942,7 @@ protected:
             _code << "\n";
             printFunctionDeclaration(_code, "void", _functionName, funcArgDcl_);
             _code  << " {\n";
+            printProfileStart(_code, _functionName);
             _nameGen->customFunctionVariableDeclarations(_code);
             _code << generateIndependentVariableDeclaration() << "\n";
             _code << generateDependentVariableDeclaration() << "\n";
@@ -930,8 +1000,12 @@ protected:
                 _ss << "#include <math.h>\n"
                         "#include <stdio.h>\n\n"
                     << ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+                if (_profiling) {
+                    _ss << PROFILE_STRUCT_DEFINITION << "\n\n";
+                }
                 printFunctionDeclaration(_ss, "void", _functionName, funcArgDcl_);
                 _ss << " {\n";
+                printProfileStart(_ss, _functionName);
                 _nameGen->customFunctionVariableDeclarations(_ss);
                 _ss << generateIndependentVariableDeclaration() << "\n";
                 _ss << generateDependentVariableDeclaration() << "\n";
@@ -941,6 +1015,7 @@ protected:
                 _nameGen->prepareCustomFunctionVariables(_ss);
                 _ss << _code.str();
                 _nameGen->finalizeCustomFunctionVariables(_ss);
+                printProfileEnd(_ss);
                 _ss << "}\n\n";
 
                 out << _ss.str();
@@ -950,6 +1025,7 @@ protected:
                 }
             } else {
                 _nameGen->finalizeCustomFunctionVariables(_code);
+                printProfileEnd(_code);
                 _code << "}\n\n";
 
                 (*_sources)[_functionName + ".c"] = _code.str();
@@ -1045,6 +1121,42 @@ protected:
         return dcl + " " + funcArg.name;
     }
 
+    /**
+     * Declaration of an independent or dependent variable argument which
+     * uses the restrict qualifier for arrays when there are vectorizable
+     * loops.
+     */
+    inline std::string ioArgumentDeclaration(const FuncArgument& funcArg) const {
+        if (funcArg.array && !_vectorizableLoops.empty()) {
+            return _baseTypeName + "* __restrict " + funcArg.name;
+        }
+        return argumentDeclaration(funcArg);
+    }
+
+    /**
+     * Declares the call counter of a generated function and starts its
+     * timer (must be the first statement in the function body).
+     */
+    inline void printProfileStart(std::ostream& out,
+                                  const std::string& funcName) {
+        if (!_profiling)
+            return;
+
+        out << _spaces << "static CppADCGProfile cppadcg_profile = {\"" << funcName << "\", 0, 0, 0, 0};\n"
+            << _spaces << "unsigned long long cppadcg_profile_t0 = cppadcg_profile_begin(&cppadcg_profile);\n";
+    }
+
+    /**
+     * Stops the timer of a generated function (must be the last statement
+     * in the function body).
+     */
+    inline void printProfileEnd(std::ostream& out) {
+        if (!_profiling)
+            return;
+
+        out << _spaces << "cppadcg_profile_end(&cppadcg_profile, cppadcg_profile_t0);\n";
+    }
+
     virtual void saveLocalFunction(std::vector<std::string>& localFuncNames,
                                    bool zeroDependentArray) {
         _ss << _functionName << "__" << (localFuncNames.size() + 1);
@@ -1054,8 +1166,12 @@ protected:
         _ss << "#include <math.h>\n"
                 "#include <stdio.h>\n\n"
                 << ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+        if (_profiling) {
+            _ss << PROFILE_STRUCT_DEFINITION << "\n\n";
+        }
         printFunctionDeclaration(_ss, "void", funcName, localFuncArgDcl_);
         _ss << " {\n";
+        printProfileStart(_ss, funcName);
         _nameGen->customFunctionVariableDeclarations(_ss);
         _ss << generateIndependentVariableDeclaration() << "\n";
         _ss << generateDependentVariableDeclaration() << "\n";
@@ -1079,6 +1195,7 @@ protected:
         _nameGen->prepareCustomFunctionVariables(_ss);
         _ss << _code.str();
         _nameGen->finalizeCustomFunctionVariables(_ss);
+        printProfileEnd(_ss);
         _ss << "}\n\n";
 
         (*_sources)[funcName + ".c"] = _ss.str();
@@ -1917,11 +2034,25 @@ protected:
             iterationCount = oss.str();
         }
 
+        auto itVec = _vectorizableLoops.find(&lnode);
+        if (itVec != _vectorizableLoops.end()) {
+            // there are no dependencies between iterations
+            _streamStack << "#if defined(__clang__)\n"
+                            "#pragma clang loop vectorize(assume_safety)\n"
+                            "#elif defined(__GNUC__)\n"
+                            "#pragma GCC ivdep\n"
+                            "#endif\n";
+        }
+
         _streamStack << _spaces << "for("
                      << jj << " = 0; "
                      << jj << " < " << iterationCount << "; "
                      << jj << "++) {\n";
         _indentation += _spaces;
+
+        if (itVec != _vectorizableLoops.end() && !itVec->second.empty()) {
+            _streamStack << _indentation << _baseTypeName << " " << implode(itVec->second, ", ") << ";\n";
+        }
     }
 
     virtual void pushLoopEnd(Node& node) {
@@ -1938,6 +2069,21 @@ protected:
     virtual size_t printLoopIndexDeps(const std::vector<Node*>& variableOrder,
                                       size_t pos);
 
+    /**
+     * Determines which loops do not have dependencies between iterations
+     * and can be vectorized by the compiler. Temporary variables which are
+     * only used inside those loops are renamed so that they become scalars
+     * declared in the loop body.
+     *
+     * @param variableOrder the operations in the order they are evaluated
+     */
+    virtual void findVectorizableLoops(const std::vector<Node*>& variableOrder);
+
+    /**
+     * Whether or not an operation inside a loop prevents its vectorization.
+     */
+    virtual bool isVectorizableLoopOperation(const Node& node) const;
+
     virtual size_t printLoopIndexedDepsUsingLoop(const std::vector<Node*>& variableOrder,
                                                  size_t starti);
 
@@ -2103,6 +2249,7 @@ protected:
                 // order to avoid integer overflows
                 output << '.';
             }
+            output << getParameterSuffix();
         }
     }
 
@@ -2138,6 +2285,16 @@ protected:
         return format;
     }
 
+    /**
+     * Provides the suffix appended to floating point literals so that
+     * parameters have the same type as Base (e.g. "f" for float) and
+     * no promotions to double occur in the generated code.
+     */
+    inline const std::string& getParameterSuffix() {
+        static const std::string suffix; // empty string
+        return suffix;
+    }
+
     static bool isFunction(enum CGOpCode op) {
         return isUnaryFunction(op) || op == CGOpCode::Pow;
     }
@@ -2257,6 +2414,19 @@ const std::string LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION = // NOLINT(cert-
 "                   const Array py[]);\n"
 "};";
 
+template<class Base>
+const std::string LanguageC<Base>::PROFILE_STRUCT_DEFINITION = // NOLINT(cert-err58-cpp)
+"typedef struct CppADCGProfile {\n"
+"    const char* name;\n"
+"    unsigned long long calls;\n"
+"    unsigned long long nanoseconds;\n"
+"    struct CppADCGProfile* next;\n"
+"    int registered;\n"
+"} CppADCGProfile;\n"
+"\n"
+"unsigned long long cppadcg_profile_begin(CppADCGProfile* p);\n"
+"void cppadcg_profile_end(CppADCGProfile* p, unsigned long long t0);";
+
 } // END cg namespace
 } // END CppAD namespace
 
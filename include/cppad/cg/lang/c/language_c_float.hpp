@@ -101,6 +101,12 @@ inline const std::string& LanguageC<float>::tanFuncName() {
     return name;
 }
 
+template<>
+inline const std::string& LanguageC<float>::powFuncName() {
+    static const std::string name("powf"); // C99
+    return name;
+}
+
 #if CPPAD_USE_CPLUSPLUS_2011
 template<>
 inline const std::string& LanguageC<float>::erfFuncName() {
@@ -108,6 +114,12 @@ inline const std::string& LanguageC<float>::erfFuncName() {
     return name;
 }
 
+template<>
+inline const std::string& LanguageC<float>::erfcFuncName() {
+    static const std::string name("erfcf"); // C99
+    return name;
+}
+
 template<>
 inline const std::string& LanguageC<float>::asinhFuncName() {
     static const std::string name("asinhf"); // C99
@@ -146,6 +158,12 @@ inline const std::string& LanguageC<float>::getPrintfBaseFormat() {
     return format;
 }
 
+template<>
+inline const std::string& LanguageC<float>::getParameterSuffix() {
+    static const std::string suffix("f");
+    return suffix;
+}
+
 } // END cg namespace
 } // END CppAD namespace
 
@@ -172,6 +172,184 @@ inline size_t LanguageC<Base>::printLoopIndexedDepsUsingLoop(const std::vector<O
     return i - 1;
 }
 
+template<class Base>
+void LanguageC<Base>::findVectorizableLoops(const std::vector<OperationNode<Base>*>& variableOrder) {
+    const size_t npos = (std::numeric_limits<size_t>::max)();
+
+    struct LoopInfo {
+        LoopStartOperationNode<Base>* loop;
+        bool vectorizable;
+    };
+
+    /**
+     * determine the innermost loop of each operation and check the
+     * operations in the loop body
+     */
+    std::vector<LoopInfo> loops;
+    std::vector<size_t> loopOf(variableOrder.size(), npos);
+    std::vector<size_t> openLoops;
+
+    for (size_t p = 0; p < variableOrder.size(); ++p) {
+        const OperationNode<Base>& node = *variableOrder[p];
+        CGOpCode op = node.getOperationType();
+
+        if (!openLoops.empty()) {
+            loopOf[p] = openLoops.back();
+        }
+
+        if (op == CGOpCode::LoopStart) {
+            if (!openLoops.empty())
+                loops[openLoops.back()].vectorizable = false; // nested loop
+            loops.push_back(LoopInfo{static_cast<LoopStartOperationNode<Base>*>(variableOrder[p]), true});
+            openLoops.push_back(loops.size() - 1);
+        } else if (op == CGOpCode::LoopEnd) {
+            CPPADCG_ASSERT_UNKNOWN(!openLoops.empty())
+            openLoops.pop_back();
+        } else if (loopOf[p] != npos && !isVectorizableLoopOperation(node)) {
+            loops[loopOf[p]].vectorizable = false;
+        }
+    }
+
+    if (loops.empty())
+        return;
+
+    /**
+     * temporary variables created inside loops
+     */
+    std::map<const OperationNode<Base>*, size_t> tmpLoop;
+    for (size_t p = 0; p < variableOrder.size(); ++p) {
+        const OperationNode<Base>& node = *variableOrder[p];
+        CGOpCode op = node.getOperationType();
+        if (loopOf[p] != npos && op != CGOpCode::LoopEnd &&
+            !isDependent(node) && op != CGOpCode::IndexDeclaration &&
+            requiresVariableName(node) && op != CGOpCode::ArrayCreation && op != CGOpCode::SparseArrayCreation) {
+            tmpLoop[&node] = loopOf[p];
+        }
+    }
+
+    /**
+     * the values of temporary variables are lost after each iteration:
+     * they cannot be used outside their loop
+     */
+    std::set<const OperationNode<Base>*> variables(variableOrder.begin(), variableOrder.end());
+    std::set<const OperationNode<Base>*> visited;
+    std::vector<const OperationNode<Base>*> stack;
+
+    for (size_t p = 0; p < variableOrder.size(); ++p) {
+        // the loop start is evaluated outside its own loop
+        size_t l = loopOf[p];
+
+        visited.clear();
+        for (const Argument<Base>& a : variableOrder[p]->getArguments()) {
+            if (a.getOperation() != nullptr)
+                stack.push_back(a.getOperation());
+        }
+
+        while (!stack.empty()) {
+            const OperationNode<Base>* arg = stack.back();
+            stack.pop_back();
+
+            auto it = tmpLoop.find(arg);
+            if (it != tmpLoop.end()) {
+                if (it->second != l)
+                    loops[it->second].vectorizable = false;
+                continue;
+            } else if (variables.find(arg) != variables.end() || !visited.insert(arg).second) {
+                continue;
+            }
+
+            // operation printed inside the expression of another operation
+            if (l != npos && !isVectorizableLoopOperation(*arg)) {
+                loops[l].vectorizable = false;
+            }
+            for (const Argument<Base>& a : arg->getArguments()) {
+                if (a.getOperation() != nullptr)
+                    stack.push_back(a.getOperation());
+            }
+        }
+    }
+
+    for (size_t i = 0; i < _dependent->size(); i++) {
+        auto it = tmpLoop.find((*_dependent)[i].getOperationNode());
+        if (it != tmpLoop.end()) {
+            loops[it->second].vectorizable = false;
+        }
+    }
+
+    /**
+     * temporary variables of vectorizable loops become scalars
+     */
+    for (const LoopInfo& info : loops) {
+        if (info.vectorizable)
+            _vectorizableLoops[info.loop];
+    }
+
+    const std::vector<FuncArgument>& tmpArg = _nameGen->getTemporary();
+    if (!tmpArg[0].array)
+        return; // already scalars
+
+    std::vector<std::set<std::string> > declared(loops.size());
+    for (size_t p = 0; p < variableOrder.size(); ++p) {
+        OperationNode<Base>& node = *variableOrder[p];
+        auto it = tmpLoop.find(&node);
+        if (it == tmpLoop.end() || !loops[it->second].vectorizable)
+            continue;
+
+        std::string name = tmpArg[0].name + "_" + std::to_string(getVariableID(node) - _minTemporaryVarID);
+        if (declared[it->second].insert(name).second) {
+            _vectorizableLoops[loops[it->second].loop].push_back(name);
+        }
+        node.setName(name);
+    }
+}
+
+template<class Base>
+bool LanguageC<Base>::isVectorizableLoopOperation(const OperationNode<Base>& node) const {
+    switch (node.getOperationType()) {
+        case CGOpCode::LoopIndexedDep: {
+            if (node.getInfo()[1] == 0)
+                return true; // each dependent is only assigned once
+
+            // the same element cannot be updated by different iterations
+            const IndexPattern* ip = _info->loopDependentIndexPatterns[node.getInfo()[0]];
+            if (ip->getType() == IndexPatternType::Linear) {
+                const auto* lip = static_cast<const LinearIndexPattern*> (ip);
+                return lip->getLinearSlopeDx() == 1 && lip->getLinearSlopeDy() != 0;
+            } else if (ip->getType() == IndexPatternType::Random1D) {
+                const auto& values = static_cast<const Random1DIndexPattern*> (ip)->getValues();
+                std::set<size_t> y;
+                for (const auto& v : values) {
+                    if (!y.insert(v.second).second)
+                        return false;
+                }
+                return true;
+            }
+            return false;
+        }
+        case CGOpCode::ArrayCreation:
+        case CGOpCode::SparseArrayCreation:
+        case CGOpCode::ArrayElement:
+        case CGOpCode::AtomicForward:
+        case CGOpCode::AtomicReverse:
+        case CGOpCode::DependentMultiAssign:
+        case CGOpCode::Pri:
+        case CGOpCode::LoopStart:
+        case CGOpCode::LoopEnd:
+        case CGOpCode::TmpDcl:
+        case CGOpCode::Tmp:
+        case CGOpCode::LoopIndexedTmp:
+        case CGOpCode::IndexCondExpr:
+        case CGOpCode::StartIf:
+        case CGOpCode::ElseIf:
+        case CGOpCode::Else:
+        case CGOpCode::EndIf:
+        case CGOpCode::CondResult:
+        case CGOpCode::UserCustom:
+            return false;
+        default:
+            return true;
+    }
+}
 
 } // END cg namespace
 } // END CppAD namespace
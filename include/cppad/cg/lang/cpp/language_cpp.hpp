@@ -0,0 +1,256 @@
+#ifndef CPPAD_CG_LANGUAGE_CPP_INCLUDED
+#define CPPAD_CG_LANGUAGE_CPP_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Generates C++ function templates where the scalar type is a template
+ * parameter.
+ * The arguments are fixed size std::array objects and, therefore, the
+ * generated code can be included directly in other C++ sources and
+ * instantiated for any type with the required arithmetic operations
+ * (e.g. double, float or SIMD types).
+ * The math functions are called without namespace qualification so that
+ * they can be found through argument dependent lookup or by using-declarations
+ * (e.g. using std::sin).
+ *
+ * Atomic functions are not supported.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class LanguageCpp : public LanguageC<Base> {
+public:
+    using Node = OperationNode<Base>;
+    using Arg = Argument<Base>;
+protected:
+    // the name of the template parameter with the scalar type
+    const std::string _templateTypeName;
+    // the name of the function template (if the string is empty no function is created)
+    std::string _cppFunctionName;
+    // the size of each independent variable array
+    std::vector<size_t> _independentSizes;
+public:
+
+    /**
+     * Creates a C++ language source code generator
+     *
+     * @param templateTypeName the name of the template parameter with the
+     *                         scalar type
+     * @param spaces number of spaces for indentations
+     */
+    explicit LanguageCpp(const std::string& templateTypeName = "T",
+                         size_t spaces = 3) :
+        LanguageC<Base>(templateTypeName, spaces),
+        _templateTypeName(templateTypeName) {
+    }
+
+    inline virtual ~LanguageCpp() = default;
+
+    inline const std::string& getTemplateTypeName() const {
+        return _templateTypeName;
+    }
+
+    /**
+     * Defines the name of the generated function template.
+     * An empty name means that only the function body is generated.
+     *
+     * @param functionName the function name
+     */
+    void setGenerateFunction(const std::string& functionName) override {
+        _cppFunctionName = functionName;
+    }
+
+    /**
+     * Defines the size of each independent variable array argument.
+     * By default all independent variables are placed in a single array.
+     *
+     * @param sizes the number of elements of each independent array
+     */
+    inline void setIndependentSizes(const std::vector<size_t>& sizes) {
+        _independentSizes = sizes;
+    }
+
+    inline const std::vector<size_t>& getIndependentSizes() const {
+        return _independentSizes;
+    }
+
+    /**
+     * Splitting the generated code into several functions is not supported
+     * by this language since all the code is placed in a single (inline)
+     * function template.
+     *
+     * @param maxAssignmentsPerFunction must be zero (no limit)
+     * @param sources not used
+     * @throws CGException if a limit is requested
+     */
+    void setMaxAssignmentsPerFunction(size_t maxAssignmentsPerFunction,
+                                      std::map<std::string, std::string>* sources) override {
+        if (maxAssignmentsPerFunction > 0) {
+            throw CGException("LanguageCpp does not support a maximum number of assignments per function");
+        }
+    }
+
+    /**
+     * Prints the declaration of a function template.
+     *
+     * @param out the stream where the declaration is printed
+     * @param templateTypeName the name of the template parameter
+     * @param functionName the function name
+     * @param arguments function arguments
+     */
+    static inline void printTemplateFunctionDeclaration(std::ostringstream& out,
+                                                        const std::string& templateTypeName,
+                                                        const std::string& functionName,
+                                                        const std::vector<std::string>& arguments) {
+        out << "template<class " << templateTypeName << ">\n";
+        LanguageC<Base>::printFunctionDeclaration(out, "inline void", functionName, arguments);
+    }
+
+    /**
+     * overloaded C++ math functions (instead of the C functions for each type)
+     */
+    CPPAD_CG_C_LANG_FUNCNAME(abs)
+    CPPAD_CG_C_LANG_FUNCNAME(acos)
+    CPPAD_CG_C_LANG_FUNCNAME(asin)
+    CPPAD_CG_C_LANG_FUNCNAME(atan)
+    CPPAD_CG_C_LANG_FUNCNAME(cosh)
+    CPPAD_CG_C_LANG_FUNCNAME(cos)
+    CPPAD_CG_C_LANG_FUNCNAME(exp)
+    CPPAD_CG_C_LANG_FUNCNAME(log)
+    CPPAD_CG_C_LANG_FUNCNAME(sinh)
+    CPPAD_CG_C_LANG_FUNCNAME(sin)
+    CPPAD_CG_C_LANG_FUNCNAME(sqrt)
+    CPPAD_CG_C_LANG_FUNCNAME(tanh)
+    CPPAD_CG_C_LANG_FUNCNAME(tan)
+    CPPAD_CG_C_LANG_FUNCNAME(pow)
+#if CPPAD_USE_CPLUSPLUS_2011
+    CPPAD_CG_C_LANG_FUNCNAME(erf)
+    CPPAD_CG_C_LANG_FUNCNAME(erfc)
+    CPPAD_CG_C_LANG_FUNCNAME(asinh)
+    CPPAD_CG_C_LANG_FUNCNAME(acosh)
+    CPPAD_CG_C_LANG_FUNCNAME(atanh)
+    CPPAD_CG_C_LANG_FUNCNAME(expm1)
+    CPPAD_CG_C_LANG_FUNCNAME(log1p)
+#endif
+
+protected:
+
+    void generateSourceCode(std::ostream& out,
+                            std::unique_ptr<LanguageGenerationData<Base> > info) override {
+        // the base class only generates the function body
+        std::ostringstream body;
+        LanguageC<Base>::generateSourceCode(body, std::move(info));
+
+        if (_cppFunctionName.empty()) {
+            out << body.str();
+            return;
+        }
+
+        const std::vector<FuncArgument>& indArg = this->_nameGen->getIndependent();
+        const std::vector<FuncArgument>& depArg = this->_nameGen->getDependent();
+
+        CPPADCG_ASSERT_KNOWN(depArg.size() == 1 && depArg[0].array,
+                             "The dependent variables must be saved in a single array")
+
+        std::vector<size_t> indSizes = _independentSizes;
+        if (indSizes.empty())
+            indSizes.push_back(this->_independentSize);
+
+        CPPADCG_ASSERT_KNOWN(indSizes.size() == indArg.size(),
+                             "The number of independent array sizes does not match the number of independent arguments")
+
+        std::vector<std::string> args;
+        args.reserve(indArg.size() + 1);
+        for (size_t k = 0; k < indArg.size(); k++) {
+            CPPADCG_ASSERT_KNOWN(indArg[k].array, "The independent variables must be saved in arrays")
+            args.push_back(generateArrayArgument(indArg[k].name, indSizes[k], true));
+        }
+        args.push_back(generateArrayArgument(depArg[0].name, this->_info->dependent.size(), false));
+
+        std::ostringstream ss;
+        printTemplateFunctionDeclaration(ss, _templateTypeName, _cppFunctionName, args);
+        ss << " {\n";
+        ss << this->generateTemporaryVariableDeclaration(false, this->_info->zeroDependents) << "\n";
+        ss << body.str();
+        ss << "}\n";
+
+        out << ss.str();
+    }
+
+    inline std::string generateArrayArgument(const std::string& name,
+                                             size_t size,
+                                             bool input) const {
+        std::string arg = "std::array<" + _templateTypeName + ", " + std::to_string(size) + ">& " + name;
+        if (input)
+            return "const " + arg;
+        return arg;
+    }
+
+    /**
+     * Constants are explicitly converted to the template type so that no
+     * mixed type operations are required
+     */
+    void printParameter(const Base& value) override {
+        this->_code << _templateTypeName << "(";
+        this->writeParameter(value, this->_code);
+        this->_code << ")";
+    }
+
+    void pushParameter(const Base& value) override {
+        this->_streamStack << _templateTypeName << "(";
+        this->writeParameter(value, this->_streamStack);
+        this->_streamStack << ")";
+    }
+
+    void pushPrintOperation(const Node& node) override {
+        CPPADCG_ASSERT_KNOWN(node.getOperationType() == CGOpCode::Pri, "Invalid node type")
+        CPPADCG_ASSERT_KNOWN(node.getArguments().size() >= 1, "Invalid number of arguments for print operation")
+
+        const auto& pnode = static_cast<const PrintOperationNode<Base>&> (node);
+        std::string before = pnode.getBeforeString();
+        replaceString(before, "\n", "\\n");
+        replaceString(before, "\"", "\\\"");
+        std::string after = pnode.getAfterString();
+        replaceString(after, "\n", "\\n");
+        replaceString(after, "\"", "\\\"");
+
+        this->_streamStack << this->_indentation << "std::cerr << \"" << before << "\"";
+        const std::vector<Arg>& args = pnode.getArguments();
+        for (size_t a = 0; a < args.size(); a++) {
+            this->_streamStack << " << ";
+            this->push(args[a]);
+        }
+        this->_streamStack << " << \"" << after << "\";\n";
+    }
+
+    void pushAtomicForwardOp(Node& atomicFor) override {
+        throw CGException("Atomic functions are not supported by the C++ template language (function '",
+                          _cppFunctionName, "')");
+    }
+
+    void pushAtomicReverseOp(Node& atomicRev) override {
+        throw CGException("Atomic functions are not supported by the C++ template language (function '",
+                          _cppFunctionName, "')");
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -31,6 +31,8 @@ protected:
     std::string _path; // the path to the gcc executable
     std::string _tmpFolder;
     std::string _sourcesFolder; // path where source files are saved
+    std::string _cacheFolder; // path where object files are kept between runs
+    std::string _versionOutput; // the output of 'compiler --version' (used in the cache keys)
     std::set<std::string> _ofiles; // compiled object files
     std::set<std::string> _sfiles; // compiled source files
     std::vector<std::string> _compileFlags;
@@ -38,6 +40,8 @@ protected:
     std::vector<std::string> _linkFlags;
     bool _verbose;
     bool _saveToDiskFirst;
+    bool _inMemory;
+    std::vector<int> _memFiles; // file descriptors of the files in memory
 public:
 
     AbstractCCompiler(const std::string& compilerPath) :
@@ -45,7 +49,8 @@ public:
         _tmpFolder("cppadcg_tmp"),
         _sourcesFolder("cppadcg_sources"),
         _verbose(false),
-        _saveToDiskFirst(false) {
+        _saveToDiskFirst(false),
+        _inMemory(false) {
     }
 
     AbstractCCompiler(const AbstractCCompiler& orig) = delete;
@@ -57,6 +62,7 @@ public:
 
     void setCompilerPath(const std::string& path) {
         _path = path;
+        _versionOutput.clear();
     }
 
     const std::string& getTemporaryFolder() const override {
@@ -75,6 +81,14 @@ public:
         _saveToDiskFirst = saveToDiskFirst;
     }
 
+    bool isInMemory() const override {
+        return _inMemory;
+    }
+
+    void setInMemory(bool inMemory) override {
+        _inMemory = inMemory;
+    }
+
     const std::string& getSourcesFolder() const override {
         return _sourcesFolder;
     }
@@ -83,6 +97,14 @@ public:
         _sourcesFolder = srcFolder;
     }
 
+    const std::string& getCacheFolder() const override {
+        return _cacheFolder;
+    }
+
+    void setCacheFolder(const std::string& cacheFolder) override {
+        _cacheFolder = cacheFolder;
+    }
+
     const std::set<std::string>& getObjectFiles() const override {
         return _ofiles;
     }
@@ -159,14 +181,15 @@ public:
         if (sources.empty())
             return; // nothing to do
 
-        system::createFolder(this->_tmpFolder);
+        if (!_inMemory)
+            system::createFolder(this->_tmpFolder);
 
         // determine the maximum file name length
         size_t maxsize = 0;
         std::map<std::string, std::string>::const_iterator it;
         for (it = sources.begin(); it != sources.end(); ++it) {
             _sfiles.insert(it->first);
-            std::string file = system::createPath(this->_tmpFolder, it->first + outputExtension);
+            std::string file = _inMemory ? it->first + outputExtension : system::createPath(this->_tmpFolder, it->first + outputExtension);
             maxsize = std::max<size_t>(maxsize, file.size());
         }
 
@@ -188,10 +211,27 @@ public:
             system::createFolder(_sourcesFolder);
         }
 
+        if (!_cacheFolder.empty()) {
+            system::createFolder(_cacheFolder);
+
+            // an upgraded compiler in the same path must not reuse old object files
+            if (_versionOutput.empty()) {
+                system::callExecutable(_path, {"--version"}, &_versionOutput);
+            }
+        }
+
         // compile each source code file into a different object file
         for (it = sources.begin(); it != sources.end(); ++it) {
             count++;
-            std::string file = system::createPath(this->_tmpFolder, it->first + outputExtension);
+            std::string file;
+            if (_inMemory) {
+                // the object file is an anonymous file in memory
+                int fd = system::createMemoryFile(it->first + outputExtension);
+                _memFiles.push_back(fd);
+                file = system::getFileDescriptorPath(fd);
+            } else {
+                file = system::createPath(this->_tmpFolder, it->first + outputExtension);
+            }
             outputFiles.insert(file);
 
             steady_clock::time_point beginTime;
@@ -215,6 +255,19 @@ public:
                 std::cout.fill(f); // restore fill character
             }
 
+            // reuse the object file from a previous compilation of the same source
+            std::string cacheFile;
+            bool cached = false;
+            if (!_cacheFolder.empty()) {
+                cacheFile = system::createPath(_cacheFolder, createCacheKey(it->second, posIndepCode, outputExtension) + outputExtension);
+                if (system::isFile(cacheFile)) {
+                    system::copyFile(cacheFile, file);
+                    cached = true;
+                    if (timer != nullptr)
+                        timer->setJobCounter("cached", 1);
+                }
+            }
+
             if (_saveToDiskFirst) {
                 // save a new source file to disk
                 std::ofstream sourceFile;
@@ -224,12 +277,28 @@ public:
                 sourceFile.close();
 
                 // compile the file
-                compileFile(srcfile, file, posIndepCode);
-            } else {
+                if (!cached)
+                    compileFile(srcfile, file, posIndepCode);
+            } else if (!cached) {
                  // compile without saving the source code to disk
                 compileSource(it->second, file, posIndepCode);
             }
 
+            if (!cached && !cacheFile.empty()) {
+                // other processes must never find incomplete files in the cache
+                // (each writer uses its own temporary file)
+                std::string partFile = system::createUniqueFile(cacheFile + ".part");
+                try {
+                    system::copyFile(file, partFile);
+                } catch (...) {
+                    std::remove(partFile.c_str());
+                    throw;
+                }
+                if (std::rename(partFile.c_str(), cacheFile.c_str()) != 0) {
+                    std::remove(partFile.c_str());
+                }
+            }
+
             if (timer != nullptr) {
                 timer->finishedJob();
             } else if (_verbose) {
@@ -253,14 +322,22 @@ public:
 
     void cleanup() override {
         // clean up;
-        for (const std::string& it : _ofiles) {
-            if (remove(it.c_str()) != 0)
-                std::cerr << "Failed to delete temporary file '" << it << "'" << std::endl;
+        if (!_memFiles.empty()) {
+            for (int fd : _memFiles) {
+                system::closeMemoryFile(fd);
+            }
+            _memFiles.clear();
+        } else {
+            for (const std::string& it : _ofiles) {
+                if (remove(it.c_str()) != 0)
+                    std::cerr << "Failed to delete temporary file '" << it << "'" << std::endl;
+            }
         }
         _ofiles.clear();
         _sfiles.clear();
 
-        remove(this->_tmpFolder.c_str());
+        if (!_inMemory)
+            remove(this->_tmpFolder.c_str());
     }
 
     virtual ~AbstractCCompiler() {
@@ -269,6 +346,43 @@ public:
 
 protected:
 
+    /**
+     * Creates the name of an object file in the cache folder which
+     * identifies the compiler (path and version), the compilation flags,
+     * and the source code (64-bit FNV-1a hash).
+     *
+     * @param source the content of the source file
+     * @param posIndepCode whether or not position-independent code is
+     *                     created
+     * @param outputExtension the extension of the compiled file
+     */
+    virtual std::string createCacheKey(const std::string& source,
+                                       bool posIndepCode,
+                                       const std::string& outputExtension) const {
+        uint64_t hash = 14695981039346656037ull;
+        auto add = [&hash](const std::string& str) {
+            for (char c : str) {
+                hash ^= (unsigned char) c;
+                hash *= 1099511628211ull;
+            }
+            // separator
+            hash ^= 0xffu;
+            hash *= 1099511628211ull;
+        };
+
+        add(_path);
+        add(_versionOutput);
+        for (const std::string& flag : _compileFlags)
+            add(flag);
+        add(posIndepCode ? "PIC" : "");
+        add(outputExtension);
+        add(source);
+
+        std::ostringstream key;
+        key << std::hex << std::setw(16) << std::setfill('0') << hash;
+        return key.str();
+    }
+
     /**
      * Compiles a single source file into an object file.
      *
@@ -68,6 +68,54 @@ public:
 
     virtual const std::set<std::string>& getSourceFiles() const = 0;
 
+    /**
+     * Whether or not object files and libraries are only kept in memory
+     * (anonymous memory files) instead of the temporary folder.
+     *
+     * @return true if no files are created in the file system
+     */
+    virtual bool isInMemory() const = 0;
+
+    /**
+     * Defines whether or not object files and libraries are only kept in
+     * memory (anonymous memory files) instead of the temporary folder.
+     * Only supported in Linux (memfd_create).
+     *
+     * @param inMemory true to avoid creating files in the file system
+     */
+    virtual void setInMemory(bool inMemory) = 0;
+
+    /**
+     * Provides the path to the folder where compiled object files are kept
+     * between runs (an empty path means that no cache is used).
+     *
+     * @return path to the cache folder
+     */
+    virtual const std::string& getCacheFolder() const = 0;
+
+    /**
+     * Defines a folder where compiled object files are kept between runs
+     * (a compile cache).
+     * A source file which was already compiled with the same compiler
+     * (path and version) and flags is not compiled again: the previous
+     * object file is reused.
+     * Only the compilation is skipped; the source files of unchanged
+     * functions can also be reused with
+     * ModelCSourceGen::setGenerationCacheFolder().
+     * A source file is only reused if its text is identical, therefore
+     * after a change to a few equations of a large model the files of
+     * the unaffected functions are typically reused.
+     * However, when a function is split into several files
+     * (LanguageC::setMaxAssignmentsPerFunction()), a change in any of
+     * its equations usually changes the contents of all of its files
+     * (e.g. the temporary variable indexes and the split points) and they
+     * are all compiled again.
+     *
+     * @param cacheFolder path to the cache folder (an empty path disables
+     *                    the cache)
+     */
+    virtual void setCacheFolder(const std::string& cacheFolder) = 0;
+
     virtual bool isVerbose() const = 0;
 
     virtual void setVerbose(bool verbose) = 0;
@@ -170,6 +170,9 @@ protected:
         if (posIndepCode) {
             args.push_back("-fPIC"); // position-independent code for dynamic linking
         }
+        if (this->_inMemory) {
+            args.push_back("-pipe"); // avoid temporary files between compilation stages
+        }
         args.push_back("-o");
         args.push_back(output);
 
@@ -186,6 +189,9 @@ protected:
         if (posIndepCode) {
             args.push_back("-fPIC"); // position-independent code for dynamic linking
         }
+        if (this->_inMemory) {
+            args.push_back("-pipe"); // avoid temporary files between compilation stages
+        }
         args.push_back("-c");
         args.push_back(path);
         args.push_back("-o");
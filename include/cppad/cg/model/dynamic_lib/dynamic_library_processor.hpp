@@ -101,7 +101,12 @@ public:
     }
 
     /**
-     * System dependent custom options
+     * System dependent custom options.
+     * In Linux, "dlOpenMode" defines the flags used to open the dynamic
+     * library with dlopen() (e.g. std::to_string(RTLD_LAZY) to resolve
+     * undefined symbols only when they are first used; the model functions
+     * are only loaded on first use with
+     * FunctorModelLibrary::setLazyFunctionLoading()).
      */
     inline std::map<std::string, std::string>& getOptions() {
         return _options;
@@ -116,6 +121,9 @@ public:
 
     /**
      * Compiles all models and generates a dynamic library.
+     * If the compiler keeps files in memory (CCompiler::setInMemory()) the
+     * dynamic library is also created as an anonymous file in memory and
+     * it must be loaded.
      * 
      * @param compiler The compiler used to compile the sources and create
      *                 the dynamic library
@@ -127,8 +135,18 @@ public:
         // backup output format so that it can be restored
         OStreamConfigRestore coutb(std::cout);
 
+        CPPADCG_ASSERT_KNOWN(loadLib || !compiler.isInMemory(), "A dynamic library created in memory must be loaded")
+
         this->modelLibraryHelper_->startingJob("", JobTimer::DYNAMIC_MODEL_LIBRARY);
 
+        std::string libname = _libraryName;
+        if (_customLibExtension != nullptr)
+            libname += *_customLibExtension;
+        else
+            libname += system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+
+        int libFd = -1; // the file descriptor of the library in memory
+
         const std::map<std::string, ModelCSourceGen < Base>*>&models = this->modelLibraryHelper_->getModels();
         try {
             for (const auto& p : models) {
@@ -145,15 +163,16 @@ public:
             const std::map<std::string, std::string>& customSource = this->modelLibraryHelper_->getCustomSources();
             compiler.compileSources(customSource, true, this->modelLibraryHelper_);
 
-            std::string libname = _libraryName;
-            if (_customLibExtension != nullptr)
-                libname += *_customLibExtension;
-            else
-                libname += system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+            if (compiler.isInMemory()) {
+                libFd = system::createMemoryFile(system::filenameFromPath(libname));
+                libname = system::getFileDescriptorPath(libFd);
+            }
 
             compiler.buildDynamic(libname, this->modelLibraryHelper_);
 
         } catch (...) {
+            if (libFd != -1)
+                system::closeMemoryFile(libFd);
             compiler.cleanup();
             throw;
         }
@@ -161,14 +180,27 @@ public:
 
         this->modelLibraryHelper_->finishedJob();
 
-        if (loadLib)
-            return loadDynamicLibrary();
-        else
+        if (libFd != -1) {
+            std::unique_ptr<DynamicLib<Base>> lib;
+            try {
+                lib = loadDynamicLibrary(libname);
+            } catch (...) {
+                system::closeMemoryFile(libFd);
+                throw;
+            }
+            system::closeMemoryFile(libFd); // the loaded library keeps the file alive
+            return lib;
+        } else if (loadLib) {
+            return loadDynamicLibrary(libname);
+        } else {
             return std::unique_ptr<DynamicLib<Base>> (nullptr);
+        }
     }
 
     /**
      * Compiles all models and generates a static library.
+     * The compiler must not keep files in memory (CCompiler::setInMemory())
+     * since the static library is always saved to disk.
      * 
      * @param compiler The compiler used to compile the sources
      * @param ar The archiver used to assemble the compiled source into a
@@ -184,6 +216,8 @@ public:
         // backup output format so that it can be restored
         OStreamConfigRestore coutb(std::cout);
 
+        CPPADCG_ASSERT_KNOWN(!compiler.isInMemory(), "Static libraries cannot be created with a compiler which keeps files in memory")
+
         this->modelLibraryHelper_->startingJob("", JobTimer::STATIC_MODEL_LIBRARY);
 
         const std::map<std::string, ModelCSourceGen<Base>*>& models = this->modelLibraryHelper_->getModels();
@@ -223,6 +257,8 @@ protected:
 
     virtual std::unique_ptr<DynamicLib<Base>> loadDynamicLibrary();
 
+    virtual std::unique_ptr<DynamicLib<Base>> loadDynamicLibrary(const std::string& path);
+
 };
 
 } // END cg namespace
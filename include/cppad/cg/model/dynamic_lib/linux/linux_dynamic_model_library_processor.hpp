@@ -21,13 +21,18 @@ namespace cg {
 
 template<class Base>
 std::unique_ptr<DynamicLib<Base>> DynamicModelLibraryProcessor<Base>::loadDynamicLibrary() {
+    return loadDynamicLibrary(_libraryName + system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
+}
+
+template<class Base>
+std::unique_ptr<DynamicLib<Base>> DynamicModelLibraryProcessor<Base>::loadDynamicLibrary(const std::string& path) {
     std::unique_ptr<DynamicLib<Base>> lib;
     const auto it = _options.find("dlOpenMode");
     if (it == _options.end()) {
-        lib.reset(new LinuxDynamicLib<Base>(_libraryName + system::SystemInfo<>::DYNAMIC_LIB_EXTENSION));
+        lib.reset(new LinuxDynamicLib<Base>(path));
     } else {
         int dlOpenMode = std::stoi(it->second);
-        lib.reset(new LinuxDynamicLib<Base>(_libraryName + system::SystemInfo<>::DYNAMIC_LIB_EXTENSION, dlOpenMode));
+        lib.reset(new LinuxDynamicLib<Base>(path, dlOpenMode));
     }
     return lib;
 }
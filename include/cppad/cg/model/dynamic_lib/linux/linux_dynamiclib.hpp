@@ -38,6 +38,14 @@ protected:
     std::set<LinuxDynamicLibModel<Base>*> _models;
 public:
 
+    /**
+     * Loads a dynamic library.
+     *
+     * @param dynLibName the path to the dynamic library
+     * @param dlOpenMode the flags passed to dlopen() (lazy loading of the
+     *                   model functions must be requested separately with
+     *                   setLazyFunctionLoading())
+     */
     explicit LinuxDynamicLib(std::string dynLibName,
                              int dlOpenMode = RTLD_NOW) :
         _dynLibName(std::move(dynLibName)),
@@ -88,6 +96,8 @@ public:
     }
 
     void* loadFunction(const std::string& functionName, bool required = true) override {
+        std::lock_guard<std::mutex> lock(this->_loadFunctionMutex);
+
         void* functor = dlsym(_dynLibHandle, functionName.c_str());
 
         if (required) {
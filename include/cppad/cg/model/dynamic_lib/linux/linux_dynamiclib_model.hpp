@@ -62,7 +62,7 @@ protected:
 
         CPPADCG_ASSERT_UNKNOWN(_dynLib != nullptr);
 
-        this->init();
+        this->init(_dynLib->isLazyFunctionLoading());
     }
 
     LinuxDynamicLibModel(const LinuxDynamicLibModel&) = delete;
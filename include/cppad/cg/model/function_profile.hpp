@@ -0,0 +1,44 @@
+#ifndef CPPAD_CG_FUNCTION_PROFILE_INCLUDED
+#define CPPAD_CG_FUNCTION_PROFILE_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Runtime statistics of a generated function in a model library compiled
+ * with profiling enabled.
+ */
+class FunctionProfile {
+public:
+    /**
+     * The generated function name
+     */
+    std::string name;
+    /**
+     * Number of times the function was called
+     */
+    unsigned long long calls;
+    /**
+     * Total time spent in the function (including the functions it calls)
+     */
+    std::chrono::nanoseconds time;
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -35,6 +35,93 @@ class FunctorGenericModel : public GenericModel<Base> {
 protected:
     static constexpr const char* ERROR_LIBRARY_NOT_READY = "The model library is not ready. The model library that"
                                                            " provided this model might have been closed or deleted.";
+protected:
+    /**
+     * A function of the model in the model library which is only looked up
+     * when it is first needed.
+     * Loading is thread-safe: the function is looked up only once even if
+     * it is first used by several threads at the same time.
+     */
+    class FunctionHandle {
+    protected:
+        FunctorGenericModel* const _model;
+        /// the function name without the model name prefix
+        const std::string& _function;
+        void* _ptr;
+        /// whether or not _ptr is ready (set after _ptr)
+        std::atomic<bool> _loaded;
+    public:
+        inline FunctionHandle(FunctorGenericModel& model,
+                              const std::string& function) :
+                _model(&model),
+                _function(function),
+                _ptr(nullptr),
+                _loaded(false) {
+            model._functions.push_back(this);
+        }
+
+        inline FunctionHandle(FunctorGenericModel& model,
+                              const FunctionHandle& other) :
+                _model(&model),
+                _function(other._function),
+                _ptr(other._ptr),
+                _loaded(other._loaded.load()) {
+            model._functions.push_back(this);
+        }
+
+        FunctionHandle(const FunctionHandle&) = delete;
+        FunctionHandle& operator=(const FunctionHandle&) = delete;
+
+        inline const std::string& getName() const {
+            return _function;
+        }
+
+        inline void load() {
+            if (!_loaded.load(std::memory_order_acquire)) {
+                std::lock_guard<std::mutex> lock(_model->_functionsMutex);
+                if (!_loaded.load(std::memory_order_relaxed)) {
+                    _ptr = _model->loadFunction(_model->_name + "_" + _function, false);
+                    _loaded.store(true, std::memory_order_release);
+                }
+            }
+        }
+
+        inline void reset() {
+            std::lock_guard<std::mutex> lock(_model->_functionsMutex);
+            _ptr = nullptr;
+            _loaded.store(true, std::memory_order_release); // must not be loaded again
+        }
+    };
+
+    /**
+     * A pointer to a function of the model library which is only loaded
+     * when it is first dereferenced or compared.
+     */
+    template<class FuncPtr>
+    class LazyFunction : public FunctionHandle {
+    public:
+        using FunctionHandle::FunctionHandle;
+
+        inline FuncPtr operator*() {
+            this->load();
+            return reinterpret_cast<FuncPtr>(this->_ptr);
+        }
+
+        inline bool operator==(std::nullptr_t) {
+            this->load();
+            return this->_ptr == nullptr;
+        }
+
+        inline bool operator!=(std::nullptr_t) {
+            return !(*this == nullptr);
+        }
+
+        inline LazyFunction& operator=(std::nullptr_t) {
+            this->reset();
+            return *this;
+        }
+    };
+
 protected:
     bool _isLibraryReady;
     /// the model name
@@ -49,48 +136,86 @@ protected:
     std::vector<ExternalFunctionWrapper<Base>* > _atomic;
     size_t _missingAtomicFunctions;
     CppAD::vector<Base> _tx, _ty, _px, _py;
+    // buffer for the non-zero values used when evaluating dense matrices
+    CppAD::vector<Base> _compressed;
+    // all the functions of the model (must be declared before the functions)
+    std::vector<FunctionHandle*> _functions;
+    // protects the loading of the functions
+    std::mutex _functionsMutex;
     // original model function
-    void (*_zero)(Base const*const*, Base * const*, LangCAtomicFun);
+    LazyFunction<void (*)(Base const*const*, Base * const*, LangCAtomicFun)> _zero;
     // first order forward mode
-    int (*_forwardOne)(Base const tx[], Base ty[], LangCAtomicFun);
+    LazyFunction<int (*)(Base const tx[], Base ty[], LangCAtomicFun)> _forwardOne;
     // first order reverse mode
-    int (*_reverseOne)(Base const tx[], Base const ty[], Base px[], Base const py[], LangCAtomicFun);
+    LazyFunction<int (*)(Base const tx[], Base const ty[], Base px[], Base const py[], LangCAtomicFun)> _reverseOne;
     // second order reverse mode
-    int (*_reverseTwo)(Base const tx[], Base const ty[], Base px[], Base const py[], LangCAtomicFun);
+    LazyFunction<int (*)(Base const tx[], Base const ty[], Base px[], Base const py[], LangCAtomicFun)> _reverseTwo;
     // jacobian function in the dynamic library
-    void (*_jacobian)(Base const*const*, Base * const*, LangCAtomicFun);
+    LazyFunction<void (*)(Base const*const*, Base * const*, LangCAtomicFun)> _jacobian;
     // hessian function in the dynamic library
-    void (*_hessian)(Base const*const*, Base * const*, LangCAtomicFun);
+    LazyFunction<void (*)(Base const*const*, Base * const*, LangCAtomicFun)> _hessian;
     //
-    int (*_sparseForwardOne)(unsigned long, Base const *const *, Base * const *, LangCAtomicFun);
+    LazyFunction<int (*)(unsigned long, Base const *const *, Base * const *, LangCAtomicFun)> _sparseForwardOne;
     //
-    int (*_sparseReverseOne)(unsigned long, Base const *const *, Base * const *, LangCAtomicFun);
+    LazyFunction<int (*)(unsigned long, Base const *const *, Base * const *, LangCAtomicFun)> _sparseReverseOne;
     //
-    int (*_sparseReverseTwo)(unsigned long, Base const *const *, Base * const *, LangCAtomicFun);
+    LazyFunction<int (*)(unsigned long, Base const *const *, Base * const *, LangCAtomicFun)> _sparseReverseTwo;
     // sparse jacobian function in the dynamic library
-    void (*_sparseJacobian)(Base const*const*, Base * const*, LangCAtomicFun);
+    LazyFunction<void (*)(Base const*const*, Base * const*, LangCAtomicFun)> _sparseJacobian;
     // sparse hessian function in the dynamic library
-    void (*_sparseHessian)(Base const*const*, Base * const*, LangCAtomicFun);
+    LazyFunction<void (*)(Base const*const*, Base * const*, LangCAtomicFun)> _sparseHessian;
     //
-    void (*_forwardOneSparsity)(unsigned long, unsigned long const**, unsigned long*);
+    LazyFunction<void (*)(unsigned long, unsigned long const**, unsigned long*)> _forwardOneSparsity;
     //
-    void (*_reverseOneSparsity)(unsigned long, unsigned long const**, unsigned long*);
+    LazyFunction<void (*)(unsigned long, unsigned long const**, unsigned long*)> _reverseOneSparsity;
     //
-    void (*_reverseTwoSparsity)(unsigned long, unsigned long const**, unsigned long*);
+    LazyFunction<void (*)(unsigned long, unsigned long const**, unsigned long*)> _reverseTwoSparsity;
     // jacobian sparsity function in the dynamic library
-    void (*_jacobianSparsity)(unsigned long const** row,
-            unsigned long const** col,
-            unsigned long * nnz);
+    LazyFunction<void (*)(unsigned long const** row,
+                          unsigned long const** col,
+                          unsigned long * nnz)> _jacobianSparsity;
     // hessian sparsity function in the dynamic library
-    void (*_hessianSparsity)(unsigned long const** row,
-            unsigned long const** col,
-            unsigned long * nnz);
-    void (*_hessianSparsity2)(unsigned long i,
-            unsigned long const** row,
-            unsigned long const** col,
-            unsigned long * nnz);
-    void (*_atomicFunctions)(const char*** names,
-            unsigned long * n);
+    LazyFunction<void (*)(unsigned long const** row,
+                          unsigned long const** col,
+                          unsigned long * nnz)> _hessianSparsity;
+    LazyFunction<void (*)(unsigned long i,
+                          unsigned long const** row,
+                          unsigned long const** col,
+                          unsigned long * nnz)> _hessianSparsity2;
+    // compressed (CSR/CSC) jacobian sparsity function in the dynamic library
+    LazyFunction<void (*)(unsigned int* format,
+                          unsigned long const** ptr,
+                          unsigned long const** ind,
+                          unsigned long * nnz)> _jacobianSparsityCompressed;
+    // compressed (CSR/CSC) hessian sparsity function in the dynamic library
+    LazyFunction<void (*)(unsigned int* format,
+                          unsigned long const** ptr,
+                          unsigned long const** ind,
+                          unsigned long * nnz)> _hessianSparsityCompressed;
+    LazyFunction<void (*)(const char*** names,
+                          unsigned long * n)> _atomicFunctions;
+    // block lower triangular decomposition
+    LazyFunction<void (*)(unsigned long* n)> _blockCount;
+    LazyFunction<void (*)(unsigned long, unsigned long const**, unsigned long*)> _blockEquations;
+    LazyFunction<void (*)(unsigned long, unsigned long const**, unsigned long*)> _blockVariables;
+    LazyFunction<void (*)(unsigned long block,
+                          unsigned long const** row,
+                          unsigned long const** col,
+                          unsigned long * nnz)> _blockJacobianSparsity;
+    LazyFunction<int (*)(unsigned long, Base const *const *, Base * const *, LangCAtomicFun)> _blockResidual;
+    LazyFunction<int (*)(unsigned long, Base const *const *, Base * const *, LangCAtomicFun)> _blockJacobian;
+    // masked evaluation
+    LazyFunction<void (*)(unsigned char const*, Base const *const *, Base * const *, LangCAtomicFun)> _zeroMasked;
+    LazyFunction<void (*)(unsigned char const*, Base const *const *, Base * const *, LangCAtomicFun)> _sparseJacobianMasked;
+    // directional products
+    LazyFunction<void (*)(Base const*const*, Base * const*, LangCAtomicFun)> _jacobianVectorProduct;
+    LazyFunction<void (*)(Base const*const*, Base * const*, LangCAtomicFun)> _hessianVectorProduct;
+    LazyFunction<void (*)(Base const*const*, Base * const*, LangCAtomicFun)> _jacobianVectorProductBatch;
+    LazyFunction<void (*)(Base const*const*, Base * const*, LangCAtomicFun)> _hessianVectorProductBatch;
+    LazyFunction<void (*)(unsigned long* k)> _directionalBatchSize;
+    // variable ordering
+    LazyFunction<void (*)(unsigned long const**, unsigned long*)> _independentOrder;
+    LazyFunction<void (*)(unsigned long const**, unsigned long*)> _dependentOrder;
 
 public:
 
@@ -107,24 +232,41 @@ public:
             _atomicNames(std::move(other._atomicNames)),
             _atomic(std::move(other._atomic)),
             _missingAtomicFunctions(other._missingAtomicFunctions),
-            _zero(other._zero),
-            _forwardOne(other._forwardOne),
-            _reverseOne(other._reverseOne),
-            _reverseTwo(other._reverseTwo),
-            _jacobian(other._jacobian),
-            _hessian(other._hessian),
-            _sparseForwardOne(other._sparseForwardOne),
-            _sparseReverseOne(other._sparseReverseOne),
-            _sparseReverseTwo(other._sparseReverseTwo),
-            _sparseJacobian(other._sparseJacobian),
-            _sparseHessian(other._sparseHessian),
-            _forwardOneSparsity(other._forwardOneSparsity),
-            _reverseOneSparsity(other._reverseOneSparsity),
-            _reverseTwoSparsity(other._reverseTwoSparsity),
-            _jacobianSparsity(other._jacobianSparsity),
-            _hessianSparsity(other._hessianSparsity),
-            _hessianSparsity2(other._hessianSparsity2),
-            _atomicFunctions(other._atomicFunctions) {
+            _zero(*this, other._zero),
+            _forwardOne(*this, other._forwardOne),
+            _reverseOne(*this, other._reverseOne),
+            _reverseTwo(*this, other._reverseTwo),
+            _jacobian(*this, other._jacobian),
+            _hessian(*this, other._hessian),
+            _sparseForwardOne(*this, other._sparseForwardOne),
+            _sparseReverseOne(*this, other._sparseReverseOne),
+            _sparseReverseTwo(*this, other._sparseReverseTwo),
+            _sparseJacobian(*this, other._sparseJacobian),
+            _sparseHessian(*this, other._sparseHessian),
+            _forwardOneSparsity(*this, other._forwardOneSparsity),
+            _reverseOneSparsity(*this, other._reverseOneSparsity),
+            _reverseTwoSparsity(*this, other._reverseTwoSparsity),
+            _jacobianSparsity(*this, other._jacobianSparsity),
+            _hessianSparsity(*this, other._hessianSparsity),
+            _hessianSparsity2(*this, other._hessianSparsity2),
+            _jacobianSparsityCompressed(*this, other._jacobianSparsityCompressed),
+            _hessianSparsityCompressed(*this, other._hessianSparsityCompressed),
+            _atomicFunctions(*this, other._atomicFunctions),
+            _blockCount(*this, other._blockCount),
+            _blockEquations(*this, other._blockEquations),
+            _blockVariables(*this, other._blockVariables),
+            _blockJacobianSparsity(*this, other._blockJacobianSparsity),
+            _blockResidual(*this, other._blockResidual),
+            _blockJacobian(*this, other._blockJacobian),
+            _zeroMasked(*this, other._zeroMasked),
+            _sparseJacobianMasked(*this, other._sparseJacobianMasked),
+            _jacobianVectorProduct(*this, other._jacobianVectorProduct),
+            _hessianVectorProduct(*this, other._hessianVectorProduct),
+            _jacobianVectorProductBatch(*this, other._jacobianVectorProductBatch),
+            _hessianVectorProductBatch(*this, other._hessianVectorProductBatch),
+            _directionalBatchSize(*this, other._directionalBatchSize),
+            _independentOrder(*this, other._independentOrder),
+            _dependentOrder(*this, other._dependentOrder) {
 
         other._isLibraryReady = false;
     }
@@ -142,6 +284,29 @@ public:
         return _name;
     }
 
+    /**
+     * Loads the functions of this model which have not been loaded yet.
+     * Models created by a library with lazy function loading (see
+     * FunctorModelLibrary::setLazyFunctionLoading()) only look up each
+     * function when it is first used.
+     * This method can be used to remove that cost from the first
+     * evaluation of the functions which will be needed.
+     * It is safe to call it from several threads.
+     *
+     * @param functions the names of the functions to load without the model
+     *                  name prefix (e.g. ModelCSourceGen::FUNCTION_SPARSE_JACOBIAN);
+     *                  all the functions are loaded when empty
+     */
+    virtual void preloadFunctions(const std::set<std::string>& functions = std::set<std::string>()) {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+
+        for (FunctionHandle* f : _functions) {
+            if (functions.empty() || functions.find(f->getName()) != functions.end()) {
+                f->load();
+            }
+        }
+    }
+
     const std::vector<std::string>& getAtomicFunctionNames() override {
         return _atomicNames;
     }
@@ -209,6 +374,27 @@ public:
         std::copy(col, col + nnz, variables.begin());
     }
 
+    bool isJacobianSparsityCompressedAvailable() override {
+        return _jacobianSparsityCompressed != nullptr;
+    }
+
+    SparseMatrixFormat JacobianSparsityCompressed(size_t const** ptr,
+                                                  size_t const** ind,
+                                                  size_t& nnz) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_jacobianSparsityCompressed != nullptr, "No compressed Jacobian sparsity function defined in the dynamic library")
+
+        unsigned int format;
+        unsigned long const* dptr, *dind;
+        unsigned long dnnz;
+        (*_jacobianSparsityCompressed)(&format, &dptr, &dind, &dnnz);
+
+        *ptr = dptr;
+        *ind = dind;
+        nnz = dnnz;
+        return SparseMatrixFormat(format);
+    }
+
     // Hessian sparsity
     bool isHessianSparsityAvailable() override {
         return _hessianSparsity != nullptr;
@@ -262,6 +448,27 @@ public:
         std::copy(col, col + nnz, cols.begin());
     }
 
+    bool isHessianSparsityCompressedAvailable() override {
+        return _hessianSparsityCompressed != nullptr;
+    }
+
+    SparseMatrixFormat HessianSparsityCompressed(size_t const** ptr,
+                                                 size_t const** ind,
+                                                 size_t& nnz) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_hessianSparsityCompressed != nullptr, "No compressed Hessian sparsity function defined in the dynamic library")
+
+        unsigned int format;
+        unsigned long const* dptr, *dind;
+        unsigned long dnnz;
+        (*_hessianSparsityCompressed)(&format, &dptr, &dind, &dnnz);
+
+        *ptr = dptr;
+        *ind = dind;
+        nnz = dnnz;
+        return SparseMatrixFormat(format);
+    }
+
     bool isEquationHessianSparsityAvailable() override {
         return _hessianSparsity2 != nullptr;
     }
@@ -660,16 +867,16 @@ public:
         unsigned long nnz;
         (*_jacobianSparsity)(&row, &col, &nnz);
 
-        CppAD::vector<Base> compressed(nnz);
+        _compressed.resize(nnz);
 
         if (nnz > 0) {
             _in[0] = x.data();
-            _out[0] = &compressed[0];
+            _out[0] = &_compressed[0];
 
             (*_sparseJacobian)(&_in[0], &_out[0], _atomicFuncArg);
         }
 
-        createDenseFromSparse(compressed,
+        createDenseFromSparse(_compressed,
                               _m, _n,
                               row, col,
                               nnz,
@@ -778,16 +985,16 @@ public:
         unsigned long nnz;
         (*_hessianSparsity)(&row, &col, &nnz);
 
-        CppAD::vector<Base> compressed(nnz);
+        _compressed.resize(nnz);
         if (nnz > 0) {
             _inHess[0] = x.data();
             _inHess[1] = w.data();
-            _out[0] = &compressed[0];
+            _out[0] = &_compressed[0];
 
             (*_sparseHessian)(&_inHess[0], &_out[0], _atomicFuncArg);
         }
 
-        createDenseFromSparse(compressed,
+        createDenseFromSparse(_compressed,
                               _n, _n,
                               row, col,
                               nnz,
@@ -883,6 +1090,259 @@ public:
         }
     }
 
+    // Block lower triangular decomposition
+    bool isBlockDecompositionAvailable() override {
+        return _blockCount != nullptr;
+    }
+
+    size_t BlockCount() override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_blockCount != nullptr, "No block decomposition defined in the dynamic library")
+
+        unsigned long n;
+        (*_blockCount)(&n);
+        return n;
+    }
+
+    void BlockStructure(size_t block,
+                        size_t const** equations,
+                        size_t const** variables,
+                        size_t& size) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_blockCount != nullptr, "No block decomposition defined in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(block < BlockCount(), "Invalid block index")
+
+        unsigned long const* eqs, *vars;
+        unsigned long nEqs, nVars;
+        (*_blockEquations)(block, &eqs, &nEqs);
+        (*_blockVariables)(block, &vars, &nVars);
+        CPPADCG_ASSERT_KNOWN(nEqs == nVars, "Invalid block structure in the dynamic library")
+
+        *equations = eqs;
+        *variables = vars;
+        size = nEqs;
+    }
+
+    void BlockJacobianSparsity(size_t block,
+                               size_t const** row,
+                               size_t const** col,
+                               size_t& nnz) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_blockJacobianSparsity != nullptr, "No block decomposition defined in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(block < BlockCount(), "Invalid block index")
+
+        unsigned long const* drow, *dcol;
+        unsigned long dnnz;
+        (*_blockJacobianSparsity)(block, &drow, &dcol, &dnnz);
+
+        *row = drow;
+        *col = dcol;
+        nnz = dnnz;
+    }
+
+    void BlockResidual(size_t block,
+                       ArrayView<const Base> x,
+                       ArrayView<Base> res) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_blockResidual != nullptr, "No block decomposition defined in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(block < BlockCount(), "Invalid block index")
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
+
+        unsigned long const* eqs;
+        unsigned long nEqs;
+        (*_blockEquations)(block, &eqs, &nEqs);
+        CPPADCG_ASSERT_KNOWN(res.size() == nEqs, "Invalid block residual array size")
+
+        _in[0] = x.data();
+        _out[0] = res.data();
+
+        int ret = (*_blockResidual)(block, &_in[0], &_out[0], _atomicFuncArg);
+
+        CPPADCG_ASSERT_KNOWN(ret == 0, "Invalid block index")
+    }
+
+    void BlockJacobian(size_t block,
+                       ArrayView<const Base> x,
+                       ArrayView<Base> jac) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_blockJacobian != nullptr, "No block decomposition defined in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(block < BlockCount(), "Invalid block index")
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
+
+        unsigned long const* drow, *dcol;
+        unsigned long nnz;
+        (*_blockJacobianSparsity)(block, &drow, &dcol, &nnz);
+        CPPADCG_ASSERT_KNOWN(jac.size() == nnz, "Invalid number of non-zero elements in the block Jacobian")
+
+        _in[0] = x.data();
+        _out[0] = jac.data();
+
+        int ret = (*_blockJacobian)(block, &_in[0], &_out[0], _atomicFuncArg);
+
+        CPPADCG_ASSERT_KNOWN(ret == 0, "Invalid block index")
+    }
+
+    // Masked evaluation
+    bool isForwardZeroMaskedAvailable() override {
+        return _zeroMasked != nullptr;
+    }
+
+    void ForwardZeroMasked(ArrayView<const unsigned char> mask,
+                           ArrayView<const Base> x,
+                           ArrayView<Base> dep) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_zeroMasked != nullptr, "No masked zero order forward mode function defined in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+                             " please use the variable size methods")
+        CPPADCG_ASSERT_KNOWN(mask.size() == _m, "Invalid mask size")
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(dep.size() == _m, "Invalid dependent array size")
+        CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
+
+        _in[0] = x.data();
+        _out[0] = dep.data();
+
+        (*_zeroMasked)(mask.data(), &_in[0], &_out[0], _atomicFuncArg);
+    }
+
+    bool isSparseJacobianMaskedAvailable() override {
+        return _sparseJacobianMasked != nullptr;
+    }
+
+    void SparseJacobianMasked(ArrayView<const unsigned char> rowMask,
+                              ArrayView<const Base> x,
+                              ArrayView<Base> jac) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_sparseJacobianMasked != nullptr, "No masked sparse Jacobian function defined in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+                             " please use the variable size methods")
+        CPPADCG_ASSERT_KNOWN(rowMask.size() == _m, "Invalid mask size")
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
+
+        unsigned long const* drow;
+        unsigned long const* dcol;
+        unsigned long nnz;
+        (*_jacobianSparsity)(&drow, &dcol, &nnz);
+        CPPADCG_ASSERT_KNOWN(jac.size() == nnz, "Invalid number of non-zero elements in the Jacobian")
+
+        _in[0] = x.data();
+        _out[0] = jac.data();
+
+        (*_sparseJacobianMasked)(rowMask.data(), &_in[0], &_out[0], _atomicFuncArg);
+    }
+
+    bool isJacobianVectorProductAvailable() override {
+        return _jacobianVectorProduct != nullptr;
+    }
+
+    void JacobianVectorProduct(ArrayView<const Base> x,
+                               ArrayView<const Base> v,
+                               ArrayView<Base> jv) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_jacobianVectorProduct != nullptr, "No Jacobian-vector product function defined in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+                             " please use the variable size methods")
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(v.size() > 0 && v.size() % _n == 0, "Invalid direction array size")
+        CPPADCG_ASSERT_KNOWN(jv.size() * _n == v.size() * _m, "Invalid Jacobian-vector product array size")
+        CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
+
+        const size_t p = v.size() / _n; // number of directions
+        const size_t k = getDirectionalBatchSize();
+
+        const Base* in[2];
+        in[0] = x.data();
+
+        size_t d = 0;
+        if (_jacobianVectorProductBatch != nullptr) {
+            for (; d + k <= p; d += k) {
+                in[1] = &v[d * _n];
+                _out[0] = &jv[d * _m];
+                (*_jacobianVectorProductBatch)(in, &_out[0], _atomicFuncArg);
+            }
+        }
+
+        for (; d < p; d++) {
+            in[1] = &v[d * _n];
+            _out[0] = &jv[d * _m];
+            (*_jacobianVectorProduct)(in, &_out[0], _atomicFuncArg);
+        }
+    }
+
+    bool isHessianVectorProductAvailable() override {
+        return _hessianVectorProduct != nullptr;
+    }
+
+    void HessianVectorProduct(ArrayView<const Base> x,
+                              ArrayView<const Base> w,
+                              ArrayView<const Base> v,
+                              ArrayView<Base> hv) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_hessianVectorProduct != nullptr, "No Hessian-vector product function defined in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+                             " please use the variable size methods")
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
+        CPPADCG_ASSERT_KNOWN(v.size() > 0 && v.size() % _n == 0, "Invalid direction array size")
+        CPPADCG_ASSERT_KNOWN(hv.size() == v.size(), "Invalid Hessian-vector product array size")
+        CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
+
+        const size_t p = v.size() / _n; // number of directions
+        const size_t k = getDirectionalBatchSize();
+
+        const Base* in[3];
+        in[0] = x.data();
+        in[1] = w.data();
+
+        size_t d = 0;
+        if (_hessianVectorProductBatch != nullptr) {
+            for (; d + k <= p; d += k) {
+                in[2] = &v[d * _n];
+                _out[0] = &hv[d * _n];
+                (*_hessianVectorProductBatch)(in, &_out[0], _atomicFuncArg);
+            }
+        }
+
+        for (; d < p; d++) {
+            in[2] = &v[d * _n];
+            _out[0] = &hv[d * _n];
+            (*_hessianVectorProduct)(in, &_out[0], _atomicFuncArg);
+        }
+    }
+
+    size_t getDirectionalBatchSize() override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+
+        if (_directionalBatchSize == nullptr)
+            return 1;
+
+        unsigned long k;
+        (*_directionalBatchSize)(&k);
+        return k;
+    }
+
+    bool isVariableOrderingAvailable() override {
+        return _independentOrder != nullptr;
+    }
+
+    void VariableOrdering(size_t const** independent,
+                          size_t const** dependent) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_independentOrder != nullptr, "No variable ordering defined in the dynamic library")
+
+        unsigned long const* ind, *dep;
+        unsigned long n, m;
+        (*_independentOrder)(&ind, &n);
+        (*_dependentOrder)(&dep, &m);
+        CPPADCG_ASSERT_KNOWN(n == _n && m == _m, "Invalid variable ordering in the dynamic library")
+
+        *independent = ind;
+        *dependent = dep;
+    }
+
 protected:
 
     /**
@@ -897,33 +1357,60 @@ protected:
         _n(0),
         _atomicFuncArg{nullptr}, // not really required
         _missingAtomicFunctions(0),
-        _zero(nullptr),
-        _forwardOne(nullptr),
-        _reverseOne(nullptr),
-        _reverseTwo(nullptr),
-        _jacobian(nullptr),
-        _hessian(nullptr),
-        _sparseForwardOne(nullptr),
-        _sparseReverseOne(nullptr),
-        _sparseReverseTwo(nullptr),
-        _sparseJacobian(nullptr),
-        _sparseHessian(nullptr),
-        _forwardOneSparsity(nullptr),
-        _reverseOneSparsity(nullptr),
-        _reverseTwoSparsity(nullptr),
-        _jacobianSparsity(nullptr),
-        _hessianSparsity(nullptr),
-        _hessianSparsity2(nullptr),
-        _atomicFunctions(nullptr) {
-
-    }
-
-    virtual void init() {
+        _zero(*this, ModelCSourceGen<Base>::FUNCTION_FORWAD_ZERO),
+        _forwardOne(*this, ModelCSourceGen<Base>::FUNCTION_FORWARD_ONE),
+        _reverseOne(*this, ModelCSourceGen<Base>::FUNCTION_REVERSE_ONE),
+        _reverseTwo(*this, ModelCSourceGen<Base>::FUNCTION_REVERSE_TWO),
+        _jacobian(*this, ModelCSourceGen<Base>::FUNCTION_JACOBIAN),
+        _hessian(*this, ModelCSourceGen<Base>::FUNCTION_HESSIAN),
+        _sparseForwardOne(*this, ModelCSourceGen<Base>::FUNCTION_SPARSE_FORWARD_ONE),
+        _sparseReverseOne(*this, ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_ONE),
+        _sparseReverseTwo(*this, ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_TWO),
+        _sparseJacobian(*this, ModelCSourceGen<Base>::FUNCTION_SPARSE_JACOBIAN),
+        _sparseHessian(*this, ModelCSourceGen<Base>::FUNCTION_SPARSE_HESSIAN),
+        _forwardOneSparsity(*this, ModelCSourceGen<Base>::FUNCTION_FORWARD_ONE_SPARSITY),
+        _reverseOneSparsity(*this, ModelCSourceGen<Base>::FUNCTION_REVERSE_ONE_SPARSITY),
+        _reverseTwoSparsity(*this, ModelCSourceGen<Base>::FUNCTION_REVERSE_TWO_SPARSITY),
+        _jacobianSparsity(*this, ModelCSourceGen<Base>::FUNCTION_JACOBIAN_SPARSITY),
+        _hessianSparsity(*this, ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY),
+        _hessianSparsity2(*this, ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY2),
+        _jacobianSparsityCompressed(*this, ModelCSourceGen<Base>::FUNCTION_JACOBIAN_SPARSITY_COMPRESSED),
+        _hessianSparsityCompressed(*this, ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY_COMPRESSED),
+        _atomicFunctions(*this, ModelCSourceGen<Base>::FUNCTION_ATOMIC_FUNC_NAMES),
+        _blockCount(*this, ModelCSourceGen<Base>::FUNCTION_BLOCK_COUNT),
+        _blockEquations(*this, ModelCSourceGen<Base>::FUNCTION_BLOCK_EQUATIONS),
+        _blockVariables(*this, ModelCSourceGen<Base>::FUNCTION_BLOCK_VARIABLES),
+        _blockJacobianSparsity(*this, ModelCSourceGen<Base>::FUNCTION_BLOCK_JACOBIAN_SPARSITY),
+        _blockResidual(*this, ModelCSourceGen<Base>::FUNCTION_BLOCK_RESIDUAL),
+        _blockJacobian(*this, ModelCSourceGen<Base>::FUNCTION_BLOCK_JACOBIAN),
+        _zeroMasked(*this, ModelCSourceGen<Base>::FUNCTION_FORWARD_ZERO_MASKED),
+        _sparseJacobianMasked(*this, ModelCSourceGen<Base>::FUNCTION_SPARSE_JACOBIAN_MASKED),
+        _jacobianVectorProduct(*this, ModelCSourceGen<Base>::FUNCTION_JACOBIAN_VECTOR_PRODUCT),
+        _hessianVectorProduct(*this, ModelCSourceGen<Base>::FUNCTION_HESSIAN_VECTOR_PRODUCT),
+        _jacobianVectorProductBatch(*this, ModelCSourceGen<Base>::FUNCTION_JACOBIAN_VECTOR_PRODUCT_BATCH),
+        _hessianVectorProductBatch(*this, ModelCSourceGen<Base>::FUNCTION_HESSIAN_VECTOR_PRODUCT_BATCH),
+        _directionalBatchSize(*this, ModelCSourceGen<Base>::FUNCTION_DIRECTIONAL_BATCH_SIZE),
+        _independentOrder(*this, ModelCSourceGen<Base>::FUNCTION_INDEPENDENT_ORDER),
+        _dependentOrder(*this, ModelCSourceGen<Base>::FUNCTION_DEPENDENT_ORDER) {
+
+    }
+
+    /**
+     * Prepares the model for evaluation.
+     *
+     * @param lazy whether or not to postpone loading each function from the
+     *             model library until it is first used
+     */
+    virtual void init(bool lazy = false) {
         // validate the dynamic library
         validate();
 
         // load functions from the dynamic library
-        loadFunctions();
+        if (!lazy) {
+            loadFunctions();
+        }
+
+        prepareAtomicFunctions();
     }
 
     virtual void* loadFunction(const std::string& functionName,
@@ -962,24 +1449,9 @@ protected:
     }
 
     virtual void loadFunctions() {
-        _zero = reinterpret_cast<decltype(_zero)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_FORWAD_ZERO, false));
-        _forwardOne = reinterpret_cast<decltype(_forwardOne)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_FORWARD_ONE, false));
-        _reverseOne = reinterpret_cast<decltype(_reverseOne)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_REVERSE_ONE, false));
-        _reverseTwo = reinterpret_cast<decltype(_reverseTwo)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_REVERSE_TWO, false));
-        _jacobian = reinterpret_cast<decltype(_jacobian)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_JACOBIAN, false));
-        _hessian = reinterpret_cast<decltype(_hessian)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_HESSIAN, false));
-        _sparseForwardOne = reinterpret_cast<decltype(_sparseForwardOne)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_FORWARD_ONE, false));
-        _sparseReverseOne = reinterpret_cast<decltype(_sparseReverseOne)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_ONE, false));
-        _sparseReverseTwo = reinterpret_cast<decltype(_sparseReverseTwo)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_TWO, false));
-        _sparseJacobian = reinterpret_cast<decltype(_sparseJacobian)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_JACOBIAN, false));
-        _sparseHessian = reinterpret_cast<decltype(_sparseHessian)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_HESSIAN, false));
-        _forwardOneSparsity = reinterpret_cast<decltype(_forwardOneSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_FORWARD_ONE_SPARSITY, false));
-        _reverseOneSparsity = reinterpret_cast<decltype(_reverseOneSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_REVERSE_ONE_SPARSITY, false));
-        _reverseTwoSparsity = reinterpret_cast<decltype(_reverseTwoSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_REVERSE_TWO_SPARSITY, false));
-        _jacobianSparsity = reinterpret_cast<decltype(_jacobianSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_JACOBIAN_SPARSITY, false));
-        _hessianSparsity = reinterpret_cast<decltype(_hessianSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY, false));
-        _hessianSparsity2 = reinterpret_cast<decltype(_hessianSparsity2)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY2, false));
-        _atomicFunctions = reinterpret_cast<decltype(_atomicFunctions)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_ATOMIC_FUNC_NAMES, true));
+        for (FunctionHandle* f : _functions) {
+            f->load();
+        }
 
         CPPADCG_ASSERT_KNOWN((_sparseForwardOne == nullptr) == (_forwardOneSparsity == nullptr), "Missing functions in the dynamic library")
         CPPADCG_ASSERT_KNOWN((_sparseForwardOne == nullptr) == (_forwardOne == nullptr), "Missing functions in the dynamic library")
@@ -989,6 +1461,21 @@ protected:
         CPPADCG_ASSERT_KNOWN((_sparseReverseTwo == nullptr) == (_reverseTwo == nullptr), "Missing functions in the dynamic library")
         CPPADCG_ASSERT_KNOWN((_sparseJacobian == nullptr) || (_jacobianSparsity != nullptr), "Missing functions in the dynamic library")
         CPPADCG_ASSERT_KNOWN((_sparseHessian == nullptr) || (_hessianSparsity != nullptr), "Missing functions in the dynamic library")
+        CPPADCG_ASSERT_KNOWN((_blockCount == nullptr) == (_blockEquations == nullptr) &&
+                             (_blockCount == nullptr) == (_blockVariables == nullptr) &&
+                             (_blockCount == nullptr) == (_blockJacobianSparsity == nullptr) &&
+                             (_blockCount == nullptr) == (_blockResidual == nullptr) &&
+                             (_blockCount == nullptr) == (_blockJacobian == nullptr), "Missing functions in the dynamic library")
+        CPPADCG_ASSERT_KNOWN((_sparseJacobianMasked == nullptr) || (_jacobianSparsity != nullptr), "Missing functions in the dynamic library")
+        CPPADCG_ASSERT_KNOWN((_jacobianVectorProductBatch == nullptr) || (_directionalBatchSize != nullptr && _jacobianVectorProduct != nullptr), "Missing functions in the dynamic library")
+        CPPADCG_ASSERT_KNOWN((_hessianVectorProductBatch == nullptr) || (_directionalBatchSize != nullptr && _hessianVectorProduct != nullptr), "Missing functions in the dynamic library")
+        CPPADCG_ASSERT_KNOWN((_independentOrder == nullptr) == (_dependentOrder == nullptr), "Missing functions in the dynamic library")
+    }
+
+    virtual void prepareAtomicFunctions() {
+        if (_atomicFunctions == nullptr) {
+            throw CGException("Failed to load function '", _name, "_", ModelCSourceGen<Base>::FUNCTION_ATOMIC_FUNC_NAMES, "'");
+        }
 
         /**
          * Prepare the atomic functions argument
@@ -1052,23 +1539,9 @@ protected:
 
     virtual void modelLibraryClosed() {
         _isLibraryReady = false;
-        _zero = nullptr;
-        _forwardOne = nullptr;
-        _reverseOne = nullptr;
-        _reverseTwo = nullptr;
-        _jacobian = nullptr;
-        _hessian = nullptr;
-        _sparseForwardOne = nullptr;
-        _sparseReverseOne = nullptr;
-        _sparseReverseTwo = nullptr;
-        _sparseJacobian = nullptr;
-        _sparseHessian = nullptr;
-        _forwardOneSparsity = nullptr;
-        _reverseOneSparsity = nullptr;
-        _reverseTwoSparsity = nullptr;
-        _jacobianSparsity = nullptr;
-        _hessianSparsity = nullptr;
-        _hessianSparsity2 = nullptr;
+        for (FunctionHandle* f : _functions) {
+            f->reset();
+        }
     }
 
 private:
@@ -29,6 +29,7 @@ class FunctorModelLibrary : public ModelLibrary<Base> {
 protected:
     std::set<std::string> _modelNames;
     unsigned long _version; // API version
+    bool _lazyFunctionLoading;
     void (*_onClose)();
     void (*_setThreadPoolDisabled)(int);
     int (*_isThreadPoolDisabled)();
@@ -42,11 +43,22 @@ protected:
     float (*_getThreadPoolGuidedMaxWork)();
     void (*_setThreadPoolNumberOfTimeMeas)(unsigned int n);
     unsigned int (*_getThreadPoolNumberOfTimeMeas)();
+    void (*_setThreadPoolExecutor)(ThreadPoolExecutorSubmit, ThreadPoolExecutorWait, void*);
+    void (*_setThreadPoolAffinity)(const int*, int);
+    int (*_getThreadPoolAffinity)(int const**);
+    int (*_getFunctionProfiles)(const char**, unsigned long long*, unsigned long long*, int);
+    void (*_resetFunctionProfiles)();
+    /**
+     * serializes the function look ups of all the models of this library
+     * (e.g. the optimization and JIT of LLVM libraries share the module)
+     */
+    std::mutex _loadFunctionMutex;
 public:
 
     inline FunctorModelLibrary(FunctorModelLibrary&& other) noexcept:
             _modelNames(std::move(other._modelNames)),
             _version(other._version),
+            _lazyFunctionLoading(other._lazyFunctionLoading),
             _onClose(other._onClose),
             _setThreadPoolDisabled(other._setThreadPoolDisabled),
             _isThreadPoolDisabled(other._isThreadPoolDisabled),
@@ -59,7 +71,12 @@ public:
             _setThreadPoolGuidedMaxWork(other._setThreadPoolGuidedMaxWork),
             _getThreadPoolGuidedMaxWork(other._getThreadPoolGuidedMaxWork),
             _setThreadPoolNumberOfTimeMeas(other._setThreadPoolNumberOfTimeMeas),
-            _getThreadPoolNumberOfTimeMeas(other._getThreadPoolNumberOfTimeMeas) {
+            _getThreadPoolNumberOfTimeMeas(other._getThreadPoolNumberOfTimeMeas),
+            _setThreadPoolExecutor(other._setThreadPoolExecutor),
+            _setThreadPoolAffinity(other._setThreadPoolAffinity),
+            _getThreadPoolAffinity(other._getThreadPoolAffinity),
+            _getFunctionProfiles(other._getFunctionProfiles),
+            _resetFunctionProfiles(other._resetFunctionProfiles) {
         other._onClose = nullptr;
     }
 
@@ -81,6 +98,34 @@ public:
         return std::unique_ptr<GenericModel<Base>> (modelFunctor(modelName).release());
     }
 
+    /**
+     * Defines whether or not the models created afterwards should only load
+     * each of their functions from the library when it is first used.
+     * This reduces the time required to create a model from a library with
+     * many functions, but the first evaluation of each function becomes
+     * slower.
+     * For LLVM JIT libraries the gain is limited to the symbol look up:
+     * MCJIT compiles and finalizes the whole module when the address of
+     * any of its functions is first requested.
+     * Lazy loading is only enabled by this method (e.g. it is independent
+     * from the RTLD_LAZY flag used to open a Linux dynamic library).
+     * FunctorGenericModel::preloadFunctions() can be used to load a subset
+     * of the functions in advance.
+     *
+     * @param lazy whether or not to load the model functions on first use
+     */
+    virtual void setLazyFunctionLoading(bool lazy) {
+        _lazyFunctionLoading = lazy;
+    }
+
+    /**
+     * Whether or not the models created by this library only load their
+     * functions when they are first used.
+     */
+    virtual bool isLazyFunctionLoading() const {
+        return _lazyFunctionLoading;
+    }
+
     /**
      * Provides the API version used to create the model library.
      *
@@ -93,6 +138,10 @@ public:
     /**
      * Provides a pointer to a function in the model library.
      *
+     * Implementations must be thread-safe (e.g. by locking
+     * _loadFunctionMutex) since the models created with lazy function
+     * loading can look up functions from different threads.
+     *
      * @param functionName The name of the function in the dynamic library
      * @param required Whether or not the function symbol must exist in the
      *                 library. If the function is required and does not
@@ -184,11 +233,69 @@ public:
         return 0;
     }
 
+    void setThreadPoolAffinity(const std::vector<int>& cores) override {
+        if (_setThreadPoolAffinity != nullptr) {
+            (*_setThreadPoolAffinity)(cores.data(), int(cores.size()));
+        }
+    }
+
+    std::vector<int> getThreadPoolAffinity() const override {
+        if (_getThreadPoolAffinity != nullptr) {
+            int const* cores = nullptr;
+            int n = (*_getThreadPoolAffinity)(&cores);
+            if (n > 0)
+                return std::vector<int>(cores, cores + n);
+        }
+        return std::vector<int>();
+    }
+
+    void setThreadPoolExecutor(ThreadPoolExecutorSubmit submit,
+                               ThreadPoolExecutorWait wait,
+                               void* ctx) override {
+        if (_setThreadPoolExecutor != nullptr) {
+            (*_setThreadPoolExecutor)(submit, wait, ctx);
+        }
+    }
+
+    std::vector<FunctionProfile> getFunctionProfiles() const override {
+        std::vector<FunctionProfile> profiles;
+        if (_getFunctionProfiles == nullptr)
+            return profiles;
+
+        // functions can be registered at any time by other threads
+        int n = (*_getFunctionProfiles)(nullptr, nullptr, nullptr, 0);
+        std::vector<const char*> names(n);
+        std::vector<unsigned long long> calls(n);
+        std::vector<unsigned long long> nanoseconds(n);
+        n = std::min(n, (*_getFunctionProfiles)(names.data(), calls.data(), nanoseconds.data(), n));
+
+        profiles.resize(n);
+        for (int i = 0; i < n; ++i) {
+            profiles[i].name = names[i];
+            profiles[i].calls = calls[i];
+            profiles[i].time = std::chrono::nanoseconds(nanoseconds[i]);
+        }
+
+        std::stable_sort(profiles.begin(), profiles.end(),
+                         [](const FunctionProfile& a, const FunctionProfile& b) {
+                             return a.time > b.time;
+                         });
+
+        return profiles;
+    }
+
+    void resetFunctionProfiles() override {
+        if (_resetFunctionProfiles != nullptr) {
+            (*_resetFunctionProfiles)();
+        }
+    }
+
     inline virtual ~FunctorModelLibrary() = default;
 
 protected:
     FunctorModelLibrary() :
             _version(0), // not really required (but it avoids warnings)
+            _lazyFunctionLoading(false),
             _onClose(nullptr),
             _setThreadPoolDisabled(nullptr),
             _isThreadPoolDisabled(nullptr),
@@ -201,7 +308,12 @@ protected:
             _setThreadPoolGuidedMaxWork(nullptr),
             _getThreadPoolGuidedMaxWork(nullptr),
             _setThreadPoolNumberOfTimeMeas(nullptr),
-            _getThreadPoolNumberOfTimeMeas(nullptr) {
+            _getThreadPoolNumberOfTimeMeas(nullptr),
+            _setThreadPoolExecutor(nullptr),
+            _setThreadPoolAffinity(nullptr),
+            _getThreadPoolAffinity(nullptr),
+            _getFunctionProfiles(nullptr),
+            _resetFunctionProfiles(nullptr) {
     }
 
     inline void validate() {
@@ -251,6 +363,15 @@ protected:
         _getThreadPoolGuidedMaxWork = reinterpret_cast<decltype(_getThreadPoolGuidedMaxWork)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLGUIDEDMAXGROUPWORK, false));
         _setThreadPoolNumberOfTimeMeas = reinterpret_cast<decltype(_setThreadPoolNumberOfTimeMeas)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLNUMBEROFTIMEMEAS, false));
         _getThreadPoolNumberOfTimeMeas = reinterpret_cast<decltype(_getThreadPoolNumberOfTimeMeas)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLNUMBEROFTIMEMEAS, false));
+        _setThreadPoolExecutor = reinterpret_cast<decltype(_setThreadPoolExecutor)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLEXECUTOR, false));
+        _setThreadPoolAffinity = reinterpret_cast<decltype(_setThreadPoolAffinity)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLAFFINITY, false));
+        _getThreadPoolAffinity = reinterpret_cast<decltype(_getThreadPoolAffinity)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLAFFINITY, false));
+
+        /**
+         * Profiling related functions
+         */
+        _getFunctionProfiles = reinterpret_cast<decltype(_getFunctionProfiles)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_PROFILEGET, false));
+        _resetFunctionProfiles = reinterpret_cast<decltype(_resetFunctionProfiles)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_PROFILERESET, false));
 
         if(_setThreads != nullptr) {
             (*_setThreads)(std::thread::hardware_concurrency());
@@ -68,6 +68,31 @@ public:
     virtual void JacobianSparsity(std::vector<size_t>& equations,
                                   std::vector<size_t>& variables) = 0;
 
+    /**
+     * Determines whether or not the Jacobian sparsity pattern is available
+     * in a compressed sparse format (CSR or CSC).
+     * The values of the sparse Jacobian follow the same order.
+     *
+     * @return true if it is possible to request the compressed Jacobian
+     *         sparsity pattern
+     */
+    virtual bool isJacobianSparsityCompressedAvailable() = 0;
+
+    /**
+     * Provides the Jacobian sparsity pattern in a compressed sparse format
+     * without any copies.
+     *
+     * @param ptr The position of the first element of each row (CSR) or
+     *            column (CSC) plus an additional last value with the number
+     *            of non-zeros
+     * @param ind The column (CSR) or row (CSC) index of each element
+     * @param nnz The number of non-zeros
+     * @return the format used (CSR or CSC)
+     */
+    virtual SparseMatrixFormat JacobianSparsityCompressed(size_t const** ptr,
+                                                          size_t const** ind,
+                                                          size_t& nnz) = 0;
+
     /**
      * Determines whether or not the sparsity pattern for the weighted sum of
      * the Hessians can be requested.
@@ -88,6 +113,31 @@ public:
     virtual void HessianSparsity(std::vector<size_t>& rows,
                                  std::vector<size_t>& cols) = 0;
 
+    /**
+     * Determines whether or not the sparsity pattern for the weighted sum of
+     * the Hessians is available in a compressed sparse format (CSR or CSC).
+     * The values of the sparse Hessian follow the same order.
+     *
+     * @return true if it is possible to request the compressed Hessian
+     *         sparsity pattern
+     */
+    virtual bool isHessianSparsityCompressedAvailable() = 0;
+
+    /**
+     * Provides the sparsity pattern for the weighted sum of the Hessians in
+     * a compressed sparse format without any copies.
+     *
+     * @param ptr The position of the first element of each row (CSR) or
+     *            column (CSC) plus an additional last value with the number
+     *            of non-zeros
+     * @param ind The column (CSR) or row (CSC) index of each element
+     * @param nnz The number of non-zeros
+     * @return the format used (CSR or CSC)
+     */
+    virtual SparseMatrixFormat HessianSparsityCompressed(size_t const** ptr,
+                                                         size_t const** ind,
+                                                         size_t& nnz) = 0;
+
     /**
      * Determines whether or not the sparsity pattern for the Hessian
      * associated with a dependent variable can be requested.
@@ -879,6 +929,263 @@ public:
                                size_t const** row,
                                size_t const** col) = 0;
 
+    /***********************************************************************
+     *                Block lower triangular decomposition
+     **********************************************************************/
+
+    /**
+     * Determines whether or not the block lower triangular (BLT)
+     * decomposition of the model is available.
+     *
+     * @return true if the block structure and the block residual and
+     *         Jacobian functions can be used
+     */
+    virtual bool isBlockDecompositionAvailable() = 0;
+
+    /**
+     * Provides the number of blocks in the block lower triangular
+     * decomposition.
+     * Blocks are ordered so that each block only depends on the unknowns
+     * of itself and of the previous blocks.
+     */
+    virtual size_t BlockCount() = 0;
+
+    /**
+     * Provides the equations of a block and the unknown variable assigned
+     * to each of them.
+     *
+     * @param block The block index
+     * @param equations The equation (dependent variable) indexes
+     * @param variables The unknown (independent variable) indexes; the k-th
+     *                  variable is assigned to the k-th equation
+     * @param size The number of equations in the block
+     */
+    virtual void BlockStructure(size_t block,
+                                size_t const** equations,
+                                size_t const** variables,
+                                size_t& size) = 0;
+
+    /**
+     * Provides the sparsity of the Jacobian of a block residual relative to
+     * the block unknowns.
+     *
+     * @param block The block index
+     * @param row The positions of the equations inside the block
+     * @param col The positions of the unknowns inside the block
+     * @param nnz The number of non-zero elements
+     */
+    virtual void BlockJacobianSparsity(size_t block,
+                                       size_t const** row,
+                                       size_t const** col,
+                                       size_t& nnz) = 0;
+
+    /**
+     * Evaluates the residuals of the equations in a block.
+     *
+     * @param block The block index
+     * @param x The independent variables (known and unknown)
+     * @param res The residuals in the order of the block equations
+     */
+    virtual void BlockResidual(size_t block,
+                               ArrayView<const Base> x,
+                               ArrayView<Base> res) = 0;
+
+    /**
+     * Evaluates the sparse Jacobian of a block residual relative to the
+     * block unknowns.
+     *
+     * @param block The block index
+     * @param x The independent variables (known and unknown)
+     * @param jac The Jacobian values in the order provided by
+     *            BlockJacobianSparsity()
+     */
+    virtual void BlockJacobian(size_t block,
+                               ArrayView<const Base> x,
+                               ArrayView<Base> jac) = 0;
+
+    /***********************************************************************
+     *                        Masked evaluation
+     **********************************************************************/
+
+    /**
+     * Determines whether or not the zero order forward mode function which
+     * only evaluates the requested dependent variables can be called.
+     *
+     * @return true if ForwardZeroMasked() can be used
+     */
+    virtual bool isForwardZeroMaskedAvailable() = 0;
+
+    /**
+     * Evaluates only the requested dependent variables (operations shared
+     * with other dependents are evaluated once).
+     * The elements of dep which are not requested are not modified.
+     *
+     * @param mask whether or not each dependent variable is requested
+     *             (must have m elements)
+     * @param x independent variable array (must have n elements)
+     * @param dep dependent variable array (must have m elements)
+     */
+    virtual void ForwardZeroMasked(ArrayView<const unsigned char> mask,
+                                   ArrayView<const Base> x,
+                                   ArrayView<Base> dep) = 0;
+
+    /**
+     * Determines whether or not the sparse Jacobian function which only
+     * evaluates the requested rows can be called.
+     *
+     * @return true if SparseJacobianMasked() can be used
+     */
+    virtual bool isSparseJacobianMaskedAvailable() = 0;
+
+    /**
+     * Evaluates only the elements of the sparse Jacobian in the requested
+     * rows (operations shared with other rows are evaluated once).
+     * The elements of jac in rows which are not requested are not modified.
+     *
+     * @param rowMask whether or not each Jacobian row is requested
+     *                (must have m elements)
+     * @param x independent variable array (must have n elements)
+     * @param jac The values of the sparse Jacobian in the order provided by
+     *            JacobianSparsity()
+     */
+    virtual void SparseJacobianMasked(ArrayView<const unsigned char> rowMask,
+                                      ArrayView<const Base> x,
+                                      ArrayView<Base> jac) = 0;
+
+    /***********************************************************************
+     *                        Directional products
+     **********************************************************************/
+
+    /**
+     * Determines whether or not the product of the Jacobian with
+     * directions can be evaluated without determining the Jacobian.
+     *
+     * @return true if JacobianVectorProduct() can be used
+     */
+    virtual bool isJacobianVectorProductAvailable() = 0;
+
+    /**
+     * Determines the product of the Jacobian with a direction.
+     * \f[ jv = \frac{\rm d F }{{\rm d} x } (x) \, v \f]
+     *
+     * @param x The independent variables
+     * @param v The direction
+     * @return The Jacobian-vector product
+     */
+    template<typename VectorBase>
+    inline VectorBase JacobianVectorProduct(const VectorBase& x,
+                                            const VectorBase& v) {
+        VectorBase jv(Range() * (v.size() / Domain()));
+        this->JacobianVectorProduct(ArrayView<const Base>(&x[0], x.size()),
+                                    ArrayView<const Base>(&v[0], v.size()),
+                                    ArrayView<Base>(&jv[0], jv.size()));
+        return jv;
+    }
+
+    /**
+     * Determines the product of the Jacobian with one or more directions.
+     * \f[ jv^{(d)} = \frac{\rm d F }{{\rm d} x } (x) \, v^{(d)} \f]
+     * When the model provides batch functions, several directions are
+     * evaluated at a time (see getDirectionalBatchSize()).
+     *
+     * @param x The independent variables (must have n elements)
+     * @param v The directions, one after the other (must have n p elements
+     *          for p directions)
+     * @param jv The Jacobian-vector products, one after the other (must
+     *           have m p elements)
+     */
+    virtual void JacobianVectorProduct(ArrayView<const Base> x,
+                                       ArrayView<const Base> v,
+                                       ArrayView<Base> jv) = 0;
+
+    /**
+     * Determines whether or not the product of the weighted sum of the
+     * Hessians with directions can be evaluated without determining the
+     * Hessian.
+     *
+     * @return true if HessianVectorProduct() can be used
+     */
+    virtual bool isHessianVectorProductAvailable() = 0;
+
+    /**
+     * Determines the product of the weighted sum of the Hessians with a
+     * direction.
+     * \f[ hv = \frac{\rm d^2  }{{\rm d} x^2 }  \sum_{i} w_i F_i (x) \, v \f]
+     *
+     * @param x The independent variables
+     * @param w The equation multipliers
+     * @param v The direction
+     * @return The Hessian-vector product
+     */
+    template<typename VectorBase>
+    inline VectorBase HessianVectorProduct(const VectorBase& x,
+                                           const VectorBase& w,
+                                           const VectorBase& v) {
+        VectorBase hv(v.size());
+        this->HessianVectorProduct(ArrayView<const Base>(&x[0], x.size()),
+                                   ArrayView<const Base>(&w[0], w.size()),
+                                   ArrayView<const Base>(&v[0], v.size()),
+                                   ArrayView<Base>(&hv[0], hv.size()));
+        return hv;
+    }
+
+    /**
+     * Determines the product of the weighted sum of the Hessians with one
+     * or more directions.
+     * \f[ hv^{(d)} = \frac{\rm d^2  }{{\rm d} x^2 }  \sum_{i} w_i F_i (x) \, v^{(d)} \f]
+     * When the model provides batch functions, several directions are
+     * evaluated at a time (see getDirectionalBatchSize()).
+     *
+     * @param x The independent variables (must have n elements)
+     * @param w The equation multipliers (must have m elements)
+     * @param v The directions, one after the other (must have n p elements
+     *          for p directions)
+     * @param hv The Hessian-vector products, one after the other (must
+     *           have n p elements)
+     */
+    virtual void HessianVectorProduct(ArrayView<const Base> x,
+                                      ArrayView<const Base> w,
+                                      ArrayView<const Base> v,
+                                      ArrayView<Base> hv) = 0;
+
+    /**
+     * Provides the number of directions evaluated by each call to the
+     * batch directional product functions.
+     *
+     * @return the batch size (1 if there are no batch functions)
+     */
+    virtual size_t getDirectionalBatchSize() = 0;
+
+    /***********************************************************************
+     *                        Variable ordering
+     **********************************************************************/
+
+    /**
+     * Determines whether or not a locality improving ordering of the
+     * independent and dependent variables is available.
+     *
+     * @return true if VariableOrdering() can be used
+     */
+    virtual bool isVariableOrderingAvailable() = 0;
+
+    /**
+     * Provides a reverse Cuthill-McKee ordering of the independent and
+     * dependent variables (determined from the Jacobian sparsity pattern)
+     * which places variables that interact with each other close together.
+     * It can be used to store the model values in the caller with a better
+     * memory locality.
+     * Only the zero order forward mode of the generated code uses this
+     * ordering internally; all the other functions of the model use the
+     * original variable numbering.
+     *
+     * @param independent The original index of the independent variable in
+     *                    each new position (n elements)
+     * @param dependent The original index of the dependent variable in each
+     *                  new position (m elements)
+     */
+    virtual void VariableOrdering(size_t const** independent,
+                                  size_t const** dependent) = 0;
+
     /**
      * Provides a wrapper for this compiled model allowing it to be used as
      * an atomic function. The model must not be deleted while the atomic
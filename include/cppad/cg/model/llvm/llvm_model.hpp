@@ -55,7 +55,7 @@ protected:
 
         CPPADCG_ASSERT_UNKNOWN(_dynLib != nullptr);
 
-        this->init();
+        this->init(_dynLib->isLazyFunctionLoading());
     }
 
     void* loadFunction(const std::string& functionName, bool required = true) override {
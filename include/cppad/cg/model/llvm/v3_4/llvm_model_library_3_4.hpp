@@ -97,6 +97,9 @@ public:
     }
 
     void* loadFunction(const std::string& functionName, bool required = true) override {
+        // the module and the execution engine are shared by all models
+        std::lock_guard<std::mutex> lock(this->_loadFunctionMutex);
+
         llvm::Function* func = _module->getFunction(functionName);
         if (func == nullptr) {
             if (required)
@@ -52,6 +52,8 @@ public:
     static const std::string FUNCTION_JACOBIAN_SPARSITY;
     static const std::string FUNCTION_HESSIAN_SPARSITY;
     static const std::string FUNCTION_HESSIAN_SPARSITY2;
+    static const std::string FUNCTION_JACOBIAN_SPARSITY_COMPRESSED;
+    static const std::string FUNCTION_HESSIAN_SPARSITY_COMPRESSED;
     static const std::string FUNCTION_SPARSE_FORWARD_ONE;
     static const std::string FUNCTION_SPARSE_REVERSE_ONE;
     static const std::string FUNCTION_SPARSE_REVERSE_TWO;
@@ -60,6 +62,23 @@ public:
     static const std::string FUNCTION_REVERSE_TWO_SPARSITY;
     static const std::string FUNCTION_INFO;
     static const std::string FUNCTION_ATOMIC_FUNC_NAMES;
+    static const std::string FUNCTION_BLOCK_COUNT;
+    static const std::string FUNCTION_BLOCK_EQUATIONS;
+    static const std::string FUNCTION_BLOCK_VARIABLES;
+    static const std::string FUNCTION_BLOCK_RESIDUAL;
+    static const std::string FUNCTION_BLOCK_JACOBIAN;
+    static const std::string FUNCTION_BLOCK_JACOBIAN_SPARSITY;
+    static const std::string FUNCTION_FORWARD_ZERO_MASKED;
+    static const std::string FUNCTION_SPARSE_JACOBIAN_MASKED;
+    static const std::string FUNCTION_JACOBIAN_VECTOR_PRODUCT;
+    static const std::string FUNCTION_HESSIAN_VECTOR_PRODUCT;
+    static const std::string FUNCTION_JACOBIAN_VECTOR_PRODUCT_BATCH;
+    static const std::string FUNCTION_HESSIAN_VECTOR_PRODUCT_BATCH;
+    static const std::string FUNCTION_DIRECTIONAL_BATCH_SIZE;
+    static const std::string FUNCTION_INDEPENDENT_ORDER;
+    static const std::string FUNCTION_DEPENDENT_ORDER;
+    /// suffix of the functions which use renumbered variables
+    static const std::string ORDERED_SUFFIX;
 protected:
     static const std::string CONST;
 
@@ -157,20 +176,42 @@ protected:
      * the name of the data type used in operations
      */
     const std::string _baseTypeName;
+    /**
+     * the name of the data type used to accumulate the contributions of
+     * several directions in forward and reverse mode functions
+     * (an empty string means the same type as the one used in operations)
+     */
+    std::string _accumulationTypeName;
     /**
      * the maximum precision used to print values
      */
     size_t _parameterPrecision;
+    /**
+     * whether or not to add call counters and timers to the generated
+     * functions
+     */
+    bool _profiling;
+    /**
+     * whether or not to generate loops which can be more easily vectorized
+     * by the compiler
+     */
+    bool _loopVectorization;
     /**
      * Typical values of the independent vector
      */
     std::vector<Base> _x;
     /**
      * Whether or not to enable the generation of multithreaded code for the
-     * sparse Jacobian and sparse Hessian if possible and requested by the
-     * model library (experimental).
+     * sparse Jacobian, sparse Hessian, and parallel tasks if possible and
+     * requested by the model library (experimental).
      */
     bool _multiThreading;
+    /**
+     * The number of independent tasks used to evaluate the zero order
+     * forward mode and the dense Jacobian when multithreading is used
+     * (0 or 1 means that these functions are evaluated by a single thread).
+     */
+    size_t _parallelTasks;
     /// generate source code for the zero order model evaluation
     bool _zero;
     bool _zeroEvaluated;
@@ -209,11 +250,19 @@ protected:
      */
     Position _custom_jac;
     LocalSparsityInfo _jacSparsity;
+    /**
+     * The order of the values of the sparse Jacobian
+     */
+    SparseMatrixFormat _jacFormat;
     /**
      * Custom Hessian element indexes
      */
     Position _custom_hess;
     LocalSparsityInfo _hessSparsity;
+    /**
+     * The order of the values of the sparse Hessian
+     */
+    SparseMatrixFormat _hessFormat;
     /**
      * Hessian sparsity from the model for each equation
      */
@@ -276,6 +325,97 @@ protected:
      *
      */
     JobTimer* _jobTimer;
+    /**
+     * rewrites the operation graphs before generating source code
+     * (not owned; might not be used)
+     */
+    GraphRewriter<Base>* _graphRewriter;
+    /**
+     * whether or not operations are reordered to reduce the number of
+     * temporary variables simultaneously in use
+     */
+    bool _scheduleOperations;
+    /**
+     * whether or not sparsity patterns are determined from the operation
+     * graph instead of CppAD sparsity sweeps
+     */
+    bool _graphSparsity;
+    /**
+     * the maximum number of threads used to determine sparsity patterns
+     * from the operation graph
+     */
+    size_t _graphSparsityThreads;
+    /**
+     * the operation graph used to determine sparsity patterns (only
+     * created when needed and shared by the Jacobian and Hessian)
+     */
+    std::unique_ptr<CodeHandler<Base> > _sparsityHandler;
+    std::unique_ptr<GraphSparsity<Base> > _sparsityGraph;
+    /**
+     * the maximum number of threads used to prepare the sparsity
+     * information of the loop models and of the model without loops
+     */
+    size_t _loopThreads;
+    /**
+     * whether or not to generate the block lower triangular decomposition
+     * of the model with a residual and a Jacobian function for each block
+     */
+    bool _blockDecomposition;
+    /**
+     * the independent variables which are unknowns in the block
+     * decomposition (empty means all independent variables)
+     */
+    std::vector<size_t> _blockUnknowns;
+    /**
+     * the equations (dependent variable indexes) of each block
+     * in the order in which blocks can be solved
+     */
+    std::vector<std::vector<size_t> > _blockEquations;
+    /**
+     * the unknowns (independent variable indexes) of each block;
+     * the k-th unknown is assigned to the k-th equation of the block
+     */
+    std::vector<std::vector<size_t> > _blockVariables;
+    /**
+     * the Jacobian sparsity of each block (positions inside the block)
+     */
+    std::vector<LocalSparsityInfo> _blockJacSparsity;
+    /**
+     * whether or not to generate a zero order forward mode function which
+     * only evaluates the requested dependent variables
+     */
+    bool _maskedForwardZero;
+    /**
+     * whether or not to generate a sparse Jacobian function which only
+     * evaluates the requested Jacobian rows
+     */
+    bool _maskedSparseJacobian;
+    /**
+     * whether or not to generate a function for the product of the
+     * Jacobian with a direction
+     */
+    bool _jacobianVectorProduct;
+    /**
+     * whether or not to generate a function for the product of the
+     * weighted sum of the Hessians with a direction
+     */
+    bool _hessianVectorProduct;
+    /**
+     * the number of directions used by the batch versions of the
+     * directional product functions (1 means no batch functions)
+     */
+    size_t _directionalBatchSize;
+    /**
+     * whether or not to generate the functions which provide a
+     * locality improving ordering of the independent and dependent
+     * variables
+     */
+    bool _variableOrdering;
+    /**
+     * the folder where the generated source code of each function is kept
+     * between runs (empty to disable)
+     */
+    std::string _generationCacheFolder;
     /**
      * Generated source code (maps file names to content)
      */
@@ -296,7 +436,10 @@ public:
         _name(std::move(model)),
         _baseTypeName(ModelCSourceGen<Base>::baseTypeName()),
         _parameterPrecision(std::numeric_limits<Base>::digits10),
+        _profiling(false),
+        _loopVectorization(false),
         _multiThreading(true),
+        _parallelTasks(0),
         _zero(true),
         _zeroEvaluated(false),
         _jacobian(false),
@@ -310,10 +453,24 @@ public:
         _sparseJacobianReusesOne(true),
         _sparseHessianReusesRev2(true),
         _jacMode(JacobianADMode::Automatic),
+        _jacFormat(SparseMatrixFormat::Coordinate),
+        _hessFormat(SparseMatrixFormat::Coordinate),
         _atomicsInfo(nullptr),
         _maxAssignPerFunc(20000),
         _maxOperationsPerAssignment(1000),
-        _jobTimer(nullptr) {
+        _jobTimer(nullptr),
+        _graphRewriter(nullptr),
+        _scheduleOperations(false),
+        _graphSparsity(false),
+        _graphSparsityThreads(1),
+        _loopThreads(1),
+        _blockDecomposition(false),
+        _maskedForwardZero(false),
+        _maskedSparseJacobian(false),
+        _jacobianVectorProduct(false),
+        _hessianVectorProduct(false),
+        _directionalBatchSize(1),
+        _variableOrdering(false) {
 
         CPPADCG_ASSERT_KNOWN(!_name.empty(), "Model name cannot be empty")
         CPPADCG_ASSERT_KNOWN((_name[0] >= 'a' && _name[0] <= 'z') ||
@@ -387,6 +544,54 @@ public:
         _parameterPrecision = p;
     }
 
+    /**
+     * Whether or not the generated functions count the number of calls and
+     * the time spent in them.
+     *
+     * @return true if profiling code is added to the generated functions
+     */
+    inline bool isProfiling() const {
+        return _profiling;
+    }
+
+    /**
+     * Defines whether or not the generated functions count the number of
+     * calls and the time spent in them.
+     * The statistics can be retrieved with
+     * ModelLibrary::getFunctionProfiles().
+     * Profiling adds a small overhead to every call and should only be
+     * used to find which functions should be optimized.
+     *
+     * @param profiling true to add profiling code to the generated functions
+     */
+    inline void setProfiling(bool profiling) {
+        _profiling = profiling;
+    }
+
+    /**
+     * Whether or not loops without dependencies between iterations are
+     * generated so that they can be vectorized by the compiler.
+     *
+     * @return true if vectorization friendly loops are generated
+     */
+    inline bool isLoopVectorization() const {
+        return _loopVectorization;
+    }
+
+    /**
+     * Defines whether or not loops without dependencies between iterations
+     * should be generated so that they can be vectorized by the compiler
+     * (see LanguageC::setLoopVectorization()).
+     * Only relevant when loops are detected (see setRelatedDependents()).
+     * The input and output arrays of the generated functions must not
+     * overlap.
+     *
+     * @param vectorize true to generate vectorization friendly loops
+     */
+    inline void setLoopVectorization(bool vectorize) {
+        _loopVectorization = vectorize;
+    }
+
     /**
      * Returns whether or not multithreading directives can be generated to
      * parallelize the sparse Jacobian and sparse Hessian evaluation.
@@ -428,6 +633,35 @@ public:
         return _multiThreading && _loopTapes.empty() && _sparseHessian && _sparseHessianReusesRev2 && _reverseTwo;
     }
 
+    /**
+     * Provides the number of independent tasks used to evaluate the zero
+     * order forward mode and the dense Jacobian with multiple threads.
+     */
+    inline size_t getParallelTasks() const {
+        return _parallelTasks;
+    }
+
+    /**
+     * Defines the number of independent tasks used to evaluate the zero
+     * order forward mode and the dense Jacobian with multiple threads.
+     * The dependent variables are split into contiguous ranges requiring a
+     * similar number of operations and each range is evaluated by a
+     * different function.
+     * Operations shared by several ranges are evaluated by each of those
+     * functions so that no synchronization is required between tasks.
+     * Multithreaded code is only generated if requested by the model library
+     * and if loop detection is disabled.
+     *
+     * @param tasks the number of tasks (0 or 1 to use a single function)
+     */
+    inline void setParallelTasks(size_t tasks) {
+        _parallelTasks = tasks;
+    }
+
+    inline bool isParallelTasksEnabled() const {
+        return _multiThreading && _loopTapes.empty() && _parallelTasks > 1 && (_zero || _jacobian);
+    }
+
     /**
      * Determines whether or not to generate source-code for a function
      * that evaluates a dense Hessian.
@@ -851,6 +1085,90 @@ public:
         _custom_hess = Position(elements);
     }
 
+    /**
+     * Provides the order of the values computed by the generated sparse
+     * Jacobian.
+     *
+     * @return the storage order of the sparse Jacobian values
+     */
+    inline SparseMatrixFormat getSparseJacobianFormat() const {
+        return _jacFormat;
+    }
+
+    /**
+     * Defines the order of the values computed by the generated sparse
+     * Jacobian.
+     * With CSR (or CSC) the Jacobian elements, including any custom
+     * elements, are sorted by row (or column) and the library also exports
+     * the row (or column) pointers and the column (or row) indexes, so
+     * that values can be written directly into the storage of a solver
+     * without any permutation.
+     *
+     * @param format the storage order of the sparse Jacobian values
+     */
+    inline void setSparseJacobianFormat(SparseMatrixFormat format) {
+        _jacFormat = format;
+    }
+
+    /**
+     * Provides the order of the values computed by the generated sparse
+     * Hessian.
+     *
+     * @return the storage order of the sparse Hessian values
+     */
+    inline SparseMatrixFormat getSparseHessianFormat() const {
+        return _hessFormat;
+    }
+
+    /**
+     * Defines the order of the values computed by the generated sparse
+     * Hessian.
+     * With CSR (or CSC) the Hessian elements, including any custom
+     * elements, are sorted by row (or column) and the library also exports
+     * the row (or column) pointers and the column (or row) indexes.
+     *
+     * @param format the storage order of the sparse Hessian values
+     */
+    inline void setSparseHessianFormat(SparseMatrixFormat format) {
+        _hessFormat = format;
+    }
+
+    /**
+     * Provides the name of the data type used to accumulate the
+     * contributions of each direction in the forward one, reverse one,
+     * and reverse two functions.
+     *
+     * @return the name of the accumulation type (an empty string if the
+     *         same type used in operations)
+     */
+    inline const std::string& getAccumulationTypeName() const {
+        return _accumulationTypeName;
+    }
+
+    /**
+     * Defines the name of the data type used to accumulate the
+     * contributions of each direction in the forward one, reverse one,
+     * and reverse two functions (e.g. Hessian-vector products).
+     * A mixed precision mode can be used with a float model by
+     * accumulating in double: the model operations are evaluated with
+     * floats while the sums are performed with doubles.
+     *
+     * @param typeName the name of a C floating point type (e.g. "double")
+     *                 or an empty string to use the same type as the
+     *                 model operations
+     */
+    inline void setAccumulationTypeName(const std::string& typeName) {
+        _accumulationTypeName = typeName;
+    }
+
+    /**
+     * Whether or not the accumulations use a different data type from the
+     * one used in the model operations.
+     */
+    inline bool isMixedPrecision() const {
+        return !_accumulationTypeName.empty() && _accumulationTypeName != _baseTypeName;
+    }
+
     /**
      * The maximum number of assignment per generated function.
      * Zero means it is disabled (no limit).
@@ -896,6 +1214,301 @@ public:
         _maxOperationsPerAssignment = maxOperationsPerAssignment;
     }
 
+    inline GraphRewriter<Base>* getGraphRewriter() const {
+        return _graphRewriter;
+    }
+
+    /**
+     * Defines an object used to rewrite the operation graph of each
+     * generated function (e.g. strength reduction of powers with constant
+     * exponents) before its source code is created.
+     * The rewriter accumulates the operation counts of all the generated
+     * functions which can be used to compare the number of operations
+     * before and after rewriting.
+     *
+     * @param rewriter the graph rewriter (not owned) or null to disable
+     *                 rewriting
+     */
+    inline void setGraphRewriter(GraphRewriter<Base>* rewriter) {
+        _graphRewriter = rewriter;
+    }
+
+    inline bool isScheduleOperations() const {
+        return _scheduleOperations;
+    }
+
+    /**
+     * Defines whether or not to reorder the operations of each generated
+     * function so that fewer temporary variables are simultaneously in use.
+     *
+     * @see CodeHandler::setScheduleOperations()
+     */
+    inline void setScheduleOperations(bool schedule) {
+        _scheduleOperations = schedule;
+    }
+
+    inline bool isGraphSparsity() const {
+        return _graphSparsity;
+    }
+
+    /**
+     * Defines whether or not the Jacobian and Hessian sparsity patterns are
+     * determined directly from the operation graph (using GraphSparsity)
+     * instead of CppAD sparsity sweeps.
+     * This is only used for models without loops.
+     * Atomic functions are considered to have dense derivatives.
+     *
+     * @param graphSparsity whether or not to use the operation graph
+     * @param threads the maximum number of threads used to determine the
+     *                sparsity patterns
+     */
+    inline void setGraphSparsity(bool graphSparsity,
+                                 size_t threads = 1) {
+        _graphSparsity = graphSparsity;
+        _graphSparsityThreads = threads;
+    }
+
+    inline size_t getGraphSparsityThreads() const {
+        return _graphSparsityThreads;
+    }
+
+    inline size_t getLoopThreads() const {
+        return _loopThreads;
+    }
+
+    /**
+     * Defines the maximum number of threads used to determine the Jacobian
+     * and Hessian sparsity information of the detected loops (and of the
+     * equations outside loops) before generating source code.
+     * Each loop model has its own tape and is processed by a single thread.
+     * Tapes calling atomic functions are always processed sequentially.
+     * The source code of the second order reverse mode functions of each
+     * loop is also created concurrently (each loop has its own
+     * CodeHandler whose graph is built beforehand by the calling thread);
+     * the other functions with loops share a single CodeHandler and are
+     * created sequentially.
+     * The generated source code does not depend on the number of threads.
+     * This is only relevant for models with loops.
+     *
+     * @param threads the maximum number of threads (1 means that no
+     *                additional threads are created)
+     */
+    inline void setLoopThreads(size_t threads) {
+        _loopThreads = threads == 0 ? 1 : threads;
+    }
+
+    inline bool isCreateBlockDecomposition() const {
+        return _blockDecomposition;
+    }
+
+    /**
+     * Defines whether or not to generate the block lower triangular (BLT)
+     * decomposition of the model.
+     * Each equation is assigned to an unknown variable (maximum matching)
+     * and the equations are split into the strongly connected blocks which
+     * can be solved sequentially.
+     * A residual function and a sparse Jacobian function (relative to the
+     * block unknowns) are generated for each block.
+     * The number of unknowns must match the number of equations.
+     *
+     * @param createBlocks whether or not to generate the block decomposition
+     */
+    inline void setCreateBlockDecomposition(bool createBlocks) {
+        _blockDecomposition = createBlocks;
+    }
+
+    inline const std::vector<size_t>& getBlockUnknowns() const {
+        return _blockUnknowns;
+    }
+
+    /**
+     * Defines which independent variables are unknowns in the block
+     * decomposition (e.g. the algebraic variables and the derivatives of
+     * a reduced DAE system).
+     * All other independent variables are considered known when a
+     * block is evaluated.
+     *
+     * @param unknowns the independent variable indexes (an empty vector
+     *                 means all independent variables)
+     */
+    inline void setBlockUnknowns(const std::vector<size_t>& unknowns) {
+        _blockUnknowns = unknowns;
+        _blockEquations.clear();
+        _blockVariables.clear();
+        _blockJacSparsity.clear();
+    }
+
+    /**
+     * Provides the equations of each block in the order in which the
+     * blocks can be solved.
+     * The decomposition is determined if it was not yet determined.
+     */
+    inline const std::vector<std::vector<size_t> >& getBlockEquations() {
+        determineBlocks();
+        return _blockEquations;
+    }
+
+    /**
+     * Provides the unknown variables of each block (the k-th variable is
+     * assigned to the k-th equation of the block).
+     * The decomposition is determined if it was not yet determined.
+     */
+    inline const std::vector<std::vector<size_t> >& getBlockVariables() {
+        determineBlocks();
+        return _blockVariables;
+    }
+
+    inline bool isCreateMaskedForwardZero() const {
+        return _maskedForwardZero;
+    }
+
+    /**
+     * Defines whether or not to generate a zero order forward mode function
+     * which receives a mask with the requested dependent variables.
+     * Operations are grouped by the set of dependent variables which use
+     * them and only the groups used by requested dependents are evaluated
+     * (the other elements of the output are not modified).
+     *
+     * @param create whether or not to generate the masked function
+     */
+    inline void setCreateMaskedForwardZero(bool create) {
+        _maskedForwardZero = create;
+    }
+
+    inline bool isCreateMaskedSparseJacobian() const {
+        return _maskedSparseJacobian;
+    }
+
+    /**
+     * Defines whether or not to generate a sparse Jacobian function which
+     * receives a mask with the requested Jacobian rows.
+     * Operations are grouped by the set of rows which use them and only
+     * the groups used by requested rows are evaluated (the other elements
+     * of the output are not modified).
+     * The elements are provided in the same order as for the sparse
+     * Jacobian.
+     *
+     * @param create whether or not to generate the masked function
+     */
+    inline void setCreateMaskedSparseJacobian(bool create) {
+        _maskedSparseJacobian = create;
+    }
+
+    inline bool isCreateJacobianVectorProduct() const {
+        return _jacobianVectorProduct;
+    }
+
+    /**
+     * Defines whether or not to generate a function which evaluates the
+     * product of the Jacobian with a direction without determining the
+     * Jacobian:
+     * \f[ jv = \frac{\rm d F }{{\rm d} x } (x) \, v \f]
+     *
+     * @param create whether or not to generate the function
+     */
+    inline void setCreateJacobianVectorProduct(bool create) {
+        _jacobianVectorProduct = create;
+    }
+
+    inline bool isCreateHessianVectorProduct() const {
+        return _hessianVectorProduct;
+    }
+
+    /**
+     * Defines whether or not to generate a function which evaluates the
+     * product of the weighted sum of the Hessians with a direction without
+     * determining the Hessian:
+     * \f[ hv = \frac{\rm d^2  }{{\rm d} x^2 }  \sum_{i} w_i F_i (x) \, v \f]
+     *
+     * @param create whether or not to generate the function
+     */
+    inline void setCreateHessianVectorProduct(bool create) {
+        _hessianVectorProduct = create;
+    }
+
+    inline size_t getDirectionalBatchSize() const {
+        return _directionalBatchSize;
+    }
+
+    /**
+     * Defines the number of directions evaluated by each call of the batch
+     * versions of the Jacobian-vector and Hessian-vector product functions.
+     * The zero order values are computed only once for all the directions
+     * in a batch.
+     * Batch functions are only generated for sizes higher than 1.
+     *
+     * @param k the number of directions in each batch
+     */
+    inline void setDirectionalBatchSize(size_t k) {
+        CPPADCG_ASSERT_KNOWN(k > 0, "The batch size must be positive")
+        _directionalBatchSize = k;
+    }
+
+    inline bool isCreateVariableOrdering() const {
+        return _variableOrdering;
+    }
+
+    /**
+     * Defines whether or not to generate the functions which provide a
+     * reverse Cuthill-McKee ordering of the independent and dependent
+     * variables determined from the Jacobian sparsity pattern.
+     * Variables which interact with each other are placed close together,
+     * which can be used by the caller to store the model values with a
+     * better memory locality (see GenericModel::VariableOrdering()).
+     * Only the zero order forward mode is reordered: it is generated with
+     * renumbered independent and dependent variables (function
+     * <model>_forward_zero_ordered, which expects already permuted
+     * buffers) and <model>_forward_zero becomes a wrapper which permutes
+     * the values once before and after calling it; therefore the interface
+     * and the sparsity arrays of the model are not affected.
+     * The Jacobian, Hessian and forward/reverse mode functions, and the
+     * zero order forward mode with loops or parallel tasks, keep the
+     * original variable numbering.
+     *
+     * @param create whether or not to generate the variable ordering
+     */
+    inline void setCreateVariableOrdering(bool create) {
+        _variableOrdering = create;
+    }
+
+    /**
+     * Provides a reverse Cuthill-McKee ordering of the independent and
+     * dependent variables which reduces the bandwidth of the Jacobian.
+     *
+     * @param independent the original index of the independent variable
+     *                    in each new position
+     * @param dependent the original index of the dependent variable in
+     *                  each new position
+     */
+    inline void getVariableOrdering(std::vector<size_t>& independent,
+                                    std::vector<size_t>& dependent) {
+        determineJacobianSparsity();
+        reverseCuthillMcKee(_jacSparsity.sparsity, _fun.Domain(), dependent, independent);
+    }
+
+    inline const std::string& getGenerationCacheFolder() const {
+        return _generationCacheFolder;
+    }
+
+    /**
+     * Defines a folder where the generated source code of each function is
+     * kept between runs.
+     * Each function is identified by a fingerprint of the operation graph
+     * of its dependent variables (and of the code generation options);
+     * functions whose graph did not change since a previous run reuse the
+     * saved source code instead of being generated again.
+     * The model is still taped and its sparsities are still determined.
+     * Functions with atomic functions, loops, parallel tasks, or created
+     * with a graph rewriter are always generated.
+     * The compilers can also reuse the object files of unchanged sources
+     * (see CCompiler::setCacheFolder()).
+     *
+     * @param folder the cache folder (an empty string disables the cache)
+     */
+    inline void setGenerationCacheFolder(const std::string& folder) {
+        _generationCacheFolder = folder;
+    }
+
     inline virtual ~ModelCSourceGen() {
         delete _funNoLoops;
         delete _atomicsInfo;
@@ -930,6 +1543,16 @@ protected:
 
     virtual void generateLoops();
 
+    /**
+     * Determines the Jacobian (and Hessian) sparsity information of each
+     * loop model and of the model without loops, using up to
+     * _loopThreads threads.
+     *
+     * @param hessian whether or not to also determine the Hessian
+     *                sparsity information
+     */
+    virtual void evalLoopSparsities(bool hessian);
+
     virtual void generateInfoSource();
 
     virtual void generateAtomicFuncNames();
@@ -942,7 +1565,7 @@ protected:
      * zero order (the original model)
      **********************************************************************/
 
-    virtual void generateZeroSource();
+    virtual void generateZeroSource(MultiThreadingType multiThreadingType);
 
     /**
      * Generates the operation graph for the zero order model with loops
@@ -954,7 +1577,7 @@ protected:
      * Jacobian
      **********************************************************************/
 
-    virtual void generateJacobianSource();
+    virtual void generateJacobianSource(MultiThreadingType multiThreadingType);
 
     virtual void generateSparseJacobianSource(MultiThreadingType multiThreadingType);
 
@@ -1051,6 +1674,44 @@ protected:
                                                     const LoopModel<Base>& loop,
                                                     size_t i);
 
+    /***********************************************************************
+     * parallel tasks
+     **********************************************************************/
+
+    /**
+     * Generates the source code for a function whose dependent variables
+     * are evaluated by several independent tasks in parallel.
+     * Each task is a function which evaluates a contiguous range of the
+     * dependent variables.
+     *
+     * @param handler the handler with the operation graph
+     * @param dep the dependent variables
+     * @param functionName the name of the function to be generated
+     * @param depName the name of the dependent variable array
+     * @param jobName the name of the job used for reporting
+     * @param multiThreadingType the type of multithreading
+     */
+    virtual void generateParallelTasksSource(CodeHandler<Base>& handler,
+                                             std::vector<CGBase>& dep,
+                                             const std::string& functionName,
+                                             const std::string& depName,
+                                             const std::string& jobName,
+                                             MultiThreadingType multiThreadingType);
+
+    /**
+     * Splits the dependent variables into contiguous ranges which require
+     * a similar number of operations.
+     *
+     * @param handler the handler with the operation graph
+     * @param dep the dependent variables
+     * @param nTasks the maximum number of ranges
+     * @return the first dependent index of each range followed by the
+     *         total number of dependent variables
+     */
+    static std::vector<size_t> determineTaskRanges(CodeHandler<Base>& handler,
+                                                   const std::vector<CGBase>& dep,
+                                                   size_t nTasks);
+
     /***********************************************************************
      * Hessian
      **********************************************************************/
@@ -1150,6 +1811,11 @@ protected:
     virtual void generateSparsity1DSource2(const std::string& function,
                                            const std::map<size_t, std::vector<size_t> >& rows);
 
+    virtual void generateSparsityCompressedSource(const std::string& function,
+                                                  const LocalSparsityInfo& sparsity,
+                                                  SparseMatrixFormat format,
+                                                  size_t outerSize);
+
     /***********************************************************************
      * Forward 1 mode
      **********************************************************************/
@@ -1218,11 +1884,244 @@ protected:
                                                          const std::string& function_sparsity,
                                                          const std::map<size_t, std::vector<size_t> >& elements);
 
+    /**
+     * Generates a function which calls another function according to a
+     * position argument.
+     *
+     * @param function the name of the function (without the model name)
+     * @param function2_suffix the suffix of the called functions which is
+     *                         followed by the position
+     * @param elements the valid positions (keys)
+     */
+    virtual void generateDispatchFunctionSource(const std::string& function,
+                                                const std::string& function2_suffix,
+                                                const std::map<size_t, std::vector<size_t> >& elements);
+
     /**
      * Loops
      */
     virtual void prepareSparseReverseTwoWithLoops(const std::map<size_t, std::vector<size_t> >& elements);
 
+    /**
+     * Generates the second order reverse mode functions of a single loop
+     * from its own operation graph.
+     * It can be called concurrently for different loops since it only
+     * modifies the provided objects.
+     *
+     * @param lModel the loop model
+     * @param info the Hessian information of the loop
+     * @param graph the operation graph of the loop
+     * @param groups saves the compressed locations of each Hessian row
+     *               group of the loop
+     * @param sources saves the generated source code
+     */
+    virtual void generateSparseReverseTwoLoopSources(LoopModel<Base>& lModel,
+                                                     loops::HessianWithLoopsInfo<Base>& info,
+                                                     loops::LoopReverseTwoGraph<Base>& graph,
+                                                     std::map<size_t, std::map<size_t, std::set<size_t> > >& groups,
+                                                     std::map<std::string, std::string>& sources);
+
+    /***********************************************************************
+     * Block lower triangular decomposition
+     **********************************************************************/
+
+    /**
+     * Determines the assignment of equations to unknowns and the block
+     * lower triangular decomposition (if not yet determined).
+     */
+    virtual void determineBlocks();
+
+    virtual void generateBlockSources();
+
+    virtual void generateBlockCountSource();
+
+    /**
+     * Generates a function for the dependent variables of a single block.
+     */
+    virtual void generateBlockFunctionSource(CodeHandler<Base>& handler,
+                                             ArrayView<CGBase> dep,
+                                             const std::string& functionName,
+                                             const std::string& depName,
+                                             const std::string& jobName);
+
+    /***********************************************************************
+     * Masked evaluation
+     **********************************************************************/
+
+    virtual void generateMaskedZeroSource();
+
+    virtual void generateMaskedSparseJacobianSource();
+
+    /**
+     * Groups the operations by the set of outputs which depend on them.
+     * There is also a group for each individual output where its values
+     * are assigned.
+     * Groups are sorted so that the groups which determine the arguments
+     * of an operation are always before the group of that operation.
+     *
+     * @param handler the handler which owns the operation graph
+     * @param dep the dependent variables
+     * @param depOutput the output of each dependent variable
+     * @param nOutputs the number of outputs
+     * @param nodes the operations used by the dependent variables
+     * @param nodeGroup the group of each operation (arrays and atomic
+     *                  function calls are not assigned to any group)
+     * @param groupOutputs the outputs of each group
+     * @param outputGroup the group where the values of each output are
+     *                    assigned
+     */
+    virtual void determineOutputGroups(CodeHandler<Base>& handler,
+                                       const std::vector<CGBase>& dep,
+                                       const std::vector<size_t>& depOutput,
+                                       size_t nOutputs,
+                                       std::vector<OperationNode<Base>*>& nodes,
+                                       CodeHandlerVector<Base, size_t>& nodeGroup,
+                                       std::vector<std::vector<size_t> >& groupOutputs,
+                                       std::vector<size_t>& outputGroup);
+
+    /**
+     * Generates a function for each group of operations and a function
+     * which receives a mask and only calls the functions of the groups
+     * with at least one requested output.
+     * Values used by other groups are passed through a local array.
+     *
+     * @param handler the handler which owns the operation graph
+     * @param indVars the independent variables
+     * @param dep the dependent variables
+     * @param depOutput the output of each dependent variable
+     * @param nOutputs the number of outputs (the mask size)
+     * @param function the name of the function (without the model name)
+     * @param depName the name of the output array
+     * @param jobName the job name
+     */
+    virtual void generateMaskedFunctionSource(CodeHandler<Base>& handler,
+                                              const std::vector<CGBase>& indVars,
+                                              std::vector<CGBase>& dep,
+                                              const std::vector<size_t>& depOutput,
+                                              size_t nOutputs,
+                                              const std::string& function,
+                                              const std::string& depName,
+                                              const std::string& jobName);
+
+    /**
+     * Whether or not an operation provides a single value which can be
+     * shared between the groups of a masked function.
+     * Arrays and atomic function calls are repeated in each group which
+     * uses them.
+     */
+    static inline bool isMaskedValueOperation(CGOpCode op) {
+        return op != CGOpCode::ArrayCreation && op != CGOpCode::SparseArrayCreation &&
+               op != CGOpCode::AtomicForward && op != CGOpCode::AtomicReverse;
+    }
+
+    /**
+     * Whether or not an operation can be copied into the graph of a group
+     * of a masked function.
+     */
+    static inline bool isMaskedSupportedOperation(CGOpCode op) {
+        switch (op) {
+            case CGOpCode::DependentMultiAssign:
+            case CGOpCode::DependentRefRhs:
+            case CGOpCode::IndexDeclaration:
+            case CGOpCode::Index:
+            case CGOpCode::IndexAssign:
+            case CGOpCode::LoopStart:
+            case CGOpCode::LoopIndexedIndep:
+            case CGOpCode::LoopIndexedDep:
+            case CGOpCode::LoopIndexedTmp:
+            case CGOpCode::LoopEnd:
+            case CGOpCode::TmpDcl:
+            case CGOpCode::Tmp:
+            case CGOpCode::IndexCondExpr:
+            case CGOpCode::StartIf:
+            case CGOpCode::ElseIf:
+            case CGOpCode::Else:
+            case CGOpCode::EndIf:
+            case CGOpCode::CondResult:
+            case CGOpCode::UserCustom:
+                return false;
+            default:
+                return true;
+        }
+    }
+
+    /***********************************************************************
+     * Directional products
+     **********************************************************************/
+
+    /**
+     * Generates the product of the Jacobian with k directions.
+     *
+     * @param k the number of directions (1 for the non-batch function)
+     */
+    virtual void generateJacobianVectorProductSource(size_t k);
+
+    /**
+     * Generates the product of the weighted sum of the Hessians with k
+     * directions.
+     *
+     * @param k the number of directions (1 for the non-batch function)
+     */
+    virtual void generateHessianVectorProductSource(size_t k);
+
+    virtual void generateDirectionalBatchSizeSource();
+
+    /***********************************************************************
+     * Variable ordering
+     **********************************************************************/
+
+    virtual void generateVariableOrderingSources();
+
+    /**
+     * Generates a function with the original variable numbering which
+     * calls a function that uses renumbered variables (with the suffix
+     * ORDERED_SUFFIX).
+     * The permuted values are stored in heap buffers.
+     *
+     * @param function the name of the function with the original numbering
+     * @param independent the original index of the independent variable in
+     *                    each new position
+     * @param dependent the original index of the dependent variable in each
+     *                  new position
+     */
+    virtual void generateOrderedWrapperSource(const std::string& function,
+                                              const std::vector<size_t>& independent,
+                                              const std::vector<size_t>& dependent);
+
+    /***********************************************************************
+     * Generation cache
+     **********************************************************************/
+
+    /**
+     * Generates the source code of a function or reuses the source code
+     * saved in the generation cache folder by a previous run for the same
+     * operation graph.
+     *
+     * @param handler the code handler which owns the operation graph
+     * @param langC the language used to create the function (must define
+     *              the function name and the sources map)
+     * @param dependent the dependent variables of the function
+     * @param nameGen the variable name generator
+     * @param jobName the name of the job used in the job timer
+     */
+    virtual void generateFunctionCode(CodeHandler<Base>& handler,
+                                      LanguageC<Base>& langC,
+                                      ArrayView<CGBase> dependent,
+                                      VariableNameGenerator<Base>& nameGen,
+                                      const std::string& jobName);
+
+    /**
+     * Creates a fingerprint for the source code of a function from its
+     * operation graph and the code generation options (64-bit FNV-1a hash).
+     *
+     * @return the fingerprint or an empty string if the generated source
+     *         code cannot be reused (e.g. it uses atomic functions)
+     */
+    virtual std::string createGenerationCacheKey(CodeHandler<Base>& handler,
+                                                 const std::string& function,
+                                                 ArrayView<CGBase> dependent,
+                                                 const std::string& jobName);
+
     /***********************************************************************
      * Sparsities
      **********************************************************************/
@@ -1233,6 +2132,29 @@ protected:
 
     virtual void determineHessianSparsity();
 
+    virtual void determineHessianSparsityCppAD();
+
+    virtual void determineHessianSparsityFromGraph();
+
+    inline bool isGraphSparsityEnabled() const {
+        return _graphSparsity && _loopTapes.empty();
+    }
+
+    /**
+     * Provides an object to determine sparsity patterns from the operation
+     * graph of the model (zero order).
+     * The operation graph is only created once.
+     */
+    virtual GraphSparsity<Base>& getGraphSparsity();
+
+    /**
+     * Releases the operation graph used to determine sparsity patterns.
+     */
+    inline void clearGraphSparsity() {
+        _sparsityGraph.reset();
+        _sparsityHandler.reset();
+    }
+
     /**
      * Determines groups of rows from a sparsity pattern which do not share
      * the same columns
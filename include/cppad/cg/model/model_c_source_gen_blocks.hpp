@@ -0,0 +1,251 @@
+#ifndef CPPAD_CG_MODEL_C_SOURCE_GEN_BLOCKS_INCLUDED
+#define CPPAD_CG_MODEL_C_SOURCE_GEN_BLOCKS_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+template<class Base>
+void ModelCSourceGen<Base>::determineBlocks() {
+    if (!_blockEquations.empty())
+        return; // already determined
+
+    const size_t m = _fun.Range();
+    const size_t n = _fun.Domain();
+
+    std::vector<size_t> unknowns = _blockUnknowns;
+    if (unknowns.empty()) {
+        unknowns.resize(n);
+        for (size_t j = 0; j < n; j++)
+            unknowns[j] = j;
+    }
+
+    CPPADCG_ASSERT_KNOWN(unknowns.size() == m,
+                         "The number of unknown variables must match the number of equations in the block decomposition")
+
+    std::vector<long> var2Unknown(n, -1);
+    for (size_t u = 0; u < unknowns.size(); u++) {
+        CPPADCG_ASSERT_KNOWN(unknowns[u] < n, "Invalid unknown variable index")
+        CPPADCG_ASSERT_KNOWN(var2Unknown[unknowns[u]] < 0, "Repeated unknown variable index")
+        var2Unknown[unknowns[u]] = u;
+    }
+
+    /**
+     * the structure of the equations relative to the unknowns
+     */
+    determineJacobianSparsity();
+
+    std::vector<std::vector<size_t> > eqVars(m);
+    for (size_t i = 0; i < m; i++) {
+        for (size_t j : _jacSparsity.sparsity[i]) {
+            if (var2Unknown[j] >= 0)
+                eqVars[i].push_back(var2Unknown[j]);
+        }
+    }
+
+    std::vector<long> eq2Var, var2Eq;
+    size_t matched = maximumMatching(eqVars, m, eq2Var, var2Eq);
+    if (matched < m) {
+        throw CGException("Unable to create the block decomposition of model '", _name, "': the system is structurally singular (only ",
+                          matched, " of ", m, " equations can be assigned to an unknown)");
+    }
+
+    _blockEquations = bltDecomposition(eqVars, var2Eq);
+
+    const size_t nBlocks = _blockEquations.size();
+    _blockVariables.resize(nBlocks);
+    _blockJacSparsity.resize(nBlocks);
+
+    // the block and the position inside the block of each unknown
+    std::vector<size_t> unknownBlock(m);
+    std::vector<size_t> unknownPos(m);
+
+    for (size_t b = 0; b < nBlocks; b++) {
+        const std::vector<size_t>& eqs = _blockEquations[b];
+        std::vector<size_t>& vars = _blockVariables[b];
+        vars.resize(eqs.size());
+        for (size_t k = 0; k < eqs.size(); k++) {
+            size_t u = eq2Var[eqs[k]];
+            vars[k] = unknowns[u];
+            unknownBlock[u] = b;
+            unknownPos[u] = k;
+        }
+    }
+
+    for (size_t b = 0; b < nBlocks; b++) {
+        const std::vector<size_t>& eqs = _blockEquations[b];
+        LocalSparsityInfo& jac = _blockJacSparsity[b];
+        jac.sparsity.resize(eqs.size());
+        for (size_t k = 0; k < eqs.size(); k++) {
+            for (size_t u : eqVars[eqs[k]]) {
+                if (unknownBlock[u] == b)
+                    jac.sparsity[k].insert(unknownPos[u]);
+            }
+            for (size_t pos : jac.sparsity[k]) {
+                jac.rows.push_back(k);
+                jac.cols.push_back(pos);
+            }
+        }
+    }
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateBlockSources() {
+    using std::vector;
+
+    determineBlocks();
+
+    const size_t m = _fun.Range();
+    const size_t n = _fun.Domain();
+    const size_t nBlocks = _blockEquations.size();
+
+    const std::string jobName = "model block decomposition";
+
+    startingJob("'" + jobName + "'", JobTimer::GRAPH);
+
+    CodeHandler<Base> handler;
+    handler.setJobTimer(_jobTimer);
+    handler.setGraphRewriter(_graphRewriter);
+    handler.setScheduleOperations(_scheduleOperations);
+
+    vector<CGBase> indVars(n);
+    handler.makeVariables(indVars);
+    if (_x.size() > 0) {
+        for (size_t i = 0; i < n; i++) {
+            indVars[i].setValue(_x[i]);
+        }
+    }
+
+    vector<CGBase> res = _fun.Forward(0, indVars);
+
+    /**
+     * the Jacobian elements of all blocks (ordered by block)
+     */
+    vector<size_t> rows, cols;
+    vector<size_t> jacStart(nBlocks + 1, 0);
+    SparsitySetType sparsity(m);
+    for (size_t b = 0; b < nBlocks; b++) {
+        const LocalSparsityInfo& jacb = _blockJacSparsity[b];
+        for (size_t e = 0; e < jacb.rows.size(); e++) {
+            size_t i = _blockEquations[b][jacb.rows[e]];
+            size_t j = _blockVariables[b][jacb.cols[e]];
+            rows.push_back(i);
+            cols.push_back(j);
+            sparsity[i].insert(j);
+        }
+        jacStart[b + 1] = rows.size();
+    }
+
+    vector<CGBase> jac(rows.size());
+    CppAD::sparse_jacobian_work work;
+    if (estimateBestJacobianADMode(rows, cols)) {
+        _fun.SparseJacobianForward(indVars, sparsity, rows, cols, jac, work);
+    } else {
+        _fun.SparseJacobianReverse(indVars, sparsity, rows, cols, jac, work);
+    }
+
+    finishedJob();
+
+    /**
+     * a residual and a Jacobian function for each block
+     */
+    std::map<size_t, vector<size_t> > equations;
+    std::map<size_t, vector<size_t> > variables;
+
+    const std::string resFunction = _name + "_" + FUNCTION_BLOCK_RESIDUAL + "_block";
+    const std::string jacFunction = _name + "_" + FUNCTION_BLOCK_JACOBIAN + "_block";
+
+    vector<CGBase> resBlock;
+    for (size_t b = 0; b < nBlocks; b++) {
+        const vector<size_t>& eqs = _blockEquations[b];
+
+        resBlock.resize(eqs.size());
+        for (size_t k = 0; k < eqs.size(); k++) {
+            resBlock[k] = res[eqs[k]];
+        }
+        generateBlockFunctionSource(handler, ArrayView<CGBase>(resBlock), resFunction + std::to_string(b), "res",
+                                    jobName + " residual " + std::to_string(b));
+
+        ArrayView<CGBase> jacBlock(jac.data() + jacStart[b], jacStart[b + 1] - jacStart[b]);
+        generateBlockFunctionSource(handler, jacBlock, jacFunction + std::to_string(b), "jac",
+                                    jobName + " Jacobian " + std::to_string(b));
+
+        equations[b] = eqs;
+        variables[b] = _blockVariables[b];
+    }
+
+    /**
+     * functions which select the block
+     */
+    generateDispatchFunctionSource(FUNCTION_BLOCK_RESIDUAL, "block", equations);
+    generateDispatchFunctionSource(FUNCTION_BLOCK_JACOBIAN, "block", variables);
+
+    /**
+     * block structure
+     */
+    generateBlockCountSource();
+
+    generateSparsity1DSource2(_name + "_" + FUNCTION_BLOCK_EQUATIONS, equations);
+    _sources[_name + "_" + FUNCTION_BLOCK_EQUATIONS + ".c"] = _cache.str();
+    _cache.str("");
+
+    generateSparsity1DSource2(_name + "_" + FUNCTION_BLOCK_VARIABLES, variables);
+    _sources[_name + "_" + FUNCTION_BLOCK_VARIABLES + ".c"] = _cache.str();
+    _cache.str("");
+
+    generateSparsity2DSource2(_name + "_" + FUNCTION_BLOCK_JACOBIAN_SPARSITY, _blockJacSparsity);
+    _sources[_name + "_" + FUNCTION_BLOCK_JACOBIAN_SPARSITY + ".c"] = _cache.str();
+    _cache.str("");
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateBlockFunctionSource(CodeHandler<Base>& handler,
+                                                        ArrayView<CGBase> dep,
+                                                        const std::string& functionName,
+                                                        const std::string& depName,
+                                                        const std::string& jobName) {
+    LanguageC<Base> langC(_baseTypeName);
+    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+    langC.setParameterPrecision(_parameterPrecision);
+    langC.setProfiling(_profiling);
+    langC.setLoopVectorization(_loopVectorization);
+    langC.setGenerateFunction(functionName);
+
+    std::ostringstream code;
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator(depName));
+
+    handler.generateCode(code, langC, dep, *nameGen, _atomicFunctions, jobName);
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateBlockCountSource() {
+    std::string funcName = _name + "_" + FUNCTION_BLOCK_COUNT;
+
+    _cache.str("");
+    LanguageC<Base>::printFunctionDeclaration(_cache, "void", funcName, {"unsigned long* n"});
+    _cache << " {\n"
+            "   *n = " << _blockEquations.size() << ";\n"
+            "}\n";
+
+    _sources[funcName + ".c"] = _cache.str();
+    _cache.str("");
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,239 @@
+#ifndef CPPAD_CG_MODEL_C_SOURCE_GEN_CACHE_INCLUDED
+#define CPPAD_CG_MODEL_C_SOURCE_GEN_CACHE_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+template<class Base>
+void ModelCSourceGen<Base>::generateFunctionCode(CodeHandler<Base>& handler,
+                                                 LanguageC<Base>& langC,
+                                                 ArrayView<CGBase> dependent,
+                                                 VariableNameGenerator<Base>& nameGen,
+                                                 const std::string& jobName) {
+    const std::string& function = langC.getGenerateFunction();
+
+    std::string cacheFile;
+    if (!_generationCacheFolder.empty()) {
+        std::string key = createGenerationCacheKey(handler, function, dependent, jobName);
+        if (!key.empty()) {
+            cacheFile = system::createPath(_generationCacheFolder, key + ".csrc");
+        }
+    }
+
+    /**
+     * files created for this function: <function>.c and <function>__<k>.c
+     */
+    auto isFunctionFile = [&function](const std::string& file) {
+        if (file.compare(0, function.size(), function) != 0)
+            return false;
+        std::string suffix = file.substr(function.size());
+        return suffix == ".c" || suffix.compare(0, 2, "__") == 0;
+    };
+
+    if (!cacheFile.empty() && system::isFile(cacheFile)) {
+        std::ifstream in(cacheFile, std::ios::binary);
+        std::map<std::string, std::string> files;
+        bool valid = true;
+        size_t nameSize, contentSize;
+        while (in >> nameSize >> contentSize) {
+            std::string name(nameSize, ' ');
+            std::string content(contentSize, ' ');
+            in.get(); // new line
+            in.read(&name[0], nameSize);
+            in.read(&content[0], contentSize);
+            if (!in || !isFunctionFile(name)) {
+                valid = false;
+                break;
+            }
+            files[name] = std::move(content);
+        }
+
+        if (valid && in.eof() && files.count(function + ".c") != 0) {
+            startingJob("'" + jobName + "' (reused)", JobTimer::SOURCE_GENERATION);
+            for (auto& it : files) {
+                _sources[it.first] = std::move(it.second);
+            }
+            finishedJob();
+            return;
+        }
+        // an incomplete or invalid file is replaced
+    }
+
+    std::ostringstream code;
+    handler.generateCode(code, langC, dependent, nameGen, _atomicFunctions, jobName);
+
+    if (cacheFile.empty())
+        return;
+
+    system::createFolder(_generationCacheFolder);
+
+    // other processes must never find incomplete files in the cache
+    std::string partFile = system::createUniqueFile(cacheFile + ".part");
+    {
+        std::ofstream out(partFile, std::ios::binary);
+        for (auto it = _sources.lower_bound(function); it != _sources.end() && it->first.compare(0, function.size(), function) == 0; ++it) {
+            if (isFunctionFile(it->first)) {
+                out << it->first.size() << " " << it->second.size() << "\n" << it->first << it->second;
+            }
+        }
+        if (!out) {
+            out.close();
+            std::remove(partFile.c_str());
+            return;
+        }
+    }
+    if (std::rename(partFile.c_str(), cacheFile.c_str()) != 0) {
+        std::remove(partFile.c_str());
+    }
+}
+
+template<class Base>
+std::string ModelCSourceGen<Base>::createGenerationCacheKey(CodeHandler<Base>& handler,
+                                                            const std::string& function,
+                                                            ArrayView<CGBase> dependent,
+                                                            const std::string& jobName) {
+    if (!_loopTapes.empty() || _graphRewriter != nullptr)
+        return ""; // the generated code does not depend only on the graph
+
+    uint64_t hash = 14695981039346656037ull;
+    auto addBytes = [&hash](const char* bytes, size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            hash ^= (unsigned char) bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    auto add = [&addBytes](size_t value) {
+        uint64_t v = value;
+        addBytes(reinterpret_cast<const char*>(&v), sizeof(v));
+    };
+    auto addString = [&add, &addBytes](const std::string& str) {
+        add(str.size());
+        addBytes(str.data(), str.size());
+    };
+    std::ostringstream valueStream;
+    valueStream << std::setprecision(std::numeric_limits<Base>::max_digits10);
+    auto addValue = [&addString, &valueStream](const Base& value) {
+        valueStream.str("");
+        valueStream << value;
+        addString(valueStream.str());
+    };
+
+    /**
+     * code generation options
+     */
+    addString("cppadcg-c-source-1");
+    addString(function);
+    addString(jobName);
+    addString(_baseTypeName);
+    add(_parameterPrecision);
+    add(_maxAssignPerFunc);
+    add(_maxOperationsPerAssignment);
+    add(_profiling);
+    add(_loopVectorization);
+    add(_scheduleOperations);
+    add(handler.getIndependentVariableSize());
+
+    /**
+     * operation graph (each node is identified by its position in a
+     * depth-first post-order traversal)
+     */
+    CodeHandlerVector<Base, size_t> ids(handler);
+    ids.adjustSize();
+    ids.fill(0);
+
+    // independent variables are created in order
+    CodeHandlerVector<Base, size_t> independent(handler);
+    independent.adjustSize();
+    size_t nInd = 0;
+    for (OperationNode<Base>* node : handler.getManagedNodes()) {
+        if (node != nullptr && node->getOperationType() == CGOpCode::Inv) {
+            independent[*node] = nInd++;
+        }
+    }
+
+    size_t lastId = 0;
+    std::vector<std::pair<OperationNode<Base>*, size_t> > stack;
+
+    for (const CGBase& dep : dependent) {
+        if (!dep.isVariable()) {
+            add(0);
+            addValue(dep.getValue());
+            continue;
+        }
+
+        OperationNode<Base>* root = dep.getOperationNode();
+        if (ids[*root] == 0) {
+            stack.emplace_back(root, 0);
+        }
+
+        while (!stack.empty()) {
+            OperationNode<Base>* node = stack.back().first;
+            size_t& a = stack.back().second;
+            const std::vector<Argument<Base> >& args = node->getArguments();
+
+            // visit the arguments first
+            while (a < args.size() && (args[a].getOperation() == nullptr || ids[*args[a].getOperation()] != 0)) {
+                a++;
+            }
+            if (a < args.size()) {
+                stack.emplace_back(args[a].getOperation(), 0);
+                continue;
+            }
+
+            CGOpCode op = node->getOperationType();
+            if (op == CGOpCode::AtomicForward || op == CGOpCode::AtomicReverse) {
+                return ""; // atomic functions must be registered by the code generation
+            }
+
+            add(size_t(op));
+            add(node->getInfo().size());
+            for (size_t i : node->getInfo())
+                add(i);
+            if (node->getName() != nullptr) {
+                addString(*node->getName());
+            } else {
+                add(0);
+            }
+            if (op == CGOpCode::Inv) {
+                add(independent[*node]);
+            }
+            add(args.size());
+            for (const Argument<Base>& arg : args) {
+                if (arg.getOperation() != nullptr) {
+                    add(ids[*arg.getOperation()]);
+                } else {
+                    add(0);
+                    addValue(*arg.getParameter());
+                }
+            }
+
+            ids[*node] = ++lastId;
+            stack.pop_back();
+        }
+
+        add(ids[*root]);
+    }
+
+    std::ostringstream key;
+    key << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return key.str();
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,180 @@
+#ifndef CPPAD_CG_MODEL_C_SOURCE_GEN_DIRECTIONAL_INCLUDED
+#define CPPAD_CG_MODEL_C_SOURCE_GEN_DIRECTIONAL_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+template<class Base>
+void ModelCSourceGen<Base>::generateJacobianVectorProductSource(size_t k) {
+    using std::vector;
+
+    CPPADCG_ASSERT_UNKNOWN(k > 0)
+
+    const std::string function = k == 1 ? FUNCTION_JACOBIAN_VECTOR_PRODUCT : FUNCTION_JACOBIAN_VECTOR_PRODUCT_BATCH;
+    const std::string jobName = k == 1 ? "Jacobian-vector product" : "Jacobian-vector product (batch)";
+
+    const size_t m = _fun.Range();
+    const size_t n = _fun.Domain();
+
+    startingJob("'" + jobName + "'", JobTimer::GRAPH);
+
+    CodeHandler<Base> handler;
+    handler.setJobTimer(_jobTimer);
+    handler.setGraphRewriter(_graphRewriter);
+    handler.setScheduleOperations(_scheduleOperations);
+
+    // independent variables
+    vector<CGBase> indVars(n);
+    handler.makeVariables(indVars);
+    if (_x.size() > 0) {
+        for (size_t j = 0; j < n; j++) {
+            indVars[j].setValue(_x[j]);
+        }
+    }
+
+    // directions (column-major: one direction after the other)
+    vector<CGBase> v(n * k);
+    handler.makeVariables(v);
+    if (_x.size() > 0) {
+        for (size_t j = 0; j < n * k; j++) {
+            v[j].setValue(Base(1.0));
+        }
+    }
+
+    // the zero order values are shared by all directions
+    _fun.Forward(0, indVars);
+
+    vector<CGBase> jv(m * k);
+    vector<CGBase> tx1(n);
+    for (size_t d = 0; d < k; d++) {
+        std::copy(v.begin() + d * n, v.begin() + (d + 1) * n, tx1.begin());
+        vector<CGBase> ty1 = _fun.Forward(1, tx1);
+        std::copy(ty1.begin(), ty1.end(), jv.begin() + d * m);
+    }
+
+    finishedJob();
+
+    LanguageC<Base> langC(_baseTypeName);
+    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+    langC.setParameterPrecision(_parameterPrecision);
+    langC.setProfiling(_profiling);
+    langC.setLoopVectorization(_loopVectorization);
+    langC.setGenerateFunction(_name + "_" + function);
+
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("jv"));
+    LangCDefaultHessianVarNameGenerator<Base> nameGenDir(nameGen.get(), "dir", n);
+
+    generateFunctionCode(handler, langC, jv, nameGenDir, jobName);
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateHessianVectorProductSource(size_t k) {
+    using std::vector;
+
+    CPPADCG_ASSERT_UNKNOWN(k > 0)
+
+    const std::string function = k == 1 ? FUNCTION_HESSIAN_VECTOR_PRODUCT : FUNCTION_HESSIAN_VECTOR_PRODUCT_BATCH;
+    const std::string jobName = k == 1 ? "Hessian-vector product" : "Hessian-vector product (batch)";
+
+    const size_t m = _fun.Range();
+    const size_t n = _fun.Domain();
+
+    startingJob("'" + jobName + "'", JobTimer::GRAPH);
+
+    CodeHandler<Base> handler;
+    handler.setJobTimer(_jobTimer);
+    handler.setGraphRewriter(_graphRewriter);
+    handler.setScheduleOperations(_scheduleOperations);
+
+    // independent variables
+    vector<CGBase> indVars(n);
+    handler.makeVariables(indVars);
+    if (_x.size() > 0) {
+        for (size_t j = 0; j < n; j++) {
+            indVars[j].setValue(_x[j]);
+        }
+    }
+
+    // multipliers
+    vector<CGBase> w(m);
+    handler.makeVariables(w);
+    if (_x.size() > 0) {
+        for (size_t i = 0; i < m; i++) {
+            w[i].setValue(Base(1.0));
+        }
+    }
+
+    // directions (column-major: one direction after the other)
+    vector<CGBase> v(n * k);
+    handler.makeVariables(v);
+    if (_x.size() > 0) {
+        for (size_t j = 0; j < n * k; j++) {
+            v[j].setValue(Base(1.0));
+        }
+    }
+
+    // the zero order values are shared by all directions
+    _fun.Forward(0, indVars);
+
+    vector<CGBase> hv(n * k);
+    vector<CGBase> tx1(n);
+    for (size_t d = 0; d < k; d++) {
+        std::copy(v.begin() + d * n, v.begin() + (d + 1) * n, tx1.begin());
+        _fun.Forward(1, tx1);
+        vector<CGBase> px = _fun.Reverse(2, w);
+        CPPADCG_ASSERT_UNKNOWN(px.size() == 2 * n);
+
+        for (size_t j = 0; j < n; j++) {
+            hv[d * n + j] = px[j * 2 + 1]; // not interested in the first order values
+        }
+    }
+
+    finishedJob();
+
+    LanguageC<Base> langC(_baseTypeName);
+    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+    langC.setParameterPrecision(_parameterPrecision);
+    langC.setProfiling(_profiling);
+    langC.setLoopVectorization(_loopVectorization);
+    langC.setGenerateFunction(_name + "_" + function);
+
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("hv"));
+    LangCDefaultReverse2VarNameGenerator<Base> nameGenDir(nameGen.get(), n, "w", m, "dir");
+
+    generateFunctionCode(handler, langC, hv, nameGenDir, jobName);
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateDirectionalBatchSizeSource() {
+    std::string funcName = _name + "_" + FUNCTION_DIRECTIONAL_BATCH_SIZE;
+
+    _cache.str("");
+    LanguageC<Base>::printFunctionDeclaration(_cache, "void", funcName, {"unsigned long* k"});
+    _cache << " {\n"
+            "   *k = " << _directionalBatchSize << ";\n"
+            "}\n";
+
+    _sources[funcName + ".c"] = _cache.str();
+    _cache.str("");
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -19,16 +19,38 @@ namespace CppAD {
 namespace cg {
 
 template<class Base>
-void ModelCSourceGen<Base>::generateZeroSource() {
+void ModelCSourceGen<Base>::generateZeroSource(MultiThreadingType multiThreadingType) {
     const std::string jobName = "model (zero-order forward)";
 
     startingJob("'" + jobName + "'", JobTimer::GRAPH);
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setGraphRewriter(_graphRewriter);
+    handler.setScheduleOperations(_scheduleOperations);
+
+    const bool parallel = isParallelTasksEnabled() && multiThreadingType != MultiThreadingType::NONE;
+
+    /**
+     * the variables are renumbered according to the variable ordering
+     * (not used with loops and parallel tasks which index the original arrays)
+     */
+    const bool ordered = _variableOrdering && _loopTapes.empty() && !parallel;
+    std::vector<size_t> indOrder, depOrder;
+    if (ordered) {
+        getVariableOrdering(indOrder, depOrder);
+    }
 
     std::vector<CGBase> indVars(_fun.Domain());
-    handler.makeVariables(indVars);
+    if (ordered) {
+        std::vector<CGBase> xOrdered(indVars.size());
+        handler.makeVariables(xOrdered);
+        for (size_t k = 0; k < indOrder.size(); k++) {
+            indVars[indOrder[k]] = xOrdered[k];
+        }
+    } else {
+        handler.makeVariables(indVars);
+    }
     if (_x.size() > 0) {
         for (size_t i = 0; i < indVars.size(); i++) {
             indVars[i].setValue(_x[i]);
@@ -37,7 +59,13 @@ void ModelCSourceGen<Base>::generateZeroSource() {
 
     std::vector<CGBase> dep;
 
-    if (_loopTapes.empty()) {
+    if (ordered) {
+        std::vector<CGBase> depOriginal = _fun.Forward(0, indVars);
+        dep.resize(depOriginal.size());
+        for (size_t k = 0; k < depOrder.size(); k++) {
+            dep[k] = depOriginal[depOrder[k]];
+        }
+    } else if (_loopTapes.empty()) {
         dep = _fun.Forward(0, indVars);
     } else {
         /**
@@ -48,16 +76,30 @@ void ModelCSourceGen<Base>::generateZeroSource() {
 
     finishedJob();
 
+    if (parallel) {
+        generateParallelTasksSource(handler, dep, _name + "_" + FUNCTION_FORWAD_ZERO, "y", jobName, multiThreadingType);
+        return;
+    }
+
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
-    langC.setGenerateFunction(_name + "_" + FUNCTION_FORWAD_ZERO);
+    langC.setProfiling(_profiling);
+    langC.setLoopVectorization(_loopVectorization);
+    if (ordered) {
+        langC.setGenerateFunction(_name + "_" + FUNCTION_FORWAD_ZERO + ORDERED_SUFFIX);
+    } else {
+        langC.setGenerateFunction(_name + "_" + FUNCTION_FORWAD_ZERO);
+    }
 
-    std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator());
 
-    handler.generateCode(code, langC, dep, *nameGen, _atomicFunctions, jobName);
+    generateFunctionCode(handler, langC, dep, *nameGen, jobName);
+
+    if (ordered) {
+        generateOrderedWrapperSource(_name + "_" + FUNCTION_FORWAD_ZERO, indOrder, depOrder);
+    }
 }
 
 
@@ -84,6 +84,8 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesWithAtomics(const std
 
         CodeHandler<Base> handler;
         handler.setJobTimer(_jobTimer);
+        handler.setGraphRewriter(_graphRewriter);
+        handler.setScheduleOperations(_scheduleOperations);
 
         vector<CGBase> indVars(n);
         handler.makeVariables(indVars);
@@ -117,15 +119,16 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesWithAtomics(const std
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setProfiling(_profiling);
+        langC.setLoopVectorization(_loopVectorization);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
 
-        std::ostringstream code;
         std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dy"));
         LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dx", n);
 
-        handler.generateCode(code, langC, dyCustom, nameGenHess, _atomicFunctions, subJobName);
+        generateFunctionCode(handler, langC, dyCustom, nameGenHess, subJobName);
     }
 }
 
@@ -140,6 +143,8 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesNoAtomics(const std::
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setGraphRewriter(_graphRewriter);
+    handler.setScheduleOperations(_scheduleOperations);
 
     vector<CGBase> x(n);
     handler.makeVariables(x);
@@ -204,15 +209,16 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesNoAtomics(const std::
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setProfiling(_profiling);
+        langC.setLoopVectorization(_loopVectorization);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
 
-        std::ostringstream code;
         std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dy"));
         LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dx", n);
 
-        handler.generateCode(code, langC, dyCustom, nameGenHess, _atomicFunctions, subJobName);
+        generateFunctionCode(handler, langC, dyCustom, nameGenHess, subJobName);
     }
 }
 
@@ -230,6 +236,10 @@ void ModelCSourceGen<Base>::generateForwardOneSources() {
     std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
     std::string args = langC.generateDefaultFunctionArguments();
 
+    // the contributions of each direction can be summed with a different type
+    bool mixed = isMixedPrecision();
+    std::string sum = mixed ? "acc[pos[ePos]]" : "ty[pos[ePos] * 2 + 1]";
+
     _cache.str("");
     _cache << "#include <stdlib.h>\n"
             << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
@@ -249,8 +259,11 @@ void ModelCSourceGen<Base>::generateForwardOneSources() {
             "   " << _baseTypeName << " const * in[2];\n"
             "   " << _baseTypeName << "* out[1];\n"
             "   " << _baseTypeName << " x[" << n << "];\n"
-            "   " << _baseTypeName << "* compressed;\n"
-            "   int ret;\n"
+            "   " << _baseTypeName << "* compressed;\n";
+    if (mixed) {
+        _cache << "   " << _accumulationTypeName << "* acc;\n";
+    }
+    _cache << "   int ret;\n"
             "\n"
             "   txPos = 0;\n"
             "   nnzTx = 0;\n"
@@ -282,8 +295,11 @@ void ModelCSourceGen<Base>::generateForwardOneSources() {
             "      return 0; //nothing to do\n"
             "   }\n"
             "\n"
-            "   compressed = (" << _baseTypeName << "*) malloc(nnzMax * sizeof(" << _baseTypeName << "));\n"
-            "\n"
+            "   compressed = (" << _baseTypeName << "*) malloc(nnzMax * sizeof(" << _baseTypeName << "));\n";
+    if (mixed) {
+        _cache << "   acc = (" << _accumulationTypeName << "*) calloc(" << m << ", sizeof(" << _accumulationTypeName << "));\n";
+    }
+    _cache << "\n"
             "   for (j = 0; j < " << n << "; j++)\n"
             "      x[j] = tx[j * 2];\n"
             "\n"
@@ -304,15 +320,22 @@ void ModelCSourceGen<Base>::generateForwardOneSources() {
             "      if (ret != 0) {\n"
             "         free(compressed);\n"
             "         free(txPos);\n"
+            << (mixed ? "         free(acc);\n" : "") <<
             "         return ret;\n"
             "      }\n"
             "\n"
             "      for (ePos = 0; ePos < nnz; ePos++) {\n"
-            "         ty[pos[ePos] * 2 + 1] += compressed[ePos];\n"
+            "         " << sum << " += compressed[ePos];\n"
             "      }\n"
             "\n"
-            "   }\n"
-            "   free(compressed);\n"
+            "   }\n";
+    if (mixed) {
+        _cache << "   for (i = 0; i < " << m << "; i++) {\n"
+                "      ty[i * 2 + 1] = acc[i];\n"
+                "   }\n"
+                "   free(acc);\n";
+    }
+    _cache << "   free(compressed);\n"
             "   free(txPos);\n"
             "   return 0;\n"
             "}\n";
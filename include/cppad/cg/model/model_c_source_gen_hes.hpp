@@ -28,6 +28,8 @@ void ModelCSourceGen<Base>::generateHessianSource() {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setGraphRewriter(_graphRewriter);
+    handler.setScheduleOperations(_scheduleOperations);
 
     size_t m = _fun.Range();
     size_t n = _fun.Domain();
@@ -66,13 +68,14 @@ void ModelCSourceGen<Base>::generateHessianSource() {
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setProfiling(_profiling);
+    langC.setLoopVectorization(_loopVectorization);
     langC.setGenerateFunction(_name + "_" + FUNCTION_HESSIAN);
 
-    std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("hess"));
     LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), n);
 
-    handler.generateCode(code, langC, hess, nameGenHess, _atomicFunctions, jobName);
+    generateFunctionCode(handler, langC, hess, nameGenHess, jobName);
 }
 
 template<class Base>
@@ -162,6 +165,8 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setGraphRewriter(_graphRewriter);
+    handler.setScheduleOperations(_scheduleOperations);
 
     // independent variables
     vector<CGBase> indVars(n);
@@ -214,13 +219,14 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setProfiling(_profiling);
+    langC.setLoopVectorization(_loopVectorization);
     langC.setGenerateFunction(_name + "_" + FUNCTION_SPARSE_HESSIAN);
 
-    std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("hess"));
     LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), n);
 
-    handler.generateCode(code, langC, hess, nameGenHess, _atomicFunctions, jobName);
+    generateFunctionCode(handler, langC, hess, nameGenHess, jobName);
 }
 
 template<class Base>
@@ -546,6 +552,51 @@ void ModelCSourceGen<Base>::determineHessianSparsity() {
         return;
     }
 
+    if (isGraphSparsityEnabled()) {
+        determineHessianSparsityFromGraph();
+    } else {
+        determineHessianSparsityCppAD();
+    }
+
+    if (_hessianByEquation || _reverseTwo) {
+        size_t m = _fun.Range();
+
+        for (size_t i = 0; i < m; i++) {
+            LocalSparsityInfo& hessSparsitiesi = _hessSparsities[i];
+
+            if (!_custom_hess.defined) {
+                generateSparsityIndexes(hessSparsitiesi.sparsity,
+                                        hessSparsitiesi.rows, hessSparsitiesi.cols);
+
+            } else {
+                size_t nnz = _custom_hess.row.size();
+                for (size_t e = 0; e < nnz; e++) {
+                    size_t i1 = _custom_hess.row[e];
+                    size_t i2 = _custom_hess.col[e];
+                    if (hessSparsitiesi.sparsity[i1].find(i2) != hessSparsitiesi.sparsity[i1].end()) {
+                        hessSparsitiesi.rows.push_back(i1);
+                        hessSparsitiesi.cols.push_back(i2);
+                    }
+                }
+            }
+        }
+
+    }
+
+    if (!_custom_hess.defined) {
+        generateSparsityIndexes(_hessSparsity.sparsity,
+                                _hessSparsity.rows, _hessSparsity.cols);
+
+    } else {
+        _hessSparsity.rows = _custom_hess.row;
+        _hessSparsity.cols = _custom_hess.col;
+    }
+
+    sortSparsityIndexes(_hessFormat, _hessSparsity.rows, _hessSparsity.cols);
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::determineHessianSparsityCppAD() {
     size_t m = _fun.Range();
     size_t n = _fun.Domain();
 
@@ -626,36 +677,23 @@ void ModelCSourceGen<Base>::determineHessianSparsity() {
             }
 
         }
+    }
+}
 
-        for (size_t i = 0; i < m; i++) {
-            LocalSparsityInfo& hessSparsitiesi = _hessSparsities[i];
-
-            if (!_custom_hess.defined) {
-                generateSparsityIndexes(hessSparsitiesi.sparsity,
-                                        hessSparsitiesi.rows, hessSparsitiesi.cols);
-
-            } else {
-                size_t nnz = _custom_hess.row.size();
-                for (size_t e = 0; e < nnz; e++) {
-                    size_t i1 = _custom_hess.row[e];
-                    size_t i2 = _custom_hess.col[e];
-                    if (hessSparsitiesi.sparsity[i1].find(i2) != hessSparsitiesi.sparsity[i1].end()) {
-                        hessSparsitiesi.rows.push_back(i1);
-                        hessSparsitiesi.cols.push_back(i2);
-                    }
-                }
-            }
-        }
+template<class Base>
+void ModelCSourceGen<Base>::determineHessianSparsityFromGraph() {
+    GraphSparsity<Base>& graph = getGraphSparsity();
 
-    }
+    _hessSparsity.sparsity = graph.hessianSparsity();
 
-    if (!_custom_hess.defined) {
-        generateSparsityIndexes(_hessSparsity.sparsity,
-                                _hessSparsity.rows, _hessSparsity.cols);
+    if (_hessianByEquation || _reverseTwo) {
+        std::vector<SparsitySetType> sparsities = graph.hessianSparsityByEquation();
 
-    } else {
-        _hessSparsity.rows = _custom_hess.row;
-        _hessSparsity.cols = _custom_hess.col;
+        size_t m = sparsities.size();
+        _hessSparsities.resize(m);
+        for (size_t i = 0; i < m; i++) {
+            _hessSparsities[i].sparsity.swap(sparsities[i]);
+        }
     }
 }
 
@@ -667,6 +705,12 @@ void ModelCSourceGen<Base>::generateHessianSparsitySource() {
     _sources[_name + "_" + FUNCTION_HESSIAN_SPARSITY + ".c"] = _cache.str();
     _cache.str("");
 
+    if (_hessFormat != SparseMatrixFormat::Coordinate) {
+        generateSparsityCompressedSource(_name + "_" + FUNCTION_HESSIAN_SPARSITY_COMPRESSED, _hessSparsity, _hessFormat, _fun.Domain());
+        _sources[_name + "_" + FUNCTION_HESSIAN_SPARSITY_COMPRESSED + ".c"] = _cache.str();
+        _cache.str("");
+    }
+
     if (_hessianByEquation || _reverseTwo) {
         generateSparsity2DSource2(_name + "_" + FUNCTION_HESSIAN_SPARSITY2, _hessSparsities);
         _sources[_name + "_" + FUNCTION_HESSIAN_SPARSITY2 + ".c"] = _cache.str();
@@ -53,6 +53,12 @@ const std::string ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY = "hessian_sp
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY2 = "hessian_sparsity2";
 
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_JACOBIAN_SPARSITY_COMPRESSED = "jacobian_sparsity_compressed";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY_COMPRESSED = "hessian_sparsity_compressed";
+
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_SPARSE_FORWARD_ONE = "sparse_forward_one";
 
@@ -77,6 +83,54 @@ const std::string ModelCSourceGen<Base>::FUNCTION_INFO = "info";
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_ATOMIC_FUNC_NAMES = "atomic_functions";
 
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_BLOCK_COUNT = "block_count";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_BLOCK_EQUATIONS = "block_equations";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_BLOCK_VARIABLES = "block_variables";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_BLOCK_RESIDUAL = "block_residual";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_BLOCK_JACOBIAN = "block_jacobian";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_BLOCK_JACOBIAN_SPARSITY = "block_jacobian_sparsity";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_FORWARD_ZERO_MASKED = "forward_zero_masked";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_SPARSE_JACOBIAN_MASKED = "sparse_jacobian_masked";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_JACOBIAN_VECTOR_PRODUCT = "jacobian_vector_product";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_HESSIAN_VECTOR_PRODUCT = "hessian_vector_product";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_JACOBIAN_VECTOR_PRODUCT_BATCH = "jacobian_vector_product_batch";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_HESSIAN_VECTOR_PRODUCT_BATCH = "hessian_vector_product_batch";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_DIRECTIONAL_BATCH_SIZE = "directional_batch_size";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_INDEPENDENT_ORDER = "independent_order";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_DEPENDENT_ORDER = "dependent_order";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::ORDERED_SUFFIX = "_ordered";
+
 template<class Base>
 const std::string ModelCSourceGen<Base>::CONST = "const";
 
@@ -107,12 +161,12 @@ void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingTyp
     startingJob("'" + _name + "'", JobTimer::SOURCE_FOR_MODEL);
 
     if (_zero) {
-        generateZeroSource();
+        generateZeroSource(multiThreadingType);
         _zeroEvaluated = true;
     }
 
     if (_jacobian) {
-        generateJacobianSource();
+        generateJacobianSource(multiThreadingType);
     }
 
     if (_hessian) {
@@ -142,7 +196,31 @@ void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingTyp
         generateSparseHessianSource(multiThreadingType);
     }
 
-    if (_sparseJacobian || _forwardOne || _reverseOne) {
+    if (_maskedForwardZero) {
+        generateMaskedZeroSource();
+    }
+
+    if (_maskedSparseJacobian) {
+        generateMaskedSparseJacobianSource();
+    }
+
+    if (_jacobianVectorProduct) {
+        generateJacobianVectorProductSource(1);
+        if (_directionalBatchSize > 1)
+            generateJacobianVectorProductSource(_directionalBatchSize);
+    }
+
+    if (_hessianVectorProduct) {
+        generateHessianVectorProductSource(1);
+        if (_directionalBatchSize > 1)
+            generateHessianVectorProductSource(_directionalBatchSize);
+    }
+
+    if ((_jacobianVectorProduct || _hessianVectorProduct) && _directionalBatchSize > 1) {
+        generateDirectionalBatchSizeSource();
+    }
+
+    if (_sparseJacobian || _forwardOne || _reverseOne || _maskedSparseJacobian) {
         generateJacobianSparsitySource();
     }
 
@@ -150,10 +228,21 @@ void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingTyp
         generateHessianSparsitySource();
     }
 
+    if (_blockDecomposition) {
+        generateBlockSources();
+    }
+
+    if (_variableOrdering) {
+        generateVariableOrderingSources();
+    }
+
     generateInfoSource();
 
     generateAtomicFuncNames();
 
+    // the sparsity patterns have already been determined
+    clearGraphSparsity();
+
     finishedJob();
 }
 
@@ -167,6 +256,8 @@ void ModelCSourceGen<Base>::generateLoops() {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setGraphRewriter(_graphRewriter);
+    handler.setScheduleOperations(_scheduleOperations);
 
     std::vector<CGBase> xx(_fun.Domain());
     handler.makeVariables(xx);
@@ -188,6 +279,55 @@ void ModelCSourceGen<Base>::generateLoops() {
     }
 }
 
+template<class Base>
+void ModelCSourceGen<Base>::evalLoopSparsities(bool hessian) {
+    /**
+     * each loop model has its own tape and can be processed independently
+     * (tapes with atomic functions are processed sequentially since the
+     * atomic functions might not be thread safe).
+     * The loop graphs are created afterwards by the calling thread.
+     */
+    std::vector<LoopModel<Base>*> parallel;
+    std::vector<LoopModel<Base>*> sequential;
+    for (LoopModel<Base>* l : _loopTapes) {
+        if (l->isContainsAtomics())
+            sequential.push_back(l);
+        else
+            parallel.push_back(l);
+    }
+
+    auto evalLoop = [hessian](LoopModel<Base>& l) {
+        l.evalJacobianSparsity();
+        if (hessian)
+            l.evalHessianSparsity();
+    };
+
+    auto evalNoLoops = [this, hessian]() {
+        _funNoLoops->evalJacobianSparsity();
+        if (hessian)
+            _funNoLoops->evalHessianSparsity();
+    };
+
+    bool noLoopsInParallel = _funNoLoops != nullptr && !isAtomicsUsed();
+
+    size_t nTasks = parallel.size() + (noLoopsInParallel ? 1 : 0);
+
+    CppADParallelFor<CGBase>::run(nTasks, _loopThreads, [&](size_t t) {
+        if (t < parallel.size())
+            evalLoop(*parallel[t]);
+        else
+            evalNoLoops();
+    });
+
+    for (LoopModel<Base>* l : sequential) {
+        evalLoop(*l);
+    }
+
+    if (_funNoLoops != nullptr && !noLoopsInParallel) {
+        evalNoLoops();
+    }
+}
+
 template<class Base>
 void ModelCSourceGen<Base>::generateInfoSource() {
     const char* localBaseName = typeid (Base).name();
@@ -234,6 +374,22 @@ void ModelCSourceGen<Base>::generateAtomicFuncNames() {
     _sources[funcName + ".c"] = _cache.str();
 }
 
+template<class Base>
+GraphSparsity<Base>& ModelCSourceGen<Base>::getGraphSparsity() {
+    if (_sparsityGraph == nullptr) {
+        _sparsityHandler.reset(new CodeHandler<Base>());
+
+        std::vector<CGBase> indVars(_fun.Domain());
+        _sparsityHandler->makeVariables(indVars);
+
+        std::vector<CGBase> dep = _fun.Forward(0, indVars);
+
+        _sparsityGraph.reset(new GraphSparsity<Base>(*_sparsityHandler, dep));
+        _sparsityGraph->setThreads(_graphSparsityThreads);
+    }
+    return *_sparsityGraph;
+}
+
 template<class Base>
 bool ModelCSourceGen<Base>::isAtomicsUsed() {
     if (_zeroEvaluated) {
@@ -318,6 +474,20 @@ void ModelCSourceGen<Base>::generateGlobalDirectionalFunctionSource(const std::s
     /**
      * The function that matches each equation to a directional derivative function
      */
+    generateDispatchFunctionSource(function, suffix, elements);
+
+    /**
+     * Sparsity
+     */
+    generateSparsity1DSource2(_name + "_" + function_sparsity, elements);
+    _sources[_name + "_" + function_sparsity + ".c"] = _cache.str();
+    _cache.str("");
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateDispatchFunctionSource(const std::string& function,
+                                                           const std::string& suffix,
+                                                           const std::map<size_t, std::vector<size_t> >& elements) {
     LanguageC<Base> langC(_baseTypeName);
     std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
     std::vector<std::string> argsDcl2 = langC.generateDefaultFunctionArgumentsDcl2();
@@ -347,13 +517,6 @@ void ModelCSourceGen<Base>::generateGlobalDirectionalFunctionSource(const std::s
     _cache << "}\n";
     _sources[model_function + ".c"] = _cache.str();
     _cache.str("");
-
-    /**
-     * Sparsity
-     */
-    generateSparsity1DSource2(_name + "_" + function_sparsity, elements);
-    _sources[_name + "_" + function_sparsity + ".c"] = _cache.str();
-    _cache.str("");
 }
 
 template<class Base>
@@ -559,6 +722,33 @@ void ModelCSourceGen<Base>::generateSparsity1DSource2(const std::string& functio
     _cache << "}\n";
 }
 
+template<class Base>
+void ModelCSourceGen<Base>::generateSparsityCompressedSource(const std::string& function,
+                                                             const LocalSparsityInfo& sparsity,
+                                                             SparseMatrixFormat format,
+                                                             size_t outerSize) {
+    std::vector<size_t> ptr, ind;
+    generateCompressedSparsityIndexes(format, outerSize, sparsity.rows, sparsity.cols, ptr, ind);
+
+    LanguageC<Base>::printFunctionDeclaration(_cache, "void", function, {"unsigned int* format",
+                                                                         "unsigned long const** ptr",
+                                                                         "unsigned long const** ind",
+                                                                         "unsigned long* nnz"});
+    _cache << " {\n";
+
+    _cache << "   ";
+    LanguageC<Base>::printStaticIndexArray(_cache, "ptrs", ptr);
+
+    _cache << "   ";
+    LanguageC<Base>::printStaticIndexArray(_cache, "inds", ind);
+
+    _cache << "   *format = " << int(format) << "; // " << (format == SparseMatrixFormat::CSR ? "CSR" : "CSC") << "\n"
+            "   *ptr = ptrs;\n"
+            "   *ind = inds;\n"
+            "   *nnz = " << ind.size() << ";\n"
+            "}\n";
+}
+
 template<class Base>
 inline std::map<size_t, std::vector<std::set<size_t> > > ModelCSourceGen<Base>::determineOrderByCol(const std::map<size_t, std::vector<size_t> >& elements,
                                                                                                     const LocalSparsityInfo& sparsity) {
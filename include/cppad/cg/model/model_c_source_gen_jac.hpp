@@ -19,7 +19,7 @@ namespace CppAD {
 namespace cg {
 
 template<class Base>
-void ModelCSourceGen<Base>::generateJacobianSource() {
+void ModelCSourceGen<Base>::generateJacobianSource(MultiThreadingType multiThreadingType) {
     using std::vector;
 
     const std::string jobName = "Jacobian";
@@ -28,6 +28,8 @@ void ModelCSourceGen<Base>::generateJacobianSource() {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setGraphRewriter(_graphRewriter);
+    handler.setScheduleOperations(_scheduleOperations);
 
     vector<CGBase> indVars(_fun.Domain());
     handler.makeVariables(indVars);
@@ -51,16 +53,22 @@ void ModelCSourceGen<Base>::generateJacobianSource() {
 
     finishedJob();
 
+    if (isParallelTasksEnabled() && multiThreadingType != MultiThreadingType::NONE) {
+        generateParallelTasksSource(handler, jac, _name + "_" + FUNCTION_JACOBIAN, "jac", jobName, multiThreadingType);
+        return;
+    }
+
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setProfiling(_profiling);
+    langC.setLoopVectorization(_loopVectorization);
     langC.setGenerateFunction(_name + "_" + FUNCTION_JACOBIAN);
 
-    std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("jac"));
 
-    handler.generateCode(code, langC, jac, *nameGen, _atomicFunctions, jobName);
+    generateFunctionCode(handler, langC, jac, *nameGen, jobName);
 }
 
 template<class Base>
@@ -110,6 +118,8 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(bool forward) {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setGraphRewriter(_graphRewriter);
+    handler.setScheduleOperations(_scheduleOperations);
 
     vector<CGBase> indVars(n);
     handler.makeVariables(indVars);
@@ -139,12 +149,13 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(bool forward) {
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setProfiling(_profiling);
+    langC.setLoopVectorization(_loopVectorization);
     langC.setGenerateFunction(_name + "_" + FUNCTION_SPARSE_JACOBIAN);
 
-    std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("jac"));
 
-    handler.generateCode(code, langC, jac, *nameGen, _atomicFunctions, jobName);
+    generateFunctionCode(handler, langC, jac, *nameGen, jobName);
 }
 
 template<class Base>
@@ -466,7 +477,11 @@ void ModelCSourceGen<Base>::determineJacobianSparsity() {
     /**
      * Determine the sparsity pattern
      */
-    _jacSparsity.sparsity = jacobianSparsitySet<SparsitySetType, CGBase> (_fun);
+    if (isGraphSparsityEnabled()) {
+        _jacSparsity.sparsity = getGraphSparsity().jacobianSparsity();
+    } else {
+        _jacSparsity.sparsity = jacobianSparsitySet<SparsitySetType, CGBase> (_fun);
+    }
 
     if (!_custom_jac.defined) {
         generateSparsityIndexes(_jacSparsity.sparsity, _jacSparsity.rows, _jacSparsity.cols);
@@ -475,6 +490,8 @@ void ModelCSourceGen<Base>::determineJacobianSparsity() {
         _jacSparsity.rows = _custom_jac.row;
         _jacSparsity.cols = _custom_jac.col;
     }
+
+    sortSparsityIndexes(_jacFormat, _jacSparsity.rows, _jacSparsity.cols);
 }
 
 template<class Base>
@@ -484,6 +501,13 @@ void ModelCSourceGen<Base>::generateJacobianSparsitySource() {
     generateSparsity2DSource(_name + "_" + FUNCTION_JACOBIAN_SPARSITY, _jacSparsity);
     _sources[_name + "_" + FUNCTION_JACOBIAN_SPARSITY + ".c"] = _cache.str();
     _cache.str("");
+
+    if (_jacFormat != SparseMatrixFormat::Coordinate) {
+        size_t outerSize = _jacFormat == SparseMatrixFormat::CSR ? _fun.Range() : _fun.Domain();
+        generateSparsityCompressedSource(_name + "_" + FUNCTION_JACOBIAN_SPARSITY_COMPRESSED, _jacSparsity, _jacFormat, outerSize);
+        _sources[_name + "_" + FUNCTION_JACOBIAN_SPARSITY_COMPRESSED + ".c"] = _cache.str();
+        _cache.str("");
+    }
 }
 
 } // END cg namespace
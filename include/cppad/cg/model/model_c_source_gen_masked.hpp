@@ -0,0 +1,494 @@
+#ifndef CPPAD_CG_MODEL_C_SOURCE_GEN_MASKED_INCLUDED
+#define CPPAD_CG_MODEL_C_SOURCE_GEN_MASKED_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+template<class Base>
+void ModelCSourceGen<Base>::generateMaskedZeroSource() {
+    const std::string jobName = "model (masked zero-order forward)";
+
+    const size_t m = _fun.Range();
+
+    startingJob("'" + jobName + "'", JobTimer::GRAPH);
+
+    CodeHandler<Base> handler;
+    handler.setJobTimer(_jobTimer);
+    handler.setGraphRewriter(_graphRewriter);
+    handler.setScheduleOperations(_scheduleOperations);
+
+    std::vector<CGBase> indVars(_fun.Domain());
+    handler.makeVariables(indVars);
+    if (_x.size() > 0) {
+        for (size_t i = 0; i < indVars.size(); i++) {
+            indVars[i].setValue(_x[i]);
+        }
+    }
+
+    // loops are not used since each group only contains some equations
+    std::vector<CGBase> dep = _fun.Forward(0, indVars);
+
+    finishedJob();
+
+    std::vector<size_t> depOutput(m);
+    for (size_t i = 0; i < m; i++)
+        depOutput[i] = i;
+
+    generateMaskedFunctionSource(handler, indVars, dep, depOutput, m, FUNCTION_FORWARD_ZERO_MASKED, "y", jobName);
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateMaskedSparseJacobianSource() {
+    const std::string jobName = "masked sparse Jacobian";
+
+    const size_t m = _fun.Range();
+    const size_t n = _fun.Domain();
+
+    determineJacobianSparsity();
+
+    const std::vector<size_t>& rows = _jacSparsity.rows;
+    const std::vector<size_t>& cols = _jacSparsity.cols;
+
+    startingJob("'" + jobName + "'", JobTimer::GRAPH);
+
+    CodeHandler<Base> handler;
+    handler.setJobTimer(_jobTimer);
+    handler.setGraphRewriter(_graphRewriter);
+    handler.setScheduleOperations(_scheduleOperations);
+
+    std::vector<CGBase> indVars(n);
+    handler.makeVariables(indVars);
+    if (_x.size() > 0) {
+        for (size_t i = 0; i < n; i++) {
+            indVars[i].setValue(_x[i]);
+        }
+    }
+
+    std::vector<CGBase> jac(rows.size());
+    if (!rows.empty()) {
+        CppAD::sparse_jacobian_work work;
+        if (estimateBestJacobianADMode(rows, cols)) {
+            _fun.SparseJacobianForward(indVars, _jacSparsity.sparsity, rows, cols, jac, work);
+        } else {
+            _fun.SparseJacobianReverse(indVars, _jacSparsity.sparsity, rows, cols, jac, work);
+        }
+    }
+
+    finishedJob();
+
+    generateMaskedFunctionSource(handler, indVars, jac, rows, m, FUNCTION_SPARSE_JACOBIAN_MASKED, "jac", jobName);
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::determineOutputGroups(CodeHandler<Base>& handler,
+                                                  const std::vector<CGBase>& dep,
+                                                  const std::vector<size_t>& depOutput,
+                                                  size_t nOutputs,
+                                                  std::vector<OperationNode<Base>*>& nodes,
+                                                  CodeHandlerVector<Base, size_t>& nodeGroup,
+                                                  std::vector<std::vector<size_t> >& groupOutputs,
+                                                  std::vector<size_t>& outputGroup) {
+    using Node = OperationNode<Base>;
+
+    CPPADCG_ASSERT_UNKNOWN(dep.size() == depOutput.size())
+
+    const size_t NONE = (std::numeric_limits<size_t>::max)();
+
+    std::vector<std::vector<size_t> > outputDeps(nOutputs);
+    for (size_t e = 0; e < dep.size(); e++) {
+        CPPADCG_ASSERT_KNOWN(depOutput[e] < nOutputs, "Invalid output index")
+        outputDeps[depOutput[e]].push_back(e);
+    }
+
+    /**
+     * determine the outputs which depend on each operation
+     * (the outputs are visited in order and therefore each list is sorted)
+     */
+    CodeHandlerVector<Base, size_t> visited(handler); // last output plus one
+    visited.adjustSize();
+    visited.fill(0);
+
+    CodeHandlerVector<Base, std::vector<size_t> > nodeOutputs(handler);
+    nodeOutputs.adjustSize();
+
+    nodes.clear();
+    std::vector<Node*> stack;
+
+    for (size_t o = 0; o < nOutputs; o++) {
+        for (size_t e : outputDeps[o]) {
+            Node* root = dep[e].getOperationNode();
+            if (root != nullptr)
+                stack.push_back(root);
+
+            while (!stack.empty()) {
+                Node* node = stack.back();
+                stack.pop_back();
+
+                // independent variables are not evaluated
+                if (node->getOperationType() == CGOpCode::Inv)
+                    continue;
+
+                size_t& v = visited[*node];
+                if (v == o + 1)
+                    continue;
+                if (v == 0)
+                    nodes.push_back(node);
+                v = o + 1;
+
+                nodeOutputs[*node].push_back(o);
+
+                for (const Argument<Base>& a : node->getArguments()) {
+                    if (a.getOperation() != nullptr)
+                        stack.push_back(a.getOperation());
+                }
+            }
+        }
+    }
+
+    /**
+     * a group for each distinct set of outputs and a group for each
+     * individual output (where its values are assigned)
+     */
+    std::vector<std::vector<size_t> > sets;
+    std::map<std::vector<size_t>, size_t> setIds;
+    auto groupOf = [&](const std::vector<size_t>& outputs) -> size_t {
+        auto it = setIds.find(outputs);
+        if (it != setIds.end())
+            return it->second;
+        size_t id = sets.size();
+        setIds[outputs] = id;
+        sets.push_back(outputs);
+        return id;
+    };
+
+    nodeGroup.adjustSize();
+    nodeGroup.fill(NONE);
+    for (Node* node : nodes) {
+        // arrays and atomic function calls are repeated in each group which uses them
+        if (isMaskedValueOperation(node->getOperationType()))
+            nodeGroup[*node] = groupOf(nodeOutputs[*node]);
+    }
+
+    outputGroup.assign(nOutputs, NONE);
+    for (size_t o = 0; o < nOutputs; o++) {
+        if (!outputDeps[o].empty())
+            outputGroup[o] = groupOf(std::vector<size_t>{o});
+    }
+
+    /**
+     * the arguments of an operation are used by at least the same outputs
+     * and, therefore, groups with more outputs are evaluated first
+     */
+    std::vector<size_t> order(sets.size());
+    for (size_t g = 0; g < order.size(); g++)
+        order[g] = g;
+    std::stable_sort(order.begin(), order.end(), [&](size_t g1, size_t g2) {
+        return sets[g1].size() > sets[g2].size();
+    });
+
+    std::vector<size_t> newId(sets.size());
+    groupOutputs.resize(sets.size());
+    for (size_t g = 0; g < order.size(); g++) {
+        newId[order[g]] = g;
+        groupOutputs[g] = std::move(sets[order[g]]);
+    }
+
+    for (Node* node : nodes) {
+        size_t& g = nodeGroup[*node];
+        if (g != NONE)
+            g = newId[g];
+    }
+    for (size_t o = 0; o < nOutputs; o++) {
+        if (outputGroup[o] != NONE)
+            outputGroup[o] = newId[outputGroup[o]];
+    }
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateMaskedFunctionSource(CodeHandler<Base>& handler,
+                                                         const std::vector<CGBase>& indVars,
+                                                         std::vector<CGBase>& dep,
+                                                         const std::vector<size_t>& depOutput,
+                                                         size_t nOutputs,
+                                                         const std::string& function,
+                                                         const std::string& depName,
+                                                         const std::string& jobName) {
+    using Node = OperationNode<Base>;
+
+    const size_t NONE = (std::numeric_limits<size_t>::max)();
+    const size_t n = indVars.size();
+
+    std::vector<Node*> nodes;
+    CodeHandlerVector<Base, size_t> nodeGroup(handler);
+    std::vector<std::vector<size_t> > groupOutputs;
+    std::vector<size_t> outputGroup;
+    determineOutputGroups(handler, dep, depOutput, nOutputs, nodes, nodeGroup, groupOutputs, outputGroup);
+
+    const size_t nGroups = groupOutputs.size();
+
+    const std::string functionName = _name + "_" + function;
+
+    /**
+     * values used by other groups are exchanged through a shared array
+     * (including the values of dependents assigned in another group)
+     */
+    CodeHandlerVector<Base, size_t> sharedIndex(handler);
+    sharedIndex.adjustSize();
+    sharedIndex.fill(NONE);
+
+    std::vector<std::vector<Node*> > groupShared(nGroups);
+    size_t nShared = 0;
+
+    auto share = [&](Node& node) {
+        size_t& s = sharedIndex[node];
+        if (s == NONE) {
+            s = nShared++;
+            groupShared[nodeGroup[node]].push_back(&node);
+        }
+    };
+
+    for (Node* node : nodes) {
+        bool value = isMaskedValueOperation(node->getOperationType());
+        for (const Argument<Base>& a : node->getArguments()) {
+            Node* arg = a.getOperation();
+            if (arg == nullptr || arg->getOperationType() == CGOpCode::Inv ||
+                !isMaskedValueOperation(arg->getOperationType()))
+                continue;
+
+            if (!value || nodeGroup[*arg] != nodeGroup[*node])
+                share(*arg);
+        }
+    }
+
+    std::vector<std::vector<size_t> > groupDeps(nGroups);
+    for (size_t e = 0; e < dep.size(); e++) {
+        size_t g = outputGroup[depOutput[e]];
+        groupDeps[g].push_back(e);
+
+        Node* root = dep[e].getOperationNode();
+        if (root != nullptr && root->getOperationType() != CGOpCode::Inv && nodeGroup[*root] != g)
+            share(*root);
+    }
+
+    /**
+     * a function for each group which only evaluates its own operations
+     */
+    CodeHandlerVector<Base, size_t> indepIndex(handler);
+    indepIndex.adjustSize();
+    for (size_t j = 0; j < n; j++)
+        indepIndex[*indVars[j].getOperationNode()] = j;
+
+    CodeHandlerVector<Base, Node*> clone(handler);
+    clone.adjustSize();
+    clone.fill(nullptr);
+    std::vector<Node*> cloned;
+
+    for (size_t g = 0; g < nGroups; g++) {
+        CodeHandler<Base> groupHandler;
+        groupHandler.setJobTimer(_jobTimer);
+        groupHandler.setGraphRewriter(_graphRewriter);
+        groupHandler.setScheduleOperations(_scheduleOperations);
+
+        std::vector<CGBase> x(n);
+        groupHandler.makeVariables(x);
+
+        std::vector<size_t> sharedIn;
+
+        auto argument = [&](const Argument<Base>& a) -> Argument<Base> {
+            Node* arg = a.getOperation();
+            if (arg == nullptr)
+                return Argument<Base>(*a.getParameter());
+            else if (arg->getOperationType() == CGOpCode::Inv)
+                return Argument<Base>(*x[indepIndex[*arg]].getOperationNode());
+            else
+                return Argument<Base>(*clone[*arg]);
+        };
+
+        auto cloneGraph = [&](Node& root) -> Node* {
+            std::vector<std::pair<Node*, bool> > stack;
+            stack.emplace_back(&root, false);
+
+            while (!stack.empty()) {
+                Node* node = stack.back().first;
+                if (clone[*node] != nullptr) {
+                    stack.pop_back();
+                    continue;
+                }
+
+                CGOpCode op = node->getOperationType();
+
+                if (isMaskedValueOperation(op) && nodeGroup[*node] != g) {
+                    // a value determined by another group
+                    CGBase v;
+                    groupHandler.makeVariable(v);
+                    sharedIn.push_back(sharedIndex[*node]);
+                    clone[*node] = v.getOperationNode();
+                    cloned.push_back(node);
+                    stack.pop_back();
+                    continue;
+                }
+
+                if (!stack.back().second) {
+                    stack.back().second = true;
+                    for (const Argument<Base>& a : node->getArguments()) {
+                        Node* arg = a.getOperation();
+                        if (arg != nullptr && arg->getOperationType() != CGOpCode::Inv && clone[*arg] == nullptr)
+                            stack.emplace_back(arg, false);
+                    }
+                    continue;
+                }
+                stack.pop_back();
+
+                std::vector<Argument<Base> > args;
+                args.reserve(node->getArguments().size());
+                for (const Argument<Base>& a : node->getArguments())
+                    args.push_back(argument(a));
+
+                Node* newNode;
+                if (op == CGOpCode::Pri) {
+                    auto& p = static_cast<PrintOperationNode<Base>&>(*node);
+                    newNode = groupHandler.makePrintNode(p.getBeforeString(), args[0], p.getAfterString());
+                } else {
+                    CPPADCG_ASSERT_KNOWN(isMaskedSupportedOperation(op),
+                                         "Operation type not supported in masked functions")
+                    newNode = groupHandler.makeNode(op, node->getInfo(), args);
+                }
+
+                clone[*node] = newNode;
+                cloned.push_back(node);
+            }
+
+            return clone[root];
+        };
+
+        std::vector<CGBase> groupDep;
+        std::vector<size_t> depPositions;
+        std::vector<size_t> sharedOut;
+
+        for (size_t e : groupDeps[g]) {
+            Node* root = dep[e].getOperationNode();
+            if (root == nullptr) {
+                groupDep.push_back(CGBase(dep[e].getValue()));
+            } else if (root->getOperationType() == CGOpCode::Inv) {
+                groupDep.push_back(x[indepIndex[*root]]);
+            } else {
+                groupDep.push_back(CGBase(*cloneGraph(*root)));
+            }
+            depPositions.push_back(e);
+        }
+
+        for (Node* node : groupShared[g]) {
+            groupDep.push_back(CGBase(*cloneGraph(*node)));
+            sharedOut.push_back(sharedIndex[*node]);
+        }
+
+        for (Node* node : cloned)
+            clone[*node] = nullptr;
+        cloned.clear();
+
+        LanguageC<Base> langC(_baseTypeName);
+        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+        langC.setParameterPrecision(_parameterPrecision);
+        langC.setProfiling(_profiling);
+        langC.setLoopVectorization(_loopVectorization);
+        langC.setGenerateFunction(functionName + "_group" + std::to_string(g));
+
+        std::ostringstream code;
+        LangCMaskedGroupVarNameGenerator<Base> nameGen(depPositions, sharedOut, n, sharedIn, depName);
+
+        groupHandler.generateCode(code, langC, groupDep, nameGen, _atomicFunctions,
+                                  jobName + " group " + std::to_string(g));
+    }
+
+    /**
+     * the function which evaluates the groups with requested outputs
+     */
+    LanguageC<Base> langC(_baseTypeName);
+    std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
+
+    _cache.str("");
+    _cache << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+    for (size_t g = 0; g < nGroups; g++) {
+        _cache << "void " << functionName << "_group" << g << "(" << argsDcl << ");\n";
+    }
+    _cache << "\n";
+    LanguageC<Base>::printFunctionDeclaration(_cache, "void", functionName, {"unsigned char const* mask"},
+                                              langC.generateDefaultFunctionArgumentsDcl2());
+    _cache << " {\n";
+
+    if (nGroups > 0) {
+        const std::string& indexType = LanguageC<Base>::U_INDEX_TYPE;
+
+        size_t nGroupOutputs = 0;
+        for (const auto& outputs : groupOutputs)
+            nGroupOutputs += outputs.size();
+
+        _cache << "   static const " << indexType << " groupOutputs[" << nGroupOutputs << "] = {";
+        size_t k = 0;
+        for (const auto& outputs : groupOutputs) {
+            for (size_t o : outputs) {
+                if (k++ > 0) _cache << ",";
+                _cache << o;
+            }
+        }
+        _cache << "};\n"
+                "   static const " << indexType << " groupStart[" << (nGroups + 1) << "] = {0";
+        k = 0;
+        for (const auto& outputs : groupOutputs) {
+            k += outputs.size();
+            _cache << "," << k;
+        }
+        _cache << "};\n"
+                "   " << _baseTypeName << " shared[" << std::max<size_t>(nShared, 1) << "];\n"
+                "   " << _baseTypeName << " const * groupIn[2];\n"
+                "   " << _baseTypeName << "* groupOut[2];\n"
+                "   unsigned char eval[" << nGroups << "];\n"
+                "   " << indexType << " g, i;\n"
+                "\n"
+                "   // a group is evaluated if any of its outputs is requested\n"
+                "   for(g = 0; g < " << nGroups << "; g++) {\n"
+                "      eval[g] = 0;\n"
+                "      for(i = groupStart[g]; i < groupStart[g + 1]; i++) {\n"
+                "         if(mask[groupOutputs[i]]) {\n"
+                "            eval[g] = 1;\n"
+                "            break;\n"
+                "         }\n"
+                "      }\n"
+                "   }\n"
+                "\n"
+                "   groupIn[0] = " << langC.getArgumentIn() << "[0];\n"
+                "   groupIn[1] = shared;\n"
+                "   groupOut[0] = " << langC.getArgumentOut() << "[0];\n"
+                "   groupOut[1] = shared;\n"
+                "\n";
+        for (size_t g = 0; g < nGroups; g++) {
+            _cache << "   if(eval[" << g << "]) " << functionName << "_group" << g
+                    << "(groupIn, groupOut, " << langC.getArgumentAtomic() << ");\n";
+        }
+    }
+
+    _cache << "}\n";
+
+    _sources[functionName + ".c"] = _cache.str();
+    _cache.str("");
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef CPPAD_CG_MODEL_C_SOURCE_GEN_ORDERING_INCLUDED
+#define CPPAD_CG_MODEL_C_SOURCE_GEN_ORDERING_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+template<class Base>
+void ModelCSourceGen<Base>::generateVariableOrderingSources() {
+    std::vector<size_t> independent, dependent;
+    getVariableOrdering(independent, dependent);
+
+    generateSparsity1DSource(_name + "_" + FUNCTION_INDEPENDENT_ORDER, independent);
+    _sources[_name + "_" + FUNCTION_INDEPENDENT_ORDER + ".c"] = _cache.str();
+    _cache.str("");
+
+    generateSparsity1DSource(_name + "_" + FUNCTION_DEPENDENT_ORDER, dependent);
+    _sources[_name + "_" + FUNCTION_DEPENDENT_ORDER + ".c"] = _cache.str();
+    _cache.str("");
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateOrderedWrapperSource(const std::string& function,
+                                                         const std::vector<size_t>& independent,
+                                                         const std::vector<size_t>& dependent) {
+    LanguageC<Base> langC(_baseTypeName);
+    std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
+    const std::string& indexType = LanguageC<Base>::U_INDEX_TYPE;
+    const size_t n = independent.size();
+    const size_t m = dependent.size();
+
+    auto printArray = [this](const std::vector<size_t>& values) {
+        for (size_t k = 0; k < values.size(); k++) {
+            if (k > 0) _cache << ",";
+            _cache << values[k];
+        }
+    };
+
+    // the permuted values are kept in the heap since large models would
+    // not fit in the stack
+    _cache.str("");
+    _cache << "#include <stdlib.h>\n"
+            << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+    _cache << "void " << function << ORDERED_SUFFIX << "(" << argsDcl << ");\n\n";
+    LanguageC<Base>::printFunctionDeclaration(_cache, "void", function, langC.generateDefaultFunctionArgumentsDcl2());
+    _cache << " {\n";
+    _cache << "   static const " << indexType << " independent[" << std::max<size_t>(n, 1) << "] = {";
+    printArray(independent);
+    _cache << "};\n"
+            "   static const " << indexType << " dependent[" << std::max<size_t>(m, 1) << "] = {";
+    printArray(dependent);
+    _cache << "};\n"
+            "   " << _baseTypeName << "* x;\n"
+            "   " << _baseTypeName << "* y;\n"
+            "   " << _baseTypeName << " const * orderedIn[1];\n"
+            "   " << _baseTypeName << "* orderedOut[1];\n"
+            "   " << indexType << " k;\n"
+            "\n"
+            "   x = (" << _baseTypeName << "*) malloc(" << (n + m) << " * sizeof(" << _baseTypeName << "));\n"
+            "   y = x + " << n << ";\n"
+            "\n"
+            "   for(k = 0; k < " << n << "; k++) x[k] = " << langC.getArgumentIn() << "[0][independent[k]];\n"
+            "\n"
+            "   orderedIn[0] = x;\n"
+            "   orderedOut[0] = y;\n"
+            "   " << function << ORDERED_SUFFIX << "(orderedIn, orderedOut, " << langC.getArgumentAtomic() << ");\n"
+            "\n"
+            "   for(k = 0; k < " << m << "; k++) " << langC.getArgumentOut() << "[0][dependent[k]] = y[k];\n"
+            "\n"
+            "   free(x);\n"
+            "}\n";
+
+    _sources[function + ".c"] = _cache.str();
+    _cache.str("");
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
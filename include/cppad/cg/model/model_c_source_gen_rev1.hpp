@@ -88,6 +88,8 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesWithAtomics(const std
 
         CodeHandler<Base> handler;
         handler.setJobTimer(_jobTimer);
+        handler.setGraphRewriter(_graphRewriter);
+        handler.setScheduleOperations(_scheduleOperations);
 
         vector<CGBase> indVars(_fun.Domain());
         handler.makeVariables(indVars);
@@ -122,15 +124,16 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesWithAtomics(const std
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setProfiling(_profiling);
+        langC.setLoopVectorization(_loopVectorization);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "_dep" << i;
         langC.setGenerateFunction(_cache.str());
 
-        std::ostringstream code;
         std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dw"));
         LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "py", n);
 
-        handler.generateCode(code, langC, dwCustom, nameGenHess, _atomicFunctions, subJobName);
+        generateFunctionCode(handler, langC, dwCustom, nameGenHess, subJobName);
     }
 }
 
@@ -146,6 +149,8 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesNoAtomics(const std::
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setGraphRewriter(_graphRewriter);
+    handler.setScheduleOperations(_scheduleOperations);
 
     vector<CGBase> x(n);
     handler.makeVariables(x);
@@ -210,15 +215,16 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesNoAtomics(const std::
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setProfiling(_profiling);
+        langC.setLoopVectorization(_loopVectorization);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "_dep" << i;
         langC.setGenerateFunction(_cache.str());
 
-        std::ostringstream code;
         std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dw"));
         LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "py", n);
 
-        handler.generateCode(code, langC, dwCustom, nameGenHess, _atomicFunctions, subJobName);
+        generateFunctionCode(handler, langC, dwCustom, nameGenHess, subJobName);
     }
 }
 
@@ -236,6 +242,10 @@ void ModelCSourceGen<Base>::generateReverseOneSources() {
     std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
     std::string args = langC.generateDefaultFunctionArguments();
 
+    // the contributions of each direction can be summed with a different type
+    bool mixed = isMixedPrecision();
+    std::string sum = mixed ? "acc[pos[ePos]]" : "px[pos[ePos]]";
+
     _cache << "#include <stdlib.h>\n"
             << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
             "\n"
@@ -255,8 +265,11 @@ void ModelCSourceGen<Base>::generateReverseOneSources() {
             "   unsigned long nnzPy;\n"
             "   " << _baseTypeName << " const * in[2];\n"
             "   " << _baseTypeName << "* out[1];\n"
-            "   " << _baseTypeName << "* compressed;\n"
-            "   int ret;\n"
+            "   " << _baseTypeName << "* compressed;\n";
+    if (mixed) {
+        _cache << "   " << _accumulationTypeName << "* acc;\n";
+    }
+    _cache << "   int ret;\n"
             "\n"
             "   pyPos = 0;\n"
             "   nnzPy = 0;\n"
@@ -288,8 +301,11 @@ void ModelCSourceGen<Base>::generateReverseOneSources() {
             "      return 0; //nothing to do\n"
             "   }\n"
             "\n"
-            "   compressed = (" << _baseTypeName << "*) malloc(nnzMax * sizeof(" << _baseTypeName << "));\n"
-            "\n"
+            "   compressed = (" << _baseTypeName << "*) malloc(nnzMax * sizeof(" << _baseTypeName << "));\n";
+    if (mixed) {
+        _cache << "   acc = (" << _accumulationTypeName << "*) calloc(" << n << ", sizeof(" << _accumulationTypeName << "));\n";
+    }
+    _cache << "\n"
             "   for (ei = 0; ei < nnzPy; ei++) {\n"
             "      i = pyPos[ei];\n"
             "      " << _name << "_" << FUNCTION_REVERSE_ONE_SPARSITY << "(i, &pos, &nnz);\n"
@@ -307,15 +323,22 @@ void ModelCSourceGen<Base>::generateReverseOneSources() {
             "      if (ret != 0) {\n"
             "         free(compressed);\n"
             "         free(pyPos);\n"
+            << (mixed ? "         free(acc);\n" : "") <<
             "         return ret;\n"
             "      }\n"
             "\n"
             "      for (ePos = 0; ePos < nnz; ePos++) {\n"
-            "         px[pos[ePos]] += compressed[ePos];\n"
+            "         " << sum << " += compressed[ePos];\n"
             "      }\n"
             "\n"
-            "   }\n"
-            "   free(compressed);\n"
+            "   }\n";
+    if (mixed) {
+        _cache << "   for (j = 0; j < " << n << "; j++) {\n"
+                "      px[j] = acc[j];\n"
+                "   }\n"
+                "   free(acc);\n";
+    }
+    _cache << "   free(compressed);\n"
             "   free(pyPos);\n"
             "   return 0;\n"
             "}\n";
@@ -88,6 +88,8 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesWithAtomics(const std
 
         CodeHandler<Base> handler;
         handler.setJobTimer(_jobTimer);
+        handler.setGraphRewriter(_graphRewriter);
+        handler.setScheduleOperations(_scheduleOperations);
 
         vector<CGBase> tx0(n);
         handler.makeVariables(tx0);
@@ -130,15 +132,16 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesWithAtomics(const std
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setProfiling(_profiling);
+        langC.setLoopVectorization(_loopVectorization);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
 
-        std::ostringstream code;
         std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("px"));
         LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n, 1);
 
-        handler.generateCode(code, langC, pxCustom, nameGenRev2, _atomicFunctions, subJobName);
+        generateFunctionCode(handler, langC, pxCustom, nameGenRev2, subJobName);
     }
 }
 
@@ -167,6 +170,8 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesNoAtomics(const std::
     // we can use a new handler to reduce memory usage
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setGraphRewriter(_graphRewriter);
+    handler.setScheduleOperations(_scheduleOperations);
 
     vector<CGBase> tx0(n);
     handler.makeVariables(tx0);
@@ -233,15 +238,16 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesNoAtomics(const std::
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setProfiling(_profiling);
+        langC.setLoopVectorization(_loopVectorization);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
 
-        std::ostringstream code;
         std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("px"));
         LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n, 1);
 
-        handler.generateCode(code, langC, pxCustom, nameGenRev2, _atomicFunctions, subJobName);
+        generateFunctionCode(handler, langC, pxCustom, nameGenRev2, subJobName);
     }
 }
 
@@ -259,6 +265,10 @@ void ModelCSourceGen<Base>::generateReverseTwoSources() {
     std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
     std::string args = langC.generateDefaultFunctionArguments();
 
+    // the contributions of each direction can be summed with a different type
+    bool mixed = isMixedPrecision();
+    std::string sum = mixed ? "acc[pos[ePos]]" : "px[pos[ePos] * 2]";
+
     _cache << "#include <stdlib.h>\n"
             << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
             "\n"
@@ -280,8 +290,11 @@ void ModelCSourceGen<Base>::generateReverseTwoSources() {
             "    " << _baseTypeName << "* out[1];\n"
             "    " << _baseTypeName << " x[" << n << "];\n"
             "    " << _baseTypeName << " w[" << m << "];\n"
-            "    " << _baseTypeName << "* compressed;\n"
-            "    int nonZeroW;\n"
+            "    " << _baseTypeName << "* compressed;\n";
+    if (mixed) {
+        _cache << "    " << _accumulationTypeName << "* acc;\n";
+    }
+    _cache << "    int nonZeroW;\n"
             "    int ret;\n"
             "\n"
             "    nonZeroW = 0;\n"
@@ -330,8 +343,11 @@ void ModelCSourceGen<Base>::generateReverseTwoSources() {
             "    for (j = 0; j < " << n << "; j++)\n"
             "        x[j] = tx[j * 2];\n"
             "\n"
-            "   compressed = (" << _baseTypeName << "*) malloc(nnzMax * sizeof(" << _baseTypeName << "));\n"
-            "\n"
+            "   compressed = (" << _baseTypeName << "*) malloc(nnzMax * sizeof(" << _baseTypeName << "));\n";
+    if (mixed) {
+        _cache << "   acc = (" << _accumulationTypeName << "*) calloc(" << n << ", sizeof(" << _accumulationTypeName << "));\n";
+    }
+    _cache << "\n"
             "   for (ej = 0; ej < nnzTx; ej++) {\n"
             "      j = txPos[ej];\n"
             "      " << _name << "_" << FUNCTION_REVERSE_TWO_SPARSITY << "(j, &pos, &nnz);\n"
@@ -350,15 +366,22 @@ void ModelCSourceGen<Base>::generateReverseTwoSources() {
             "      if (ret != 0) {\n"
             "         free(compressed);\n"
             "         free(txPos);\n"
+            << (mixed ? "         free(acc);\n" : "") <<
             "         return ret;\n"
             "      }\n"
             "\n"
             "      for (ePos = 0; ePos < nnz; ePos++) {\n"
-            "         px[pos[ePos] * 2] += compressed[ePos];\n"
+            "         " << sum << " += compressed[ePos];\n"
             "      }\n"
             "\n"
-            "   }\n"
-            "   free(compressed);\n"
+            "   }\n";
+    if (mixed) {
+        _cache << "   for (j = 0; j < " << n << "; j++) {\n"
+                "      px[j * 2] = acc[j];\n"
+                "   }\n"
+                "   free(acc);\n";
+    }
+    _cache << "   free(compressed);\n"
             "   free(txPos);\n"
             "   return 0;\n"
             "};\n";
@@ -0,0 +1,201 @@
+#ifndef CPPAD_CG_MODEL_C_SOURCE_GEN_TASKS_INCLUDED
+#define CPPAD_CG_MODEL_C_SOURCE_GEN_TASKS_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+template<class Base>
+void ModelCSourceGen<Base>::generateParallelTasksSource(CodeHandler<Base>& handler,
+                                                        std::vector<CGBase>& dep,
+                                                        const std::string& functionName,
+                                                        const std::string& depName,
+                                                        const std::string& jobName,
+                                                        MultiThreadingType multiThreadingType) {
+    CPPADCG_ASSERT_UNKNOWN(multiThreadingType != MultiThreadingType::NONE)
+
+    const std::vector<size_t> ranges = determineTaskRanges(handler, dep, _parallelTasks);
+    const size_t nTasks = ranges.size() - 1;
+
+    /**
+     * Create a function for each task
+     */
+    for (size_t t = 0; t < nTasks; ++t) {
+        LanguageC<Base> langC(_baseTypeName);
+        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+        langC.setParameterPrecision(_parameterPrecision);
+        langC.setProfiling(_profiling);
+        langC.setLoopVectorization(_loopVectorization);
+        langC.setGenerateFunction(functionName + "_task" + std::to_string(t));
+
+        ArrayView<CGBase> depTask(dep.data() + ranges[t], ranges[t + 1] - ranges[t]);
+
+        std::ostringstream code;
+        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator(depName));
+
+        handler.generateCode(code, langC, depTask, *nameGen, _atomicFunctions, jobName + " task " + std::to_string(t));
+    }
+
+    /**
+     * Create the function which evaluates all tasks
+     */
+    LanguageC<Base> langC(_baseTypeName);
+    std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
+
+    _cache.str("");
+    _cache << "#include <stdlib.h>\n"
+            "\n"
+           << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+    for (size_t t = 0; t < nTasks; ++t) {
+        _cache << "void " << functionName << "_task" << t << "(" << argsDcl << ");\n";
+    }
+
+    langC.setArgumentOut("outLocal");
+    std::string argsLocal = langC.generateDefaultFunctionArguments();
+
+    _cache << "\n"
+            "typedef void (*cppadcg_function_type) (" << argsDcl << ");\n";
+
+    if (multiThreadingType == MultiThreadingType::OPENMP) {
+        _cache << "\n";
+        printFileStartOpenMP(_cache);
+        _cache << "\n";
+
+    } else {
+        assert(multiThreadingType == MultiThreadingType::PTHREADS);
+
+        printFileStartPThreads(_cache, _baseTypeName);
+    }
+
+    _cache << "\n"
+            "void " << functionName << "(" << argsDcl << ") {\n"
+            "   static const cppadcg_function_type p[" << nTasks << "] = {";
+    for (size_t t = 0; t < nTasks; ++t) {
+        if (t != 0) _cache << ", ";
+        _cache << functionName << "_task" << t;
+    }
+    _cache << "};\n"
+            "   static const long offset[" << nTasks << "] = {";
+    for (size_t t = 0; t < nTasks; ++t) {
+        if (t != 0) _cache << ", ";
+        _cache << ranges[t];
+    }
+    _cache << "};\n"
+            "   " << _baseTypeName << " * outLocal[1];\n"
+            "   " << _baseTypeName << " * dep = out[0];\n"
+            "   long i;\n"
+            "\n";
+
+    if (multiThreadingType == MultiThreadingType::OPENMP) {
+        printFunctionStartOpenMP(_cache, nTasks);
+        _cache << "\n";
+        printLoopStartOpenMP(_cache, nTasks);
+        _cache << "      outLocal[0] = &dep[offset[i]];\n"
+                "      (*p[i])(" << argsLocal << ");\n";
+        printLoopEndOpenMP(_cache, nTasks);
+        _cache << "\n";
+
+    } else {
+        printFunctionStartPThreads(_cache, nTasks);
+        _cache << "\n"
+                "   for(i = 0; i < " << nTasks << "; ++i) {\n"
+                "      args[i] = (ExecArgStruct*) malloc(sizeof(ExecArgStruct));\n"
+                "      args[i]->func = p[i];\n"
+                "      args[i]->in = " << langC.getArgumentIn() << ";\n"
+                "      args[i]->out[0] = &dep[offset[i]];\n"
+                "      args[i]->atomicFun = " << langC.getArgumentAtomic() << ";\n"
+                "   }\n"
+                "\n";
+        printFunctionEndPThreads(_cache, nTasks);
+    }
+
+    _cache << "\n"
+            "}\n";
+
+    _sources[functionName + ".c"] = _cache.str();
+    _cache.str("");
+}
+
+template<class Base>
+std::vector<size_t> ModelCSourceGen<Base>::determineTaskRanges(CodeHandler<Base>& handler,
+                                                               const std::vector<CGBase>& dep,
+                                                               size_t nTasks) {
+    using Node = OperationNode<Base>;
+
+    const size_t m = dep.size();
+
+    std::vector<Node*> stack;
+
+    /**
+     * the number of operations not yet visited required by a dependent
+     */
+    auto countNewOperations = [&](const CGBase& y) {
+        size_t count = 0;
+        if (y.getOperationNode() != nullptr)
+            stack.push_back(y.getOperationNode());
+
+        while (!stack.empty()) {
+            Node* node = stack.back();
+            stack.pop_back();
+            if (handler.isVisited(*node))
+                continue;
+            handler.markVisited(*node);
+            count++;
+
+            for (const Argument<Base>& a : node->getArguments()) {
+                if (a.getOperation() != nullptr && !handler.isVisited(*a.getOperation()))
+                    stack.push_back(a.getOperation());
+            }
+        }
+        return count;
+    };
+
+    handler.startNewOperationTreeVisit();
+    size_t total = 0;
+    for (size_t i = 0; i < m; ++i) {
+        total += countNewOperations(dep[i]);
+    }
+
+    std::vector<size_t> ranges;
+    ranges.reserve(nTasks + 1);
+    ranges.push_back(0);
+
+    if (nTasks > 1 && m > 1) {
+        // operations shared by several ranges are counted in each range
+        size_t target = (total + nTasks - 1) / nTasks;
+        size_t count = 0;
+
+        handler.startNewOperationTreeVisit();
+        for (size_t i = 0; i + 1 < m && ranges.size() < nTasks; ++i) {
+            count += countNewOperations(dep[i]);
+            if (count >= target) {
+                ranges.push_back(i + 1);
+                count = 0;
+                handler.startNewOperationTreeVisit();
+            }
+        }
+    }
+
+    ranges.push_back(m);
+
+    return ranges;
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
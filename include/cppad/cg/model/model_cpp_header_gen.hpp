@@ -0,0 +1,421 @@
+#ifndef CPPAD_CG_MODEL_CPP_HEADER_GEN_INCLUDED
+#define CPPAD_CG_MODEL_CPP_HEADER_GEN_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Generates a header-only C++ model where each function is a template on
+ * the scalar type.
+ * The generated header does not require a dynamic library (or atomic
+ * functions) and it can be compiled directly into other applications.
+ * The sparsity patterns are provided as constexpr arrays.
+ *
+ * The model functions are placed inside a namespace with the model name:
+ *  - forward_zero(x, y)
+ *  - sparse_jacobian(x, jac) with the elements in jacobian_rows/jacobian_cols
+ *  - sparse_hessian(x, w, hess) with the elements of the lower triangle in
+ *    hessian_rows/hessian_cols
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class ModelCppHeaderGen {
+public:
+    using CGBase = CG<Base>;
+    using SparsitySetType = std::vector<std::set<size_t> >;
+protected:
+    /**
+     * The model
+     */
+    ADFun<CGBase>& _fun;
+    /**
+     * the model name (used as namespace name)
+     */
+    const std::string _name;
+    /**
+     * the name of the template parameter with the scalar type
+     */
+    std::string _templateTypeName;
+    /**
+     * the maximum precision used to print values
+     */
+    size_t _parameterPrecision;
+    /**
+     * typical values of the independent variables
+     */
+    std::vector<Base> _x;
+    /**
+     * whether or not to create the zero order forward mode function
+     */
+    bool _zero;
+    /**
+     * whether or not to create the sparse Jacobian function
+     */
+    bool _sparseJacobian;
+    /**
+     * whether or not to create the sparse Hessian function
+     */
+    bool _sparseHessian;
+    /**
+     * the generated header
+     */
+    std::string _header;
+public:
+
+    /**
+     * Creates a new C++ header generator for a model.
+     *
+     * @param fun The ADFun with the taped model. It must not use atomic
+     *            functions.
+     * @param model The model name (must be a valid C++ identifier since it
+     *              is used as the namespace of the model functions)
+     */
+    ModelCppHeaderGen(ADFun<CGBase>& fun,
+                      std::string model) :
+        _fun(fun),
+        _name(std::move(model)),
+        _templateTypeName("T"),
+        _parameterPrecision(std::numeric_limits<Base>::digits10),
+        _zero(true),
+        _sparseJacobian(false),
+        _sparseHessian(false) {
+
+        CPPADCG_ASSERT_KNOWN(!_name.empty(), "Model name cannot be empty")
+        CPPADCG_ASSERT_KNOWN((_name[0] >= 'a' && _name[0] <= 'z') ||
+                             (_name[0] >= 'A' && _name[0] <= 'Z'),
+                             "Invalid model name character")
+        for (size_t i = 1; i < _name.size(); i++) {
+            char c = _name[i];
+            CPPADCG_ASSERT_KNOWN((c >= 'a' && c <= 'z') ||
+                                 (c >= 'A' && c <= 'Z') ||
+                                 (c >= '0' && c <= '9') ||
+                                 c == '_'
+                                 , "Invalid model name character")
+        }
+    }
+
+    ModelCppHeaderGen(const ModelCppHeaderGen&) = delete;
+    ModelCppHeaderGen& operator=(const ModelCppHeaderGen&) = delete;
+
+    inline virtual ~ModelCppHeaderGen() = default;
+
+    /**
+     * @return The model name
+     */
+    inline const std::string& getName() const {
+        return _name;
+    }
+
+    inline const std::string& getTemplateTypeName() const {
+        return _templateTypeName;
+    }
+
+    /**
+     * Defines the name of the template parameter used in the generated
+     * functions.
+     *
+     * @param name the template parameter name
+     */
+    inline void setTemplateTypeName(const std::string& name) {
+        _templateTypeName = name;
+        _header.clear();
+    }
+
+    /**
+     * Defines typical values for the independent variables.
+     * These values may be used for the determination of zero entries
+     * (e.g. in conditional expressions).
+     *
+     * @param x typical independent variable vector
+     */
+    template<class VectorBase>
+    inline void setTypicalIndependentValues(const VectorBase& x) {
+        CPPAD_ASSERT_KNOWN(x.size() == 0 || x.size() == _fun.Domain(),
+                           "Invalid independent variable vector size")
+        _x.resize(x.size());
+        for (size_t i = 0; i < x.size(); i++) {
+            _x[i] = x[i];
+        }
+        _header.clear();
+    }
+
+    inline size_t getParameterPrecision() const {
+        return _parameterPrecision;
+    }
+
+    inline void setParameterPrecision(size_t p) {
+        _parameterPrecision = p;
+        _header.clear();
+    }
+
+    inline bool isCreateForwardZero() const {
+        return _zero;
+    }
+
+    inline void setCreateForwardZero(bool create) {
+        _zero = create;
+        _header.clear();
+    }
+
+    inline bool isCreateSparseJacobian() const {
+        return _sparseJacobian;
+    }
+
+    inline void setCreateSparseJacobian(bool create) {
+        _sparseJacobian = create;
+        _header.clear();
+    }
+
+    inline bool isCreateSparseHessian() const {
+        return _sparseHessian;
+    }
+
+    inline void setCreateSparseHessian(bool create) {
+        _sparseHessian = create;
+        _header.clear();
+    }
+
+    /**
+     * Provides the contents of the generated header (it is generated if
+     * required).
+     *
+     * @return the C++ header source code
+     */
+    inline const std::string& getHeader() {
+        if (_header.empty()) {
+            generateHeader();
+        }
+        return _header;
+    }
+
+    /**
+     * Saves the generated header to a file.
+     *
+     * @param fileName the path of the header file
+     */
+    inline void saveHeader(const std::string& fileName) {
+        const std::string& header = getHeader();
+
+        std::ofstream out(fileName.c_str());
+        if (!out.is_open()) {
+            throw CGException("Failed to create the header file '", fileName, "'");
+        }
+        out << header;
+        out.close();
+    }
+
+protected:
+
+    virtual void generateHeader() {
+        const size_t m = _fun.Range();
+        const size_t n = _fun.Domain();
+
+        std::string guard = "CPPADCG_MODEL_" + _name + "_HPP";
+        std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+
+        std::ostringstream out;
+        out << "#ifndef " << guard << "\n"
+               "#define " << guard << "\n"
+               "// Generated by CppADCodeGen\n"
+               "\n"
+               "#include <array>\n"
+               "#include <cmath>\n"
+               "#include <iostream>\n"
+               "\n"
+               "namespace " << _name << " {\n"
+               "\n"
+               "using std::abs;\n"
+               "using std::acos;\n"
+               "using std::asin;\n"
+               "using std::atan;\n"
+               "using std::cosh;\n"
+               "using std::cos;\n"
+               "using std::exp;\n"
+               "using std::log;\n"
+               "using std::sinh;\n"
+               "using std::sin;\n"
+               "using std::sqrt;\n"
+               "using std::tanh;\n"
+               "using std::tan;\n"
+               "using std::pow;\n"
+#if CPPAD_USE_CPLUSPLUS_2011
+               "using std::erf;\n"
+               "using std::erfc;\n"
+               "using std::asinh;\n"
+               "using std::acosh;\n"
+               "using std::atanh;\n"
+               "using std::expm1;\n"
+               "using std::log1p;\n"
+#endif
+               "\n"
+               "constexpr unsigned long n = " << n << ";\n"
+               "constexpr unsigned long m = " << m << ";\n"
+               "\n";
+
+        if (_zero) {
+            generateForwardZeroSource(out);
+        }
+        if (_sparseJacobian) {
+            generateSparseJacobianSource(out);
+        }
+        if (_sparseHessian) {
+            generateSparseHessianSource(out);
+        }
+
+        out << "} // END " << _name << " namespace\n"
+               "\n"
+               "#endif\n";
+
+        _header = out.str();
+    }
+
+    virtual void generateForwardZeroSource(std::ostringstream& out) {
+        CodeHandler<Base> handler;
+
+        std::vector<CGBase> indVars(_fun.Domain());
+        makeIndependentVariables(handler, indVars);
+
+        std::vector<CGBase> dep = _fun.Forward(0, indVars);
+
+        LangCDefaultVariableNameGenerator<Base> nameGen;
+        generateFunctionSource(out, handler, dep, nameGen, "forward_zero", {});
+    }
+
+    virtual void generateSparseJacobianSource(std::ostringstream& out) {
+        const size_t m = _fun.Range();
+        const size_t n = _fun.Domain();
+
+        SparsitySetType sparsity = jacobianSparsitySet<SparsitySetType, CGBase>(_fun);
+        std::vector<size_t> rows, cols;
+        generateSparsityIndexes(sparsity, rows, cols);
+
+        CodeHandler<Base> handler;
+
+        std::vector<CGBase> indVars(n);
+        makeIndependentVariables(handler, indVars);
+
+        std::vector<CGBase> jac(rows.size());
+        CppAD::sparse_jacobian_work work;
+        if (n <= m) {
+            _fun.SparseJacobianForward(indVars, sparsity, rows, cols, jac, work);
+        } else {
+            _fun.SparseJacobianReverse(indVars, sparsity, rows, cols, jac, work);
+        }
+
+        generateSparsitySource(out, "jacobian", rows, cols);
+
+        LangCDefaultVariableNameGenerator<Base> nameGen("jac");
+        generateFunctionSource(out, handler, jac, nameGen, "sparse_jacobian", {});
+    }
+
+    virtual void generateSparseHessianSource(std::ostringstream& out) {
+        const size_t m = _fun.Range();
+        const size_t n = _fun.Domain();
+
+        SparsitySetType sparsity = hessianSparsitySet<SparsitySetType, CGBase>(_fun);
+
+        // only the lower triangle (the Hessian is symmetric)
+        std::vector<size_t> rows, cols;
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j : sparsity[i]) {
+                if (j > i)
+                    break;
+                rows.push_back(i);
+                cols.push_back(j);
+            }
+        }
+
+        CodeHandler<Base> handler;
+
+        std::vector<CGBase> indVars(n);
+        makeIndependentVariables(handler, indVars);
+
+        std::vector<CGBase> w(m);
+        handler.makeVariables(w);
+        if (_x.size() > 0) {
+            for (size_t i = 0; i < m; i++) {
+                w[i].setValue(Base(1.0));
+            }
+        }
+
+        std::vector<CGBase> hess(rows.size());
+        if (!rows.empty()) {
+            CppAD::sparse_hessian_work work;
+            _fun.SparseHessian(indVars, w, sparsity, rows, cols, hess, work);
+        }
+
+        generateSparsitySource(out, "hessian", rows, cols);
+
+        LangCDefaultVariableNameGenerator<Base> nameGen("hess");
+        LangCDefaultHessianVarNameGenerator<Base> nameGenHess(&nameGen, "w", n);
+        generateFunctionSource(out, handler, hess, nameGenHess, "sparse_hessian", {n, m});
+    }
+
+    inline void makeIndependentVariables(CodeHandler<Base>& handler,
+                                         std::vector<CGBase>& indVars) {
+        handler.makeVariables(indVars);
+        if (_x.size() > 0) {
+            for (size_t i = 0; i < indVars.size(); i++) {
+                indVars[i].setValue(_x[i]);
+            }
+        }
+    }
+
+    inline void generateFunctionSource(std::ostringstream& out,
+                                       CodeHandler<Base>& handler,
+                                       std::vector<CGBase>& dep,
+                                       VariableNameGenerator<Base>& nameGen,
+                                       const std::string& functionName,
+                                       const std::vector<size_t>& indepSizes) {
+        LanguageCpp<Base> langCpp(_templateTypeName);
+        langCpp.setParameterPrecision(_parameterPrecision);
+        langCpp.setGenerateFunction(functionName);
+        langCpp.setIndependentSizes(indepSizes);
+
+        handler.generateCode(out, langCpp, dep, nameGen, _name + " " + functionName);
+        out << "\n";
+    }
+
+    inline void generateSparsitySource(std::ostringstream& out,
+                                       const std::string& prefix,
+                                       const std::vector<size_t>& rows,
+                                       const std::vector<size_t>& cols) {
+        out << "constexpr unsigned long " << prefix << "_nnz = " << rows.size() << ";\n";
+        generateIndexArraySource(out, prefix + "_rows", prefix + "_nnz", rows);
+        generateIndexArraySource(out, prefix + "_cols", prefix + "_nnz", cols);
+        out << "\n";
+    }
+
+    static inline void generateIndexArraySource(std::ostringstream& out,
+                                                const std::string& name,
+                                                const std::string& sizeName,
+                                                const std::vector<size_t>& values) {
+        out << "constexpr std::array<unsigned long, " << sizeName << "> " << name << " = {{";
+        for (size_t e = 0; e < values.size(); e++) {
+            if (e > 0) out << ",";
+            out << values[e];
+        }
+        out << "}};\n";
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -134,6 +134,70 @@ public:
      */
     virtual unsigned int getThreadPoolNumberOfTimeMeas() const = 0;
 
+    /**
+     * Defines the cores where the threads of the thread pool are pinned to.
+     * The thread with index i is pinned to the core cores[i % cores.size()].
+     * When the static scheduling strategy is used, each work group is
+     * assigned to a thread and a thread always processes the groups
+     * assigned to it first so that the data used by those jobs tends to
+     * remain close to the same core (NUMA).
+     * A thread only takes a group assigned to another thread when none of
+     * its own groups remain in the queue (work stealing), therefore the
+     * same jobs are not guaranteed to run in the same thread in every
+     * evaluation.
+     * This value is only used by the models if they were compiled with
+     * pthreads multithreading support on Linux.
+     *
+     * @param cores the core indexes (empty for no affinity, which also
+     *              restores the default affinity of existing threads)
+     */
+    virtual void setThreadPoolAffinity(const std::vector<int>& cores) = 0;
+
+    /**
+     * Provides the cores where the threads of the thread pool are pinned to.
+     *
+     * @return the core indexes (empty for no affinity)
+     */
+    virtual std::vector<int> getThreadPoolAffinity() const = 0;
+
+    /**
+     * Defines an executor provided by the host application which will
+     * receive the jobs of multithreaded model evaluations instead of the
+     * thread pool of this library (which is shut down).
+     * The same executor can be shared by several libraries to avoid
+     * oversubscribing the processor cores.
+     * This is only used by the models if they were compiled with
+     * pthreads multithreading support.
+     * It should be defined before using the models.
+     *
+     * @param submit the function used to submit a job to the executor
+     *               (nullptr to go back to the internal thread pool)
+     * @param wait the function used to wait for the jobs submitted by the
+     *             calling thread
+     * @param ctx a user provided pointer passed to submit and wait
+     */
+    virtual void setThreadPoolExecutor(ThreadPoolExecutorSubmit submit,
+                                       ThreadPoolExecutorWait wait,
+                                       void* ctx) = 0;
+
+    /**
+     * Provides the number of calls and the time spent in each generated
+     * function of the models compiled with profiling enabled
+     * (see ModelCSourceGen::setProfiling()).
+     * Only functions which were called at least once (since the library
+     * was loaded) are included.
+     * The time of a function includes the time of the functions it calls.
+     *
+     * @return the statistics of each function sorted by decreasing time
+     */
+    virtual std::vector<FunctionProfile> getFunctionProfiles() const = 0;
+
+    /**
+     * Sets the number of calls and the time of all profiled functions to
+     * zero.
+     */
+    virtual void resetFunctionProfiles() = 0;
+
     inline virtual ~ModelLibrary() = default;
 
 };
@@ -42,6 +42,11 @@ public:
     static const std::string FUNCTION_GETTHREADPOOLGUIDEDMAXGROUPWORK;
     static const std::string FUNCTION_SETTHREADPOOLNUMBEROFTIMEMEAS;
     static const std::string FUNCTION_GETTHREADPOOLNUMBEROFTIMEMEAS;
+    static const std::string FUNCTION_SETTHREADPOOLEXECUTOR;
+    static const std::string FUNCTION_SETTHREADPOOLAFFINITY;
+    static const std::string FUNCTION_GETTHREADPOOLAFFINITY;
+    static const std::string FUNCTION_PROFILEGET;
+    static const std::string FUNCTION_PROFILERESET;
     static const unsigned long API_VERSION;
 protected:
     static const std::string CONST;
@@ -186,6 +191,8 @@ protected:
 
     virtual void generateThreadPoolSources(std::map<std::string, std::string>& sources);
 
+    virtual void generateProfileSources(std::map<std::string, std::string>& sources);
+
     static void saveSources(const std::string& sourcesFolder,
                             const std::map<std::string, std::string>& sources);
 
@@ -68,6 +68,21 @@ const std::string ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLNUMBEROFTI
 template<class Base>
 const std::string ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLNUMBEROFTIMEMEAS = "cppad_cg_thpool_get_number_of_time_meas";
 
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLEXECUTOR = "cppad_cg_thpool_set_executor";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLAFFINITY = "cppad_cg_thpool_set_affinity";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLAFFINITY = "cppad_cg_thpool_get_affinity";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_PROFILEGET = "cppad_cg_profile_get";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_PROFILERESET = "cppad_cg_profile_reset";
+
 template<class Base>
 const std::string ModelLibraryCSourceGen<Base>::CONST = "const";
 
@@ -109,11 +124,13 @@ const std::map<std::string, std::string>& ModelLibraryCSourceGen<Base>::getLibra
         generateModelsSource(_libSources);
         generateOnCloseSource(_libSources);
         generateThreadPoolSources(_libSources);
+        generateProfileSources(_libSources);
 
         if(_multiThreading != MultiThreadingType::NONE) {
             bool usingMultiThreading = false;
             for (const auto& it : _models) {
-                if (it.second->isJacobianMultiThreadingEnabled() || it.second->isHessianMultiThreadingEnabled()) {
+                if (it.second->isJacobianMultiThreadingEnabled() || it.second->isHessianMultiThreadingEnabled() ||
+                    it.second->isParallelTasksEnabled()) {
                     usingMultiThreading = true;
                     break;
                 }
@@ -170,7 +187,8 @@ void ModelLibraryCSourceGen<Base>::generateOnCloseSource(std::map<std::string, s
     bool pthreads = false;
     if(_multiThreading == MultiThreadingType::PTHREADS) {
         for (const auto& it : _models) {
-            if (it.second->isJacobianMultiThreadingEnabled() || it.second->isHessianMultiThreadingEnabled()) {
+            if (it.second->isJacobianMultiThreadingEnabled() || it.second->isHessianMultiThreadingEnabled() ||
+                it.second->isParallelTasksEnabled()) {
                 pthreads = true;
                 break;
             }
@@ -196,7 +214,8 @@ void ModelLibraryCSourceGen<Base>::generateThreadPoolSources(std::map<std::strin
     bool usingMultiThreading = false;
     if(_multiThreading != MultiThreadingType::NONE) {
         for (const auto& it : _models) {
-            if (it.second->isJacobianMultiThreadingEnabled() || it.second->isHessianMultiThreadingEnabled()) {
+            if (it.second->isJacobianMultiThreadingEnabled() || it.second->isHessianMultiThreadingEnabled() ||
+                it.second->isParallelTasksEnabled()) {
                 usingMultiThreading = true;
                 break;
             }
@@ -255,6 +274,20 @@ void ModelLibraryCSourceGen<Base>::generateThreadPoolSources(std::map<std::strin
         _cache << "   return cppadcg_thpool_get_n_time_meas();\n";
         _cache << "}\n\n";
 
+        _cache << "void " << FUNCTION_SETTHREADPOOLEXECUTOR << "(void (*submit)(void*, void (*)(void*), void*),\n"
+                  "     void (*wait)(void*),\n"
+                  "     void* ctx) {\n";
+        _cache << "   cppadcg_thpool_set_executor(submit, wait, ctx);\n";
+        _cache << "}\n\n";
+
+        _cache << "void " << FUNCTION_SETTHREADPOOLAFFINITY << "(const int* cores, int n) {\n";
+        _cache << "   cppadcg_thpool_set_affinity(cores, n);\n";
+        _cache << "}\n\n";
+
+        _cache << "int " << FUNCTION_GETTHREADPOOLAFFINITY << "(int const** cores) {\n";
+        _cache << "   return cppadcg_thpool_get_affinity(cores);\n";
+        _cache << "}\n\n";
+
         sources["thread_pool_access.c"] = _cache.str();
 
     } else if(usingMultiThreading && _multiThreading == MultiThreadingType::OPENMP) {
@@ -308,6 +341,19 @@ void ModelLibraryCSourceGen<Base>::generateThreadPoolSources(std::map<std::strin
         _cache << "   return 0;\n";
         _cache << "}\n\n";
 
+        _cache << "void " << FUNCTION_SETTHREADPOOLEXECUTOR << "(void (*submit)(void*, void (*)(void*), void*),\n"
+                  "     void (*wait)(void*),\n"
+                  "     void* ctx) {\n";
+        _cache << "}\n\n";
+
+        _cache << "void " << FUNCTION_SETTHREADPOOLAFFINITY << "(const int* cores, int n) {\n";
+        _cache << "}\n\n";
+
+        _cache << "int " << FUNCTION_GETTHREADPOOLAFFINITY << "(int const** cores) {\n";
+        _cache << "   *cores = 0;\n";
+        _cache << "   return 0;\n";
+        _cache << "}\n\n";
+
         sources["thread_pool_access.c"] = _cache.str();
 
     } else {
@@ -356,10 +402,92 @@ void ModelLibraryCSourceGen<Base>::generateThreadPoolSources(std::map<std::strin
         _cache << "   return 0;\n";
         _cache << "}\n\n";
 
+        _cache << "void " << FUNCTION_SETTHREADPOOLEXECUTOR << "(void (*submit)(void*, void (*)(void*), void*),\n"
+                  "     void (*wait)(void*),\n"
+                  "     void* ctx) {\n";
+        _cache << "}\n\n";
+
+        _cache << "void " << FUNCTION_SETTHREADPOOLAFFINITY << "(const int* cores, int n) {\n";
+        _cache << "}\n\n";
+
+        _cache << "int " << FUNCTION_GETTHREADPOOLAFFINITY << "(int const** cores) {\n";
+        _cache << "   *cores = 0;\n";
+        _cache << "   return 0;\n";
+        _cache << "}\n\n";
+
         sources["thread_pool_access.c"] = _cache.str();
     }
 }
 
+template<class Base>
+void ModelLibraryCSourceGen<Base>::generateProfileSources(std::map<std::string, std::string>& sources) {
+    /**
+     * The counters of the functions generated with profiling enabled are
+     * added to a lock-free list when they are called for the first time.
+     * The library functions are always created so that the list can be
+     * retrieved even if no model uses profiling.
+     */
+    _cache.str("");
+    _cache << "#ifndef _POSIX_C_SOURCE\n"
+              "#define _POSIX_C_SOURCE 199309L\n"
+              "#endif\n"
+              "#include <time.h>\n\n"
+           << LanguageC<Base>::PROFILE_STRUCT_DEFINITION << "\n\n"
+              "static CppADCGProfile* cppadcg_profile_list = 0;\n"
+              "\n"
+              "static unsigned long long cppadcg_profile_now() {\n"
+              "   struct timespec t;\n"
+              "   clock_gettime(CLOCK_MONOTONIC, &t);\n"
+              "   return (unsigned long long) t.tv_sec * 1000000000ULL + (unsigned long long) t.tv_nsec;\n"
+              "}\n"
+              "\n"
+              "unsigned long long cppadcg_profile_begin(CppADCGProfile* p) {\n"
+              "   if (!__atomic_load_n(&p->registered, __ATOMIC_ACQUIRE) &&\n"
+              "       !__atomic_exchange_n(&p->registered, 1, __ATOMIC_ACQ_REL)) {\n"
+              "      CppADCGProfile* head = __atomic_load_n(&cppadcg_profile_list, __ATOMIC_RELAXED);\n"
+              "      do {\n"
+              "         p->next = head;\n"
+              "      } while (!__atomic_compare_exchange_n(&cppadcg_profile_list, &head, p, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));\n"
+              "   }\n"
+              "   return cppadcg_profile_now();\n"
+              "}\n"
+              "\n"
+              "void cppadcg_profile_end(CppADCGProfile* p, unsigned long long t0) {\n"
+              "   unsigned long long dt = cppadcg_profile_now() - t0;\n"
+              "   __atomic_fetch_add(&p->calls, 1, __ATOMIC_RELAXED);\n"
+              "   __atomic_fetch_add(&p->nanoseconds, dt, __ATOMIC_RELAXED);\n"
+              "}\n\n";
+
+    LanguageC<Base>::printFunctionDeclaration(_cache, "int", FUNCTION_PROFILEGET, {"const char** names",
+                                                                                   "unsigned long long* calls",
+                                                                                   "unsigned long long* nanoseconds",
+                                                                                   "int max"});
+    _cache << " {\n"
+              "   int n = 0;\n"
+              "   CppADCGProfile* p = __atomic_load_n(&cppadcg_profile_list, __ATOMIC_ACQUIRE);\n"
+              "   for (; p != 0; p = p->next) {\n"
+              "      if (n < max) {\n"
+              "         names[n] = p->name;\n"
+              "         calls[n] = __atomic_load_n(&p->calls, __ATOMIC_RELAXED);\n"
+              "         nanoseconds[n] = __atomic_load_n(&p->nanoseconds, __ATOMIC_RELAXED);\n"
+              "      }\n"
+              "      n++;\n"
+              "   }\n"
+              "   return n;\n"
+              "}\n\n";
+
+    _cache << "void " << FUNCTION_PROFILERESET << "() {\n"
+              "   CppADCGProfile* p = __atomic_load_n(&cppadcg_profile_list, __ATOMIC_ACQUIRE);\n"
+              "   for (; p != 0; p = p->next) {\n"
+              "      __atomic_store_n(&p->calls, 0, __ATOMIC_RELAXED);\n"
+              "      __atomic_store_n(&p->nanoseconds, 0, __ATOMIC_RELAXED);\n"
+              "   }\n"
+              "}\n\n";
+
+    sources["cppad_cg_profile.c"] = _cache.str();
+    _cache.str("");
+}
+
 } // END cg namespace
 } // END CppAD namespace
 
@@ -32,6 +32,8 @@ void ModelCSourceGen<Base>::prepareSparseForwardOneWithLoops(const std::map<size
     
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setGraphRewriter(_graphRewriter);
+    handler.setScheduleOperations(_scheduleOperations);
     handler.setZeroDependents(false);
 
     auto& indexJcolDcl = *handler.makeIndexDclrNode("jcol");
@@ -347,6 +349,8 @@ void ModelCSourceGen<Base>::prepareSparseForwardOneWithLoops(const std::map<size
             LanguageC<Base> langC(_baseTypeName);
             langC.setFunctionIndexArgument(indexJcolDcl);
             langC.setParameterPrecision(_parameterPrecision);
+            langC.setProfiling(_profiling);
+            langC.setLoopVectorization(_loopVectorization);
 
             _cache.str("");
             std::ostringstream code;
@@ -431,6 +435,8 @@ void ModelCSourceGen<Base>::createForwardOneWithLoopsNL(CodeHandler<Base>& handl
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setProfiling(_profiling);
+    langC.setLoopVectorization(_loopVectorization);
     _cache.str("");
     _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_noloop_indep" << j;
     langC.setGenerateFunction(_cache.str());
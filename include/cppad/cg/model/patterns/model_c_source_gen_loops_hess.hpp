@@ -65,15 +65,7 @@ void ModelCSourceGen<Base>::analyseSparseHessianWithLoops(const std::vector<size
     /**
      * determine sparsities
      */
-    for (LoopModel<Base>* l : _loopTapes) {
-        l->evalJacobianSparsity();
-        l->evalHessianSparsity();
-    }
-
-    if (_funNoLoops != nullptr) {
-        _funNoLoops->evalJacobianSparsity();
-        _funNoLoops->evalHessianSparsity();
-    }
+    evalLoopSparsities(true);
 
     size_t m = _fun.Range();
     size_t n = _fun.Domain();
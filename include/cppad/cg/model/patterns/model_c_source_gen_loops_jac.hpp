@@ -52,12 +52,7 @@ void ModelCSourceGen<Base>::analyseSparseJacobianWithLoops(const std::vector<siz
     /**
      * determine sparsities
      */
-    for (LoopModel<Base>* l : _loopTapes) {
-        l->evalJacobianSparsity();
-    }
-
-    if (_funNoLoops != nullptr)
-        _funNoLoops->evalJacobianSparsity();
+    evalLoopSparsities(false);
 
     /**
      * Generate index patterns for the Jacobian elements resulting from loops
@@ -35,6 +35,33 @@ bool operator<(const HessianTermContrib<Base>& l, const HessianTermContrib<Base>
 template<class Base>
 class HessianRowGroup;
 
+/**
+ * The operation graph used to generate the second order reverse mode
+ * functions of a single loop (each loop has its own CodeHandler so that
+ * the source code of different loops can be created concurrently)
+ */
+template<class Base>
+class LoopReverseTwoGraph {
+public:
+    CodeHandler<Base> handler;
+    OperationNode<Base>* indexJrowDcl;
+    OperationNode<Base>* indexLocalItDcl;
+    OperationNode<Base>* indexLocalItCountDcl;
+    OperationNode<Base>* indexIterationDcl;
+    IndexOperationNode<Base>* jrowIndexOp;
+    CG<Base> tx1;
+    // Jacobian of the temporary variables used by the loop
+    std::map<size_t, std::map<size_t, CG<Base> > > dzDx;
+
+    inline LoopReverseTwoGraph() :
+        indexJrowDcl(nullptr),
+        indexLocalItDcl(nullptr),
+        indexLocalItCountDcl(nullptr),
+        indexIterationDcl(nullptr),
+        jrowIndexOp(nullptr) {
+    }
+};
+
 template<class Base>
 std::vector<std::pair<CG<Base>, IndexPattern*> > generateReverseTwoGroupOps(CodeHandler<Base>& handler,
                                                                             const LoopModel<Base>& lModel,
@@ -65,47 +92,6 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
 
     size_t m = _fun.Range();
     size_t n = _fun.Domain();
-    
-    CodeHandler<Base> handler;
-    handler.setJobTimer(_jobTimer);
-    handler.setZeroDependents(false);
-    
-    auto& indexJrowDcl = *handler.makeIndexDclrNode("jrow");
-    auto& indexLocalItDcl = *handler.makeIndexDclrNode("it");
-    auto& indexLocalItCountDcl = *handler.makeIndexDclrNode("itCount");
-    auto& indexIterationDcl = *handler.makeIndexDclrNode(LoopModel<Base>::ITERATION_INDEX_NAME);
-    auto& jrowIndexOp = *handler.makeIndexNode(indexJrowDcl);
-
-    std::vector<OperationNode<Base>* > localNodes(5);
-    localNodes[0] = &indexJrowDcl;
-    localNodes[1] = &indexLocalItDcl;
-    localNodes[2] = &indexLocalItCountDcl;
-    localNodes[3] = &indexIterationDcl;
-    localNodes[4] = &jrowIndexOp;
-
-    // independent variables
-    std::vector<CGBase> x(n);
-    handler.makeVariables(x);
-    if (_x.size() > 0) {
-        for (size_t i = 0; i < n; i++) {
-            x[i].setValue(_x[i]);
-        }
-    }
-
-    CGBase tx1;
-    handler.makeVariable(tx1);
-    if (_x.size() > 0) {
-        tx1.setValue(Base(1.0));
-    }
-
-    // multipliers
-    std::vector<CGBase> py(m); // (k+1)*m is not used because we are not interested in all values
-    handler.makeVariables(py);
-    if (_x.size() > 0) {
-        for (size_t i = 0; i < m; i++) {
-            py[i].setValue(Base(1.0));
-        }
-    }
 
     size_t nonIndexdedEqSize = _funNoLoops != nullptr ? _funNoLoops->getOrigDependentIndexes().size() : 0;
 
@@ -140,34 +126,77 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
                                   noLoopEvalHessLocations, loopHessInfo, false);
 
     /***********************************************************************
-     *        generate the operation graph
+     *        generate the operation graph of each loop
      **********************************************************************/
     /**
-     * Calculate Hessians and Jacobians
+     * Each loop has its own CodeHandler so that the source code of the
+     * loops can be created concurrently.
+     * The tapes are evaluated sequentially.
      */
-    // temporaries (zero orders)
-    std::vector<CGBase> tmpsAlias;
-    if (_funNoLoops != nullptr) {
-        ADFun<CGBase>& fun = _funNoLoops->getTape();
+    bool hasAtomics = isAtomicsUsed(); // TODO: improve this by checking only the current fun
 
-        tmpsAlias.resize(fun.Range() - nonIndexdedEqSize);
-        for (size_t k = 0; k < tmpsAlias.size(); k++) {
-            // to be defined later
-            tmpsAlias[k] = CG<Base>(*handler.makeNode(CGOpCode::Alias));
+    std::vector<LoopModel<Base>*> loopModels;
+    std::vector<std::unique_ptr<LoopReverseTwoGraph<Base> > > loopGraphs;
+
+    for (auto& itLoop2Info : loopHessInfo) {
+        LoopModel<Base>& lModel = *itLoop2Info.first;
+        HessianWithLoopsInfo<Base>& info = itLoop2Info.second;
+
+        loopModels.push_back(&lModel);
+        loopGraphs.emplace_back(new LoopReverseTwoGraph<Base>());
+        LoopReverseTwoGraph<Base>& graph = *loopGraphs.back();
+
+        CodeHandler<Base>& handler = graph.handler;
+        handler.setJobTimer(_jobTimer);
+        handler.setGraphRewriter(_graphRewriter);
+        handler.setScheduleOperations(_scheduleOperations);
+        handler.setZeroDependents(false);
+
+        graph.indexJrowDcl = handler.makeIndexDclrNode("jrow");
+        graph.indexLocalItDcl = handler.makeIndexDclrNode("it");
+        graph.indexLocalItCountDcl = handler.makeIndexDclrNode("itCount");
+        graph.indexIterationDcl = handler.makeIndexDclrNode(LoopModel<Base>::ITERATION_INDEX_NAME);
+        graph.jrowIndexOp = handler.makeIndexNode(*graph.indexJrowDcl);
+
+        // independent variables
+        std::vector<CGBase> x(n);
+        handler.makeVariables(x);
+        if (_x.size() > 0) {
+            for (size_t i = 0; i < n; i++) {
+                x[i].setValue(_x[i]);
+            }
         }
-    }
 
-    /**
-     * prepare loop independents
-     */
-    typename map<LoopModel<Base>*, HessianWithLoopsInfo<Base> >::iterator itLoop2Info;
-    for (itLoop2Info = loopHessInfo.begin(); itLoop2Info != loopHessInfo.end(); ++itLoop2Info) {
-        LoopModel<Base>& lModel = *itLoop2Info->first;
-        HessianWithLoopsInfo<Base>& info = itLoop2Info->second;
+        handler.makeVariable(graph.tx1);
+        if (_x.size() > 0) {
+            graph.tx1.setValue(Base(1.0));
+        }
 
-        info.iterationIndexOp = handler.makeIndexNode(indexIterationDcl);
-        set<IndexOperationNode<Base>*> indexesOps;
-        indexesOps.insert(info.iterationIndexOp);
+        // multipliers
+        std::vector<CGBase> py(m); // (k+1)*m is not used because we are not interested in all values
+        handler.makeVariables(py);
+        if (_x.size() > 0) {
+            for (size_t i = 0; i < m; i++) {
+                py[i].setValue(Base(1.0));
+            }
+        }
+
+        // temporaries (zero orders)
+        std::vector<CGBase> tmpsAlias;
+        if (_funNoLoops != nullptr) {
+            ADFun<CGBase>& fun = _funNoLoops->getTape();
+
+            tmpsAlias.resize(fun.Range() - nonIndexdedEqSize);
+            for (size_t k = 0; k < tmpsAlias.size(); k++) {
+                // to be defined later
+                tmpsAlias[k] = CG<Base>(*handler.makeNode(CGOpCode::Alias));
+            }
+        }
+
+        /**
+         * prepare loop independents
+         */
+        info.iterationIndexOp = handler.makeIndexNode(*graph.indexIterationDcl);
 
         /**
          * make the loop's indexed variables
@@ -176,21 +205,10 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
         info.x = createLoopIndependentVector(handler, lModel, indexedIndeps, x, tmpsAlias);
 
         info.w = createLoopDependentVector(handler, lModel, *info.iterationIndexOp);
-    }
-
-    /**
-     * Calculate Hessians and Jacobians
-     */
-    /**
-     * Loops - evaluate Jacobian and Hessian
-     */
-    bool hasAtomics = isAtomicsUsed(); // TODO: improve this by checking only the current fun
-    //const std::map<size_t, std::set<size_t> >& aaa = getAtomicsIndeps();
-
-    for (itLoop2Info = loopHessInfo.begin(); itLoop2Info != loopHessInfo.end(); ++itLoop2Info) {
-        LoopModel<Base>& lModel = *itLoop2Info->first;
-        HessianWithLoopsInfo<Base>& info = itLoop2Info->second;
 
+        /**
+         * Loop - evaluate Jacobian and Hessian
+         */
         _cache.str("");
         _cache << "model (Jacobian + Hessian, loop " << lModel.getLoopId() << ")";
         std::string jobName = _cache.str();
@@ -200,33 +218,38 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
         info.evalLoopModelJacobianHessian(hasAtomics);
 
         finishedJob();
-    }
-
-    /**
-     * No loops
-     */
-    map<size_t, map<size_t, CGBase> > dzDx;
-    if (_funNoLoops != nullptr) {
-        ADFun<CGBase>& fun = _funNoLoops->getTape();
-        std::vector<CGBase> yNL(fun.Range());
 
         /**
-         * Jacobian and Hessian - temporary variables
+         * No loops
          */
-        startingJob("'model (Jacobian + Hessian, temporaries)'", JobTimer::GRAPH);
+        if (_funNoLoops != nullptr) {
+            ADFun<CGBase>& fun = _funNoLoops->getTape();
+            std::vector<CGBase> yNL(fun.Range());
 
-        dzDx = _funNoLoops->calculateJacobianHessianUsedByLoops(handler,
-                                                                loopHessInfo, x, yNL,
-                                                                noLoopEvalJacSparsity,
-                                                                hasAtomics);
+            /**
+             * Jacobian and Hessian - temporary variables used by this loop
+             */
+            _cache.str("");
+            _cache << "model (Jacobian + Hessian, temporaries, loop " << lModel.getLoopId() << ")";
+            jobName = _cache.str();
 
-        finishedJob();
+            startingJob("'" + jobName + "'", JobTimer::GRAPH);
+
+            map<LoopModel<Base>*, HessianWithLoopsInfo<Base> > loopInfo;
+            std::swap(loopInfo[&lModel], info);
+
+            graph.dzDx = _funNoLoops->calculateJacobianHessianUsedByLoops(handler,
+                                                                          loopInfo, x, yNL,
+                                                                          noLoopEvalJacSparsity,
+                                                                          hasAtomics);
+
+            std::swap(loopInfo[&lModel], info);
+
+            finishedJob();
 
-        for (size_t i = 0; i < tmpsAlias.size(); i++)
-            tmpsAlias[i].getOperationNode()->getArguments().push_back(asArgument(yNL[nonIndexdedEqSize + i]));
+            for (size_t i = 0; i < tmpsAlias.size(); i++)
+                tmpsAlias[i].getOperationNode()->getArguments().push_back(asArgument(yNL[nonIndexdedEqSize + i]));
 
-        for (itLoop2Info = loopHessInfo.begin(); itLoop2Info != loopHessInfo.end(); ++itLoop2Info) {
-            HessianWithLoopsInfo<Base>& info = itLoop2Info->second;
             // not needed anymore:
             info.dyiDzk.clear();
         }
@@ -234,206 +257,27 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
 
     /**
      * Loops - Hessian
+     * (the row groups of each loop are only modified by the thread
+     * processing that loop)
      */
-    for (itLoop2Info = loopHessInfo.begin(); itLoop2Info != loopHessInfo.end(); ++itLoop2Info) {
-        LoopModel<Base>& lModel = *itLoop2Info->first;
-        HessianWithLoopsInfo<Base>& info = itLoop2Info->second;
-
-        /*******************************************************************
-         * create Hessian row groups
-         * for the contributions from the equations in loops
-         ******************************************************************/
-        SmartVectorPointer<HessianRowGroup<Base> > loopGroups;
-
-        generateHessianRowGroups(lModel, info, n, loopGroups);
-
-        /*******************************************************************
-         * generate the operation graph for each Hessian row subgroup
-         ******************************************************************/
-        for (size_t g = 0; g < loopGroups.size(); g++) {
-            HessianRowGroup<Base>& group = *loopGroups[g];
-
-            /**
-             * determine if a loop should be created
-             */
-            LoopStartOperationNode<Base>* loopStart = nullptr;
-
-            map<size_t, set<size_t> > localIterCount2Jrows;
-
-            for (const auto& itJrow2It : group.jRow2Iterations) {
-                size_t jrow = itJrow2It.first;
-                size_t itCount = itJrow2It.second.size();
-                localIterCount2Jrows[itCount].insert(jrow);
-            }
-
-            bool createsLoop = localIterCount2Jrows.size() != 1 || // is there a different number of it
-                    localIterCount2Jrows.begin()->first != 1; // is there always just on iteration?
-
-            /**
-             * Model index pattern
-             * 
-             * detect the index pattern for the model iterations
-             * based on jrow and the local loop iteration
-             */
-            map<size_t, map<size_t, size_t> > jrow2localIt2ModelIt;
-
-            for (const auto& itJrow2It : group.jRow2Iterations) {
-                size_t jrow = itJrow2It.first;
-
-                map<size_t, size_t>& localIt2ModelIt = jrow2localIt2ModelIt[jrow];
-                size_t localIt = 0;
-                for (auto itIt = itJrow2It.second.begin(); itIt != itJrow2It.second.end(); ++itIt, localIt++) {
-                    localIt2ModelIt[localIt] = *itIt;
-                }
-            }
-
-            /**
-             * try to fit a combination of two patterns:
-             *  j = fStart(jrow) + flit(lit);
-             */
-            std::unique_ptr<IndexPattern> itPattern(Plane2DIndexPattern::detectPlane2D(jrow2localIt2ModelIt));
-
-            if (itPattern.get() == nullptr) {
-                // did not match!
-                itPattern.reset(new Random2DIndexPattern(jrow2localIt2ModelIt));
-            }
-
-            /**
-             * Local iteration count pattern
-             */
-            IndexOperationNode<Base>* localIterIndexOp = nullptr;
-            IndexOperationNode<Base>* localIterCountIndexOp = nullptr;
-            IndexAssignOperationNode<Base>* itCountAssignOp = nullptr;
-            std::unique_ptr<IndexPattern> indexLocalItCountPattern;
-
-            if (createsLoop) {
-                map<size_t, size_t> jrow2litCount;
-
-                for (const auto& itJrow2Its : group.jRow2Iterations) {
-                    size_t jrow = itJrow2Its.first;
-                    jrow2litCount[jrow] = itJrow2Its.second.size();
-                }
-
-                indexLocalItCountPattern.reset(IndexPattern::detect(jrow2litCount));
-
-                if (IndexPattern::isConstant(*indexLocalItCountPattern.get())) {
-                    size_t itCount = group.jRow2Iterations.begin()->second.size();
-                    loopStart = handler.makeLoopStartNode(indexLocalItDcl, itCount);
-                } else {
-                    itCountAssignOp = handler.makeIndexAssignNode(indexLocalItCountDcl, *indexLocalItCountPattern.get(), jrowIndexOp);
-                    localIterCountIndexOp = handler.makeIndexNode(*itCountAssignOp);
-                    loopStart = handler.makeLoopStartNode(indexLocalItDcl, *localIterCountIndexOp);
-                }
-
-                localIterIndexOp = handler.makeIndexNode(*loopStart);
-            }
-
-
-            auto* iterationIndexPatternOp = handler.makeIndexAssignNode(indexIterationDcl, *itPattern.get(), &jrowIndexOp, localIterIndexOp);
-            info.iterationIndexOp->makeAssigmentDependent(*iterationIndexPatternOp);
-
-            map<size_t, set<size_t> > jrow2CompressedLoc;
-            std::vector<pair<CG<Base>, IndexPattern*> > indexedLoopResults;
-
-            indexedLoopResults = generateReverseTwoGroupOps(handler, lModel, info,
-                                                            group, tx1,
-                                                            dzDx,
-                                                            jrow2CompressedLoc);
-
-            _loopRev2Groups[&lModel][g] = jrow2CompressedLoc;
-
-            LoopEndOperationNode<Base>* loopEnd = nullptr;
-            std::vector<CGBase> pxCustom;
-            if (createsLoop) {
-                /**
-                 * make the loop end
-                 */
-                size_t assignOrAdd = 1;
-                set<IndexOperationNode<Base>*> indexesOps;
-                indexesOps.insert(info.iterationIndexOp);
-                loopEnd = createLoopEnd(handler, *loopStart, indexedLoopResults, indexesOps, assignOrAdd);
-
-                /**
-                 * move non-indexed expressions outside loop
-                 */
-                moveNonIndexedOutsideLoop(handler, *loopStart, *loopEnd);
-
-                /**
-                 * 
-                 */
-                pxCustom.resize(1);
-
-                // {0} : must point to itself since there is only one dependent
-                pxCustom[0] = handler.createCG(*handler.makeNode(CGOpCode::DependentRefRhs,{0},{*loopEnd}));
-
-            } else {
-                /**
-                 * No loop required
-                 */
-                pxCustom.resize(indexedLoopResults.size());
-                for (size_t i = 0; i < indexedLoopResults.size(); i++) {
-                    const CGBase& val = indexedLoopResults[i].first;
-                    IndexPattern* ip = indexedLoopResults[i].second;
-
-                    pxCustom[i] = createLoopDependentFunctionResult(handler, i, val, ip, *info.iterationIndexOp);
-                }
-
-            }
-
-            LanguageC<Base> langC(_baseTypeName);
-            langC.setFunctionIndexArgument(indexJrowDcl);
-            langC.setParameterPrecision(_parameterPrecision);
-
-            std::ostringstream code;
-            std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("px"));
-            LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n, 1);
+    std::vector<std::map<std::string, std::string> > loopSources(loopModels.size());
+    for (LoopModel<Base>* lModel : loopModels) {
+        _loopRev2Groups[lModel].clear();
+    }
 
-            /**
-             * Generate the source code inside the loop
-             */
-            _cache.str("");
-            _cache << "model (reverse two, loop " << lModel.getLoopId() << ", group " << g << ")";
-            string jobName = _cache.str();
-            handler.generateCode(code, langC, pxCustom, nameGenRev2, _atomicFunctions, jobName);
+    CppADParallelFor<CGBase>::run(loopModels.size(), hasAtomics ? 1 : _loopThreads, [&](size_t l) {
+        LoopModel<Base>& lModel = *loopModels[l];
 
-            _cache.str("");
-            generateFunctionNameLoopRev2(_cache, lModel, g);
-            std::string functionName = _cache.str();
+        generateSparseReverseTwoLoopSources(lModel, loopHessInfo.at(&lModel), *loopGraphs[l],
+                                            _loopRev2Groups.at(&lModel), loopSources[l]);
 
-            std::string argsDcl = langC.generateFunctionArgumentsDcl();
+        loopGraphs[l].reset(); // release the memory used by the operation graph
+    });
 
-            _cache.str("");
-            _cache << "#include <stdlib.h>\n"
-                    "#include <math.h>\n"
-                    "\n"
-                    << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
-                    "\n"
-                    "void " << functionName << "(" << argsDcl << ") {\n";
-            nameGenRev2.customFunctionVariableDeclarations(_cache);
-            _cache << langC.generateIndependentVariableDeclaration() << "\n";
-            _cache << langC.generateDependentVariableDeclaration() << "\n";
-            _cache << langC.generateTemporaryVariableDeclaration(false, false,
-                                                                 handler.getExternalFuncMaxForwardOrder(),
-                                                                 handler.getExternalFuncMaxReverseOrder()) << "\n";
-            nameGenRev2.prepareCustomFunctionVariables(_cache);
-
-            // code inside the loop
-            _cache << code.str();
-
-            nameGenRev2.finalizeCustomFunctionVariables(_cache);
-            _cache << "}\n\n";
-
-            _sources[functionName + ".c"] = _cache.str();
-            _cache.str("");
-
-            /**
-             * prepare the nodes to be reused!
-             */
-            if (g + 1 < loopGroups.size()) {
-                handler.resetNodes(); // uncolor nodes
-            }
+    for (std::map<std::string, std::string>& sources : loopSources) {
+        for (auto& it : sources) {
+            _sources[it.first] = std::move(it.second);
         }
-
     }
 
     /*******************************************************************
@@ -455,6 +299,8 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
             // we can use a new handler to reduce memory usage
             CodeHandler<Base> handlerNL;
             handlerNL.setJobTimer(_jobTimer);
+            handlerNL.setGraphRewriter(_graphRewriter);
+            handlerNL.setScheduleOperations(_scheduleOperations);
 
             std::vector<CGBase> tx0(n);
             handlerNL.makeVariables(tx0);
@@ -526,6 +372,8 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
                 langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
                 langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
                 langC.setParameterPrecision(_parameterPrecision);
+                langC.setProfiling(_profiling);
+                langC.setLoopVectorization(_loopVectorization);
                 _cache.str("");
                 _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_noloop_indep" << j;
                 string functionName = _cache.str();
@@ -560,6 +408,220 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
     _cache.str("");
 }
 
+template<class Base>
+void ModelCSourceGen<Base>::generateSparseReverseTwoLoopSources(LoopModel<Base>& lModel,
+                                                                loops::HessianWithLoopsInfo<Base>& info,
+                                                                loops::LoopReverseTwoGraph<Base>& graph,
+                                                                std::map<size_t, std::map<size_t, std::set<size_t> > >& groups,
+                                                                std::map<std::string, std::string>& sources) {
+    using namespace std;
+    using namespace CppAD::cg::loops;
+
+    size_t n = _fun.Domain();
+
+    CodeHandler<Base>& handler = graph.handler;
+    std::ostringstream out; // the shared cache cannot be used by several threads
+
+    /*******************************************************************
+     * create Hessian row groups
+     * for the contributions from the equations in loops
+     ******************************************************************/
+    SmartVectorPointer<HessianRowGroup<Base> > loopGroups;
+
+    generateHessianRowGroups(lModel, info, n, loopGroups);
+
+    /*******************************************************************
+     * generate the operation graph for each Hessian row subgroup
+     ******************************************************************/
+    for (size_t g = 0; g < loopGroups.size(); g++) {
+        HessianRowGroup<Base>& group = *loopGroups[g];
+
+        /**
+         * determine if a loop should be created
+         */
+        LoopStartOperationNode<Base>* loopStart = nullptr;
+
+        map<size_t, set<size_t> > localIterCount2Jrows;
+
+        for (const auto& itJrow2It : group.jRow2Iterations) {
+            size_t jrow = itJrow2It.first;
+            size_t itCount = itJrow2It.second.size();
+            localIterCount2Jrows[itCount].insert(jrow);
+        }
+
+        bool createsLoop = localIterCount2Jrows.size() != 1 || // is there a different number of it
+                localIterCount2Jrows.begin()->first != 1; // is there always just on iteration?
+
+        /**
+         * Model index pattern
+         * 
+         * detect the index pattern for the model iterations
+         * based on jrow and the local loop iteration
+         */
+        map<size_t, map<size_t, size_t> > jrow2localIt2ModelIt;
+
+        for (const auto& itJrow2It : group.jRow2Iterations) {
+            size_t jrow = itJrow2It.first;
+
+            map<size_t, size_t>& localIt2ModelIt = jrow2localIt2ModelIt[jrow];
+            size_t localIt = 0;
+            for (auto itIt = itJrow2It.second.begin(); itIt != itJrow2It.second.end(); ++itIt, localIt++) {
+                localIt2ModelIt[localIt] = *itIt;
+            }
+        }
+
+        /**
+         * try to fit a combination of two patterns:
+         *  j = fStart(jrow) + flit(lit);
+         */
+        std::unique_ptr<IndexPattern> itPattern(Plane2DIndexPattern::detectPlane2D(jrow2localIt2ModelIt));
+
+        if (itPattern.get() == nullptr) {
+            // did not match!
+            itPattern.reset(new Random2DIndexPattern(jrow2localIt2ModelIt));
+        }
+
+        /**
+         * Local iteration count pattern
+         */
+        IndexOperationNode<Base>* localIterIndexOp = nullptr;
+        IndexOperationNode<Base>* localIterCountIndexOp = nullptr;
+        IndexAssignOperationNode<Base>* itCountAssignOp = nullptr;
+        std::unique_ptr<IndexPattern> indexLocalItCountPattern;
+
+        if (createsLoop) {
+            map<size_t, size_t> jrow2litCount;
+
+            for (const auto& itJrow2Its : group.jRow2Iterations) {
+                size_t jrow = itJrow2Its.first;
+                jrow2litCount[jrow] = itJrow2Its.second.size();
+            }
+
+            indexLocalItCountPattern.reset(IndexPattern::detect(jrow2litCount));
+
+            if (IndexPattern::isConstant(*indexLocalItCountPattern.get())) {
+                size_t itCount = group.jRow2Iterations.begin()->second.size();
+                loopStart = handler.makeLoopStartNode(*graph.indexLocalItDcl, itCount);
+            } else {
+                itCountAssignOp = handler.makeIndexAssignNode(*graph.indexLocalItCountDcl, *indexLocalItCountPattern.get(), *graph.jrowIndexOp);
+                localIterCountIndexOp = handler.makeIndexNode(*itCountAssignOp);
+                loopStart = handler.makeLoopStartNode(*graph.indexLocalItDcl, *localIterCountIndexOp);
+            }
+
+            localIterIndexOp = handler.makeIndexNode(*loopStart);
+        }
+
+
+        auto* iterationIndexPatternOp = handler.makeIndexAssignNode(*graph.indexIterationDcl, *itPattern.get(), graph.jrowIndexOp, localIterIndexOp);
+        info.iterationIndexOp->makeAssigmentDependent(*iterationIndexPatternOp);
+
+        map<size_t, set<size_t> > jrow2CompressedLoc;
+        std::vector<pair<CG<Base>, IndexPattern*> > indexedLoopResults;
+
+        indexedLoopResults = generateReverseTwoGroupOps(handler, lModel, info,
+                                                        group, graph.tx1,
+                                                        graph.dzDx,
+                                                        jrow2CompressedLoc);
+
+        groups[g] = jrow2CompressedLoc;
+
+        LoopEndOperationNode<Base>* loopEnd = nullptr;
+        std::vector<CGBase> pxCustom;
+        if (createsLoop) {
+            /**
+             * make the loop end
+             */
+            size_t assignOrAdd = 1;
+            set<IndexOperationNode<Base>*> indexesOps;
+            indexesOps.insert(info.iterationIndexOp);
+            loopEnd = createLoopEnd(handler, *loopStart, indexedLoopResults, indexesOps, assignOrAdd);
+
+            /**
+             * move non-indexed expressions outside loop
+             */
+            moveNonIndexedOutsideLoop(handler, *loopStart, *loopEnd);
+
+            /**
+             * 
+             */
+            pxCustom.resize(1);
+
+            // {0} : must point to itself since there is only one dependent
+            pxCustom[0] = handler.createCG(*handler.makeNode(CGOpCode::DependentRefRhs,{0},{*loopEnd}));
+
+        } else {
+            /**
+             * No loop required
+             */
+            pxCustom.resize(indexedLoopResults.size());
+            for (size_t i = 0; i < indexedLoopResults.size(); i++) {
+                const CGBase& val = indexedLoopResults[i].first;
+                IndexPattern* ip = indexedLoopResults[i].second;
+
+                pxCustom[i] = createLoopDependentFunctionResult(handler, i, val, ip, *info.iterationIndexOp);
+            }
+
+        }
+
+        LanguageC<Base> langC(_baseTypeName);
+        langC.setFunctionIndexArgument(*graph.indexJrowDcl);
+        langC.setParameterPrecision(_parameterPrecision);
+        langC.setProfiling(_profiling);
+        langC.setLoopVectorization(_loopVectorization);
+
+        std::ostringstream code;
+        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("px"));
+        LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n, 1);
+
+        /**
+         * Generate the source code inside the loop
+         */
+        out.str("");
+        out << "model (reverse two, loop " << lModel.getLoopId() << ", group " << g << ")";
+        string jobName = out.str();
+        // the list of atomic functions is only modified when there are atomic
+        // functions (the loops are then processed sequentially)
+        handler.generateCode(code, langC, pxCustom, nameGenRev2, _atomicFunctions, jobName);
+
+        out.str("");
+        generateFunctionNameLoopRev2(out, lModel, g);
+        std::string functionName = out.str();
+
+        std::string argsDcl = langC.generateFunctionArgumentsDcl();
+
+        out.str("");
+        out << "#include <stdlib.h>\n"
+                "#include <math.h>\n"
+                "\n"
+                << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
+                "\n"
+                "void " << functionName << "(" << argsDcl << ") {\n";
+        nameGenRev2.customFunctionVariableDeclarations(out);
+        out << langC.generateIndependentVariableDeclaration() << "\n";
+        out << langC.generateDependentVariableDeclaration() << "\n";
+        out << langC.generateTemporaryVariableDeclaration(false, false,
+                                                          handler.getExternalFuncMaxForwardOrder(),
+                                                          handler.getExternalFuncMaxReverseOrder()) << "\n";
+        nameGenRev2.prepareCustomFunctionVariables(out);
+
+        // code inside the loop
+        out << code.str();
+
+        nameGenRev2.finalizeCustomFunctionVariables(out);
+        out << "}\n\n";
+
+        sources[functionName + ".c"] = out.str();
+        out.str("");
+
+        /**
+         * prepare the nodes to be reused!
+         */
+        if (g + 1 < loopGroups.size()) {
+            handler.resetNodes(); // uncolor nodes
+        }
+    }
+}
+
 namespace loops {
 
 template<class Base>
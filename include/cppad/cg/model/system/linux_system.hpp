@@ -21,6 +21,14 @@
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <sys/stat.h>
+#include <sys/resource.h>
+#ifndef CPPAD_CG_SYSTEM_APPLE
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#ifndef MFD_CLOEXEC
+#include <linux/memfd.h> // older C libraries do not define it in sys/mman.h
+#endif
+#endif
 
 namespace CppAD {
 namespace cg {
@@ -195,6 +203,87 @@ inline bool isFile(const std::string& path) {
     return false;
 }
 
+inline void copyFile(const std::string& source,
+                     const std::string& destination) {
+    std::ifstream in(source.c_str(), std::ios::binary);
+    if (!in.is_open()) {
+        throw CGException("Failed to open file '", source, "'");
+    }
+    std::ofstream out(destination.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        throw CGException("Failed to create file '", destination, "'");
+    }
+    out << in.rdbuf();
+    if (out.fail()) {
+        throw CGException("Failed to copy file '", source, "' to '", destination, "'");
+    }
+}
+
+inline std::string createUniqueFile(const std::string& prefix) {
+    std::string path = prefix + ".XXXXXX";
+    int fd = mkstemp(&path[0]);
+    if (fd == -1) {
+        const char* error = strerror(errno);
+        throw CGException("Failed to create file '", prefix, "': ", error);
+    }
+    ::close(fd);
+    return path;
+}
+
+inline int createMemoryFile(const std::string& name) {
+#ifdef SYS_memfd_create
+    // not inherited by child processes (they use getFileDescriptorPath())
+    int fd = (int) syscall(SYS_memfd_create, name.c_str(), MFD_CLOEXEC);
+    if (fd == -1) {
+        const char* error = strerror(errno);
+        throw CGException("Failed to create memory file '", name, "': ", error);
+    }
+    return fd;
+#else
+    throw CGException("Failed to create memory file '", name, "': memfd_create is not supported");
+#endif
+}
+
+inline std::string getFileDescriptorPath(int fd) {
+    // the process ID is used so that the path is also valid in child processes
+    return "/proc/" + std::to_string(getpid()) + "/fd/" + std::to_string(fd);
+}
+
+inline void closeMemoryFile(int fd) {
+    ::close(fd);
+}
+
+inline size_t getPeakResidentMemory() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef CPPAD_CG_SYSTEM_APPLE
+    return size_t(usage.ru_maxrss); // bytes
+#else
+    return size_t(usage.ru_maxrss) * 1024; // kilobytes
+#endif
+}
+
+inline std::string findCommand(const std::string& command) {
+    if (command.find('/') != std::string::npos) {
+        return access(command.c_str(), X_OK) == 0 ? command : "";
+    }
+
+    const char* pathEnv = getenv("PATH");
+    if (pathEnv == nullptr)
+        return "";
+
+    std::istringstream paths(pathEnv);
+    std::string folder;
+    while (std::getline(paths, folder, ':')) {
+        std::string path = createPath(folder.empty() ? "." : folder, command);
+        if (isFile(path) && access(path.c_str(), X_OK) == 0)
+            return path;
+    }
+
+    return "";
+}
+
 inline void callExecutable(const std::string& executable,
                            const std::vector<std::string>& args,
                            std::string* stdOutErrMessage,
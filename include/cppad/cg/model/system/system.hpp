@@ -96,6 +96,72 @@ inline bool isDirectory(const std::string& path);
  */
 inline bool isFile(const std::string& path);
 
+/**
+ * Copies the contents of a file (replaces the destination if it already
+ * exists).
+ *
+ * @param source the path of the file to copy
+ * @param destination the path of the new file
+ * @throws CGException on failure to read or write the files
+ */
+inline void copyFile(const std::string& source,
+                     const std::string& destination);
+
+/**
+ * Creates a new empty file with a unique name (system dependent).
+ *
+ * @param prefix the path of the new file without the unique suffix
+ * @return the path of the new file
+ * @throws CGException on failure to create the file
+ */
+inline std::string createUniqueFile(const std::string& prefix);
+
+/**
+ * Creates an anonymous file which only exists in memory (system dependent).
+ *
+ * @param name a name for the file which is only used for debugging purposes
+ * @return the file descriptor of the new file
+ * @throws CGException on failure to create the file or if it is not
+ *                     supported by the system
+ */
+inline int createMemoryFile(const std::string& name);
+
+/**
+ * Provides a path to an open file descriptor of the current process which
+ * can also be used by child processes (system dependent).
+ *
+ * @param fd the file descriptor
+ * @return the path to the file descriptor
+ */
+inline std::string getFileDescriptorPath(int fd);
+
+/**
+ * Closes a file created with createMemoryFile() (system dependent).
+ * The file is discarded once it is no longer used.
+ *
+ * @param fd the file descriptor
+ */
+inline void closeMemoryFile(int fd);
+
+/**
+ * Provides the peak resident set size of the current process (system
+ * dependent).
+ *
+ * @return the maximum resident memory used so far in bytes or zero if it
+ *         is not supported by the system
+ */
+inline size_t getPeakResidentMemory();
+
+/**
+ * Searches for an executable in the folders of the PATH environment
+ * variable (system dependent).
+ *
+ * @param command the executable name (e.g. "g++")
+ * @return the path to the executable or an empty string if it was not
+ *         found
+ */
+inline std::string findCommand(const std::string& command);
+
 /**
  * Calls an external executable (system dependent).
  * In the case of an error during execution an exception will be thrown.
@@ -18,6 +18,10 @@
  *  https://github.com/Pithikos/C-Thread-Pool/blob/master/thpool.c
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* required for the thread affinity (CPU_SET, pthread_setaffinity_np) */
+#endif
+
 #include <unistd.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -28,8 +32,11 @@
 #include <sys/prctl.h>
 #include <time.h>
 #include <sys/time.h>
+#ifndef __USE_GNU
 #define __USE_GNU /* required before including  resource.h */
+#endif
 #include <sys/resource.h>
+#include <sched.h>
 #endif
 
 enum ScheduleStrategy {SCHED_STATIC = 1,
@@ -42,6 +49,8 @@ enum ElapsedTimeReference {ELAPSED_TIME_AVG,
 
 typedef struct ThPool ThPool;
 typedef void (* thpool_function_type)(void*);
+typedef void (* cppadcg_executor_submit_type)(void* ctx, thpool_function_type function, void* arg);
+typedef void (* cppadcg_executor_wait_type)(void* ctx);
 
 static ThPool* volatile cppadcg_pool = NULL;
 static int cppadcg_pool_n_threads = 2;
@@ -52,6 +61,15 @@ static unsigned int cppadcg_pool_time_meas = 10; // default number of time measu
 static float cppadcg_pool_guided_maxgroupwork = 0.75;
 
 static enum ScheduleStrategy schedule_strategy = SCHED_DYNAMIC;
+static int* cppadcg_pool_affinity = NULL; // the cores where each thread is pinned to (NULL for no affinity)
+static int cppadcg_pool_affinity_n = 0;
+
+/**
+ * executor provided by the host application (replaces the thread pool)
+ */
+static cppadcg_executor_submit_type cppadcg_executor_submit = NULL;
+static cppadcg_executor_wait_type cppadcg_executor_wait = NULL;
+static void* cppadcg_executor_ctx = NULL;
 
 /* ==================== INTERNAL HIGH LEVEL API  ====================== */
 
@@ -77,6 +95,12 @@ static void thpool_wait(ThPool*);
 
 static void thpool_destroy(ThPool*);
 
+void cppadcg_thpool_shutdown();
+
+static void thread_set_affinity(pthread_t pthread, int id);
+
+static void thread_reset_affinity(pthread_t pthread, int id);
+
 /* ========================== STRUCTURES ============================ */
 /* Binary semaphore */
 typedef struct BSem {
@@ -103,6 +127,7 @@ typedef struct WorkGroup {
     struct WorkGroup*  prev;             /* pointer to previous WorkGroup  */
     struct Job* jobs;                    /* jobs                           */
     int size;                            /* number of jobs                 */
+    int thread;                          /* preferred thread (SCHED_STATIC only) */
     struct timespec startTime;           /* initial time (verbose only)    */
     struct timespec endTime;             /* final time (verbose only)      */
 } WorkGroup;
@@ -208,6 +233,9 @@ float cppadcg_thpool_get_guided_maxgroupwork() {
 }
 
 unsigned int cppadcg_thpool_get_n_time_meas() {
+    if (cppadcg_executor_submit != NULL) {
+        return 0; // the execution time of jobs in the host executor is not measured
+    }
     return cppadcg_pool_time_meas;
 }
 
@@ -231,8 +259,66 @@ int cppadcg_thpool_is_verbose() {
     return cppadcg_pool_verbose;
 }
 
+void cppadcg_thpool_set_affinity(const int cores[],
+                                 int n) {
+    int i;
+
+    free(cppadcg_pool_affinity);
+    cppadcg_pool_affinity = NULL;
+    cppadcg_pool_affinity_n = 0;
+
+    if (cores != NULL && n > 0) {
+        cppadcg_pool_affinity = (int*) malloc(n * sizeof(int));
+        if (cppadcg_pool_affinity == NULL) {
+            fprintf(stderr, "cppadcg_thpool_set_affinity(): Could not allocate memory\n");
+            return;
+        }
+        for (i = 0; i < n; ++i) {
+            cppadcg_pool_affinity[i] = cores[i];
+        }
+        cppadcg_pool_affinity_n = n;
+    }
+
+    if (cppadcg_pool != NULL) {
+        // pin (or unpin) the existing threads
+        for (i = 0; i < cppadcg_pool->num_threads; ++i) {
+            if (cppadcg_pool_affinity_n == 0)
+                thread_reset_affinity(cppadcg_pool->threads[i]->pthread, i);
+            else
+                thread_set_affinity(cppadcg_pool->threads[i]->pthread, i);
+        }
+    }
+}
+
+int cppadcg_thpool_get_affinity(int const** cores) {
+    *cores = cppadcg_pool_affinity;
+    return cppadcg_pool_affinity_n;
+}
+
+void cppadcg_thpool_set_executor(cppadcg_executor_submit_type submit,
+                                 cppadcg_executor_wait_type wait,
+                                 void* ctx) {
+    if (submit != NULL && wait != NULL) {
+        // the internal threads are no longer required
+        cppadcg_thpool_shutdown();
+
+        cppadcg_executor_submit = submit;
+        cppadcg_executor_wait = wait;
+        cppadcg_executor_ctx = ctx;
+    } else {
+        // back to the internal thread pool
+        cppadcg_executor_submit = NULL;
+        cppadcg_executor_wait = NULL;
+        cppadcg_executor_ctx = NULL;
+    }
+}
+
+int cppadcg_thpool_has_executor() {
+    return cppadcg_executor_submit != NULL;
+}
+
 void cppadcg_thpool_prepare() {
-    if(cppadcg_pool == NULL) {
+    if(cppadcg_pool == NULL && cppadcg_executor_submit == NULL) {
         cppadcg_pool = thpool_init(cppadcg_pool_n_threads);
     }
 }
@@ -242,6 +328,11 @@ void cppadcg_thpool_add_job(thpool_function_type function,
                             float* avgElapsed,
                             float* elapsed) {
     if (!cppadcg_pool_disabled) {
+        if (cppadcg_executor_submit != NULL) {
+            (*cppadcg_executor_submit)(cppadcg_executor_ctx, function, arg);
+            return;
+        }
+
         cppadcg_thpool_prepare();
         if (cppadcg_pool != NULL) {
             thpool_add_job(cppadcg_pool, function, arg, avgElapsed, elapsed);
@@ -263,6 +354,18 @@ void cppadcg_thpool_add_jobs(thpool_function_type functions[],
                              int lastElapsedChanged) {
     int i;
     if (!cppadcg_pool_disabled) {
+        if (cppadcg_executor_submit != NULL) {
+            // submit the longest jobs first
+            int byOrder[nJobs];
+            for (i = 0; i < nJobs; ++i) {
+                byOrder[order != NULL ? order[i] : i] = i;
+            }
+            for (i = 0; i < nJobs; ++i) {
+                (*cppadcg_executor_submit)(cppadcg_executor_ctx, functions[byOrder[i]], args[byOrder[i]]);
+            }
+            return;
+        }
+
         cppadcg_thpool_prepare();
         if (cppadcg_pool != NULL) {
             thpool_add_jobs(cppadcg_pool, functions, args, avgElapsed, elapsed, order, job2Thread, nJobs, lastElapsedChanged);
@@ -277,7 +380,9 @@ void cppadcg_thpool_add_jobs(thpool_function_type functions[],
 }
 
 void cppadcg_thpool_wait() {
-    if(cppadcg_pool != NULL) {
+    if (cppadcg_executor_wait != NULL && !cppadcg_pool_disabled) {
+        (*cppadcg_executor_wait)(cppadcg_executor_ctx);
+    } else if(cppadcg_pool != NULL) {
         thpool_wait(cppadcg_pool);
     }
 }
@@ -716,6 +821,7 @@ static int jobqueue_push_static_jobs(ThPool* thpool,
     for (i = 0; i < num_threads; ++i) {
         group = (WorkGroup*) malloc(sizeof(WorkGroup));
         group->size = 0;
+        group->thread = i; // the preferred thread (other threads may steal it)
         group->jobs = (Job*) malloc(n_jobs[i] * sizeof(Job));
         groups[i] = group;
     }
@@ -948,9 +1054,52 @@ static int thread_init(ThPool* thpool,
 
     pthread_create(&(*thread)->pthread, NULL, (void*) thread_do, (*thread));
     pthread_detach((*thread)->pthread);
+    thread_set_affinity((*thread)->pthread, id);
     return 0;
 }
 
+/**
+ * Pins a thread to the core defined for its id (if a core list was provided).
+ */
+static void thread_set_affinity(pthread_t pthread,
+                                int id) {
+    if (cppadcg_pool_affinity_n == 0)
+        return;
+
+#if defined(__linux__)
+    cpu_set_t cpuset;
+    int core = cppadcg_pool_affinity[id % cppadcg_pool_affinity_n];
+
+    CPU_ZERO(&cpuset);
+    CPU_SET(core, &cpuset);
+    if (pthread_setaffinity_np(pthread, sizeof(cpu_set_t), &cpuset) != 0) {
+        fprintf(stderr, "thread_set_affinity(): Failed to pin thread %i to core %i\n", id, core);
+    } else if (cppadcg_pool_verbose) {
+        fprintf(stdout, "thread_set_affinity(): Thread %i pinned to core %i\n", id, core);
+    }
+#else
+    fprintf(stderr, "thread_set_affinity(): thread affinity is not supported on this system\n");
+#endif
+}
+
+/**
+ * Allows a previously pinned thread to run on the same cores as the
+ * calling thread (the default affinity of a new thread).
+ */
+static void thread_reset_affinity(pthread_t pthread,
+                                  int id) {
+#if defined(__linux__)
+    cpu_set_t cpuset;
+
+    if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) != 0 ||
+        pthread_setaffinity_np(pthread, sizeof(cpu_set_t), &cpuset) != 0) {
+        fprintf(stderr, "thread_reset_affinity(): Failed to reset the affinity of thread %i\n", id);
+    } else if (cppadcg_pool_verbose) {
+        fprintf(stdout, "thread_reset_affinity(): Thread %i no longer pinned\n", id);
+    }
+#endif
+}
+
 /* What each thread is doing
 *
 * In principle this is an endless loop. The only time this loop gets interrupted is once
@@ -1257,9 +1406,20 @@ static WorkGroup* jobqueue_pull(ThPool* thpool,
 
     if (schedule_strategy == SCHED_STATIC && queue->group_front != NULL) {
         // STATIC
-        group = queue->group_front;
+        // a thread always takes the work groups assigned to it first so that the
+        // data used by each job remains in the memory close to the same core;
+        // a group assigned to another thread is only taken (stolen) when no
+        // group assigned to this thread remains in the queue
+        WorkGroup** prev = &queue->group_front;
+        while (*prev != NULL && (*prev)->thread != id) {
+            prev = &(*prev)->prev;
+        }
+        if (*prev == NULL) {
+            prev = &queue->group_front; // steal the group at the front of the queue
+        }
+        group = *prev;
 
-        queue->group_front = group->prev;
+        *prev = group->prev;
         group->prev = NULL;
 
     } else if (queue->len == 0) {
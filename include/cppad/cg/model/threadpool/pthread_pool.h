@@ -29,6 +29,20 @@ enum ElapsedTimeReference {ELAPSED_TIME_AVG,
 
 typedef void (*cppadcg_thpool_function_type)(void*);
 
+/**
+ * Submits a job to an executor provided by the host application.
+ * The job must eventually call function(arg) exactly once.
+ */
+typedef void (*cppadcg_executor_submit_type)(void* ctx,
+                                             cppadcg_thpool_function_type function,
+                                             void* arg);
+
+/**
+ * Blocks until all the jobs submitted by the calling thread have
+ * completed.
+ */
+typedef void (*cppadcg_executor_wait_type)(void* ctx);
+
 
 void cppadcg_thpool_set_threads(int n);
 
@@ -65,6 +79,28 @@ void cppadcg_thpool_set_disabled(int disabled);
 int cppadcg_thpool_is_disabled();
 
 
+/**
+ * Pins the thread with index i to the core cores[i % n].
+ * Providing n = 0 removes the affinity of new threads.
+ */
+void cppadcg_thpool_set_affinity(const int cores[],
+                                 int n);
+
+int cppadcg_thpool_get_affinity(int const** cores);
+
+
+/**
+ * Dispatches the jobs to an executor provided by the host application
+ * instead of the internal thread pool (which is shut down).
+ * Providing NULL functions restores the internal thread pool.
+ */
+void cppadcg_thpool_set_executor(cppadcg_executor_submit_type submit,
+                                 cppadcg_executor_wait_type wait,
+                                 void* ctx);
+
+int cppadcg_thpool_has_executor();
+
+
 void cppadcg_thpool_prepare();
 
 void cppadcg_thpool_add_job(cppadcg_thpool_function_type function,
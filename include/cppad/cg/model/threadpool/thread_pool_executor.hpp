@@ -0,0 +1,42 @@
+#ifndef CPPAD_CG_THREAD_POOL_EXECUTOR_INCLUDED
+#define CPPAD_CG_THREAD_POOL_EXECUTOR_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+extern "C" {
+
+/**
+ * Submits a job to an executor provided by the host application.
+ * The executor must eventually call job(arg) exactly once.
+ */
+typedef void (*ThreadPoolExecutorSubmit)(void* ctx,
+                                         void (*job)(void*),
+                                         void* arg);
+
+/**
+ * Blocks until all the jobs submitted to the executor by the calling
+ * thread have completed.
+ */
+typedef void (*ThreadPoolExecutorWait)(void* ctx);
+
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,293 @@
+#ifndef CPPAD_CG_STRUCTURAL_DECOMPOSITION_INCLUDED
+#define CPPAD_CG_STRUCTURAL_DECOMPOSITION_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Determines a maximum matching between equations and variables using the
+ * Hopcroft-Karp algorithm (O(E sqrt(V))).
+ * No recursion is used so that very large systems can be processed.
+ *
+ * @param eqVars the variables present in each equation
+ * @param nVars the total number of variables
+ * @param eq2Var the variable assigned to each equation or -1 (output)
+ * @param var2Eq the equation assigned to each variable or -1 (output)
+ * @return the number of matched equations
+ */
+inline size_t maximumMatching(const std::vector<std::vector<size_t> >& eqVars,
+                              size_t nVars,
+                              std::vector<long>& eq2Var,
+                              std::vector<long>& var2Eq) {
+    const size_t m = eqVars.size();
+    const size_t INF = (std::numeric_limits<size_t>::max)();
+
+    eq2Var.assign(m, -1);
+    var2Eq.assign(nVars, -1);
+
+    size_t matched = 0;
+
+    // quick initial assignment
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j : eqVars[i]) {
+            if (var2Eq[j] < 0) {
+                var2Eq[j] = i;
+                eq2Var[i] = j;
+                matched++;
+                break;
+            }
+        }
+    }
+
+    std::vector<size_t> dist(m);
+    std::vector<size_t> queue;
+    std::vector<size_t> next(m); // next edge to explore by each equation
+    std::vector<size_t> stack;
+    queue.reserve(m);
+
+    while (matched < m) {
+        /**
+         * breadth first search: layers of equations starting at the
+         * unmatched ones
+         */
+        queue.clear();
+        for (size_t i = 0; i < m; ++i) {
+            if (eq2Var[i] < 0) {
+                dist[i] = 0;
+                queue.push_back(i);
+            } else {
+                dist[i] = INF;
+            }
+        }
+
+        bool found = false;
+        for (size_t q = 0; q < queue.size(); ++q) {
+            size_t i = queue[q];
+            for (size_t j : eqVars[i]) {
+                long k = var2Eq[j];
+                if (k < 0) {
+                    found = true;
+                } else if (dist[k] == INF) {
+                    dist[k] = dist[i] + 1;
+                    queue.push_back(k);
+                }
+            }
+        }
+
+        if (!found)
+            break; // maximum matching
+
+        /**
+         * depth first search: vertex disjoint shortest augmenting paths
+         */
+        std::fill(next.begin(), next.end(), 0);
+
+        size_t augmented = 0;
+        for (size_t i0 = 0; i0 < m; ++i0) {
+            if (eq2Var[i0] >= 0)
+                continue;
+
+            stack.clear();
+            stack.push_back(i0);
+
+            while (!stack.empty()) {
+                size_t i = stack.back();
+
+                if (next[i] == eqVars[i].size()) {
+                    dist[i] = INF; // dead end
+                    stack.pop_back();
+                    continue;
+                }
+
+                size_t j = eqVars[i][next[i]++];
+                long k = var2Eq[j];
+
+                if (k < 0) {
+                    // augment along the path in the stack
+                    for (size_t e : stack) {
+                        size_t v = eqVars[e][next[e] - 1];
+                        var2Eq[v] = e;
+                        eq2Var[e] = v;
+                    }
+                    augmented++;
+                    break;
+
+                } else if (dist[k] == dist[i] + 1) {
+                    stack.push_back(k);
+                }
+            }
+        }
+
+        if (augmented == 0)
+            break;
+        matched += augmented;
+    }
+
+    return matched;
+}
+
+/**
+ * Determines the block lower triangular (BLT) decomposition of a system
+ * of equations using Tarjan's strongly connected components algorithm.
+ * An equation depends on another equation if it contains the variable
+ * assigned to the other equation.
+ * No recursion is used so that very large systems can be processed.
+ *
+ * @param eqVars the variables present in each equation
+ * @param var2Eq the equation assigned to each variable or -1
+ *               (e.g. from maximumMatching())
+ * @return the equations in each block (sorted) with the blocks in the
+ *         order in which they can be solved
+ */
+inline std::vector<std::vector<size_t> > bltDecomposition(const std::vector<std::vector<size_t> >& eqVars,
+                                                         const std::vector<long>& var2Eq) {
+    const size_t m = eqVars.size();
+    const size_t UNDEF = (std::numeric_limits<size_t>::max)();
+
+    std::vector<std::vector<size_t> > blocks;
+
+    std::vector<size_t> index(m, UNDEF);
+    std::vector<size_t> low(m);
+    std::vector<bool> onStack(m, false);
+    std::vector<size_t> stack;
+    std::vector<std::pair<size_t, size_t> > callStack; // equation, next edge
+    size_t counter = 0;
+
+    for (size_t s = 0; s < m; ++s) {
+        if (index[s] != UNDEF)
+            continue;
+
+        index[s] = low[s] = counter++;
+        stack.push_back(s);
+        onStack[s] = true;
+        callStack.emplace_back(s, 0);
+
+        while (!callStack.empty()) {
+            size_t v = callStack.back().first;
+            size_t& p = callStack.back().second;
+
+            if (p < eqVars[v].size()) {
+                size_t j = eqVars[v][p];
+                ++p;
+                long w = j < var2Eq.size() ? var2Eq[j] : -1;
+                if (w < 0)
+                    continue;
+
+                if (index[w] == UNDEF) {
+                    index[w] = low[w] = counter++;
+                    stack.push_back(w);
+                    onStack[w] = true;
+                    callStack.emplace_back(w, 0); // p is no longer valid
+                } else if (onStack[w]) {
+                    low[v] = std::min(low[v], index[w]);
+                }
+
+            } else {
+                callStack.pop_back();
+                if (!callStack.empty()) {
+                    size_t u = callStack.back().first;
+                    low[u] = std::min(low[u], low[v]);
+                }
+
+                if (low[v] == index[v]) {
+                    // root of a strongly connected component
+                    blocks.emplace_back();
+                    std::vector<size_t>& block = blocks.back();
+                    size_t w;
+                    do {
+                        w = stack.back();
+                        stack.pop_back();
+                        onStack[w] = false;
+                        block.push_back(w);
+                    } while (w != v);
+                    std::sort(block.begin(), block.end());
+                }
+            }
+        }
+    }
+
+    return blocks;
+}
+
+/**
+ * Determines the independent groups of equations and variables
+ * (connected components of the bipartite graph).
+ *
+ * @param eqVars the variables present in each equation
+ * @param nVars the total number of variables
+ * @param eqComp the component of each equation (output)
+ * @param varComp the component of each variable (output)
+ * @return the number of components
+ */
+inline size_t connectedComponents(const std::vector<std::vector<size_t> >& eqVars,
+                                  size_t nVars,
+                                  std::vector<size_t>& eqComp,
+                                  std::vector<size_t>& varComp) {
+    const size_t m = eqVars.size();
+    const size_t UNDEF = (std::numeric_limits<size_t>::max)();
+
+    // equations of each variable
+    std::vector<std::vector<size_t> > varEqs(nVars);
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j : eqVars[i])
+            varEqs[j].push_back(i);
+    }
+
+    eqComp.assign(m, UNDEF);
+    varComp.assign(nVars, UNDEF);
+
+    size_t nComp = 0;
+    std::vector<size_t> queue;
+
+    for (size_t i0 = 0; i0 < m; ++i0) {
+        if (eqComp[i0] != UNDEF)
+            continue;
+
+        eqComp[i0] = nComp;
+        queue.clear();
+        queue.push_back(i0);
+
+        for (size_t q = 0; q < queue.size(); ++q) {
+            for (size_t j : eqVars[queue[q]]) {
+                if (varComp[j] != UNDEF)
+                    continue;
+                varComp[j] = nComp;
+                for (size_t k : varEqs[j]) {
+                    if (eqComp[k] == UNDEF) {
+                        eqComp[k] = nComp;
+                        queue.push_back(k);
+                    }
+                }
+            }
+        }
+
+        nComp++;
+    }
+
+    // variables not present in any equation
+    for (size_t j = 0; j < nVars; ++j) {
+        if (varComp[j] == UNDEF)
+            varComp[j] = nComp++;
+    }
+
+    return nComp;
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,267 @@
+#ifndef CPPAD_CG_CPPADCG_EIGEN_MODEL_INCLUDED
+#define CPPAD_CG_CPPADCG_EIGEN_MODEL_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+# include <cppad/cg.hpp>
+# include <Eigen/Dense>
+# include <Eigen/Sparse>
+
+/**
+ * Evaluation of compiled models (GenericModel) directly into Eigen
+ * dense and sparse matrices
+ */
+namespace CppAD {
+namespace cg {
+
+/**
+ * Eigen types used to evaluate compiled models
+ * (also avoids the deduction of Base from the Eigen arguments)
+ */
+template<class Base>
+struct EigenModelTypes {
+    using Vector = Eigen::Matrix<Base, Eigen::Dynamic, 1>;
+    using VectorRef = Eigen::Ref<Vector>;
+    using ConstVectorRef = Eigen::Ref<const Vector>;
+    using DenseMatrix = Eigen::Matrix<Base, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    using DenseMatrixRef = Eigen::Ref<DenseMatrix>;
+};
+
+/**
+ * A sparse Jacobian or Hessian stored in an Eigen sparse matrix whose
+ * pattern is defined only once from the sparsity of a compiled model.
+ * Evaluations only update the value array of the matrix.
+ *
+ * When the order of the elements in the model is the same as the storage
+ * order of the Eigen matrix (e.g. CSC values for a column major matrix, see
+ * ModelCSourceGen::setSparseJacobianFormat()) the values are written
+ * directly into the matrix, otherwise they are scattered using a
+ * permutation determined when the pattern was created.
+ */
+template<class Base, int Options = Eigen::ColMajor, class StorageIndex = int>
+class EigenSparseModelMatrix {
+public:
+    using SparseMatrix = Eigen::SparseMatrix<Base, Options, StorageIndex>;
+protected:
+    /**
+     * the Eigen matrix with a fixed pattern
+     */
+    SparseMatrix _mat;
+    /**
+     * the position in the value array of the Eigen matrix of each element
+     * computed by the model (empty if the orders are the same)
+     */
+    std::vector<size_t> _valuePos;
+    /**
+     * the values computed by the model in its own order
+     * (only used when a permutation is required)
+     */
+    std::vector<Base> _values;
+public:
+
+    inline EigenSparseModelMatrix() = default;
+
+    /**
+     * Creates the pattern of a sparse Jacobian.
+     *
+     * @param model the compiled model
+     */
+    inline void initJacobian(GenericModel<Base>& model) {
+        CPPADCG_ASSERT_KNOWN(model.isSparseJacobianAvailable(), "No sparse Jacobian function defined in the model")
+
+        std::vector<size_t> rows, cols;
+        model.JacobianSparsity(rows, cols);
+        initPattern(model.Range(), model.Domain(), rows, cols);
+    }
+
+    /**
+     * Creates the pattern of the sparse Hessian of the weighted sum of the
+     * dependent variables.
+     *
+     * @param model the compiled model
+     */
+    inline void initHessian(GenericModel<Base>& model) {
+        CPPADCG_ASSERT_KNOWN(model.isSparseHessianAvailable(), "No sparse Hessian function defined in the model")
+
+        std::vector<size_t> rows, cols;
+        model.HessianSparsity(rows, cols);
+        initPattern(model.Domain(), model.Domain(), rows, cols);
+    }
+
+    /**
+     * Provides the Eigen sparse matrix.
+     * Its pattern must not be modified.
+     */
+    inline SparseMatrix& matrix() {
+        return _mat;
+    }
+
+    inline const SparseMatrix& matrix() const {
+        return _mat;
+    }
+
+    /**
+     * Whether or not the model values are written directly into the value
+     * array of the Eigen matrix (no permutation).
+     */
+    inline bool isDirect() const {
+        return _valuePos.empty();
+    }
+
+    /**
+     * Provides the array where the model should write its values.
+     */
+    inline ArrayView<Base> modelValues() {
+        if (_valuePos.empty())
+            return ArrayView<Base>(_mat.valuePtr(), _mat.nonZeros());
+        else
+            return ArrayView<Base>(_values);
+    }
+
+    /**
+     * Copies the values in the model order into the Eigen matrix
+     * (does nothing if the orders are the same).
+     */
+    inline void scatterValues() {
+        if (_valuePos.empty())
+            return;
+
+        Base* v = _mat.valuePtr();
+        std::fill(v, v + _mat.nonZeros(), Base(0));
+        for (size_t e = 0; e < _values.size(); ++e) {
+            v[_valuePos[e]] += _values[e]; // repeated elements are added
+        }
+    }
+
+protected:
+
+    inline void initPattern(size_t nrows,
+                            size_t ncols,
+                            const std::vector<size_t>& rows,
+                            const std::vector<size_t>& cols) {
+        size_t nnz = rows.size();
+
+        std::vector<Eigen::Triplet<Base, StorageIndex> > triplets(nnz);
+        for (size_t e = 0; e < nnz; ++e) {
+            triplets[e] = Eigen::Triplet<Base, StorageIndex>(rows[e], cols[e], Base(0));
+        }
+
+        _mat.resize(nrows, ncols);
+        _mat.setFromTriplets(triplets.begin(), triplets.end());
+        _mat.makeCompressed();
+
+        const StorageIndex* outerPtr = _mat.outerIndexPtr();
+        const StorageIndex* innerPtr = _mat.innerIndexPtr();
+        bool rowMajor = SparseMatrix::IsRowMajor;
+
+        _valuePos.resize(nnz);
+        bool identity = size_t(_mat.nonZeros()) == nnz;
+        for (size_t e = 0; e < nnz; ++e) {
+            StorageIndex outer = rowMajor ? rows[e] : cols[e];
+            StorageIndex inner = rowMajor ? cols[e] : rows[e];
+            const StorageIndex* it = std::lower_bound(innerPtr + outerPtr[outer], innerPtr + outerPtr[outer + 1], inner);
+            _valuePos[e] = it - innerPtr;
+            identity = identity && _valuePos[e] == e;
+        }
+
+        if (identity) {
+            _valuePos.clear();
+            _values.clear();
+        } else {
+            _values.resize(nnz);
+        }
+    }
+};
+
+/**
+ * Evaluates the dependent variables of a compiled model.
+ *
+ * @param model the compiled model
+ * @param x the independent variables
+ * @param y the dependent variables
+ */
+template<class Base>
+inline void ForwardZero(GenericModel<Base>& model,
+                        const typename EigenModelTypes<Base>::ConstVectorRef& x,
+                        typename EigenModelTypes<Base>::VectorRef y) {
+    model.ForwardZero(ArrayView<const Base>(x.data(), x.size()),
+                      ArrayView<Base>(y.data(), y.size()));
+}
+
+/**
+ * Evaluates a dense Jacobian of a compiled model (row major).
+ *
+ * @param model the compiled model
+ * @param x the independent variables
+ * @param jac the Jacobian
+ */
+template<class Base>
+inline void Jacobian(GenericModel<Base>& model,
+                     const typename EigenModelTypes<Base>::ConstVectorRef& x,
+                     typename EigenModelTypes<Base>::DenseMatrixRef jac) {
+    CPPADCG_ASSERT_KNOWN(jac.outerStride() == jac.cols(), "The Jacobian matrix must be stored contiguously")
+
+    model.Jacobian(ArrayView<const Base>(x.data(), x.size()),
+                   ArrayView<Base>(jac.data(), jac.size()));
+}
+
+/**
+ * Evaluates a sparse Jacobian of a compiled model into the value array of
+ * an Eigen sparse matrix.
+ *
+ * @param model the compiled model
+ * @param x the independent variables
+ * @param jac the sparse Jacobian created with
+ *            EigenSparseModelMatrix::initJacobian()
+ */
+template<class Base, int Options, class StorageIndex>
+inline void SparseJacobian(GenericModel<Base>& model,
+                           const typename EigenModelTypes<Base>::ConstVectorRef& x,
+                           EigenSparseModelMatrix<Base, Options, StorageIndex>& jac) {
+    size_t const* row;
+    size_t const* col;
+    model.SparseJacobian(ArrayView<const Base>(x.data(), x.size()),
+                         jac.modelValues(), &row, &col);
+    jac.scatterValues();
+}
+
+/**
+ * Evaluates the sparse Hessian of the weighted sum of the dependent
+ * variables of a compiled model into the value array of an Eigen sparse
+ * matrix.
+ *
+ * @param model the compiled model
+ * @param x the independent variables
+ * @param w the weights of the dependent variables
+ * @param hess the sparse Hessian created with
+ *             EigenSparseModelMatrix::initHessian()
+ */
+template<class Base, int Options, class StorageIndex>
+inline void SparseHessian(GenericModel<Base>& model,
+                          const typename EigenModelTypes<Base>::ConstVectorRef& x,
+                          const typename EigenModelTypes<Base>::ConstVectorRef& w,
+                          EigenSparseModelMatrix<Base, Options, StorageIndex>& hess) {
+    size_t const* row;
+    size_t const* col;
+    model.SparseHessian(ArrayView<const Base>(x.data(), x.size()),
+                        ArrayView<const Base>(w.data(), w.size()),
+                        hess.modelValues(), &row, &col);
+    hess.scatterValues();
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
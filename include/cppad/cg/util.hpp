@@ -437,6 +437,85 @@ inline bool intersects(const std::set<size_t>& a,
     return false;
 }
 
+/**
+ * Determines a reverse Cuthill-McKee ordering of the rows and columns of a
+ * sparsity pattern which places related rows and columns close to each
+ * other (reduces the bandwidth).
+ * The bipartite graph of rows and columns is used so that non-square
+ * patterns are also supported.
+ *
+ * @param pattern the column indexes of the non-zero elements of each row
+ * @param n the number of columns
+ * @param rowOrder the original index of the row in each new position
+ * @param colOrder the original index of the column in each new position
+ */
+template<class VectorSet>
+inline void reverseCuthillMcKee(const VectorSet& pattern,
+                                size_t n,
+                                std::vector<size_t>& rowOrder,
+                                std::vector<size_t>& colOrder) {
+    const size_t m = pattern.size();
+    const size_t nv = m + n;
+
+    // graph vertices: the rows followed by the columns
+    std::vector<std::vector<size_t> > adj(nv);
+    for (size_t i = 0; i < m; i++) {
+        for (size_t j : pattern[i]) {
+            CPPADCG_ASSERT_KNOWN(j < n, "Invalid column index in sparsity pattern")
+            adj[i].push_back(m + j);
+            adj[m + j].push_back(i);
+        }
+    }
+
+    auto lowerDegree = [&adj](size_t a, size_t b) {
+        return adj[a].size() < adj[b].size() || (adj[a].size() == adj[b].size() && a < b);
+    };
+
+    for (auto& a : adj) {
+        std::sort(a.begin(), a.end(), lowerDegree);
+    }
+
+    // each connected component starts at a vertex with the lowest degree
+    std::vector<size_t> start(nv);
+    for (size_t v = 0; v < nv; v++) {
+        start[v] = v;
+    }
+    std::sort(start.begin(), start.end(), lowerDegree);
+
+    std::vector<bool> visited(nv, false);
+    std::vector<size_t> order;
+    order.reserve(nv);
+
+    for (size_t s : start) {
+        if (visited[s])
+            continue;
+
+        visited[s] = true;
+        order.push_back(s);
+
+        // breadth-first search
+        for (size_t k = order.size() - 1; k < order.size(); k++) {
+            for (size_t v : adj[order[k]]) {
+                if (!visited[v]) {
+                    visited[v] = true;
+                    order.push_back(v);
+                }
+            }
+        }
+    }
+
+    rowOrder.clear();
+    rowOrder.reserve(m);
+    colOrder.clear();
+    colOrder.reserve(n);
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        if (*it < m)
+            rowOrder.push_back(*it);
+        else
+            colOrder.push_back(*it - m);
+    }
+}
+
 template<class VectorSizet, class VectorSet>
 inline CppAD::sparse_rc<VectorSizet> toSparsityPattern(const VectorSet& inPattern,
                                                        size_t m, size_t n) {
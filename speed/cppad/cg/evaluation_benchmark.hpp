@@ -0,0 +1,597 @@
+#ifndef CPPAD_CG_EVALUATION_BENCHMARK_INCLUDED
+#define CPPAD_CG_EVALUATION_BENCHMARK_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <cppad/cg/cppadcg.hpp>
+
+#if CPPAD_CG_SYSTEM_LINUX && !CPPAD_CG_SYSTEM_APPLE
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define CPPAD_CG_PERF_EVENTS 1
+#endif
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Hardware event counters of the calling thread (Linux perf events).
+ * Events which cannot be opened (e.g. missing permissions, virtual
+ * machines or other operating systems) are ignored.
+ * Events in other threads (e.g. a thread pool) are not counted.
+ */
+class PerfCounters {
+public:
+    static const size_t N_EVENTS = 4;
+private:
+    int fd_[N_EVENTS];
+public:
+
+    inline PerfCounters() {
+        for (size_t i = 0; i < N_EVENTS; i++) {
+            fd_[i] = -1;
+        }
+
+#ifdef CPPAD_CG_PERF_EVENTS
+        const unsigned long long config[N_EVENTS] = {PERF_COUNT_HW_CPU_CYCLES,
+                                                     PERF_COUNT_HW_INSTRUCTIONS,
+                                                     PERF_COUNT_HW_CACHE_MISSES,
+                                                     PERF_COUNT_HW_BRANCH_MISSES};
+        for (size_t i = 0; i < N_EVENTS; i++) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = config[i];
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd_[i] = (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    inline virtual ~PerfCounters() {
+#ifdef CPPAD_CG_PERF_EVENTS
+        for (int fd : fd_) {
+            if (fd != -1)
+                close(fd);
+        }
+#endif
+    }
+
+    /**
+     * @return true if at least one of the hardware events can be counted
+     */
+    inline bool isAvailable() const {
+        for (int fd : fd_) {
+            if (fd != -1)
+                return true;
+        }
+        return false;
+    }
+
+    static inline const char* getEventName(size_t i) {
+        static const char* names[N_EVENTS] = {"cycles", "instructions", "cache_misses", "branch_misses"};
+        return names[i];
+    }
+
+    inline void start() {
+#ifdef CPPAD_CG_PERF_EVENTS
+        for (int fd : fd_) {
+            if (fd != -1) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    /**
+     * Stops counting and adds the number of events since start() to
+     * counters (only for the available events).
+     */
+    inline void stop(std::map<std::string, double>& counters) {
+#ifdef CPPAD_CG_PERF_EVENTS
+        for (int fd : fd_) {
+            if (fd != -1)
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+        for (size_t i = 0; i < N_EVENTS; i++) {
+            unsigned long long value;
+            if (fd_[i] != -1 && read(fd_[i], &value, sizeof(value)) == sizeof(value)) {
+                counters[getEventName(i)] += double(value);
+            }
+        }
+#endif
+    }
+};
+
+/**
+ * Summary of a set of latency measurements
+ */
+class LatencyStatistics {
+public:
+    size_t count;
+    double mean;
+    double stdDev;
+    double min;
+    double p50;
+    double p90;
+    double p99;
+    double max;
+public:
+
+    /**
+     * @param times the measured times (any order)
+     */
+    inline explicit LatencyStatistics(std::vector<double> times) :
+        count(times.size()) {
+        if (times.empty()) {
+            mean = stdDev = min = p50 = p90 = p99 = max = std::numeric_limits<double>::quiet_NaN();
+            return;
+        }
+
+        std::sort(times.begin(), times.end());
+
+        mean = 0;
+        for (double t : times)
+            mean += t;
+        mean /= count;
+
+        double sum = 0;
+        for (double t : times)
+            sum += (t - mean) * (t - mean);
+        stdDev = std::sqrt(sum / count);
+
+        min = times.front();
+        p50 = percentile(times, 50);
+        p90 = percentile(times, 90);
+        p99 = percentile(times, 99);
+        max = times.back();
+    }
+
+    /**
+     * Nearest-rank percentile.
+     *
+     * @param sorted the values in ascending order
+     * @param p the percentile (0 to 100)
+     */
+    static inline double percentile(const std::vector<double>& sorted,
+                                    double p) {
+        size_t rank = size_t(std::ceil(p / 100.0 * sorted.size()));
+        return sorted[rank == 0 ? 0 : rank - 1];
+    }
+};
+
+/**
+ * The measurements of a model function
+ */
+class EvaluationResult {
+public:
+    /**
+     * the function name
+     */
+    std::string name;
+    /**
+     * latency of the first call in seconds (includes lazy initializations
+     * such as symbol resolution or the thread pool creation)
+     */
+    double first;
+    /**
+     * latencies in seconds of consecutive calls (hot caches)
+     */
+    std::vector<double> hot;
+    /**
+     * latencies in seconds of calls preceded by a cache flush
+     */
+    std::vector<double> cold;
+    /**
+     * average number of hardware events per call with hot caches
+     */
+    std::map<std::string, double> hotCounters;
+    /**
+     * average number of hardware events per call with cold caches
+     */
+    std::map<std::string, double> coldCounters;
+};
+
+/**
+ * Measures the evaluation latency of the functions in a GenericModel or
+ * in a CppAD tape.
+ *
+ * For each function it determines the latency of the first call, the
+ * latency distribution of consecutive calls and, optionally, the latency
+ * distribution when the CPU caches are flushed before each call.
+ */
+template<class Base>
+class EvaluationBenchmark {
+protected:
+    size_t nTimes_;
+    bool coldCache_;
+    bool hardwareCounters_;
+    std::vector<char> flushBuffer_;
+    PerfCounters perf_;
+public:
+
+    inline explicit EvaluationBenchmark(size_t nTimes = 100) :
+        nTimes_(nTimes),
+        coldCache_(true),
+        hardwareCounters_(true),
+        flushBuffer_(64 * 1024 * 1024) {
+    }
+
+    inline virtual ~EvaluationBenchmark() = default;
+
+    inline size_t getNumberOfExecutions() const {
+        return nTimes_;
+    }
+
+    /**
+     * Defines the number of calls used to determine each latency
+     * distribution.
+     */
+    inline void setNumberOfExecutions(size_t nTimes) {
+        nTimes_ = nTimes;
+    }
+
+    inline bool isColdCache() const {
+        return coldCache_;
+    }
+
+    /**
+     * Defines whether or not to also measure the latencies when the CPU
+     * caches are flushed before each call.
+     */
+    inline void setColdCache(bool cold) {
+        coldCache_ = cold;
+    }
+
+    /**
+     * Defines the size of the buffer accessed to flush the CPU caches
+     * (it should be larger than the last level cache).
+     *
+     * @param bytes the buffer size in bytes
+     */
+    inline void setCacheFlushSize(size_t bytes) {
+        flushBuffer_.resize(bytes);
+    }
+
+    /**
+     * @return true if the hardware event counters are collected
+     */
+    inline bool isHardwareCounters() const {
+        return hardwareCounters_ && perf_.isAvailable();
+    }
+
+    /**
+     * Defines whether or not to collect hardware event counters (only if
+     * they are available).
+     */
+    inline void setHardwareCounters(bool counters) {
+        hardwareCounters_ = counters;
+    }
+
+    /**
+     * Measures a function.
+     * The first call to the function is measured separately.
+     *
+     * @param name the function name
+     * @param function the function to evaluate
+     */
+    template<class Function>
+    inline EvaluationResult measure(const std::string& name,
+                                    const Function& function) {
+        using namespace std::chrono;
+
+        EvaluationResult r;
+        r.name = name;
+
+        auto t0 = steady_clock::now();
+        function();
+        r.first = duration<double>(steady_clock::now() - t0).count();
+
+        r.hot = measureTimes(function, false, r.hotCounters);
+        if (coldCache_) {
+            r.cold = measureTimes(function, true, r.coldCounters);
+        }
+
+        return r;
+    }
+
+    /**
+     * Measures all the functions available in a model.
+     * The first call latencies are only meaningful for a new model object.
+     *
+     * @param model the model
+     * @param x the independent variables
+     */
+    inline std::vector<EvaluationResult> measure(GenericModel<Base>& model,
+                                                 const std::vector<Base>& x) {
+        std::vector<EvaluationResult> results;
+
+        const size_t n = model.Domain();
+        const size_t m = model.Range();
+
+        ArrayView<const Base> xv(x);
+        const std::vector<Base> w(m, 1.0);
+        ArrayView<const Base> wv(w);
+        const std::vector<Base> v(n, 1.0);
+
+        // a single non-zero direction for the first order methods
+        const size_t idx[1] = {0};
+        const Base dir[1] = {1.0};
+
+        if (model.isForwardZeroAvailable()) {
+            std::vector<Base> y(m);
+            results.push_back(measure("ForwardZero", [&]() {
+                model.ForwardZero(xv, ArrayView<Base>(y));
+            }));
+        }
+
+        if (model.isSparseJacobianAvailable()) {
+            std::vector<size_t> rows, cols;
+            model.JacobianSparsity(rows, cols);
+            std::vector<Base> jac(rows.size());
+            const size_t* row;
+            const size_t* col;
+            results.push_back(measure("SparseJacobian", [&]() {
+                model.SparseJacobian(xv, ArrayView<Base>(jac), &row, &col);
+            }));
+        }
+
+        if (model.isSparseHessianAvailable()) {
+            std::vector<size_t> rows, cols;
+            model.HessianSparsity(rows, cols);
+            std::vector<Base> hess(rows.size());
+            const size_t* row;
+            const size_t* col;
+            results.push_back(measure("SparseHessian", [&]() {
+                model.SparseHessian(xv, wv, ArrayView<Base>(hess), &row, &col);
+            }));
+        }
+
+        if (model.isSparseForwardOneAvailable()) {
+            std::vector<Base> ty1(m);
+            results.push_back(measure("ForwardOne", [&]() {
+                model.ForwardOne(xv, 1, idx, dir, ArrayView<Base>(ty1));
+            }));
+        }
+
+        if (model.isSparseReverseOneAvailable()) {
+            std::vector<Base> px(n);
+            results.push_back(measure("ReverseOne", [&]() {
+                model.ReverseOne(xv, ArrayView<Base>(px), 1, idx, dir);
+            }));
+        }
+
+        if (model.isSparseReverseTwoAvailable()) {
+            std::vector<Base> px2(n);
+            results.push_back(measure("ReverseTwo", [&]() {
+                model.ReverseTwo(xv, 1, idx, dir, ArrayView<Base>(px2), wv);
+            }));
+        }
+
+        if (model.isJacobianVectorProductAvailable()) {
+            std::vector<Base> jv(m);
+            results.push_back(measure("JacobianVectorProduct", [&]() {
+                model.JacobianVectorProduct(xv, ArrayView<const Base>(v), ArrayView<Base>(jv));
+            }));
+        }
+
+        if (model.isHessianVectorProductAvailable()) {
+            std::vector<Base> hv(n);
+            results.push_back(measure("HessianVectorProduct", [&]() {
+                model.HessianVectorProduct(xv, wv, ArrayView<const Base>(v), ArrayView<Base>(hv));
+            }));
+        }
+
+        return results;
+    }
+
+    /**
+     * Measures the equivalent operations with a CppAD tape so that they
+     * can be compared with a generated model (same function names).
+     * The sparsity patterns are determined before the measurements.
+     *
+     * @param fun the CppAD tape
+     * @param x the independent variables
+     */
+    inline std::vector<EvaluationResult> measure(ADFun<Base>& fun,
+                                                 const std::vector<Base>& x) {
+        using VectorSet = std::vector<std::set<size_t> >;
+
+        std::vector<EvaluationResult> results;
+
+        const size_t n = fun.Domain();
+        const size_t m = fun.Range();
+
+        const std::vector<Base> w(m, 1.0);
+        std::vector<Base> dx(n, 0.0);
+        dx[0] = 1.0;
+        std::vector<Base> dy(m, 0.0);
+        dy[0] = 1.0;
+
+        results.push_back(measure("ForwardZero", [&]() {
+            fun.Forward(0, x);
+        }));
+
+        VectorSet jacSparsity = jacobianSparsitySet<VectorSet, Base>(fun);
+        std::vector<size_t> jacRows, jacCols;
+        generateSparsityIndexes(jacSparsity, jacRows, jacCols);
+        std::vector<Base> jac(jacRows.size());
+        sparse_jacobian_work jacWork;
+        results.push_back(measure("SparseJacobian", [&]() {
+            fun.SparseJacobianReverse(x, jacSparsity, jacRows, jacCols, jac, jacWork);
+        }));
+
+        VectorSet hessSparsity = hessianSparsitySet<VectorSet, Base>(fun);
+        std::vector<size_t> hessRows, hessCols;
+        generateSparsityIndexes(hessSparsity, hessRows, hessCols);
+        std::vector<Base> hess(hessRows.size());
+        sparse_hessian_work hessWork;
+        results.push_back(measure("SparseHessian", [&]() {
+            fun.SparseHessian(x, w, hessSparsity, hessRows, hessCols, hess, hessWork);
+        }));
+
+        results.push_back(measure("ForwardOne", [&]() {
+            fun.Forward(0, x);
+            fun.Forward(1, dx);
+        }));
+
+        results.push_back(measure("ReverseOne", [&]() {
+            fun.Forward(0, x);
+            fun.Reverse(1, dy);
+        }));
+
+        results.push_back(measure("ReverseTwo", [&]() {
+            fun.Forward(0, x);
+            fun.Forward(1, dx);
+            fun.Reverse(2, w);
+        }));
+
+        return results;
+    }
+
+    /**
+     * Prints a table with the latency distribution of each function.
+     */
+    static inline void print(std::ostream& out,
+                             const std::vector<EvaluationResult>& results) {
+        OStreamConfigRestore osr(out);
+
+        out << std::setw(30) << "" << "  "
+            << std::setw(12) << "first" << " "
+            << std::setw(12) << "mean" << " "
+            << std::setw(12) << "min" << " "
+            << std::setw(12) << "p50" << " "
+            << std::setw(12) << "p90" << " "
+            << std::setw(12) << "p99" << " "
+            << std::setw(12) << "max" << std::endl;
+
+        for (const EvaluationResult& r : results) {
+            printRow(out, r.name, r.first, r.hot, r.hotCounters);
+            if (!r.cold.empty())
+                printRow(out, r.name + " (cold)", std::numeric_limits<double>::quiet_NaN(), r.cold, r.coldCounters);
+        }
+    }
+
+    /**
+     * Prints the ratios between the latencies of two sets of measurements
+     * of functions with the same names (e.g. CppAD tape / generated model).
+     */
+    static inline void printComparison(std::ostream& out,
+                                       const std::vector<EvaluationResult>& reference,
+                                       const std::vector<EvaluationResult>& results) {
+        OStreamConfigRestore osr(out);
+
+        out << std::setw(30) << "speedup" << "  "
+            << std::setw(12) << "first" << " "
+            << std::setw(12) << "p50" << " "
+            << std::setw(12) << "p99" << " "
+            << std::setw(12) << "max" << std::endl;
+
+        for (const EvaluationResult& r : results) {
+            for (const EvaluationResult& ref : reference) {
+                if (ref.name != r.name)
+                    continue;
+
+                LatencyStatistics sRef(ref.hot);
+                LatencyStatistics s(r.hot);
+                out << std::setw(30) << r.name << ": "
+                    << std::setw(12) << ref.first / r.first << " "
+                    << std::setw(12) << sRef.p50 / s.p50 << " "
+                    << std::setw(12) << sRef.p99 / s.p99 << " "
+                    << std::setw(12) << sRef.max / s.max << std::endl;
+                break;
+            }
+        }
+    }
+
+protected:
+
+    template<class Function>
+    inline std::vector<double> measureTimes(const Function& function,
+                                            bool cold,
+                                            std::map<std::string, double>& counters) {
+        using namespace std::chrono;
+
+        const bool perf = isHardwareCounters();
+
+        std::vector<double> dt(nTimes_);
+        for (size_t i = 0; i < nTimes_; i++) {
+            if (cold)
+                flushCache();
+
+            if (perf)
+                perf_.start();
+
+            auto t0 = steady_clock::now();
+            function();
+            dt[i] = duration<double>(steady_clock::now() - t0).count();
+
+            if (perf)
+                perf_.stop(counters);
+        }
+
+        if (nTimes_ > 0) {
+            for (auto& c : counters)
+                c.second /= nTimes_;
+        }
+
+        return dt;
+    }
+
+    /**
+     * Evicts the model data from the CPU caches by accessing a large
+     * buffer.
+     */
+    inline void flushCache() {
+        volatile char* b = flushBuffer_.data();
+        const size_t size = flushBuffer_.size();
+        for (size_t i = 0; i < size; i += 64) {
+            b[i] = char(b[i] + 1);
+        }
+    }
+
+    static inline void printRow(std::ostream& out,
+                                const std::string& title,
+                                double first,
+                                const std::vector<double>& times,
+                                const std::map<std::string, double>& counters) {
+        LatencyStatistics s(times);
+        out << std::setw(30) << title << ": "
+            << std::setw(12) << first << " "
+            << std::setw(12) << s.mean << " "
+            << std::setw(12) << s.min << " "
+            << std::setw(12) << s.p50 << " "
+            << std::setw(12) << s.p90 << " "
+            << std::setw(12) << s.p99 << " "
+            << std::setw(12) << s.max;
+        for (const auto& c : counters)
+            out << "  " << c.first << "=" << c.second;
+        out << std::endl;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,217 @@
+#ifndef CPPAD_CG_BENCHMARK_REPORT_INCLUDED
+#define CPPAD_CG_BENCHMARK_REPORT_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <cppad/cg/cppadcg.hpp>
+#include "../evaluation_benchmark.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A set of time measurements of a benchmark
+ */
+class BenchmarkEntry {
+public:
+    /**
+     * the model name
+     */
+    std::string model;
+    /**
+     * the model size (e.g. number of repeated elements)
+     */
+    size_t size;
+    /**
+     * number of independent variables
+     */
+    size_t n;
+    /**
+     * number of dependent variables
+     */
+    size_t m;
+    /**
+     * how the model library was created (e.g. "loops")
+     */
+    std::string variant;
+    /**
+     * the compiler used to create the model library (empty for the
+     * preparation steps which do not depend on it)
+     */
+    std::string backend;
+    /**
+     * number of threads used by the model library
+     */
+    size_t threads;
+    /**
+     * what was measured (e.g. "tape", "SparseJacobian")
+     */
+    std::string metric;
+    /**
+     * whether or not the CPU caches were flushed before each measurement
+     */
+    bool coldCache = false;
+    /**
+     * the time of the first execution in seconds (NaN if not measured)
+     */
+    double first = std::numeric_limits<double>::quiet_NaN();
+    /**
+     * the measured times in seconds
+     */
+    std::vector<double> times;
+    /**
+     * average number of hardware events per execution
+     */
+    std::map<std::string, double> counters;
+};
+
+/**
+ * Collects the results of several benchmarks so that they can be saved
+ * in a machine readable format (JSON) for regression tracking.
+ */
+class BenchmarkReport {
+public:
+    using duration = std::chrono::steady_clock::duration;
+private:
+    std::vector<BenchmarkEntry> entries_;
+public:
+
+    inline const std::vector<BenchmarkEntry>& getEntries() const {
+        return entries_;
+    }
+
+    inline void add(BenchmarkEntry entry) {
+        entries_.push_back(std::move(entry));
+    }
+
+    inline void add(const BenchmarkEntry& info,
+                    const std::string& metric,
+                    const std::vector<duration>& times) {
+        if (times.empty())
+            return;
+
+        BenchmarkEntry e = info;
+        e.metric = metric;
+        e.times.resize(times.size());
+        for (size_t i = 0; i < times.size(); i++)
+            e.times[i] = std::chrono::duration<double>(times[i]).count();
+        entries_.push_back(std::move(e));
+    }
+
+    inline void add(const BenchmarkEntry& info,
+                    const EvaluationResult& result) {
+        BenchmarkEntry e = info;
+        e.metric = result.name;
+        e.first = result.first;
+        e.times = result.hot;
+        e.counters = result.hotCounters;
+        entries_.push_back(e);
+
+        if (!result.cold.empty()) {
+            e.coldCache = true;
+            e.first = std::numeric_limits<double>::quiet_NaN();
+            e.times = result.cold;
+            e.counters = result.coldCounters;
+            entries_.push_back(std::move(e));
+        }
+    }
+
+    /**
+     * Writes all the results in the JSON format.
+     * Each entry contains the statistics of the measured times (in seconds),
+     * the throughput (executions per second computed with the median) and,
+     * when available, the first execution time and hardware event counts.
+     */
+    inline void writeJson(std::ostream& out) const {
+        OStreamConfigRestore osr(out);
+        out << std::setprecision(9);
+
+        out << "{\"benchmark\":\"speed_models\",\n"
+               "\"results\":[";
+        for (size_t i = 0; i < entries_.size(); i++) {
+            const BenchmarkEntry& e = entries_[i];
+            if (i > 0) out << ",";
+
+            LatencyStatistics s(e.times);
+
+            out << "\n{\"model\":";
+            printJsonString(out, e.model);
+            out << ",\"size\":" << e.size
+                << ",\"n\":" << e.n
+                << ",\"m\":" << e.m
+                << ",\"variant\":";
+            printJsonString(out, e.variant);
+            out << ",\"backend\":";
+            printJsonString(out, e.backend);
+            out << ",\"threads\":" << e.threads
+                << ",\"metric\":";
+            printJsonString(out, e.metric);
+            out << ",\"cold_cache\":" << (e.coldCache ? "true" : "false");
+            if (!std::isnan(e.first))
+                out << ",\"first\":" << e.first;
+            out << ",\"count\":" << s.count
+                << ",\"mean\":" << s.mean
+                << ",\"stddev\":" << s.stdDev
+                << ",\"min\":" << s.min
+                << ",\"median\":" << s.p50
+                << ",\"p90\":" << s.p90
+                << ",\"p99\":" << s.p99
+                << ",\"max\":" << s.max
+                << ",\"throughput\":" << (s.p50 > 0 ? 1.0 / s.p50 : 0.0);
+            for (const auto& c : e.counters) {
+                out << ",";
+                printJsonString(out, c.first);
+                out << ":" << c.second;
+            }
+            out << "}";
+        }
+        out << "\n]}\n";
+    }
+
+    /**
+     * Saves all the results to a file in the JSON format.
+     *
+     * @param file the file path
+     * @throws CGException if the file cannot be created
+     */
+    inline void saveJson(const std::string& file) const {
+        std::ofstream out(file.c_str());
+        if (!out.is_open()) {
+            throw CGException("Failed to create benchmark file '", file, "'");
+        }
+        writeJson(out);
+        if (out.fail()) {
+            throw CGException("Failed to write benchmark file '", file, "'");
+        }
+    }
+
+private:
+
+    static inline void printJsonString(std::ostream& out,
+                                       const std::string& str) {
+        out << '"';
+        for (char c : str) {
+            if (c == '"' || c == '\\')
+                out << '\\';
+            out << c;
+        }
+        out << '"';
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,405 @@
+#ifndef CPPAD_CG_MODEL_BENCHMARK_INCLUDED
+#define CPPAD_CG_MODEL_BENCHMARK_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <cppad/cg/cppadcg.hpp>
+#include <cppad/cg/model/llvm/llvm.hpp>
+#include "../patterns/job_speed_listener.hpp"
+#include "../evaluation_benchmark.hpp"
+#include "benchmark_report.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Measures the time required by each step of the creation of a model
+ * library (taping, loop detection, source generation, compilation, library
+ * loading) and the time required to evaluate each of the model functions.
+ *
+ * Model libraries are created with and without loops and compiled with
+ * GCC, Clang and the LLVM JIT.
+ * Models without loops are also evaluated using a thread pool.
+ */
+class ModelBenchmark {
+public:
+    using Base = double;
+    using CGD = CppAD::cg::CG<Base>;
+    using ADCGD = CppAD::AD<CGD>;
+    using duration = std::chrono::steady_clock::duration;
+public:
+    bool withoutLoops;
+    bool withLoops;
+    bool gcc;
+    bool clang;
+    bool llvmJit;
+protected:
+    std::string name_;
+    BenchmarkReport& report_;
+    std::vector<GenericModel<Base>*> externalModels_;
+    std::vector<std::string> compileFlags_;
+    JobSpeedListener listener_;
+    EvaluationBenchmark<Base> evaluator_;
+    size_t nPrepTimes_; // number of times each library is created
+    size_t nThreads_; // number of threads in the thread pool
+    bool verbose_;
+public:
+
+    inline ModelBenchmark(const std::string& name,
+                          BenchmarkReport& report,
+                          bool verbose = false) :
+        withoutLoops(true),
+        withLoops(true),
+        gcc(true),
+        clang(true),
+        llvmJit(true),
+        name_(name),
+        report_(report),
+        evaluator_(30),
+        nPrepTimes_(1),
+        nThreads_(4),
+        verbose_(verbose) {
+    }
+
+    inline virtual ~ModelBenchmark() = default;
+
+    inline const std::string& getName() const {
+        return name_;
+    }
+
+    inline void setNumberOfExecutions(size_t nTimes) {
+        evaluator_.setNumberOfExecutions(nTimes);
+    }
+
+    /**
+     * Provides the object used to measure the evaluation latencies
+     * (e.g. to disable the cold cache measurements).
+     */
+    inline EvaluationBenchmark<Base>& getEvaluationBenchmark() {
+        return evaluator_;
+    }
+
+    inline void setNumberOfPreparations(size_t nTimes) {
+        nPrepTimes_ = nTimes == 0 ? 1 : nTimes;
+    }
+
+    inline void setNumberOfThreads(size_t nThreads) {
+        nThreads_ = nThreads;
+    }
+
+    inline void setCompileFlags(const std::vector<std::string>& compileFlags) {
+        compileFlags_ = compileFlags;
+    }
+
+    inline void setExternalModels(const std::vector<GenericModel<Base>*>& atoms) {
+        externalModels_ = atoms;
+    }
+
+    virtual std::vector<ADCGD> model(const std::vector<ADCGD>& x,
+                                     size_t repeat) = 0;
+
+    virtual std::vector<Base> getTypicalValues(size_t repeat) = 0;
+
+    virtual std::vector<std::set<size_t> > getRelatedCandidates(size_t repeat) = 0;
+
+    /**
+     * Runs all the benchmarks for a given model size.
+     *
+     * @param repeat the model size (number of repeated elements)
+     */
+    inline void measure(size_t repeat) {
+        std::vector<Base> xb = getTypicalValues(repeat);
+
+        std::cout << "\n" << name_ << " (size=" << repeat << ", n=" << xb.size() << ")" << std::endl;
+
+        if (withoutLoops)
+            measureVariant(repeat, xb, false);
+
+        if (withLoops)
+            measureVariant(repeat, xb, true);
+    }
+
+protected:
+
+    inline void measureVariant(size_t repeat,
+                               const std::vector<Base>& xb,
+                               bool loops) {
+        using namespace std::chrono;
+
+        BenchmarkEntry info;
+        info.model = name_;
+        info.size = repeat;
+        info.n = xb.size();
+        info.variant = loops ? "loops" : "no loops";
+        info.threads = 1;
+
+        std::cout << "  " << info.variant << std::endl;
+
+        std::vector<std::set<size_t> > relatedDepCandidates;
+        if (loops)
+            relatedDepCandidates = getRelatedCandidates(repeat);
+
+        // the thread pool cannot be used by models with loops or by models
+        // calling other models
+        bool multiThread = !loops && nThreads_ > 1 && externalModels_.empty();
+
+        std::string modelName = name_ + (loops ? "Loops" : "NoLoops");
+
+        /**
+         * preparation
+         */
+        std::unique_ptr<ADFun<CGD> > fun;
+        std::unique_ptr<ModelCSourceGen<Base> > modelSourceGen;
+        std::unique_ptr<ModelLibraryCSourceGen<Base> > libSourceGen;
+
+        std::vector<duration> tape(nPrepTimes_);
+        std::vector<duration> loopDetection, graphGen, srcCodeGen;
+        for (size_t i = 0; i < nPrepTimes_; i++) {
+            libSourceGen.reset();
+            modelSourceGen.reset();
+
+            // tape
+            auto t0 = steady_clock::now();
+            fun.reset(tapeModel(xb, repeat));
+            tape[i] = steady_clock::now() - t0;
+
+            // source code generation
+            listener_.reset();
+
+            modelSourceGen = createModelSourceGen(*fun, modelName, relatedDepCandidates, xb, multiThread);
+
+            libSourceGen.reset(new ModelLibraryCSourceGen<Base>(*modelSourceGen));
+            libSourceGen->setVerbose(verbose_);
+            libSourceGen->setMultiThreading(multiThread ? MultiThreadingType::PTHREADS : MultiThreadingType::NONE);
+            libSourceGen->addListener(listener_);
+
+            SaveFilesModelLibraryProcessor<Base>::saveLibrarySourcesTo(*libSourceGen, "sources_" + modelName + "_" + std::to_string(repeat));
+
+            if (loops)
+                loopDetection.push_back(listener_.patternDection);
+            graphGen.push_back(listener_.graphGen);
+            srcCodeGen.push_back(listener_.srcCodeGen);
+        }
+        info.m = fun->Range();
+
+        addResult(info, "tape", tape);
+        addResult(info, "loop detection", loopDetection);
+        addResult(info, "graph generation", graphGen);
+        addResult(info, "source generation", srcCodeGen);
+
+        /**
+         * compilation and evaluation
+         */
+        if (gcc) {
+            GccCompiler<Base> compiler;
+            measureDynamicLib(info, "gcc", compiler, *libSourceGen, modelName, xb, multiThread);
+        }
+
+        if (clang) {
+            ClangCompiler<Base> compiler;
+            if (system::isFile(compiler.getCompilerPath())) {
+                measureDynamicLib(info, "clang", compiler, *libSourceGen, modelName, xb, multiThread);
+            } else {
+                std::cout << "    clang not found: skipped" << std::endl;
+            }
+        }
+
+        if (llvmJit && !multiThread) {
+            measureJitLib(info, *libSourceGen, modelName, xb);
+        }
+    }
+
+    inline std::unique_ptr<ModelCSourceGen<Base> > createModelSourceGen(ADFun<CGD>& fun,
+                                                                        const std::string& modelName,
+                                                                        const std::vector<std::set<size_t> >& relatedDepCandidates,
+                                                                        const std::vector<Base>& xTypical,
+                                                                        bool multiThread) {
+        std::unique_ptr<ModelCSourceGen<Base> > modelSourceGen(new ModelCSourceGen<Base>(fun, modelName));
+        modelSourceGen->setCreateForwardZero(true);
+        modelSourceGen->setCreateSparseJacobian(true);
+        modelSourceGen->setCreateSparseHessian(true);
+        modelSourceGen->setCreateForwardOne(true);
+        modelSourceGen->setCreateReverseOne(true);
+        modelSourceGen->setCreateReverseTwo(true);
+        modelSourceGen->setCreateJacobianVectorProduct(true);
+        modelSourceGen->setCreateHessianVectorProduct(true);
+        modelSourceGen->setRelatedDependents(relatedDepCandidates);
+        modelSourceGen->setTypicalIndependentValues(xTypical);
+        if (multiThread) {
+            modelSourceGen->setMultiThreading(true);
+            modelSourceGen->setParallelTasks(nThreads_);
+        }
+        return modelSourceGen;
+    }
+
+    inline void measureDynamicLib(BenchmarkEntry info,
+                                  const std::string& backend,
+                                  AbstractCCompiler<Base>& compiler,
+                                  ModelLibraryCSourceGen<Base>& libSourceGen,
+                                  const std::string& modelName,
+                                  const std::vector<Base>& xb,
+                                  bool multiThread) {
+        using namespace std::chrono;
+
+        std::cout << "    " << backend << std::endl;
+
+        info.backend = backend;
+
+        if (!compileFlags_.empty())
+            compiler.setCompileFlags(compileFlags_);
+        if (multiThread)
+            compiler.addCompileFlag("-pthread");
+
+        std::string libName = "modelLib_" + backend + "_" + modelName;
+        DynamicModelLibraryProcessor<Base> p(libSourceGen, libName);
+
+        std::unique_ptr<DynamicLib<Base> > dynamicLib;
+        std::unique_ptr<GenericModel<Base> > model;
+
+        std::vector<duration> srcCodeComp, dynLibComp, total, load;
+        for (size_t i = 0; i < nPrepTimes_; i++) {
+            model.reset();
+            dynamicLib.reset();
+
+            listener_.reset();
+            p.createDynamicLibrary(compiler, false);
+
+            srcCodeComp.push_back(listener_.srcCodeComp);
+            dynLibComp.push_back(listener_.dynLibComp);
+            total.push_back(listener_.totalLibrary);
+
+            auto t0 = steady_clock::now();
+            dynamicLib.reset(new LinuxDynamicLib<Base>(libName + system::SystemInfo<>::DYNAMIC_LIB_EXTENSION));
+            model = dynamicLib->model(modelName);
+            load.push_back(steady_clock::now() - t0);
+        }
+
+        addResult(info, "source compilation", srcCodeComp);
+        addResult(info, "dynamic library compilation", dynLibComp);
+        addResult(info, "total library creation", total);
+        addResult(info, "library load", load);
+
+        evaluateLibrary(info, *dynamicLib, *model, xb, multiThread);
+    }
+
+    inline void measureJitLib(BenchmarkEntry info,
+                              ModelLibraryCSourceGen<Base>& libSourceGen,
+                              const std::string& modelName,
+                              const std::vector<Base>& xb) {
+        using namespace std::chrono;
+
+        std::cout << "    llvm" << std::endl;
+
+        info.backend = "llvm";
+
+        std::unique_ptr<LlvmModelLibrary<Base> > llvmLib;
+        std::unique_ptr<GenericModel<Base> > model;
+
+        std::vector<duration> jit, load;
+        for (size_t i = 0; i < nPrepTimes_; i++) {
+            model.reset();
+            llvmLib.reset();
+
+            listener_.reset();
+            llvmLib = LlvmModelLibraryProcessor<Base>::create(libSourceGen);
+            jit.push_back(listener_.jit);
+
+            auto t0 = steady_clock::now();
+            model = llvmLib->model(modelName);
+            load.push_back(steady_clock::now() - t0);
+        }
+
+        addResult(info, "JIT library preparation", jit);
+        addResult(info, "library load", load);
+
+        evaluateLibrary(info, *llvmLib, *model, xb, false);
+    }
+
+    inline void evaluateLibrary(BenchmarkEntry info,
+                                ModelLibrary<Base>& lib,
+                                GenericModel<Base>& model,
+                                const std::vector<Base>& xb,
+                                bool multiThread) {
+        CPPADCG_ASSERT_KNOWN(model.Domain() == xb.size(), "Invalid model library")
+
+        for (GenericModel<Base>* atom : externalModels_)
+            model.addExternalModel(*atom);
+
+        info.threads = 1;
+        if (multiThread)
+            lib.setThreadPoolDisabled(true);
+        evaluate(info, model, xb);
+
+        if (multiThread) {
+            lib.setThreadPoolDisabled(false);
+            lib.setThreadNumber(nThreads_);
+            info.threads = nThreads_;
+            evaluate(info, model, xb);
+        }
+    }
+
+    /**
+     * Measures the evaluation latency of all the available model functions.
+     */
+    inline void evaluate(const BenchmarkEntry& info,
+                         GenericModel<Base>& model,
+                         const std::vector<Base>& x) {
+        std::vector<EvaluationResult> results = evaluator_.measure(model, x);
+
+        for (const EvaluationResult& r : results) {
+            report_.add(info, r);
+        }
+
+        OStreamConfigRestore osr(std::cout);
+        if (info.threads > 1)
+            std::cout << "    " << info.threads << " threads" << std::endl;
+        EvaluationBenchmark<Base>::print(std::cout, results);
+    }
+
+    inline void addResult(const BenchmarkEntry& info,
+                          const std::string& metric,
+                          const std::vector<duration>& times) {
+        if (times.empty())
+            return;
+
+        report_.add(info, metric, times);
+
+        LatencyStatistics s(report_.getEntries().back().times);
+
+        std::cout << "      " << std::setw(36) << metric << ": "
+                  << std::setw(12) << s.p50 << " s" << std::endl;
+    }
+
+    inline ADFun<CGD>* tapeModel(const std::vector<Base>& xb,
+                                 size_t repeat) {
+        std::vector<ADCGD> x(xb.size());
+        for (size_t j = 0; j < xb.size(); j++)
+            x[j] = xb[j];
+        CppAD::Independent(x);
+
+        std::vector<ADCGD> y = model(x, repeat);
+
+        std::unique_ptr<ADFun<CGD> > fun(new ADFun<CGD>());
+        fun->Dependent(y);
+
+        return fun.release();
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,348 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "model_benchmark.hpp"
+#include "../../../../test/cppad/cg/models/cstr.hpp"
+#include "../../../../test/cppad/cg/models/distillation.hpp"
+#include "../../../../test/cppad/cg/models/tank_battery.hpp"
+#include "../../../../test/cppad/cg/models/plug_flow.hpp"
+#include "../../../../test/cppad/cg/models/collocation.hpp"
+
+namespace CppAD {
+namespace cg {
+
+using Base = double;
+using CGD = CppAD::cg::CG<Base>;
+
+/**
+ * Benchmark of a model with a fixed size which is repeated several times
+ * (each copy has its own independent variables).
+ */
+class ReplicatedModelBenchmark : public ModelBenchmark {
+protected:
+    std::vector<Base> x0_; // typical values of a single copy
+    size_t m0_; // number of equations of a single copy
+    std::vector<std::set<size_t> > related0_; // related equations of a single copy
+public:
+
+    inline ReplicatedModelBenchmark(const std::string& name,
+                                    BenchmarkReport& report,
+                                    const std::vector<Base>& x0,
+                                    size_t m0,
+                                    const std::vector<std::set<size_t> >& related0) :
+        ModelBenchmark(name, report),
+        x0_(x0),
+        m0_(m0),
+        related0_(related0) {
+    }
+
+    virtual std::vector<ADCGD> modelCopy(const std::vector<ADCGD>& x) = 0;
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x,
+                             size_t repeat) override {
+        const size_t n0 = x0_.size();
+
+        std::vector<ADCGD> y;
+        y.reserve(m0_ * repeat);
+        std::vector<ADCGD> xi(n0);
+        for (size_t i = 0; i < repeat; i++) {
+            std::copy(x.begin() + i * n0, x.begin() + (i + 1) * n0, xi.begin());
+            std::vector<ADCGD> yi = modelCopy(xi);
+            assert(yi.size() == m0_);
+            y.insert(y.end(), yi.begin(), yi.end());
+        }
+        return y;
+    }
+
+    std::vector<Base> getTypicalValues(size_t repeat) override {
+        std::vector<Base> x;
+        x.reserve(x0_.size() * repeat);
+        for (size_t i = 0; i < repeat; i++)
+            x.insert(x.end(), x0_.begin(), x0_.end());
+        return x;
+    }
+
+    std::vector<std::set<size_t> > getRelatedCandidates(size_t repeat) override {
+        std::vector<std::set<size_t> > related(related0_.size());
+        for (size_t k = 0; k < related0_.size(); k++) {
+            for (size_t i = 0; i < repeat; i++) {
+                for (size_t e : related0_[k])
+                    related[k].insert(i * m0_ + e);
+            }
+        }
+        return related;
+    }
+};
+
+/**
+ * CSTR model values
+ */
+inline std::vector<Base> cstrTypicalValues() {
+    std::vector<Base> xx(28);
+    xx[0] = 0.3; // h
+    xx[1] = 7.82e3; // Ca
+    xx[2] = 304.65; // Tr
+    xx[3] = 301.15; // Tj
+
+    xx[4] = 2.3333e-04; // u1
+    xx[5] = 6.6667e-05; // u2
+
+    xx[6] = 6.2e14; //
+    xx[7] = 10080; //
+    xx[8] = 2e3; //
+    xx[9] = 10e3; //
+    xx[10] = 1e-11; //
+    xx[11] = 6.6667e-05; //
+    xx[12] = 294.15; //
+    xx[13] = 294.15; //
+    xx[14] = 1000; //
+    xx[15] = 4184; //Cp
+    xx[16] = -33488; //deltaH
+    xx[17] = 299.15; // Tj0
+    xx[18] = 302.65; //   Tj2
+    xx[19] = 7e5; // cwallj
+    xx[20] = 1203; // csteam
+    xx[21] = 3.22; //dsteam
+    xx[22] = 950.0; //Ug
+    xx[23] = 0.48649427192323; //vc6in
+    xx[24] = 1000; //rhoj
+    xx[25] = 4184; //Cpj
+    xx[26] = 0.014; //Vj
+    xx[27] = 1e-7; //cwallr
+    return xx;
+}
+
+/**
+ * Several independent CSTRs
+ */
+class CstrBenchmark : public ReplicatedModelBenchmark {
+public:
+
+    inline CstrBenchmark(BenchmarkReport& report) :
+        ReplicatedModelBenchmark("cstr", report, cstrTypicalValues(), 4, {{0}, {1}, {2}, {3}}) {
+    }
+
+    std::vector<ADCGD> modelCopy(const std::vector<ADCGD>& x) override {
+        return CstrFunc(x);
+    }
+};
+
+/**
+ * Several independent distillation columns (8 stages each)
+ */
+class DistillationBenchmark : public ReplicatedModelBenchmark {
+public:
+    static const size_t nStage = 8;
+public:
+
+    inline DistillationBenchmark(BenchmarkReport& report) :
+        ReplicatedModelBenchmark("distillation", report, typicalValues(), nStage * 6, relatedCandidates()) {
+    }
+
+    std::vector<ADCGD> modelCopy(const std::vector<ADCGD>& x) override {
+        return distillationFunc(x);
+    }
+
+private:
+
+    static std::vector<Base> typicalValues() {
+        std::vector<Base> xb(nStage * 6 + 8);
+        size_t j = 0;
+        for (size_t i = 0; i < nStage; i++, j++) xb[j] = 12000 + 1; // mWater
+        for (size_t i = 0; i < nStage; i++, j++) xb[j] = 12000 + 1; // mEthanol[i]
+        for (size_t i = 0; i < nStage; i++, j++) xb[j] = 360 + (i + 1); // T[i]
+        for (size_t i = 0; i < nStage; i++, j++) xb[j] = 0.3 + 0.05 * i; // yWater[i]
+        for (size_t i = 0; i < nStage; i++, j++) xb[j] = 0.7 - 0.05 * i; // yEthanol[i]
+        for (size_t i = 0; i < nStage - 1; i++, j++) xb[j] = 8 + 0.1 * i; // V[i]
+        xb[j++] = 150e3; // Qc
+
+        xb[j++] = 250e3; // Qsteam
+        xb[j++] = 0.1; // Fdistillate
+        xb[j++] = 2.5; // reflux
+        xb[j++] = 4; // Frectifier
+
+        xb[j++] = 30; // feed
+        xb[j++] = 1.01325e5; // P
+        xb[j++] = 0.7; // xFWater
+        xb[j++] = 366; // Tfeed
+        assert(j == xb.size());
+        return xb;
+    }
+
+    static std::vector<std::set<size_t> > relatedCandidates() {
+        std::vector<std::set<size_t> > related(6);
+        size_t j = 0;
+        for (size_t i = 0; i < nStage; i++, j++) related[0].insert(j); // mWater
+        for (size_t i = 0; i < nStage; i++, j++) related[1].insert(j); // mEthanol
+        for (size_t i = 0; i < nStage; i++, j++) related[4].insert(j); // T
+        for (size_t i = 0; i < nStage; i++, j++) related[2].insert(j); // yWater
+        for (size_t i = 0; i < nStage; i++, j++) related[3].insert(j); // yEthanol
+        for (size_t i = 0; i < nStage - 1; i++, j++) related[5].insert(j); // V
+        return related;
+    }
+};
+
+/**
+ * Several independent batteries of 6 tanks
+ */
+class TankBatteryBenchmark : public ReplicatedModelBenchmark {
+public:
+
+    inline TankBatteryBenchmark(BenchmarkReport& report) :
+        ReplicatedModelBenchmark("tank_battery", report,
+                                 {1.0, 1.1, 1.2, 1.3, 1.4, 1.5, // tank levels
+                                  1.0, // inlet flow
+                                  0.1}, // tank radius
+                                 6, {{0, 1, 2, 3, 4, 5}}) {
+    }
+
+    std::vector<ADCGD> modelCopy(const std::vector<ADCGD>& x) override {
+        return tankBatteryFunc(x);
+    }
+};
+
+/**
+ * Plug flow reactor with a variable number of discretization elements
+ */
+class PlugFlowBenchmark : public ModelBenchmark {
+public:
+
+    inline PlugFlowBenchmark(BenchmarkReport& report) :
+        ModelBenchmark("plug_flow", report) {
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x,
+                             size_t repeat) override {
+        PlugFlowModel<CGD> m;
+        return m.model2(x, repeat);
+    }
+
+    std::vector<Base> getTypicalValues(size_t repeat) override {
+        return PlugFlowModel<Base>::getTypicalValues(repeat);
+    }
+
+    std::vector<std::set<size_t> > getRelatedCandidates(size_t repeat) override {
+        return PlugFlowModel<Base>::getRelatedCandidates(repeat);
+    }
+};
+
+/**
+ * Collocation model using the CSTR model as an external model
+ */
+template<class T>
+class CstrCollocationModel : public CollocationModel<T> {
+public:
+
+    CstrCollocationModel() :
+        CollocationModel<T>(4, // ns
+                            2, // nm
+                            22) { // npar
+    }
+
+protected:
+
+    void atomicFunction(const std::vector<AD<CG<double> > >& x,
+                        std::vector<AD<CG<double> > >& y) override {
+        y = CstrFunc(x);
+    }
+
+    void atomicFunction(const std::vector<AD<double> >& x,
+                        std::vector<AD<double> >& y) override {
+        y = CstrFunc(x);
+    }
+
+    std::string getAtomicLibName() override {
+        return "cstrAtom";
+    }
+};
+
+/**
+ * Collocation model with a variable number of time intervals
+ */
+class CollocationBenchmark : public ModelBenchmark {
+protected:
+    CstrCollocationModel<CGD> colModel_;
+public:
+
+    inline CollocationBenchmark(BenchmarkReport& report) :
+        ModelBenchmark("collocation", report) {
+        colModel_.setTypicalAtomModelValues(cstrTypicalValues());
+        colModel_.createAtomicLib();
+
+        setExternalModels({colModel_.getGenericModel()});
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x,
+                             size_t repeat) override {
+        return colModel_.evaluateModel(x, repeat);
+    }
+
+    std::vector<Base> getTypicalValues(size_t repeat) override {
+        return colModel_.getTypicalValues(repeat);
+    }
+
+    std::vector<std::set<size_t> > getRelatedCandidates(size_t repeat) override {
+        size_t m = 3 * colModel_.getAtomicDepCount(); // K * ns
+        std::vector<std::set<size_t> > related(m);
+        for (size_t i = 0; i < repeat; i++) {
+            for (size_t ii = 0; ii < m; ii++) {
+                related[ii].insert(i * m + ii);
+            }
+        }
+        return related;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+/**
+ * usage: speed_models [output.json] [executions] [threads] [model ...]
+ */
+int main(int argc, char **argv) {
+    std::string outputFile = argc > 1 ? argv[1] : "speed_models.json";
+    size_t nExec = argc > 2 ? std::stoul(argv[2]) : 30;
+    size_t nThreads = argc > 3 ? std::stoul(argv[3]) : 4;
+    std::set<std::string> selected(argv + std::min(argc, 4), argv + argc);
+
+    BenchmarkReport report;
+
+    std::vector<std::pair<std::unique_ptr<ModelBenchmark>, std::vector<size_t> > > benchmarks;
+    benchmarks.emplace_back(std::unique_ptr<ModelBenchmark>(new CstrBenchmark(report)), std::vector<size_t>{1, 10, 50});
+    benchmarks.emplace_back(std::unique_ptr<ModelBenchmark>(new DistillationBenchmark(report)), std::vector<size_t>{1, 5, 10});
+    benchmarks.emplace_back(std::unique_ptr<ModelBenchmark>(new TankBatteryBenchmark(report)), std::vector<size_t>{1, 10, 50});
+    benchmarks.emplace_back(std::unique_ptr<ModelBenchmark>(new PlugFlowBenchmark(report)), std::vector<size_t>{10, 30, 50});
+    if (selected.empty() || selected.count("collocation") > 0) {
+        // only created when required since it compiles the external model
+        benchmarks.emplace_back(std::unique_ptr<ModelBenchmark>(new CollocationBenchmark(report)), std::vector<size_t>{5, 10, 20});
+    }
+
+    for (auto& b : benchmarks) {
+        ModelBenchmark& benchmark = *b.first;
+        if (!selected.empty() && selected.count(benchmark.getName()) == 0)
+            continue;
+
+        benchmark.setNumberOfExecutions(nExec);
+        benchmark.setNumberOfThreads(nThreads);
+        for (size_t repeat : b.second) {
+            benchmark.measure(repeat);
+        }
+    }
+
+    report.saveJson(outputFile);
+    std::cout << "\nresults saved to " << outputFile << std::endl;
+}
@@ -18,6 +18,7 @@
 #include <cppad/cg/cppadcg.hpp>
 #include <cppad/cg/model/llvm/llvm.hpp>
 #include "job_speed_listener.hpp"
+#include "../evaluation_benchmark.hpp"
 
 namespace CppAD {
 namespace cg {
@@ -97,6 +98,8 @@ protected:
     std::unique_ptr<ModelCSourceGen<double> > modelSourceGen_;
     std::unique_ptr<ModelLibraryCSourceGen<double> > libSourceGen_;
     JobSpeedListener listener_;
+    EvaluationBenchmark<Base> evaluator_;
+    std::map<std::string, std::vector<EvaluationResult> > cgResults_; // evaluation results of each CppADCG variant
     bool verbose_;
     size_t nTimes_;
 private:
@@ -122,6 +125,7 @@ public:
         libName_(libName),
         testJacobian_(true),
         testHessian_(true),
+        evaluator_(50),
         verbose_(verbose),
         nTimes_(50) {
 
@@ -129,6 +133,15 @@ public:
 
     inline void setNumberOfExecutions(size_t nTimes) {
         nTimes_ = nTimes;
+        evaluator_.setNumberOfExecutions(nTimes);
+    }
+
+    /**
+     * Provides the object used to measure the evaluation latencies
+     * (e.g. to disable the cold cache measurements).
+     */
+    inline EvaluationBenchmark<Base>& getEvaluationBenchmark() {
+        return evaluator_;
     }
 
     inline void setCompileFlags(const std::vector<std::string>& compileFlags) {
@@ -170,6 +183,8 @@ public:
                              const std::vector<Base>& xb) {
         using namespace CppAD;
 
+        cgResults_.clear(); // only compare with the variants of this model
+
         std::cout << libName_ << "\n";
         std::cout << "n=" << repeat << "\n";
         std::cerr << libName_ << "\n";
@@ -220,8 +235,6 @@ protected:
         std::cout << head << std::endl;
         std::cerr << head << std::endl;
 
-        printStatHeader();
-
         ModelCppADCG model(*this);
 
         std::unique_ptr<ADFun<CGD> > fun;
@@ -239,6 +252,7 @@ protected:
             // create dynamic lib
             createDynamicLib(*fun.get(), std::vector<std::set<size_t> >(), xb, i == dt.size() - 1, JacobianADMode::Reverse, testJacobian_, testHessian_);
         }
+        printStatHeader();
         printStat("model tape", dt);
         printCGResults();
 
@@ -246,7 +260,7 @@ protected:
          * execution
          */
         // evaluation speed
-        executionSpeedCppADCG(xb, cppADCG);
+        executionSpeedCppADCG("CppADCG (without Loops) GCC", xb, cppADCG);
     }
 
     inline void measureSpeedCppADCGWithLoops(const std::vector<std::set<size_t> >& relatedDepCandidates,
@@ -262,8 +276,6 @@ protected:
         std::cout << head << std::endl;
         std::cerr << head << std::endl;
 
-        printStatHeader();
-
         ModelCppADCG model(*this);
 
         std::unique_ptr<ADFun<CGD> > fun;
@@ -281,15 +293,15 @@ protected:
             // create dynamic lib
             createDynamicLib(*fun.get(), relatedDepCandidates, xb, i == dt.size() - 1, JacobianADMode::Reverse, testJacobian_, testHessian_);
         }
+        printStatHeader();
         printStat("model tape", dt);
-
         printCGResults();
 
         /**
          * execution
          */
         // evaluation speed
-        executionSpeedCppADCG(xb, cppADCGLoops);
+        executionSpeedCppADCG("CppADCG (with Loops) GCC", xb, cppADCGLoops);
     }
 
     inline void measureSpeedCppADCGWithLoopsLlvm(const std::vector<std::set<size_t> >& relatedDepCandidates,
@@ -304,8 +316,6 @@ protected:
         std::cout << head << std::endl;
         std::cerr << head << std::endl;
 
-        printStatHeader();
-
         JacobianADMode jacMode = JacobianADMode::Reverse;
         bool forReverseOne = false;
         bool reverseTwo = false;
@@ -332,13 +342,14 @@ protected:
             // prepare LLVM module
             createJitModelLib(libBaseName, xb, withLoops);
         }
+        printStatHeader();
         printCGResults();
 
         /**
          * execution
          */
         // evaluation speed
-        executionSpeedCppADCG(xb, cppADCGLoopsLlvm);
+        executionSpeedCppADCG("CppADCG (with Loops) LLVM", xb, cppADCGLoopsLlvm);
     }
 
     inline void printCGResults() {
@@ -378,8 +389,12 @@ protected:
         std::cerr << std::endl;
     }
 
+    /**
+     * Prints the header of the preparation times (in seconds) which are
+     * printed with printStat(); the evaluation times have their own table.
+     */
     static void printStatHeader() {
-        std::cout << std::setw(30) << "" << "  "
+        std::cout << std::setw(30) << "preparation [s]" << "  "
                   << std::setw(12) << "mean" << " +- " << std::setw(12) << "stdDev"
                   << "      "
                   << std::setw(12) << "min" << "|--["
@@ -451,8 +466,6 @@ protected:
         std::cout << head << std::endl;
         std::cerr << head << std::endl;
 
-        printStatHeader();
-
         ModelCppAD model(*this);
 
         std::unique_ptr<ADFun<Base> > fun;
@@ -473,6 +486,7 @@ protected:
             fun->optimize();
             dt2[i] = steady_clock::now() - t0;
         }
+        printStatHeader();
         printStat("model tape", dt1);
         printStat("optimize tape", dt2);
 
@@ -650,66 +664,45 @@ protected:
         total_.push_back(listener_.totalLibrary);
     }
 
-    inline void executionSpeedCppADCG(const std::vector<double>& x,
+    inline void executionSpeedCppADCG(const std::string& variant,
+                                      const std::vector<double>& x,
                                       bool eval,
                                       bool zero = true,
                                       bool jacobian = true,
                                       bool hessian = true) {
-        using namespace std::chrono;
+        std::vector<EvaluationResult> results;
 
         // model (zero-order)
-        if (zero) {
-            std::vector<duration> dt;
-            if (eval && zeroOrder) {
-                dt.resize(nTimes_);
-                std::vector<double> y(model_->Range());
-                for (size_t i = 0; i < nTimes_; i++) {
-                    auto t0 = steady_clock::now();
-                    model_->ForwardZero(x, y);
-                    dt[i] = steady_clock::now() - t0;
-                }
-            }
-            // save result
-            printStat("zero order", dt);
+        if (zero && eval && zeroOrder) {
+            std::vector<double> y(model_->Range());
+            results.push_back(evaluator_.measure("zero order", [&]() {
+                model_->ForwardZero(x, y);
+            }));
         }
 
         // Jacobian
-        if (jacobian) {
-            std::vector<duration> dt;
-            if (eval && sparseJacobian) {
-                dt.resize(nTimes_);
-                std::vector<double> jac;
-                std::vector<size_t> rows, cols;
-
-                for (size_t i = 0; i < nTimes_; i++) {
-                    auto t0 = steady_clock::now();
-                    model_->SparseJacobian(x, jac, rows, cols);
-                    dt[i] = steady_clock::now() - t0;
-                }
-            }
-            // save result
-            printStat("jacobian", dt);
+        if (jacobian && eval && sparseJacobian) {
+            std::vector<double> jac;
+            std::vector<size_t> rows, cols;
+            results.push_back(evaluator_.measure("jacobian", [&]() {
+                model_->SparseJacobian(x, jac, rows, cols);
+            }));
         }
 
         // Hessian
-        if (hessian) {
-            std::vector<duration> dt;
-            if (eval && sparseHessian) {
-                dt.resize(nTimes_);
-                std::vector<double> w(model_->Range(), 1.0);
-                std::vector<double> hess;
-                std::vector<size_t> rows, cols;
-
-                for (size_t i = 0; i < nTimes_; i++) {
-                    auto t0 = steady_clock::now();
-                    model_->SparseHessian(x, w, hess, rows, cols);
-                    dt[i] = steady_clock::now() - t0;
-                }
-            }
-            // save result
-            printStat("hessian", dt);
+        if (hessian && eval && sparseHessian) {
+            std::vector<double> w(model_->Range(), 1.0);
+            std::vector<double> hess;
+            std::vector<size_t> rows, cols;
+            results.push_back(evaluator_.measure("hessian", [&]() {
+                model_->SparseHessian(x, w, hess, rows, cols);
+            }));
         }
 
+        // save result
+        printEvaluation(results);
+        if (!results.empty())
+            cgResults_[variant] = results;
     }
 
     inline void executionSpeedCppAD(ADFun<Base>& fun,
@@ -719,20 +712,13 @@ protected:
                                     bool hessian = true) {
         using namespace std::chrono;
 
+        std::vector<EvaluationResult> results;
+
         // model (zero-order)
-        if (zero) {
-            std::vector<duration> dt;
-            if (cppAD && zeroOrder) {
-                std::vector<double> y(fun.Range());
-                dt.resize(nTimes_);
-                for (size_t i = 0; i < nTimes_; i++) {
-                    auto t0 = steady_clock::now();
-                    y = fun.Forward(0, x);
-                    dt[i] = steady_clock::now() - t0;
-                }
-            }
-            // save result
-            printStat("zero order", dt);
+        if (zero && cppAD && zeroOrder) {
+            results.push_back(evaluator_.measure("zero order", [&]() {
+                fun.Forward(0, x);
+            }));
         }
 
         // Jacobian
@@ -748,22 +734,16 @@ protected:
             }
             printStat("jacobian sparsity", dtp);
 
-            std::vector<duration> dt;
             if (cppAD && sparseJacobian) {
                 std::vector<size_t> rows, cols;
                 CppAD::cg::generateSparsityIndexes(sparsity, rows, cols);
                 std::vector<double> jac(rows.size());
 
                 sparse_jacobian_work work;
-                dt.resize(nTimes_);
-                for (size_t i = 0; i < nTimes_; i++) {
-                    auto t0 = steady_clock::now();
+                results.push_back(evaluator_.measure("jacobian", [&]() {
                     fun.SparseJacobianReverse(x, sparsity, rows, cols, jac, work);
-                    dt[i] = steady_clock::now() - t0;
-                }
+                }));
             }
-            // save result
-            printStat("jacobian", dt);
         }
 
         // Hessian
@@ -779,26 +759,51 @@ protected:
             }
             printStat("hessian sparsity", dtp);
 
-            std::vector<duration> dt;
             if (cppAD && sparseHessian) {
                 std::vector<size_t> rows, cols;
                 CppAD::cg::generateSparsityIndexes(sparsity, rows, cols);
                 std::vector<double> hess(rows.size());
 
-                std::vector<double> w(model_->Range(), 1.0);
+                std::vector<double> w(fun.Range(), 1.0);
 
                 sparse_hessian_work work;
-
-                dt.resize(nTimes_);
-                for (size_t i = 0; i < nTimes_; i++) {
-                    auto t0 = steady_clock::now();
+                results.push_back(evaluator_.measure("hessian", [&]() {
                     fun.SparseHessian(x, w, sparsity, rows, cols, hess, work);
-                    dt[i] = steady_clock::now() - t0;
-                }
+                }));
             }
-            // save result
-            printStat("hessian", dt);
+        }
+
+        // save result
+        printEvaluation(results);
 
+        // compare with the generated models
+        for (const auto& p : cgResults_) {
+            std::cout << "\n" << p.first << " relative to CppAD" << std::endl;
+            EvaluationBenchmark<Base>::printComparison(std::cout, results, p.second);
+        }
+    }
+
+    /**
+     * Prints the latency distributions to the standard output and the
+     * individual times to the standard error.
+     */
+    static void printEvaluation(const std::vector<EvaluationResult>& results) {
+        if (results.empty())
+            return;
+
+        EvaluationBenchmark<Base>::print(std::cout, results);
+
+        for (const EvaluationResult& r : results) {
+            std::cerr << std::setw(30) << r.name << ": ";
+            for (double t : r.hot)
+                std::cerr << std::setw(12) << t << " ";
+            std::cerr << std::endl;
+            if (!r.cold.empty()) {
+                std::cerr << std::setw(30) << r.name + " (cold)" << ": ";
+                for (double t : r.cold)
+                    std::cerr << std::setw(12) << t << " ";
+                std::cerr << std::endl;
+            }
         }
     }
 
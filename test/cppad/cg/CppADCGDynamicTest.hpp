@@ -42,6 +42,19 @@ protected:
     std::vector<Base> _xTape;
     std::vector<double> _xRun;
     size_t _maxAssignPerFunc = 100;
+    size_t _parallelTasks = 0;
+    SparseMatrixFormat _jacFormat = SparseMatrixFormat::Coordinate;
+    SparseMatrixFormat _hessFormat = SparseMatrixFormat::Coordinate;
+    bool _inMemory = false;
+    bool _blockDecomposition = false;
+    std::vector<size_t> _blockUnknowns;
+    bool _masked = false;
+    bool _directional = false;
+    size_t _directionalBatchSize = 1;
+    bool _profiling = false;
+    bool _variableOrdering = false;
+    bool _lazyLoading = false;
+    bool _scheduleOperations = false;
     double epsilonR = 1e-14;
     double epsilonA = 1e-14;
     std::vector<double> _xNorm;
@@ -123,7 +136,20 @@ public:
         modelSourceGen.setCreateReverseOne(_reverseOne);
         modelSourceGen.setCreateReverseTwo(_reverseTwo);
         modelSourceGen.setMaxAssignmentsPerFunc(_maxAssignPerFunc);
+        modelSourceGen.setSparseJacobianFormat(_jacFormat);
+        modelSourceGen.setSparseHessianFormat(_hessFormat);
         modelSourceGen.setMultiThreading(true);
+        modelSourceGen.setParallelTasks(_parallelTasks);
+        modelSourceGen.setCreateBlockDecomposition(_blockDecomposition);
+        modelSourceGen.setBlockUnknowns(_blockUnknowns);
+        modelSourceGen.setCreateMaskedForwardZero(_masked);
+        modelSourceGen.setCreateMaskedSparseJacobian(_masked);
+        modelSourceGen.setCreateJacobianVectorProduct(_directional);
+        modelSourceGen.setCreateHessianVectorProduct(_directional);
+        modelSourceGen.setDirectionalBatchSize(_directionalBatchSize);
+        modelSourceGen.setProfiling(_profiling);
+        modelSourceGen.setCreateVariableOrdering(_variableOrdering);
+        modelSourceGen.setScheduleOperations(_scheduleOperations);
 
         if (!_jacRow.empty())
             modelSourceGen.setCustomSparseJacobianElements(_jacRow, _jacCol);
@@ -157,6 +183,7 @@ public:
         GccCompiler<double> compiler;
         //compiler.setSaveToDiskFirst(true); // useful to detect problem
         prepareTestCompilerFlags(compiler);
+        compiler.setInMemory(_inMemory);
         if(libSourceGen.getMultiThreading() == MultiThreadingType::OPENMP) {
             compiler.addCompileFlag("-fopenmp");
             compiler.addCompileFlag("-pthread");
@@ -171,7 +198,16 @@ public:
             compiler.addCompileFlag("-pthread");
         }
 
+        if (_lazyLoading) {
+#ifdef CPPAD_CG_SYSTEM_LINUX
+            p.getOptions()["dlOpenMode"] = std::to_string(RTLD_LAZY);
+#endif
+        }
+
         _dynamicLib = p.createDynamicLibrary(compiler);
+        if (_lazyLoading) {
+            _dynamicLib->setLazyFunctionLoading(true);
+        }
         _dynamicLib->setThreadPoolVerbose(this->verbose_);
         _dynamicLib->setThreadNumber(2);
         _dynamicLib->setThreadPoolDisabled(_multithreadDisabled);
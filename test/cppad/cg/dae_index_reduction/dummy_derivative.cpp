@@ -183,3 +183,54 @@ TEST_F(IndexReductionTest, DummyDerivPendulum3D) {
 
     delete fun;
 }
+
+namespace {
+
+/**
+ * Determines the variables of the reduced DAE of the 2D pendulum
+ * using a minimum block size for the sparse QR decomposition.
+ */
+std::vector<std::string> dummyDerivPendulum2DVars(size_t sparseQRMinSize) {
+    using CGD = CG<double>;
+
+    std::vector<DaeVarInfo> daeVar;
+    std::unique_ptr<ADFun<CGD>> fun(Pendulum2D<CGD> (daeVar));
+
+    std::vector<double> x = {-1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, -1.0, 9.80665};
+    std::vector<double> normVar(daeVar.size(), 1.0);
+    std::vector<double> normEq(5, 1.0);
+
+    std::vector<std::string> eqName; // empty
+
+    Pantelides<double> pantelides(*fun, daeVar, eqName, x);
+    DummyDerivatives<double> dummyD(pantelides, x, normVar, normEq);
+    dummyD.setGenerateSemiExplicitDae(true);
+    dummyD.setReduceEquations(false);
+    dummyD.setSparseQRMinSize(sparseQRMinSize);
+
+    std::vector<DaeVarInfo> newDaeVar;
+    std::vector<DaeEquationInfo> newEqInfo;
+    std::unique_ptr<ADFun<CGD>> reducedFun = dummyD.reduceIndex(newDaeVar, newEqInfo);
+    EXPECT_TRUE(reducedFun != nullptr);
+
+    std::vector<std::string> vars;
+    for (const DaeVarInfo& v : newDaeVar) {
+        vars.push_back(v.getName() + " " + std::to_string(v.getDerivative()) + " " + std::to_string(v.getAntiDerivative()));
+    }
+    return vars;
+}
+
+} // END namespace
+
+/**
+ * @test the sparse QR decomposition must select the same dummy derivatives
+ *       as the dense QR decomposition
+ */
+TEST_F(IndexReductionTest, DummyDerivPendulum2D_sparseQR) {
+    std::vector<std::string> dense, sparse;
+    ASSERT_NO_THROW(dense = dummyDerivPendulum2DVars(1000));
+    ASSERT_NO_THROW(sparse = dummyDerivPendulum2DVars(1));
+
+    ASSERT_FALSE(dense.empty());
+    ASSERT_EQ(dense, sparse);
+}
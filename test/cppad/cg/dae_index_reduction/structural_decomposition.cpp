@@ -0,0 +1,79 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include <cppad/cg/dae_index_reduction/pantelides.hpp>
+
+#include "CppADCGIndexReductionTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(IndexReductionTest, MaximumMatching) {
+    // the quick initial assignment (0->0, 1->1) must be augmented
+    std::vector<std::vector<size_t> > eqVars{{0, 1},
+                                             {0},
+                                             {1, 2}};
+
+    std::vector<long> eq2Var, var2Eq;
+    size_t matched = maximumMatching(eqVars, 3, eq2Var, var2Eq);
+
+    ASSERT_EQ(matched, 3u);
+    ASSERT_EQ(eq2Var[0], 1);
+    ASSERT_EQ(eq2Var[1], 0);
+    ASSERT_EQ(eq2Var[2], 2);
+    for (size_t i = 0; i < eqVars.size(); ++i) {
+        ASSERT_EQ(var2Eq[eq2Var[i]], long(i));
+    }
+
+    // structurally singular
+    eqVars = {{0},
+              {0},
+              {1, 2}};
+    matched = maximumMatching(eqVars, 3, eq2Var, var2Eq);
+    ASSERT_EQ(matched, 2u);
+}
+
+TEST_F(IndexReductionTest, BltDecomposition) {
+    // eq0: x0
+    // eq1: x0, x1, x2
+    // eq2: x1, x2
+    // eq3: x2, x3
+    std::vector<std::vector<size_t> > eqVars{{0},
+                                             {0, 1, 2},
+                                             {1, 2},
+                                             {2, 3}};
+
+    std::vector<long> eq2Var, var2Eq;
+    ASSERT_EQ(maximumMatching(eqVars, 4, eq2Var, var2Eq), 4u);
+
+    std::vector<std::vector<size_t> > blocks = bltDecomposition(eqVars, var2Eq);
+
+    std::vector<std::vector<size_t> > expected{{0},
+                                               {1, 2},
+                                               {3}};
+    ASSERT_EQ(blocks, expected);
+}
+
+TEST_F(IndexReductionTest, ConnectedComponents) {
+    std::vector<std::vector<size_t> > eqVars{{0, 2},
+                                             {1},
+                                             {2, 4}};
+
+    std::vector<size_t> eqComp, varComp;
+    size_t n = connectedComponents(eqVars, 5, eqComp, varComp);
+
+    ASSERT_EQ(n, 3u);
+    ASSERT_EQ(eqComp, std::vector<size_t>({0, 1, 0}));
+    ASSERT_EQ(varComp, std::vector<size_t>({0, 1, 0, 2, 0}));
+}
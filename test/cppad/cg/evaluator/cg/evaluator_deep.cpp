@@ -0,0 +1,63 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "cppad/cg/evaluator/CppADCGEvaluatorTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGEvaluatorTest, DeepChain) {
+    /**
+     * a very long chain of operations which would exceed the stack limit
+     * with a recursive evaluation
+     */
+    ModelType model = [&](const std::vector<CGD>& x) {
+        std::vector<CGD> y(2);
+
+        CGD v = x[0];
+        for (size_t i = 0; i < 200000; ++i) {
+            v = v * 0.999999 + x[1];
+        }
+
+        y[0] = v;
+        y[1] = v * x[0];
+
+        return y;
+    };
+
+    this->testCG(model, std::vector<double>{0.5, 1.5});
+}
+
+TEST_F(CppADCGEvaluatorTest, Reuse) {
+    CodeHandler<double> handler;
+
+    std::vector<CGD> x(2);
+    handler.makeVariables(x);
+
+    std::vector<CGD> y{x[0] * x[1] + sin(x[0]), x[0] * x[1] - x[1]};
+
+    Evaluator<double, double> evaluator(handler);
+
+    // the same evaluator (and its memory) is reused for new evaluations
+    for (double v: {0.5, 1.0, 2.0}) {
+        std::vector<CGD> xNew{CGD(v), CGD(v + 1)};
+        std::vector<CGD> yNew = evaluator.evaluate(xNew, y);
+
+        ASSERT_EQ(yNew.size(), 2u);
+        ASSERT_TRUE(yNew[0].isParameter());
+        ASSERT_TRUE(yNew[1].isParameter());
+        ASSERT_NEAR(yNew[0].getValue(), v * (v + 1) + std::sin(v), 1e-10);
+        ASSERT_NEAR(yNew[1].getValue(), v * (v + 1) - (v + 1), 1e-10);
+    }
+}
@@ -0,0 +1,101 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+using CGD = CG<double>;
+
+std::vector<CGD> model(const std::vector<CGD>& x) {
+    std::vector<CGD> y(6);
+    y[0] = pow(x[0], 2.0) + pow(x[1], 3.0);
+    y[1] = pow(x[0], 4.0) * pow(x[1], -1.0);
+    y[2] = pow(x[0], 0.5) + pow(x[1], -0.5) + pow(x[0], 1.5);
+    y[3] = x[0] / 4.0 + x[1] / 3.0;
+    y[4] = exp(x[0]) * exp(x[1]);
+    y[5] = pow(x[1], -2.0) + pow(x[0], 2.5); // the last power is not rewritten
+    return y;
+}
+
+} // namespace
+
+TEST(CppADCGGraphRewriterTest, Rewrite) {
+    std::vector<double> xv{1.3, 0.7};
+
+    CodeHandler<double> handler;
+    std::vector<CGD> x(2);
+    handler.makeVariables(x);
+
+    std::vector<CGD> y = model(x);
+
+    GraphRewriter<double> rewriter;
+    rewriter.rewrite(handler, y);
+
+    const auto& before = rewriter.getOperationCountsBefore();
+    const auto& after = rewriter.getOperationCountsAfter();
+
+    ASSERT_EQ(before.at(CGOpCode::Pow), 9u);
+    ASSERT_EQ(after.at(CGOpCode::Pow), 1u);
+    ASSERT_EQ(before.at(CGOpCode::Exp), 2u);
+    ASSERT_EQ(after.at(CGOpCode::Exp), 1u);
+    ASSERT_EQ(after.count(CGOpCode::Div) ? after.at(CGOpCode::Div) : 0, 3u); // only 1/x
+    ASSERT_EQ(after.at(CGOpCode::Sqrt), 3u);
+
+    ASSERT_EQ(rewriter.getRuleApplications().at("pow"), 8u);
+    ASSERT_EQ(rewriter.getRuleApplications().at("division by constant"), 2u);
+    ASSERT_EQ(rewriter.getRuleApplications().at("exp product"), 1u);
+
+    /**
+     * the rewritten graph must provide the same results
+     */
+    std::vector<CGD> xNew(xv.begin(), xv.end());
+    Evaluator<double, double> evaluator(handler);
+    std::vector<CGD> yNew = evaluator.evaluate(xNew, y);
+
+    std::vector<CGD> yRef = model(xNew);
+
+    ASSERT_EQ(yNew.size(), yRef.size());
+    for (size_t i = 0; i < yRef.size(); ++i) {
+        ASSERT_TRUE(yNew[i].isParameter());
+        ASSERT_NEAR(yNew[i].getValue(), yRef[i].getValue(), 1e-12 * std::abs(yRef[i].getValue()));
+    }
+}
+
+TEST(CppADCGGraphRewriterTest, GenerateCode) {
+    CodeHandler<double> handler;
+    std::vector<CGD> x(2);
+    handler.makeVariables(x);
+
+    std::vector<CGD> y{pow(x[0], 2.0) * x[1] + x[0] / 2.0};
+
+    GraphRewriter<double> rewriter;
+    handler.setGraphRewriter(&rewriter);
+
+    LanguageC<double> langC("double");
+    LangCDefaultVariableNameGenerator<double> nameGen;
+
+    std::ostringstream code;
+    handler.generateCode(code, langC, y, nameGen);
+
+    ASSERT_EQ(code.str().find("pow("), std::string::npos);
+    ASSERT_EQ(code.str().find(" / "), std::string::npos);
+
+    std::ostringstream report;
+    rewriter.printReport(report);
+    ASSERT_NE(report.str().find("total"), std::string::npos);
+}
@@ -0,0 +1,135 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGGraphSparsityTest : public CppADCGTest {
+protected:
+    using CGD = CppADCGTest::CGD;
+    using ADCGD = CppADCGTest::ADCGD;
+    using SparsitySetType = std::vector<std::set<size_t> >;
+public:
+
+    inline CppADCGGraphSparsityTest(bool verbose = false,
+                                    bool printValues = false) :
+        CppADCGTest(verbose, printValues) {
+    }
+
+    /**
+     * Compares the sparsity patterns determined from the operation graph
+     * with the ones from CppAD.
+     */
+    void testSparsity(ADFun<CGD>& f,
+                      size_t blockWords,
+                      size_t threads) {
+        size_t n = f.Domain();
+        size_t m = f.Range();
+
+        CodeHandler<double> handler;
+
+        std::vector<CGD> indVars(n);
+        handler.makeVariables(indVars);
+
+        std::vector<CGD> dep = f.Forward(0, indVars);
+
+        GraphSparsity<double> graph(handler, dep);
+        graph.setBlockWords(blockWords);
+        graph.setThreads(threads);
+
+        SparsitySetType jac = graph.jacobianSparsity();
+        SparsitySetType jacCppAD = jacobianSparsitySet<SparsitySetType, CGD>(f);
+        ASSERT_EQ(jac, jacCppAD);
+
+        SparsitySetType hess = graph.hessianSparsity();
+        SparsitySetType hessCppAD = hessianSparsitySet<SparsitySetType, CGD>(f);
+        ASSERT_EQ(hess, hessCppAD);
+
+        std::vector<SparsitySetType> hessByEq = graph.hessianSparsityByEquation();
+        ASSERT_EQ(hessByEq.size(), m);
+        for (size_t i = 0; i < m; ++i) {
+            SparsitySetType hessiCppAD = hessianSparsitySet<SparsitySetType, CGD>(f, i);
+            ASSERT_EQ(hessByEq[i], hessiCppAD);
+        }
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGGraphSparsityTest, Operations) {
+    size_t n = 6;
+
+    std::vector<ADCGD> x(n);
+    for (size_t j = 0; j < n; ++j)
+        x[j] = j + 1;
+    Independent(x);
+
+    std::vector<ADCGD> y(5);
+    y[0] = x[0] * x[1] + sin(x[2]);
+    y[1] = x[3] / x[4] + 3.0 * x[5];
+    y[2] = CondExpLt(x[0], x[1], exp(x[2]) * x[3], pow(x[4], x[5]));
+    y[3] = x[5];
+    y[4] = 2.0;
+
+    ADFun<CGD> f(x, y);
+
+    testSparsity(f, 1, 1);
+    testSparsity(f, 1, 3);
+}
+
+TEST_F(CppADCGGraphSparsityTest, Blocks) {
+    size_t n = 150;
+
+    std::vector<ADCGD> x(n);
+    for (size_t j = 0; j < n; ++j)
+        x[j] = j + 1;
+    Independent(x);
+
+    // several blocks of 64 independent variables
+    std::vector<ADCGD> y(n - 1);
+    for (size_t i = 0; i + 1 < n; ++i) {
+        y[i] = x[i] * x[i + 1] + x[(i * 7) % n];
+    }
+
+    ADFun<CGD> f(x, y);
+
+    testSparsity(f, 1, 1);
+    testSparsity(f, 1, 4);
+    testSparsity(f, 4, 2);
+}
+
+TEST_F(CppADCGGraphSparsityTest, Handler) {
+    size_t n = 2;
+
+    CodeHandler<double> handler;
+
+    std::vector<CGD> x(n);
+    handler.makeVariables(x);
+
+    std::vector<CGD> y(1);
+    y[0] = x[0] * x[1];
+
+    GraphSparsity<double> graph(handler, y);
+    SparsitySetType jac = graph.jacobianSparsity();
+
+    ASSERT_EQ(jac.size(), 1u);
+    ASSERT_EQ(jac[0], std::set<size_t>({0, 1}));
+    ASSERT_EQ(graph.getNodeCount(), 3u);
+}
@@ -0,0 +1,170 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST(CppADCGJobTracerTest, CodeHandler) {
+    using CGD = CG<double>;
+    using ADCGD = AD<CGD>;
+
+    std::vector<ADCGD> x(2);
+    Independent(x);
+
+    std::vector<ADCGD> y(1);
+    y[0] = sin(x[0]) * x[1] + x[0];
+
+    ADFun<CGD> fun(x, y);
+
+    JobTimer timer;
+    JobTracer tracer;
+    timer.addListener(tracer);
+
+    CodeHandler<double> handler;
+    handler.setJobTimer(&timer);
+
+    std::vector<CGD> indVars(2);
+    handler.makeVariables(indVars);
+    std::vector<CGD> dep = fun.Forward(0, indVars);
+
+    LanguageC<double> langC("double");
+    LangCDefaultVariableNameGenerator<double> nameGen;
+    std::ostringstream code;
+    timer.startingJob("'model'", JobTimer::SOURCE_FOR_MODEL);
+    handler.generateCode(code, langC, dep, nameGen);
+    timer.finishedJob();
+
+    ASSERT_EQ(timer.getJobCount(), 0u);
+
+    std::vector<JobTraceEvent> events = tracer.getEvents();
+    ASSERT_EQ(events.size(), 2u);
+
+    // the nested job finishes first
+    ASSERT_EQ(events[0].depth, 1u);
+    ASSERT_EQ(events[0].name, "source for 'source'");
+    ASSERT_GT(events[0].counters.at("nodes"), 0u);
+    ASSERT_GT(events[0].counters.at("operations"), 0u);
+    ASSERT_EQ(events[0].counters.at("temporaries"), handler.getTemporaryVariableCount());
+    ASSERT_EQ(events[1].depth, 0u);
+    ASSERT_EQ(events[1].name, "'model'");
+    ASSERT_EQ(events[1].category, JobTimer::SOURCE_FOR_MODEL.getActionName());
+    ASSERT_LE(events[1].begin, events[0].begin);
+    ASSERT_GE(events[1].duration, events[0].duration);
+
+    std::ostringstream trace;
+    tracer.writeChromeTrace(trace);
+    std::string json = trace.str();
+    ASSERT_EQ(json.find("{\"traceEvents\":["), 0u);
+    ASSERT_NE(json.find("\"name\":\"'model'\""), std::string::npos);
+    ASSERT_NE(json.find("\"ph\":\"X\""), std::string::npos);
+    ASSERT_NE(json.find("\"nodes\":"), std::string::npos);
+}
+
+TEST(CppADCGJobTracerTest, Threads) {
+    JobTimer timer;
+    JobTracer tracer;
+    timer.addListener(tracer);
+
+    const size_t nThreads = 4;
+    const size_t nJobs = 50;
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < nThreads; ++t) {
+        threads.emplace_back([&timer, t]() {
+            for (size_t j = 0; j < nJobs; ++j) {
+                timer.startingJob("outer " + std::to_string(t));
+                timer.startingJob("inner \"" + std::to_string(j) + "\"", JobTimer::COMPILING);
+                timer.setJobCounter("job", j);
+                timer.finishedJob();
+                timer.finishedJob();
+            }
+        });
+    }
+    for (std::thread& th : threads)
+        th.join();
+
+    std::vector<JobTraceEvent> events = tracer.getEvents();
+    ASSERT_EQ(events.size(), nThreads * nJobs * 2);
+
+    std::set<size_t> threadIds;
+    for (const JobTraceEvent& e : events) {
+        threadIds.insert(e.thread);
+        if (e.depth == 1) {
+            ASSERT_EQ(e.name.find("inner"), 0u);
+            ASSERT_EQ(e.counters.size(), 1u);
+        } else {
+            ASSERT_EQ(e.depth, 0u);
+            ASSERT_EQ(e.name.find("outer"), 0u);
+        }
+    }
+    ASSERT_EQ(threadIds.size(), nThreads);
+
+    // names are escaped
+    std::ostringstream trace;
+    tracer.writeChromeTrace(trace);
+    ASSERT_NE(trace.str().find("inner \\\"0\\\""), std::string::npos);
+
+    tracer.clear();
+    ASSERT_TRUE(tracer.getEvents().empty());
+}
+
+namespace {
+
+/**
+ * A listener which uses the JobTimer while it is notified
+ */
+class ReentrantListener : public JobListener {
+public:
+    JobTimer& timer;
+    std::vector<size_t> startedCounts;
+    std::vector<size_t> endedCounts;
+
+    explicit ReentrantListener(JobTimer& t) :
+        timer(t) {
+    }
+
+    void jobStarted(const std::vector<Job>& job) override {
+        startedCounts.push_back(timer.getJobCount());
+        timer.setJobCounter("listener", job.size());
+    }
+
+    void jobEndended(const std::vector<Job>& job,
+                     duration elapsed) override {
+        endedCounts.push_back(timer.getJobCount());
+        timer.addListener(*this); // already registered
+    }
+};
+
+}
+
+TEST(CppADCGJobTracerTest, ReentrantListener) {
+    JobTimer timer;
+    ReentrantListener listener(timer);
+    JobTracer tracer;
+    timer.addListener(listener);
+    timer.addListener(tracer);
+
+    timer.startingJob("outer");
+    timer.startingJob("inner");
+    timer.finishedJob();
+    timer.finishedJob();
+
+    ASSERT_EQ(listener.startedCounts, std::vector<size_t>({1, 2}));
+    // the finished job is removed before the listeners are notified
+    ASSERT_EQ(listener.endedCounts, std::vector<size_t>({1, 0}));
+    ASSERT_EQ(timer.getJobCount(), 0u);
+    ASSERT_TRUE(timer.removeListener(listener));
+}
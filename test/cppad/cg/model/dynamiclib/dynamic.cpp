@@ -107,4 +107,34 @@ TEST_F(CppADCGDynamicTestCustomSparsity1, Jacobian) {
 
 TEST_F(CppADCGDynamicTestCustomSparsity1, Hessian) {
     this->testHessian();
-}
\ No newline at end of file
+}
+#if CPPAD_CG_SYSTEM_LINUX
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicTestInMemory1 : public CppADCGDynamicTest1 {
+public:
+
+    inline explicit CppADCGDynamicTestInMemory1() :
+            CppADCGDynamicTest1() {
+        // object files and the library are only created in memory
+        _inMemory = true;
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+TEST_F(CppADCGDynamicTestInMemory1, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGDynamicTestInMemory1, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGDynamicTestInMemory1, Hessian) {
+    this->testHessian();
+}
+#endif
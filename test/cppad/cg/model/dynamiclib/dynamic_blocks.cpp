@@ -0,0 +1,129 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGDynamicTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicBlocksTest : public CppADCGDynamicTest {
+public:
+
+    explicit CppADCGDynamicBlocksTest() :
+            CppADCGDynamicTest("dynamic_blocks") {
+        _blockDecomposition = true;
+        // the first independent variable is a known parameter
+        _blockUnknowns = {1, 2, 3, 4};
+        // independent variables
+        _xTape = {1, 1, 1, 1, 1};
+        _xRun = {1.5, 2, 0.5, 3, 0.25};
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        std::vector<ADCGD> y(4);
+
+        // a single equation block
+        y[3] = x[1] - 2.0 * x[0];
+        // a block with 2 equations which depends on the previous block
+        y[0] = x[2] * x[3] - x[1] - 1.0;
+        y[2] = x[2] + sin(x[3]) - x[0];
+        // a single equation block which depends on all previous blocks
+        y[1] = x[4] * x[2] - exp(x[1]);
+
+        return y;
+    }
+
+    void testBlocks() {
+        size_t n = _fun->Domain();
+        size_t m = _fun->Range();
+
+        ASSERT_TRUE(_model->isBlockDecompositionAvailable());
+        ASSERT_EQ(_model->BlockCount(), 3u);
+
+        std::vector<double> y = _model->ForwardZero(_xRun);
+        std::vector<double> jac = _model->Jacobian(_xRun);
+        std::vector<std::set<size_t> > sparsity = _model->JacobianSparsitySet();
+
+        const std::vector<size_t> expectedEqs[3] = {{3}, {0, 2}, {1}};
+
+        std::vector<bool> solved(n, false);
+        solved[0] = true; // known
+
+        for (size_t b = 0; b < _model->BlockCount(); ++b) {
+            const size_t* eqs, * vars;
+            size_t size;
+            _model->BlockStructure(b, &eqs, &vars, size);
+
+            ASSERT_EQ(std::vector<size_t>(eqs, eqs + size), expectedEqs[b]);
+
+            for (size_t k = 0; k < size; ++k) {
+                ASSERT_LT(vars[k], n);
+                ASSERT_TRUE(sparsity[eqs[k]].find(vars[k]) != sparsity[eqs[k]].end());
+                solved[vars[k]] = true;
+            }
+
+            // block equations only depend on variables which were already solved
+            for (size_t k = 0; k < size; ++k) {
+                for (size_t j : sparsity[eqs[k]])
+                    ASSERT_TRUE(solved[j]);
+            }
+
+            // residuals
+            std::vector<double> res(size);
+            _model->BlockResidual(b, _xRun, res);
+            for (size_t k = 0; k < size; ++k) {
+                ASSERT_TRUE(nearEqual(res[k], y[eqs[k]], epsilonR, epsilonA));
+            }
+
+            // Jacobian relative to the block unknowns
+            const size_t* row, * col;
+            size_t nnz;
+            _model->BlockJacobianSparsity(b, &row, &col, nnz);
+
+            std::vector<double> jacBlock(nnz);
+            _model->BlockJacobian(b, _xRun, jacBlock);
+
+            for (size_t e = 0; e < nnz; ++e) {
+                ASSERT_LT(row[e], size);
+                ASSERT_LT(col[e], size);
+                double expected = jac[eqs[row[e]] * n + vars[col[e]]];
+                ASSERT_TRUE(nearEqual(jacBlock[e], expected, epsilonR, epsilonA));
+            }
+        }
+
+        for (size_t j = 0; j < n; ++j) {
+            ASSERT_TRUE(solved[j]);
+        }
+
+        ASSERT_EQ(m, 4u);
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicBlocksTest, Blocks) {
+    this->testBlocks();
+}
+
+TEST_F(CppADCGDynamicBlocksTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGDynamicBlocksTest, SparseJacobian) {
+    this->testJacobian();
+}
@@ -0,0 +1,183 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include <dirent.h>
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+using CGD = CG<double>;
+using ADCGD = AD<CGD>;
+
+/**
+ * Creates a model library where only the last equation depends on the
+ * provided coefficient.
+ *
+ * @param generationCacheFolder the folder where the generated sources
+ *                              are kept (empty to disable)
+ * @param reused the number of functions whose source code was reused
+ *               from the generation cache
+ * @return the number of source files and the number of object files
+ *         reused from the cache
+ */
+std::pair<size_t, size_t> createLibrary(double coefficient,
+                                        const std::string& cacheFolder,
+                                        std::vector<double>& y,
+                                        const std::string& generationCacheFolder = "",
+                                        size_t* reused = nullptr) {
+    const size_t n = 4;
+
+    std::vector<ADCGD> u(n, 1.0);
+    Independent(u);
+
+    std::vector<ADCGD> v(n);
+    for (size_t i = 0; i < n - 1; ++i)
+        v[i] = u[i] * sin(u[i + 1]);
+    v[n - 1] = coefficient * u[n - 1] * u[0];
+
+    ADFun<CGD> fun(u, v);
+
+    ModelCSourceGen<double> modelSourceGen(fun, "cached");
+    modelSourceGen.setCreateSparseJacobian(true);
+    if (!generationCacheFolder.empty()) {
+        // one function for each Jacobian row/column
+        modelSourceGen.setCreateForwardOne(true);
+        modelSourceGen.setCreateReverseOne(true);
+        modelSourceGen.setGenerationCacheFolder(generationCacheFolder);
+    }
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+    JobTracer tracer;
+    libSourceGen.addListener(tracer);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+    compiler.setCacheFolder(cacheFolder);
+
+    DynamicModelLibraryProcessor<double> p(libSourceGen, "cppadcg_test_cache_lib");
+    std::unique_ptr<DynamicLib<double>> dynamicLib = p.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<double>> model = dynamicLib->model("cached");
+
+    std::vector<double> x = {0.5, 1.5, 2.5, 3.5};
+    y = model->ForwardZero(x);
+
+    size_t compiled = 0;
+    size_t cached = 0;
+    if (reused != nullptr)
+        *reused = 0;
+    for (const JobTraceEvent& e : tracer.getEvents()) {
+        if (e.category == JobTimer::COMPILING.getActionName()) {
+            compiled++;
+            if (e.counters.count("cached") != 0)
+                cached++;
+        } else if (e.category == JobTimer::SOURCE_GENERATION.getActionName() &&
+                   e.name.find("(reused)") != std::string::npos && reused != nullptr) {
+            (*reused)++;
+        }
+    }
+
+    return {compiled, cached};
+}
+
+/**
+ * Deletes a cache folder and its files when it goes out of scope
+ */
+class CacheFolderRemover {
+private:
+    std::string _folder;
+public:
+    explicit CacheFolderRemover(std::string folder) :
+        _folder(std::move(folder)) {
+    }
+
+    ~CacheFolderRemover() {
+        DIR* dir = opendir(_folder.c_str());
+        if (dir != nullptr) {
+            struct dirent* entry;
+            while ((entry = readdir(dir)) != nullptr) {
+                std::string name = entry->d_name;
+                if (name != "." && name != "..")
+                    std::remove(system::createPath(_folder, name).c_str());
+            }
+            closedir(dir);
+        }
+        std::remove(_folder.c_str());
+    }
+};
+
+} // END namespace
+
+TEST(CppADCGCompilerCacheTest, ReuseObjectFiles) {
+    std::vector<double> y1, y2, y3;
+
+    // a new cache for each run
+    std::string cacheFolder = "cppadcg_test_cache_" + std::to_string(std::chrono::system_clock::now().time_since_epoch().count());
+    CacheFolderRemover remover(cacheFolder);
+
+    std::pair<size_t, size_t> r1 = createLibrary(2.0, cacheFolder, y1);
+    ASSERT_GT(r1.first, 0u);
+    ASSERT_EQ(r1.second, 0u);
+
+    // nothing changed
+    std::pair<size_t, size_t> r2 = createLibrary(2.0, cacheFolder, y2);
+    ASSERT_EQ(r2.first, r1.first);
+    ASSERT_EQ(r2.second, r2.first);
+    for (size_t i = 0; i < y1.size(); ++i)
+        ASSERT_EQ(y2[i], y1[i]);
+
+    // a single equation changed: only the affected files are compiled
+    std::pair<size_t, size_t> r3 = createLibrary(3.0, cacheFolder, y3);
+    ASSERT_EQ(r3.first, r1.first);
+    ASSERT_GT(r3.second, 0u);
+    ASSERT_LT(r3.second, r3.first);
+    for (size_t i = 0; i < y1.size() - 1; ++i)
+        ASSERT_EQ(y3[i], y1[i]);
+    ASSERT_NEAR(y3.back(), 1.5 * y1.back(), 1e-14);
+}
+
+TEST(CppADCGCompilerCacheTest, ReuseGeneratedSources) {
+    std::vector<double> y1, y2, y3;
+    size_t reused1, reused2, reused3;
+
+    std::string suffix = std::to_string(std::chrono::system_clock::now().time_since_epoch().count());
+    std::string cacheFolder = "cppadcg_test_cache_" + suffix;
+    std::string generationFolder = "cppadcg_test_gen_cache_" + suffix;
+    CacheFolderRemover remover(cacheFolder);
+    CacheFolderRemover generationRemover(generationFolder);
+
+    std::pair<size_t, size_t> r1 = createLibrary(2.0, cacheFolder, y1, generationFolder, &reused1);
+    ASSERT_EQ(reused1, 0u);
+    ASSERT_EQ(r1.second, 0u);
+
+    // nothing changed: no function is generated again
+    std::pair<size_t, size_t> r2 = createLibrary(2.0, cacheFolder, y2, generationFolder, &reused2);
+    ASSERT_GT(reused2, 0u);
+    ASSERT_EQ(r2.second, r2.first); // the reused sources are identical
+    for (size_t i = 0; i < y1.size(); ++i)
+        ASSERT_EQ(y2[i], y1[i]);
+
+    // a single equation changed: only the functions which depend on it are generated
+    std::pair<size_t, size_t> r3 = createLibrary(3.0, cacheFolder, y3, generationFolder, &reused3);
+    ASSERT_GT(reused3, 0u);
+    ASSERT_LT(reused3, reused2);
+    ASSERT_LT(r3.second, r3.first);
+    for (size_t i = 0; i < y1.size() - 1; ++i)
+        ASSERT_EQ(y3[i], y1[i]);
+    ASSERT_NEAR(y3.back(), 1.5 * y1.back(), 1e-14);
+}
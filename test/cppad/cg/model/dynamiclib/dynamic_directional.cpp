@@ -0,0 +1,118 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGDynamicTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicDirectionalTest : public CppADCGDynamicTest {
+public:
+
+    explicit CppADCGDynamicDirectionalTest() :
+            CppADCGDynamicTest("dynamic_directional") {
+        _directional = true;
+        _directionalBatchSize = 2;
+        _denseJacobian = true;
+        _denseHessian = true;
+        // independent variables
+        _xTape = {1, 1, 1, 1};
+        _xRun = {1.5, 2, 0.5, 3};
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        std::vector<ADCGD> y(3);
+
+        y[0] = sin(x[0]) * x[1] * x[1];
+        y[1] = exp(x[2]) + x[0] * x[3];
+        y[2] = x[1] / x[3] + log(x[2]);
+
+        return y;
+    }
+
+    void testJacobianVectorProduct() {
+        size_t m = _fun->Range();
+        size_t n = _fun->Domain();
+
+        ASSERT_TRUE(_model->isJacobianVectorProductAvailable());
+        ASSERT_EQ(_model->getDirectionalBatchSize(), 2u);
+
+        std::vector<double> jac = _model->Jacobian(_xRun);
+
+        // 3 directions: one batch and one single direction
+        size_t p = 3;
+        std::vector<double> v(n * p);
+        for (size_t e = 0; e < v.size(); ++e)
+            v[e] = 0.5 + e;
+
+        std::vector<double> jv = _model->JacobianVectorProduct(_xRun, v);
+        ASSERT_EQ(jv.size(), m * p);
+
+        for (size_t d = 0; d < p; ++d) {
+            for (size_t i = 0; i < m; ++i) {
+                double ref = 0;
+                for (size_t j = 0; j < n; ++j)
+                    ref += jac[i * n + j] * v[d * n + j];
+                ASSERT_TRUE(nearEqual(jv[d * m + i], ref, 1e-10, 1e-10));
+            }
+        }
+    }
+
+    void testHessianVectorProduct() {
+        size_t m = _fun->Range();
+        size_t n = _fun->Domain();
+
+        ASSERT_TRUE(_model->isHessianVectorProductAvailable());
+
+        std::vector<double> w = {1.0, -0.5, 2.0};
+        ASSERT_EQ(w.size(), m);
+        std::vector<double> hess = _model->Hessian(_xRun, w);
+
+        // 3 directions: one batch and one single direction
+        size_t p = 3;
+        std::vector<double> v(n * p);
+        for (size_t e = 0; e < v.size(); ++e)
+            v[e] = 1.0 - 0.25 * e;
+
+        std::vector<double> hv = _model->HessianVectorProduct(_xRun, w, v);
+        ASSERT_EQ(hv.size(), n * p);
+
+        for (size_t d = 0; d < p; ++d) {
+            for (size_t j = 0; j < n; ++j) {
+                double ref = 0;
+                for (size_t l = 0; l < n; ++l)
+                    ref += hess[j * n + l] * v[d * n + l];
+                ASSERT_TRUE(nearEqual(hv[d * n + j], ref, 1e-10, 1e-10));
+            }
+        }
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicDirectionalTest, JacobianVectorProduct) {
+    this->testJacobianVectorProduct();
+}
+
+TEST_F(CppADCGDynamicDirectionalTest, HessianVectorProduct) {
+    this->testHessianVectorProduct();
+}
+
+TEST_F(CppADCGDynamicDirectionalTest, ForwardZero) {
+    this->testForwardZero();
+}
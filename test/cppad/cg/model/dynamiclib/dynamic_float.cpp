@@ -0,0 +1,271 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Tests the generation of models with floats
+ */
+class CppADCGDynamicFloatTest : public CppADCGTest {
+protected:
+    using CGF = CG<float>;
+    using ADCGF = AD<CGF>;
+    const std::string _modelName;
+    const static size_t n;
+    const static size_t m;
+    const bool _mixed;
+    std::vector<float> x;
+    std::unique_ptr<ADFun<CGF>> _fun;
+    std::unique_ptr<DynamicLib<float>> _dynamicLib;
+    std::unique_ptr<GenericModel<float>> _model;
+public:
+
+    inline explicit CppADCGDynamicFloatTest(bool mixed) :
+        _modelName("model"),
+        _mixed(mixed),
+        x{1.5f, 2.f, 0.5f} {
+    }
+
+    void SetUp() override {
+        // independent variables
+        std::vector<ADCGF> u(n);
+        for (size_t j = 0; j < n; j++)
+            u[j] = x[j];
+
+        CppAD::Independent(u);
+
+        // dependent variable vector
+        std::vector<ADCGF> Z(m);
+
+        Z[0] = cos(u[0]) * 0.1f;
+        Z[1] = u[1] * u[2] + sin(u[0]);
+        Z[2] = pow(u[2], 0.3f) + exp(u[1]) / 3.f;
+        Z[3] = u[0] / u[2] + u[1] * u[2] + 5.f;
+
+        _fun.reset(new ADFun<CGF>(u, Z));
+
+        /**
+         * Create the dynamic library
+         * (generate and compile source code)
+         */
+        ModelCSourceGen<float> compHelp(*_fun, _modelName);
+
+        compHelp.setCreateForwardZero(true);
+        compHelp.setCreateForwardOne(true);
+        compHelp.setCreateReverseOne(true);
+        compHelp.setCreateReverseTwo(true);
+        compHelp.setCreateSparseJacobian(true);
+        compHelp.setCreateSparseHessian(true);
+        if (_mixed)
+            compHelp.setAccumulationTypeName("double");
+
+        ASSERT_EQ(compHelp.isMixedPrecision(), _mixed);
+
+        GccCompiler<float> compiler;
+        prepareTestCompilerFlags(compiler);
+
+        ModelLibraryCSourceGen<float> compDynHelp(compHelp);
+
+        DynamicModelLibraryProcessor<float> p(compDynHelp, _mixed ? "cppadcg_float_mixed" : "cppadcg_float");
+
+        _dynamicLib = p.createDynamicLibrary(compiler);
+        _model = _dynamicLib->model(_modelName);
+
+        // dimensions
+        ASSERT_EQ(_model->Domain(), _fun->Domain());
+        ASSERT_EQ(_model->Range(), _fun->Range());
+    }
+
+    void TearDown() override {
+        _model.reset(nullptr);
+        _dynamicLib.reset(nullptr);
+        _fun.reset(nullptr);
+    }
+
+    static std::vector<float> values(const std::vector<CGF>& v) {
+        std::vector<float> r(v.size());
+        for (size_t i = 0; i < v.size(); i++)
+            r[i] = v[i].getValue();
+        return r;
+    }
+
+    std::vector<CGF> xOrig() const {
+        return std::vector<CGF>(x.begin(), x.end());
+    }
+
+    void testForwardZero() {
+        std::vector<float> y = _model->ForwardZero(x);
+
+        ASSERT_TRUE(compareValues<float>(y, values(_fun->Forward(0, xOrig()))));
+    }
+
+    void testSparseJacobian() {
+        const std::vector<bool> p = jacobianSparsity<std::vector<bool>, CGF>(*_fun);
+
+        std::vector<float> jac = _model->SparseJacobian(x);
+
+        ASSERT_TRUE(compareValues<float>(jac, values(_fun->SparseJacobian(xOrig(), p))));
+    }
+
+    void testSparseHessian() {
+        std::vector<float> w(m, 1.f);
+
+        std::vector<float> hess = _model->SparseHessian(x, w);
+
+        std::vector<CGF> wOrig(w.begin(), w.end());
+        ASSERT_TRUE(compareValues<float>(hess, values(_fun->SparseHessian(xOrig(), wOrig))));
+    }
+
+    void testHessianVectorProduct() {
+        const size_t k = 1;
+        std::vector<float> tx((k + 1) * n), ty((k + 1) * m), py((k + 1) * m, 0.f);
+        std::vector<CGF> dx(n), w(m);
+        for (size_t j = 0; j < n; j++) {
+            tx[j * 2] = x[j];
+            tx[j * 2 + 1] = float(j + 1); // direction
+            dx[j] = tx[j * 2 + 1];
+        }
+        for (size_t i = 0; i < m; i++) {
+            py[i * 2 + 1] = 1.f / float(i + 1); // weights
+            w[i] = py[i * 2 + 1];
+        }
+
+        std::vector<float> px = _model->ReverseTwo(tx, ty, py);
+
+        // reference values (H * dx)
+        std::vector<CGF> hess = _fun->Hessian(xOrig(), w);
+        std::vector<float> hv(n, 0.f), pxv(n);
+        for (size_t j1 = 0; j1 < n; j1++) {
+            for (size_t j2 = 0; j2 < n; j2++) {
+                hv[j1] += hess[j1 * n + j2].getValue() * dx[j2].getValue();
+            }
+            pxv[j1] = px[j1 * 2];
+        }
+
+        ASSERT_TRUE(compareValues<float>(pxv, hv, 1e-5f, 1e-5f));
+    }
+};
+
+class CppADCGDynamicFloatSingleTest : public CppADCGDynamicFloatTest {
+public:
+    CppADCGDynamicFloatSingleTest() :
+        CppADCGDynamicFloatTest(false) {
+    }
+};
+
+class CppADCGDynamicFloatMixedTest : public CppADCGDynamicFloatTest {
+public:
+    CppADCGDynamicFloatMixedTest() :
+        CppADCGDynamicFloatTest(true) {
+    }
+};
+
+/**
+ * Evaluates the first order forward mode of y = sum(x) with a direction
+ * whose contributions cancel out: 1e8 + 1 + ... + 1 - 1e8.
+ * The small contributions are lost when they are summed with floats.
+ */
+inline float forwardOneCancellation(bool mixed) {
+    using CGF = CG<float>;
+    using ADCGF = AD<CGF>;
+
+    const size_t n = 10;
+
+    std::vector<ADCGF> u(n, 1.f);
+    CppAD::Independent(u);
+
+    std::vector<ADCGF> y(1, 0.f);
+    for (size_t j = 0; j < n; j++)
+        y[0] += u[j];
+
+    ADFun<CGF> fun(u, y);
+
+    ModelCSourceGen<float> compHelp(fun, "cancellation");
+    compHelp.setCreateForwardOne(true);
+    if (mixed)
+        compHelp.setAccumulationTypeName("double");
+
+    GccCompiler<float> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    ModelLibraryCSourceGen<float> compDynHelp(compHelp);
+
+    DynamicModelLibraryProcessor<float> p(compDynHelp, mixed ? "cppadcg_float_cancellation_mixed" : "cppadcg_float_cancellation");
+    std::unique_ptr<DynamicLib<float>> dynamicLib = p.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<float>> model = dynamicLib->model("cancellation");
+
+    std::vector<float> tx(2 * n);
+    for (size_t j = 0; j < n; j++) {
+        tx[j * 2] = 1.f;
+        tx[j * 2 + 1] = 1.f;
+    }
+    tx[1] = 1e8f;
+    tx[(n - 1) * 2 + 1] = -1e8f;
+
+    return model->ForwardOne(tx)[0];
+}
+
+/**
+ * static data
+ */
+const size_t CppADCGDynamicFloatTest::n = 3;
+const size_t CppADCGDynamicFloatTest::m = 4;
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicFloatSingleTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGDynamicFloatSingleTest, SparseJacobian) {
+    this->testSparseJacobian();
+}
+
+TEST_F(CppADCGDynamicFloatSingleTest, SparseHessian) {
+    this->testSparseHessian();
+}
+
+TEST_F(CppADCGDynamicFloatSingleTest, HessianVectorProduct) {
+    this->testHessianVectorProduct();
+}
+
+TEST(CppADCGDynamicFloatAccumulationTest, ForwardOne) {
+    const float exact = 8.f;
+
+    float single = forwardOneCancellation(false);
+    float mixed = forwardOneCancellation(true);
+
+    ASSERT_EQ(mixed, exact);
+    ASSERT_GT(std::abs(single - exact), std::abs(mixed - exact));
+}
+
+TEST_F(CppADCGDynamicFloatMixedTest, SparseJacobian) {
+    this->testSparseJacobian();
+}
+
+TEST_F(CppADCGDynamicFloatMixedTest, SparseHessian) {
+    this->testSparseHessian();
+}
+
+TEST_F(CppADCGDynamicFloatMixedTest, HessianVectorProduct) {
+    this->testHessianVectorProduct();
+}
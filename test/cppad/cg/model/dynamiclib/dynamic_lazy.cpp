@@ -0,0 +1,207 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include <thread>
+#include "CppADCGDynamicTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicLazyTest : public CppADCGDynamicTest {
+public:
+
+    explicit CppADCGDynamicLazyTest() :
+            CppADCGDynamicTest("dynamic_lazy") {
+        _lazyLoading = true;
+        // independent variables
+        _xTape = {1, 1, 1};
+        _xRun = {1.5, 0.5, 2.5};
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        std::vector<ADCGD> y(2);
+
+        y[0] = x[0] * sin(x[1]) + x[2];
+        y[1] = x[1] * x[2] / exp(x[0]);
+
+        return y;
+    }
+
+    void testPreloadFunctions() {
+        ASSERT_TRUE(_dynamicLib->isLazyFunctionLoading());
+
+        auto& model = dynamic_cast<FunctorGenericModel<double>&>(*_model);
+        model.preloadFunctions({ModelCSourceGen<double>::FUNCTION_FORWAD_ZERO,
+                                ModelCSourceGen<double>::FUNCTION_SPARSE_JACOBIAN,
+                                ModelCSourceGen<double>::FUNCTION_JACOBIAN_SPARSITY});
+
+        this->testForwardZero();
+        this->testJacobian();
+
+        // the remaining functions are still loaded when needed
+        this->testHessian();
+
+        model.preloadFunctions();
+        this->testDenseJacobian();
+    }
+
+    void testModelsInThreads() {
+        ASSERT_TRUE(_dynamicLib->isLazyFunctionLoading());
+
+        // two models of the same library load their functions at the same time
+        std::unique_ptr<GenericModel<double>> m1 = _dynamicLib->model(_name + "dynamic");
+        std::unique_ptr<GenericModel<double>> m2 = _dynamicLib->model(_name + "dynamic");
+        ASSERT_TRUE(m1 != nullptr);
+        ASSERT_TRUE(m2 != nullptr);
+
+        std::vector<double> y1, y2;
+        auto run = [this](GenericModel<double>& m, std::vector<double>& y) {
+            dynamic_cast<FunctorGenericModel<double>&>(m).preloadFunctions();
+            y = m.ForwardZero(_xRun);
+        };
+
+        std::thread t1(run, std::ref(*m1), std::ref(y1));
+        std::thread t2(run, std::ref(*m2), std::ref(y2));
+        t1.join();
+        t2.join();
+
+        ASSERT_EQ(y1, y2);
+        ASSERT_EQ(y1, _model->ForwardZero(_xRun));
+    }
+
+#if CPPAD_CG_SYSTEM_LINUX
+    /**
+     * A model which counts the functions loaded from the library
+     */
+    class CountingModel : public LinuxDynamicLibModel<double> {
+    public:
+        std::mutex mutex;
+        std::map<std::string, size_t> loaded;
+
+        CountingModel(LinuxDynamicLib<double>& lib,
+                      const std::string& name) :
+                LinuxDynamicLibModel<double>(&lib, name) {
+        }
+
+        void* loadFunction(const std::string& functionName,
+                           bool required = true) override {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                loaded[functionName]++;
+            }
+            return LinuxDynamicLibModel<double>::loadFunction(functionName, required);
+        }
+    };
+
+    std::string getLibraryPath() const {
+        return "cppad_cg_lib" + system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+    }
+
+    void testLoadOnce() {
+        LinuxDynamicLib<double> lib(getLibraryPath());
+        lib.setLazyFunctionLoading(true);
+
+        const std::string name = _name + "dynamic";
+        CountingModel model(lib, name);
+        ASSERT_TRUE(model.loaded.empty()); // nothing loaded after construction
+
+        // a function is only loaded once
+        std::vector<double> y1 = model.ForwardZero(_xRun);
+        std::vector<double> y2 = model.ForwardZero(_xRun);
+        ASSERT_EQ(y1, y2);
+        ASSERT_EQ(model.loaded.at(name + "_" + ModelCSourceGen<double>::FUNCTION_FORWAD_ZERO), 1u);
+
+        // the same function is loaded by several threads at the same time
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < 4; ++t) {
+            threads.emplace_back([&model]() {
+                model.preloadFunctions();
+            });
+        }
+        for (std::thread& th : threads)
+            th.join();
+
+        ASSERT_GT(model.loaded.size(), 1u);
+        for (const auto& p : model.loaded) {
+            ASSERT_EQ(p.second, 1u) << p.first;
+        }
+    }
+
+    void testDlOpenLazy() {
+        // RTLD_LAZY only affects the symbol resolution of dlopen()
+        LinuxDynamicLib<double> lib(getLibraryPath(), RTLD_LAZY);
+        ASSERT_FALSE(lib.isLazyFunctionLoading());
+
+        CountingModel eager(lib, _name + "dynamic");
+        ASSERT_TRUE(eager.loaded.empty()); // all functions already loaded by the base constructor
+        eager.preloadFunctions();
+        ASSERT_TRUE(eager.loaded.empty());
+
+        lib.setLazyFunctionLoading(true);
+        ASSERT_TRUE(lib.isLazyFunctionLoading());
+
+        CountingModel lazy(lib, _name + "dynamic");
+        lazy.preloadFunctions();
+        ASSERT_FALSE(lazy.loaded.empty());
+    }
+#endif
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicLazyTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGDynamicLazyTest, DenseJacobian) {
+    this->testDenseJacobian();
+}
+
+TEST_F(CppADCGDynamicLazyTest, DenseHessian) {
+    this->testDenseHessian();
+}
+
+TEST_F(CppADCGDynamicLazyTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGDynamicLazyTest, Hessian) {
+    this->testHessian();
+}
+
+TEST_F(CppADCGDynamicLazyTest, PreloadFunctions) {
+    this->testPreloadFunctions();
+}
+
+TEST_F(CppADCGDynamicLazyTest, ModelsInThreads) {
+    this->testModelsInThreads();
+}
+
+#if CPPAD_CG_SYSTEM_LINUX
+TEST_F(CppADCGDynamicLazyTest, MoveConstructors) {
+    this->testMoveConstructors();
+}
+
+TEST_F(CppADCGDynamicLazyTest, LoadOnce) {
+    this->testLoadOnce();
+}
+
+TEST_F(CppADCGDynamicLazyTest, DlOpenLazy) {
+    this->testDlOpenLazy();
+}
+#endif
@@ -0,0 +1,214 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include <cfenv>
+
+#include "CppADCGDynamicTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicMaskedTest : public CppADCGDynamicTest {
+public:
+    // a value which is never computed by the model
+    const double NOT_EVALUATED = -12345.0;
+public:
+
+    explicit CppADCGDynamicMaskedTest() :
+            CppADCGDynamicTest("dynamic_masked") {
+        _masked = true;
+        // independent variables
+        _xTape = {1, 1, 1, 1, 1};
+        _xRun = {1.5, 2, 0.5, 3, 0.25};
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        std::vector<ADCGD> y(4);
+
+        // the first two equations share operations
+        ADCGD a = sin(x[0]) * x[2];
+        y[0] = a * x[1];
+        y[1] = a + x[3];
+        // independent from the other equations
+        y[2] = x[3] * x[4];
+        // no operations
+        y[3] = x[0];
+
+        return y;
+    }
+
+    void testForwardZeroMasked() {
+        size_t m = _fun->Range();
+
+        ASSERT_TRUE(_model->isForwardZeroMaskedAvailable());
+
+        std::vector<double> y = _model->ForwardZero(_xRun);
+
+        // only the last equations
+        std::vector<unsigned char> mask(m, 0);
+        mask[2] = 1;
+
+        std::vector<double> dep(m, NOT_EVALUATED);
+        _model->ForwardZeroMasked(mask, _xRun, dep);
+
+        ASSERT_EQ(dep[0], NOT_EVALUATED);
+        ASSERT_EQ(dep[1], NOT_EVALUATED);
+        ASSERT_TRUE(nearEqual(dep[2], y[2], epsilonR, epsilonA));
+        ASSERT_EQ(dep[3], NOT_EVALUATED);
+
+        // equations which share operations are still assigned individually
+        std::fill(mask.begin(), mask.end(), 0);
+        mask[0] = 1;
+        std::fill(dep.begin(), dep.end(), NOT_EVALUATED);
+        _model->ForwardZeroMasked(mask, _xRun, dep);
+
+        ASSERT_TRUE(nearEqual(dep[0], y[0], epsilonR, epsilonA));
+        ASSERT_EQ(dep[1], NOT_EVALUATED);
+        ASSERT_EQ(dep[2], NOT_EVALUATED);
+        ASSERT_EQ(dep[3], NOT_EVALUATED);
+
+        // all equations
+        std::fill(mask.begin(), mask.end(), 1);
+        _model->ForwardZeroMasked(mask, _xRun, dep);
+
+        for (size_t i = 0; i < m; ++i) {
+            ASSERT_TRUE(nearEqual(dep[i], y[i], epsilonR, epsilonA));
+        }
+    }
+
+    void testSparseJacobianMasked() {
+        size_t m = _fun->Range();
+
+        ASSERT_TRUE(_model->isSparseJacobianMaskedAvailable());
+
+        std::vector<double> jac;
+        std::vector<size_t> row, col;
+        _model->SparseJacobian(_xRun, jac, row, col);
+
+        for (size_t r = 0; r < m; ++r) {
+            std::vector<unsigned char> rowMask(m, 0);
+            rowMask[r] = 1;
+
+            std::vector<double> jacMasked(jac.size(), NOT_EVALUATED);
+            _model->SparseJacobianMasked(rowMask, _xRun, jacMasked);
+
+            for (size_t e = 0; e < jac.size(); ++e) {
+                if (row[e] == r) {
+                    ASSERT_TRUE(nearEqual(jacMasked[e], jac[e], epsilonR, epsilonA));
+                } else {
+                    ASSERT_EQ(jacMasked[e], NOT_EVALUATED);
+                }
+            }
+        }
+    }
+};
+
+/**
+ * Outputs which share a subexpression but also have their own operations.
+ * The operations of each output are only evaluated if that output is
+ * requested: the logarithm of a negative value raises a floating point
+ * exception only when the second output is requested.
+ */
+class CppADCGDynamicMaskedSharedTest : public CppADCGDynamicTest {
+public:
+    const double NOT_EVALUATED = -12345.0;
+public:
+
+    explicit CppADCGDynamicMaskedSharedTest() :
+            CppADCGDynamicTest("dynamic_masked_shared") {
+        _masked = true;
+        // independent variables
+        _xTape = {1, 1, 1, 1};
+        _xRun = {1.5, 2, 4, -1};
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        std::vector<ADCGD> y(3);
+
+        // shared by all equations
+        ADCGD a = sin(x[0]) * x[1];
+        y[0] = a * sqrt(x[2]);
+        y[1] = a + log(x[3]); // not defined for x[3] < 0
+        y[2] = a - exp(x[0]);
+
+        return y;
+    }
+
+    void testForwardZeroMaskedShared() {
+        size_t m = _fun->Range();
+
+        std::vector<double> y = _model->ForwardZero(_xRun);
+
+        // only the first equation
+        std::vector<unsigned char> mask(m, 0);
+        mask[0] = 1;
+
+        std::vector<double> dep(m, NOT_EVALUATED);
+
+        std::feclearexcept(FE_ALL_EXCEPT);
+        _model->ForwardZeroMasked(mask, _xRun, dep);
+        ASSERT_FALSE(std::fetestexcept(FE_INVALID)); // the logarithm was not evaluated
+
+        ASSERT_TRUE(nearEqual(dep[0], y[0], epsilonR, epsilonA));
+        ASSERT_EQ(dep[1], NOT_EVALUATED);
+        ASSERT_EQ(dep[2], NOT_EVALUATED);
+
+        // the first and the last equations
+        mask[2] = 1;
+        std::fill(dep.begin(), dep.end(), NOT_EVALUATED);
+
+        std::feclearexcept(FE_ALL_EXCEPT);
+        _model->ForwardZeroMasked(mask, _xRun, dep);
+        ASSERT_FALSE(std::fetestexcept(FE_INVALID));
+
+        ASSERT_TRUE(nearEqual(dep[0], y[0], epsilonR, epsilonA));
+        ASSERT_EQ(dep[1], NOT_EVALUATED);
+        ASSERT_TRUE(nearEqual(dep[2], y[2], epsilonR, epsilonA));
+
+        // only the second equation
+        std::fill(mask.begin(), mask.end(), 0);
+        mask[1] = 1;
+        std::fill(dep.begin(), dep.end(), NOT_EVALUATED);
+
+        std::feclearexcept(FE_ALL_EXCEPT);
+        _model->ForwardZeroMasked(mask, _xRun, dep);
+        ASSERT_TRUE(std::fetestexcept(FE_INVALID));
+
+        ASSERT_EQ(dep[0], NOT_EVALUATED);
+        ASSERT_TRUE(std::isnan(dep[1]));
+        ASSERT_EQ(dep[2], NOT_EVALUATED);
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicMaskedTest, ForwardZeroMasked) {
+    this->testForwardZeroMasked();
+}
+
+TEST_F(CppADCGDynamicMaskedTest, SparseJacobianMasked) {
+    this->testSparseJacobianMasked();
+}
+
+TEST_F(CppADCGDynamicMaskedTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGDynamicMaskedSharedTest, ForwardZeroMasked) {
+    this->testForwardZeroMaskedShared();
+}
@@ -0,0 +1,147 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGDynamicTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicOrderingTest : public CppADCGDynamicTest {
+public:
+    // the order in which the independent variables are chained
+    const std::vector<size_t> chain = {3, 0, 5, 1, 4, 2};
+public:
+
+    explicit CppADCGDynamicOrderingTest() :
+            CppADCGDynamicTest("dynamic_ordering") {
+        _variableOrdering = true;
+        // independent variables
+        _xTape = {1, 1, 1, 1, 1, 1};
+        _xRun = {1.5, 2, 0.5, 3, 0.25, 1.25};
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        std::vector<ADCGD> y(chain.size() - 1);
+
+        for (size_t i = 0; i < y.size(); ++i) {
+            y[i] = x[chain[i]] * x[chain[i + 1]];
+        }
+
+        return y;
+    }
+
+    /**
+     * The maximum distance between the position of a dependent and the
+     * position of the independent variables it depends on.
+     */
+    static size_t bandwidth(const std::vector<std::set<size_t> >& sparsity,
+                            const std::vector<size_t>& indPos,
+                            const std::vector<size_t>& depPos) {
+        size_t b = 0;
+        for (size_t i = 0; i < sparsity.size(); ++i) {
+            for (size_t j : sparsity[i]) {
+                size_t d = indPos[j] > depPos[i] ? indPos[j] - depPos[i] : depPos[i] - indPos[j];
+                b = std::max(b, d);
+            }
+        }
+        return b;
+    }
+
+    void testOrdering() {
+        size_t n = _fun->Domain();
+        size_t m = _fun->Range();
+
+        ASSERT_TRUE(_model->isVariableOrderingAvailable());
+
+        const size_t* ind, * dep;
+        _model->VariableOrdering(&ind, &dep);
+
+        // must be permutations
+        std::vector<size_t> indPos(n, n), depPos(m, m);
+        for (size_t k = 0; k < n; ++k) {
+            ASSERT_LT(ind[k], n);
+            ASSERT_EQ(indPos[ind[k]], n);
+            indPos[ind[k]] = k;
+        }
+        for (size_t k = 0; k < m; ++k) {
+            ASSERT_LT(dep[k], m);
+            ASSERT_EQ(depPos[dep[k]], m);
+            depPos[dep[k]] = k;
+        }
+
+        std::vector<std::set<size_t> > sparsity = _model->JacobianSparsitySet();
+
+        std::vector<size_t> identityN(n), identityM(m);
+        for (size_t j = 0; j < n; ++j) identityN[j] = j;
+        for (size_t i = 0; i < m; ++i) identityM[i] = i;
+
+        // the chain becomes a band
+        ASSERT_EQ(bandwidth(sparsity, indPos, depPos), 1u);
+        ASSERT_GT(bandwidth(sparsity, identityN, identityM), 1u);
+    }
+
+    /**
+     * Evaluates the zero order forward mode with renumbered variables
+     * directly and compares it with CppAD.
+     */
+    void testOrderedForwardZero() {
+        size_t n = _fun->Domain();
+        size_t m = _fun->Range();
+
+        const size_t* ind, * dep;
+        _model->VariableOrdering(&ind, &dep);
+
+        using FunctionType = void (*)(double const*const*, double*const*, LangCAtomicFun);
+        std::string name = _name + "dynamic_" + ModelCSourceGen<double>::FUNCTION_FORWAD_ZERO + ModelCSourceGen<double>::ORDERED_SUFFIX;
+        auto ordered = reinterpret_cast<FunctionType>(_dynamicLib->loadFunction(name));
+
+        // the values in the new positions
+        std::vector<double> x(n), y(m);
+        for (size_t k = 0; k < n; ++k)
+            x[k] = _xRun[ind[k]];
+
+        const double* in[1] = {x.data()};
+        double* out[1] = {y.data()};
+        LangCAtomicFun atomic{};
+        (*ordered)(in, out, atomic);
+
+        // CppAD
+        std::vector<CGD> xOrig(_xRun.begin(), _xRun.end());
+        std::vector<CGD> yOrig = _fun->Forward(0, xOrig);
+
+        for (size_t k = 0; k < m; ++k) {
+            ASSERT_TRUE(yOrig[dep[k]].isValueDefined());
+            ASSERT_NEAR(y[k], yOrig[dep[k]].getValue(), 1e-14);
+        }
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicOrderingTest, VariableOrdering) {
+    this->testOrdering();
+}
+
+TEST_F(CppADCGDynamicOrderingTest, ForwardZero) {
+    // through the wrapper which permutes the values
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGDynamicOrderingTest, OrderedForwardZero) {
+    this->testOrderedForwardZero();
+}
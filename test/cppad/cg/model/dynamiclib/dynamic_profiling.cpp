@@ -0,0 +1,95 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGDynamicTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicProfilingTest : public CppADCGDynamicTest {
+public:
+
+    explicit CppADCGDynamicProfilingTest() :
+            CppADCGDynamicTest("dynamic_profiling") {
+        _profiling = true;
+        _maxAssignPerFunc = 2; // also profile the local functions
+        // independent variables
+        _xTape = {1, 1, 1};
+        _xRun = {1.5, 2, 0.5};
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        std::vector<ADCGD> y(2);
+
+        y[0] = sin(x[0]) * x[1] + cos(x[2]) * x[0];
+        y[1] = exp(x[2]) * x[1] / x[0];
+
+        return y;
+    }
+
+    void testProfiles() {
+        const std::string forwardZero = _name + "dynamic_" + ModelCSourceGen<double>::FUNCTION_FORWAD_ZERO;
+
+        _dynamicLib->resetFunctionProfiles();
+
+        for (size_t k = 0; k < 3; ++k) {
+            _model->ForwardZero(_xRun);
+        }
+        _model->SparseJacobian(_xRun);
+
+        std::vector<FunctionProfile> profiles = _dynamicLib->getFunctionProfiles();
+        ASSERT_FALSE(profiles.empty());
+
+        bool foundForwardZero = false;
+        bool foundLocal = false;
+        for (size_t i = 0; i < profiles.size(); ++i) {
+            const FunctionProfile& p = profiles[i];
+            if (p.name == forwardZero) {
+                ASSERT_EQ(p.calls, 3u);
+                foundForwardZero = true;
+            } else if (p.name.find(forwardZero + "__") == 0) {
+                ASSERT_EQ(p.calls, 3u);
+                foundLocal = true;
+            }
+            // sorted by decreasing time
+            if (i > 0) {
+                ASSERT_LE(p.time, profiles[i - 1].time);
+            }
+        }
+        ASSERT_TRUE(foundForwardZero);
+        ASSERT_TRUE(foundLocal);
+
+        _dynamicLib->resetFunctionProfiles();
+
+        profiles = _dynamicLib->getFunctionProfiles();
+        for (const FunctionProfile& p : profiles) {
+            ASSERT_EQ(p.calls, 0u);
+            ASSERT_EQ(p.time.count(), 0);
+        }
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicProfilingTest, Profiles) {
+    this->testProfiles();
+}
+
+TEST_F(CppADCGDynamicProfilingTest, ForwardZero) {
+    this->testForwardZero();
+}
@@ -0,0 +1,82 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGDynamicTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Evaluates the model functions generated with operation scheduling
+ * (CodeHandler::setScheduleOperations()) and compares them with CppAD.
+ */
+class CppADCGDynamicScheduleTest : public CppADCGDynamicTest {
+public:
+
+    explicit CppADCGDynamicScheduleTest() :
+            CppADCGDynamicTest("dynamic_schedule") {
+        _scheduleOperations = true;
+        // independent variables
+        _xTape = {1, 1, 1, 1, 1};
+        _xRun = {1.5, 0.5, 2.5, 0.75, 1.25};
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        size_t k = x.size();
+        std::vector<ADCGD> y(2 * k + 1);
+
+        // the depth first order creates all t before any r
+        std::vector<ADCGD> t(k);
+        for (size_t i = 0; i < k; ++i) {
+            t[i] = sin(x[i]);
+            y[i] = t[i] * 2.0;
+        }
+        for (size_t i = 0; i < k; ++i) {
+            ADCGD r = cos(t[i]) * x[(i + 1) % k];
+            y[k + i] = r * r + t[(i + 2) % k];
+        }
+
+        // shared values used by several equations
+        ADCGD s = t[0] * t[k - 1];
+        y[2 * k] = s / (1 + x[1] * x[2]) + exp(s);
+
+        return y;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicScheduleTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGDynamicScheduleTest, DenseJacobian) {
+    this->testDenseJacobian();
+}
+
+TEST_F(CppADCGDynamicScheduleTest, DenseHessian) {
+    this->testDenseHessian();
+}
+
+TEST_F(CppADCGDynamicScheduleTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGDynamicScheduleTest, Hessian) {
+    this->testHessian();
+}
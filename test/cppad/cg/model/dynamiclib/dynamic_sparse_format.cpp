@@ -0,0 +1,141 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGDynamicTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGSparseFormatTest : public CppADCGDynamicTest {
+public:
+
+    explicit CppADCGSparseFormatTest(const std::string& name,
+                                     SparseMatrixFormat format) :
+            CppADCGDynamicTest(name) {
+        _jacFormat = format;
+        _hessFormat = format;
+        // independent variables
+        _xTape = {1, 1, 1, 1};
+        _xRun = {1, 2, 0.5, 3};
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        std::vector<ADCGD> y(3);
+
+        y[0] = x[3] * x[0] + sin(x[2]);
+        y[1] = x[1] * x[1] * x[3];
+        y[2] = x[0] * x[2] + exp(x[1]) * x[0];
+
+        return y;
+    }
+
+    /**
+     * Checks that the compressed sparsity pattern is consistent with the
+     * coordinate sparsity pattern of the values
+     */
+    static void checkCompressed(SparseMatrixFormat format,
+                                size_t outerSize,
+                                const size_t* ptr,
+                                const size_t* ind,
+                                size_t nnz,
+                                const std::vector<size_t>& rows,
+                                const std::vector<size_t>& cols) {
+        ASSERT_EQ(nnz, rows.size());
+        ASSERT_EQ(ptr[outerSize], nnz);
+
+        const std::vector<size_t>& outer = format == SparseMatrixFormat::CSR ? rows : cols;
+        const std::vector<size_t>& inner = format == SparseMatrixFormat::CSR ? cols : rows;
+
+        for (size_t o = 0; o < outerSize; ++o) {
+            for (size_t e = ptr[o]; e < ptr[o + 1]; ++e) {
+                ASSERT_EQ(outer[e], o);
+                ASSERT_EQ(inner[e], ind[e]);
+                if (e > ptr[o])
+                    ASSERT_LT(ind[e - 1], ind[e]);
+            }
+        }
+    }
+
+    void testCompressedSparsity() {
+        size_t n = _fun->Domain();
+        size_t m = _fun->Range();
+
+        const size_t* ptr;
+        const size_t* ind;
+        size_t nnz;
+        std::vector<size_t> rows, cols;
+
+        ASSERT_TRUE(_model->isJacobianSparsityCompressedAvailable());
+        ASSERT_EQ(_model->JacobianSparsityCompressed(&ptr, &ind, nnz), _jacFormat);
+        _model->JacobianSparsity(rows, cols);
+        checkCompressed(_jacFormat, _jacFormat == SparseMatrixFormat::CSR ? m : n, ptr, ind, nnz, rows, cols);
+
+        ASSERT_TRUE(_model->isHessianSparsityCompressedAvailable());
+        ASSERT_EQ(_model->HessianSparsityCompressed(&ptr, &ind, nnz), _hessFormat);
+        _model->HessianSparsity(rows, cols);
+        checkCompressed(_hessFormat, n, ptr, ind, nnz, rows, cols);
+    }
+};
+
+class CppADCGSparseFormatCsrTest : public CppADCGSparseFormatTest {
+public:
+    CppADCGSparseFormatCsrTest() :
+            CppADCGSparseFormatTest("dynamic_sparse_csr", SparseMatrixFormat::CSR) {
+    }
+};
+
+class CppADCGSparseFormatCscTest : public CppADCGSparseFormatTest {
+public:
+    CppADCGSparseFormatCscTest() :
+            CppADCGSparseFormatTest("dynamic_sparse_csc", SparseMatrixFormat::CSC) {
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGSparseFormatCsrTest, CompressedSparsity) {
+    this->testCompressedSparsity();
+}
+
+TEST_F(CppADCGSparseFormatCsrTest, DenseJacobian) {
+    this->testDenseJacobian();
+}
+
+TEST_F(CppADCGSparseFormatCsrTest, DenseHessian) {
+    this->testDenseHessian();
+}
+
+TEST_F(CppADCGSparseFormatCsrTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGSparseFormatCsrTest, Hessian) {
+    this->testHessian();
+}
+
+TEST_F(CppADCGSparseFormatCscTest, CompressedSparsity) {
+    this->testCompressedSparsity();
+}
+
+TEST_F(CppADCGSparseFormatCscTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGSparseFormatCscTest, Hessian) {
+    this->testHessian();
+}
@@ -0,0 +1,282 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <dlfcn.h>
+
+#include "CppADCGTest.hpp"
+#include <cppad/cg/cppadcg.hpp>
+#include <gtest/gtest.h>
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGTestLangCpp : public CppADCGTest {
+public:
+
+    inline explicit CppADCGTestLangCpp(bool verbose = false,
+                                       bool printValues = false) :
+            CppADCGTest(verbose, printValues) {
+    }
+
+protected:
+
+    using EvalFunction = void (*)(const void* x, const void* w, void* y, void* jac, void* hess);
+    using SparsityFunction = void (*)(unsigned long* nnz, const unsigned long** rows, const unsigned long** cols);
+
+    template<class Scalar>
+    static ADFun<Scalar> tape(const std::vector<double>& xv) {
+        using ADS = CppAD::AD<Scalar>;
+
+        std::vector<ADS> x(xv.size());
+        for (size_t j = 0; j < x.size(); j++)
+            x[j] = xv[j];
+        Independent(x);
+
+        std::vector<ADS> y(2);
+        y[0] = sin(x[0]) * x[1] + 0.5;
+        y[1] = pow(x[2], 2.5) * abs(x[0]);
+
+        return ADFun<Scalar>(x, y);
+    }
+
+    template<class Base>
+    static ADFun<CG<Base> > model() {
+        return tape<CG<Base> >({1., 2., 3.});
+    }
+
+    /**
+     * Creates a C++ source which includes the generated header and
+     * instantiates the function templates for double and float
+     */
+    static std::string createEvaluationSource(const std::string& modelName,
+                                              const std::string& headerFile) {
+        std::string ns = modelName + "::";
+        return "#include <algorithm>\n"
+               "#include \"" + headerFile + "\"\n"
+               "\n"
+               "template<class T>\n"
+               "void eval(const void* xp, const void* wp, void* yp, void* jacp, void* hessp) {\n"
+               "   const T* x = static_cast<const T*>(xp);\n"
+               "   const T* w = static_cast<const T*>(wp);\n"
+               "   std::array<T, " + ns + "n> xa;\n"
+               "   std::array<T, " + ns + "m> wa;\n"
+               "   std::array<T, " + ns + "m> ya;\n"
+               "   std::array<T, " + ns + "jacobian_nnz> jac;\n"
+               "   std::array<T, " + ns + "hessian_nnz> hess;\n"
+               "   std::copy(x, x + xa.size(), xa.begin());\n"
+               "   std::copy(w, w + wa.size(), wa.begin());\n"
+               "   " + ns + "forward_zero(xa, ya);\n"
+               "   " + ns + "sparse_jacobian(xa, jac);\n"
+               "   " + ns + "sparse_hessian(xa, wa, hess);\n"
+               "   std::copy(ya.begin(), ya.end(), static_cast<T*>(yp));\n"
+               "   std::copy(jac.begin(), jac.end(), static_cast<T*>(jacp));\n"
+               "   std::copy(hess.begin(), hess.end(), static_cast<T*>(hessp));\n"
+               "}\n"
+               "\n"
+               "extern \"C\" {\n"
+               "void eval_double(const void* x, const void* w, void* y, void* jac, void* hess) {\n"
+               "   eval<double>(x, w, y, jac, hess);\n"
+               "}\n"
+               "void eval_float(const void* x, const void* w, void* y, void* jac, void* hess) {\n"
+               "   eval<float>(x, w, y, jac, hess);\n"
+               "}\n"
+               "void jacobian_sparsity(unsigned long* nnz, const unsigned long** rows, const unsigned long** cols) {\n"
+               "   *nnz = " + ns + "jacobian_nnz;\n"
+               "   *rows = " + ns + "jacobian_rows.data();\n"
+               "   *cols = " + ns + "jacobian_cols.data();\n"
+               "}\n"
+               "void hessian_sparsity(unsigned long* nnz, const unsigned long** rows, const unsigned long** cols) {\n"
+               "   *nnz = " + ns + "hessian_nnz;\n"
+               "   *rows = " + ns + "hessian_rows.data();\n"
+               "   *cols = " + ns + "hessian_cols.data();\n"
+               "}\n"
+               "}\n";
+    }
+
+    /**
+     * Evaluates the instantiation of the generated function templates for
+     * a given type and compares the results against CppAD
+     */
+    template<class T>
+    static void testEvaluation(void* libHandle,
+                               const std::string& functionName,
+                               ADFun<double>& fun,
+                               const std::vector<double>& x,
+                               const std::vector<double>& w,
+                               double epsilonR,
+                               double epsilonA) {
+        const size_t n = fun.Domain();
+        const size_t m = fun.Range();
+
+        auto evalFunc = reinterpret_cast<EvalFunction>(dlsym(libHandle, functionName.c_str()));
+        auto jacSparsity = reinterpret_cast<SparsityFunction>(dlsym(libHandle, "jacobian_sparsity"));
+        auto hessSparsity = reinterpret_cast<SparsityFunction>(dlsym(libHandle, "hessian_sparsity"));
+        ASSERT_TRUE(evalFunc != nullptr);
+        ASSERT_TRUE(jacSparsity != nullptr);
+        ASSERT_TRUE(hessSparsity != nullptr);
+
+        unsigned long jacNnz, hessNnz;
+        const unsigned long* jacRows, * jacCols, * hessRows, * hessCols;
+        (*jacSparsity)(&jacNnz, &jacRows, &jacCols);
+        (*hessSparsity)(&hessNnz, &hessRows, &hessCols);
+
+        std::vector<T> xt(x.begin(), x.end());
+        std::vector<T> wt(w.begin(), w.end());
+        std::vector<T> y(m), jac(jacNnz), hess(hessNnz);
+        (*evalFunc)(xt.data(), wt.data(), y.data(), jac.data(), hess.data());
+
+        // CppAD
+        std::vector<double> yOrig = fun.Forward(0, x);
+        std::vector<double> jacOrig = fun.Jacobian(x); // row-major
+        std::vector<double> hessOrig = fun.Hessian(x, w); // row-major
+
+        std::vector<double> jacDense(n * m, 0.0);
+        for (size_t e = 0; e < jacNnz; e++)
+            jacDense[jacRows[e] * n + jacCols[e]] = jac[e];
+
+        std::vector<double> hessDense(n * n, 0.0);
+        for (size_t e = 0; e < hessNnz; e++) {
+            hessDense[hessRows[e] * n + hessCols[e]] = hess[e];
+            hessDense[hessCols[e] * n + hessRows[e]] = hess[e];
+        }
+
+        ASSERT_TRUE(compareValues(std::vector<double>(y.begin(), y.end()), yOrig, epsilonR, epsilonA));
+        ASSERT_TRUE(compareValues(jacDense, jacOrig, epsilonR, epsilonA));
+        ASSERT_TRUE(compareValues(hessDense, hessOrig, epsilonR, epsilonA));
+    }
+
+    static bool contains(const std::string& text,
+                         const std::string& str) {
+        return text.find(str) != std::string::npos;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGTestLangCpp, Header) {
+    ADFun<CG<double> > fun = model<double>();
+
+    ModelCppHeaderGen<double> headerGen(fun, "cpp_model");
+    headerGen.setCreateSparseJacobian(true);
+    headerGen.setCreateSparseHessian(true);
+
+    const std::string& header = headerGen.getHeader();
+    if (verbose_) {
+        std::cout << header << std::endl;
+    }
+
+    ASSERT_TRUE(contains(header, "#ifndef CPPADCG_MODEL_CPP_MODEL_HPP"));
+    ASSERT_TRUE(contains(header, "namespace cpp_model {"));
+    ASSERT_TRUE(contains(header, "constexpr unsigned long n = 3;"));
+    ASSERT_TRUE(contains(header, "constexpr unsigned long m = 2;"));
+
+    // zero order forward mode
+    ASSERT_TRUE(contains(header, "template<class T>\ninline void forward_zero(const std::array<T, 3>& x"));
+    ASSERT_TRUE(contains(header, "std::array<T, 2>& y)"));
+    ASSERT_TRUE(contains(header, "sin(x[0])"));
+    ASSERT_TRUE(contains(header, "T(0.5)"));
+
+    // Jacobian
+    ASSERT_TRUE(contains(header, "constexpr unsigned long jacobian_nnz = 4;"));
+    ASSERT_TRUE(contains(header, "constexpr std::array<unsigned long, jacobian_nnz> jacobian_rows = {{0,0,1,1}};"));
+    ASSERT_TRUE(contains(header, "constexpr std::array<unsigned long, jacobian_nnz> jacobian_cols = {{0,1,0,2}};"));
+    ASSERT_TRUE(contains(header, "inline void sparse_jacobian(const std::array<T, 3>& x"));
+    ASSERT_TRUE(contains(header, "std::array<T, 4>& jac)"));
+
+    // Hessian
+    ASSERT_TRUE(contains(header, "constexpr std::array<unsigned long, hessian_nnz> hessian_rows"));
+    ASSERT_TRUE(contains(header, "inline void sparse_hessian(const std::array<T, 3>& x"));
+    ASSERT_TRUE(contains(header, "const std::array<T, 2>& w"));
+
+    // no C specific code
+    ASSERT_FALSE(contains(header, "LangCAtomicFun"));
+    ASSERT_FALSE(contains(header, "fabs"));
+    ASSERT_FALSE(contains(header, "#include <math.h>"));
+}
+
+TEST_F(CppADCGTestLangCpp, Float) {
+    ADFun<CG<float> > fun = model<float>();
+
+    ModelCppHeaderGen<float> headerGen(fun, "cpp_model_float");
+    headerGen.setTemplateTypeName("Scalar");
+
+    const std::string& header = headerGen.getHeader();
+
+    ASSERT_TRUE(contains(header, "template<class Scalar>\ninline void forward_zero(const std::array<Scalar, 3>& x"));
+    ASSERT_TRUE(contains(header, "sin(x[0])"));
+    ASSERT_TRUE(contains(header, "pow("));
+    ASSERT_FALSE(contains(header, "sinf("));
+    ASSERT_FALSE(contains(header, "powf("));
+    ASSERT_FALSE(contains(header, "fabsf("));
+}
+
+TEST_F(CppADCGTestLangCpp, CompiledHeader) {
+    const std::string modelName = "cpp_model_eval";
+    const std::string headerFile = modelName + ".hpp";
+    const std::string sourceFile = modelName + ".cpp";
+    const std::string library = "./" + modelName + system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+
+    std::vector<double> x{1.5, 2.0, 3.0};
+    std::vector<double> w{0.75, 1.25};
+
+    ADFun<CG<double> > fun = model<double>();
+
+    ModelCppHeaderGen<double> headerGen(fun, modelName);
+    headerGen.setCreateSparseJacobian(true);
+    headerGen.setCreateSparseHessian(true);
+    headerGen.saveHeader(headerFile);
+
+    std::ofstream source(sourceFile.c_str());
+    source << createEvaluationSource(modelName, headerFile);
+    source.close();
+
+    std::string cxx = system::findCommand("g++");
+    ASSERT_FALSE(cxx.empty()) << "g++ not found in PATH";
+
+    system::callExecutable(cxx, {"-std=c++11", "-O0", "-shared", "-fPIC",
+                                 "-I" + system::getWorkingDirectory(),
+                                 sourceFile, "-o", library});
+
+    void* libHandle = dlopen(library.c_str(), RTLD_NOW);
+    ASSERT_TRUE(libHandle != nullptr) << dlerror();
+
+    ADFun<double> funOrig = tape<double>(x);
+
+    testEvaluation<double>(libHandle, "eval_double", funOrig, x, w,
+                           std::numeric_limits<double>::epsilon() * 1e2,
+                           std::numeric_limits<double>::epsilon() * 1e2);
+    testEvaluation<float>(libHandle, "eval_float", funOrig, x, w,
+                          std::numeric_limits<float>::epsilon() * 1e2,
+                          std::numeric_limits<float>::epsilon() * 1e2);
+
+    dlclose(libHandle);
+
+    std::remove(headerFile.c_str());
+    std::remove(sourceFile.c_str());
+    std::remove(library.c_str());
+}
+
+TEST_F(CppADCGTestLangCpp, MaxAssignmentsPerFunction) {
+    LanguageCpp<double> langCpp;
+
+    langCpp.setMaxAssignmentsPerFunction(0, nullptr); // no limit
+
+    std::map<std::string, std::string> sources;
+    ASSERT_THROW(langCpp.setMaxAssignmentsPerFunction(10, &sources), CGException);
+}
@@ -13,6 +13,7 @@
  * Author: Joao Leal
  */
 
+#include <thread>
 #include "LlvmModelTest.hpp"
 
 using namespace CppAD;
@@ -51,3 +52,27 @@ TEST_F(LlvmModelLinkLlvmTest, Hessian) {
 
     testSparseHessianResults(n_tests, *model, *fun, nullptr, x, false);
 }
+
+TEST_F(LlvmModelLinkLlvmTest, LazyModelsInThreads) {
+    llvmModelLib->setLazyFunctionLoading(true);
+
+    // two models share the same LLVM module and execution engine
+    std::unique_ptr<GenericModel<Base> > m1 = llvmModelLib->model("mySmallModel");
+    std::unique_ptr<GenericModel<Base> > m2 = llvmModelLib->model("mySmallModel");
+    ASSERT_TRUE(m1 != nullptr);
+    ASSERT_TRUE(m2 != nullptr);
+
+    std::vector<double> y1, y2;
+    auto run = [this](GenericModel<Base>& m, std::vector<double>& y) {
+        dynamic_cast<FunctorGenericModel<Base>&>(m).preloadFunctions();
+        y = m.ForwardZero(x);
+    };
+
+    std::thread t1(run, std::ref(*m1), std::ref(y1));
+    std::thread t2(run, std::ref(*m2), std::ref(y2));
+    t1.join();
+    t2.join();
+
+    ASSERT_EQ(y1, y2);
+    ASSERT_EQ(y1, model->ForwardZero(x));
+}
@@ -13,6 +13,9 @@
  * ----------------------------------------------------------------------------
  * Author: Joao Leal
  */
+#include <pthread.h>
+#include <sched.h>
+#include <atomic>
 #include "ThreadPoolTest.hpp"
 
 using namespace CppAD::cg;
@@ -158,3 +161,190 @@ TEST_F(CppADCGThreadPoolDynamicCustomTest, Jacobian) {
 TEST_F(CppADCGThreadPoolDynamicCustomTest, Hessian) {
     this->testHessian();
 }
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGThreadPoolTasksTest : public ThreadPoolTest {
+public:
+    explicit CppADCGThreadPoolTasksTest() :
+            ThreadPoolTest(MultiThreadingType::PTHREADS) {
+        this->_multithreadDisabled = false;
+        this->_multithreadScheduler = ThreadPoolScheduleStrategy::DYNAMIC;
+        this->_denseJacobian = true;
+        this->_parallelTasks = 3;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+TEST_F(CppADCGThreadPoolTasksTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGThreadPoolTasksTest, DenseJacobian) {
+    this->testDenseJacobian();
+}
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Counts the jobs which were executed in a thread pinned only to core 0
+ */
+struct AffinityCheck {
+    std::atomic<int> pinned{0};
+    std::atomic<int> other{0};
+};
+
+extern "C" {
+
+static void checkAffinityJob(void* arg) {
+    auto* check = static_cast<AffinityCheck*>(arg);
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) == 0 &&
+        CPU_COUNT(&cpuset) == 1 && CPU_ISSET(0, &cpuset)) {
+        check->pinned++;
+    } else {
+        check->other++;
+    }
+}
+
+}
+
+class CppADCGThreadPoolAffinityTest : public ThreadPoolTest {
+public:
+    explicit CppADCGThreadPoolAffinityTest() :
+            ThreadPoolTest(MultiThreadingType::PTHREADS) {
+        this->_multithreadDisabled = false;
+        this->_multithreadScheduler = ThreadPoolScheduleStrategy::STATIC;
+    }
+
+    void SetUp() override {
+        ThreadPoolTest::SetUp();
+        _dynamicLib->setThreadPoolAffinity({0});
+    }
+
+    void TearDown() override {
+        _dynamicLib->setThreadPoolAffinity({});
+        ThreadPoolTest::TearDown();
+    }
+
+protected:
+
+    /**
+     * Executes jobs in the threads of the thread pool of the model library
+     */
+    void runAffinityJobs(AffinityCheck& check,
+                         size_t nJobs) {
+        using AddJob = void (*)(void (*)(void*), void*, float*, float*);
+
+        auto prepare = reinterpret_cast<void (*)()> (_dynamicLib->loadFunction("cppadcg_thpool_prepare"));
+        auto addJob = reinterpret_cast<AddJob> (_dynamicLib->loadFunction("cppadcg_thpool_add_job"));
+        auto wait = reinterpret_cast<void (*)()> (_dynamicLib->loadFunction("cppadcg_thpool_wait"));
+
+        (*prepare)();
+        for (size_t i = 0; i < nJobs; ++i) {
+            (*addJob)(&checkAffinityJob, &check, nullptr, nullptr);
+        }
+        (*wait)();
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+TEST_F(CppADCGThreadPoolAffinityTest, Affinity) {
+    ASSERT_EQ(_dynamicLib->getThreadPoolAffinity(), std::vector<int>({0}));
+
+    // the threads must be pinned to core 0
+    AffinityCheck check;
+    runAffinityJobs(check, 8);
+    ASSERT_EQ(check.pinned, 8);
+    ASSERT_EQ(check.other, 0);
+
+    // the default affinity must be restored
+    _dynamicLib->setThreadPoolAffinity({});
+    ASSERT_TRUE(_dynamicLib->getThreadPoolAffinity().empty());
+
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    ASSERT_EQ(sched_getaffinity(0, sizeof(cpu_set_t), &cpuset), 0);
+    if (CPU_COUNT(&cpuset) > 1) {
+        AffinityCheck unpinned;
+        runAffinityJobs(unpinned, 8);
+        ASSERT_EQ(unpinned.pinned, 0);
+        ASSERT_EQ(unpinned.other, 8);
+    }
+}
+
+TEST_F(CppADCGThreadPoolAffinityTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGThreadPoolAffinityTest, Hessian) {
+    this->testHessian();
+}
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A serial executor which counts the submitted jobs
+ */
+struct CountingExecutor {
+    size_t submitted = 0;
+    size_t waits = 0;
+};
+
+extern "C" {
+
+static void countingExecutorSubmit(void* ctx, void (*job)(void*), void* arg) {
+    static_cast<CountingExecutor*>(ctx)->submitted++;
+    (*job)(arg);
+}
+
+static void countingExecutorWait(void* ctx) {
+    static_cast<CountingExecutor*>(ctx)->waits++;
+}
+
+}
+
+class CppADCGThreadPoolExecutorTest : public ThreadPoolTest {
+protected:
+    CountingExecutor _executor;
+public:
+    explicit CppADCGThreadPoolExecutorTest() :
+            ThreadPoolTest(MultiThreadingType::PTHREADS) {
+        this->_multithreadDisabled = false;
+    }
+
+    void SetUp() override {
+        ThreadPoolTest::SetUp();
+        _dynamicLib->setThreadPoolExecutor(&countingExecutorSubmit, &countingExecutorWait, &_executor);
+    }
+
+    void TearDown() override {
+        _dynamicLib->setThreadPoolExecutor(nullptr, nullptr, nullptr);
+        ThreadPoolTest::TearDown();
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+TEST_F(CppADCGThreadPoolExecutorTest, Jacobian) {
+    this->testJacobian();
+
+    ASSERT_GT(_executor.submitted, 0u);
+    ASSERT_GT(_executor.waits, 0u);
+}
+
+TEST_F(CppADCGThreadPoolExecutorTest, Hessian) {
+    this->testHessian();
+
+    ASSERT_GT(_executor.submitted, 0u);
+    ASSERT_GT(_executor.waits, 0u);
+}
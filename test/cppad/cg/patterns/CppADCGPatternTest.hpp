@@ -41,6 +41,8 @@ protected:
     Base hessianEpsilonR_;
     std::vector<std::set<size_t> > customJacSparsity_;
     std::vector<std::set<size_t> > customHessSparsity_;
+    size_t loopThreads_;
+    bool loopVectorization_;
 private:
     std::unique_ptr<DefaultPatternTestModel<CG<Base> > > modelMem_;
 public:
@@ -54,7 +56,9 @@ public:
         epsilonA_(std::numeric_limits<Base>::epsilon() * 1e2),
         epsilonR_(std::numeric_limits<Base>::epsilon() * 1e2),
         hessianEpsilonA_(std::numeric_limits<Base>::epsilon() * 1e2),
-        hessianEpsilonR_(std::numeric_limits<Base>::epsilon() * 1e2) {
+        hessianEpsilonR_(std::numeric_limits<Base>::epsilon() * 1e2),
+        loopThreads_(1),
+        loopVectorization_(false) {
         //this->verbose_ = true;
     }
 
@@ -396,6 +400,8 @@ public:
         //compHelpL.setMaxAssignmentsPerFunc(maxAssignPerFunc);
         compHelpL.setRelatedDependents(relatedDepCandidates);
         compHelpL.setTypicalIndependentValues(xTypical);
+        compHelpL.setLoopThreads(loopThreads_);
+        compHelpL.setLoopVectorization(loopVectorization_);
         compHelpL.setParameterPrecision(std::numeric_limits<Base>::digits10 + 4);
 
         if (!customJacSparsity_.empty())
@@ -513,8 +519,85 @@ public:
         }
 
     }
+
+    /**
+     * Checks that the sources generated for a model with loops are the same
+     * when the loop sparsities are determined with a single thread and with
+     * several threads.
+     */
+    void testLoopThreadsSources(const std::string& libName,
+                                size_t m,
+                                size_t n,
+                                size_t repeat,
+                                size_t threads) {
+        assert(model_ != nullptr);
+
+        std::vector<Base> xb(n * repeat);
+        for (size_t j = 0; j < xb.size(); j++)
+            xb[j] = 0.5 * (j + 1);
+
+        std::vector<std::set<size_t> > relatedDepCandidates = createRelatedDepCandidates(m, repeat);
+
+        std::unique_ptr<ADFun<CGD> > fun(tapeModel(repeat, xb));
+
+        std::map<std::string, std::string> serial = generateLoopSources(*fun, libName, relatedDepCandidates, xb, 1);
+        std::map<std::string, std::string> threaded = generateLoopSources(*fun, libName, relatedDepCandidates, xb, threads);
+
+        ASSERT_FALSE(serial.empty());
+        ASSERT_EQ(serial.size(), threaded.size());
+
+        // the second order reverse mode has a function for each loop group
+        const std::string loopRev2 = libName + "Loops_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_TWO + "_loop";
+        size_t nLoopRev2 = 0;
+        for (const auto& it : serial) {
+            if (it.first.compare(0, loopRev2.size(), loopRev2) == 0)
+                nLoopRev2++;
+        }
+        ASSERT_GT(nLoopRev2, 0u);
+
+        for (const auto& it : serial) {
+            auto itT = threaded.find(it.first);
+            ASSERT_TRUE(itT != threaded.end()) << it.first;
+            ASSERT_EQ(it.second, itT->second) << it.first;
+        }
+    }
+
 protected:
 
+    /**
+     * Provides access to the sources generated for a model
+     */
+    class ModelSourceCollector : public ModelLibraryProcessor<Base> {
+    public:
+        inline explicit ModelSourceCollector(ModelLibraryCSourceGen<Base>& libGen) :
+            ModelLibraryProcessor<Base>(libGen) {
+        }
+
+        inline const std::map<std::string, std::string>& getModelSources(ModelCSourceGen<Base>& model) {
+            return this->getSources(model);
+        }
+    };
+
+    std::map<std::string, std::string> generateLoopSources(ADFun<CGD>& fun,
+                                                           const std::string& libName,
+                                                           const std::vector<std::set<size_t> >& relatedDepCandidates,
+                                                           const std::vector<Base>& xTypical,
+                                                           size_t threads) {
+        ModelCSourceGen<double> compHelpL(fun, libName + "Loops");
+        compHelpL.setCreateForwardZero(true);
+        compHelpL.setCreateSparseJacobian(true);
+        compHelpL.setCreateSparseHessian(true);
+        compHelpL.setCreateReverseTwo(true); // the functions of each loop are created concurrently
+        compHelpL.setRelatedDependents(relatedDepCandidates);
+        compHelpL.setTypicalIndependentValues(xTypical);
+        compHelpL.setLoopThreads(threads);
+
+        ModelLibraryCSourceGen<double> compDynHelpL(compHelpL);
+        ModelSourceCollector collector(compDynHelpL);
+
+        return collector.getModelSources(compHelpL);
+    }
+
     inline virtual void defineCustomSparsity(ADFun<CGD>& fun) {
     }
 };
@@ -0,0 +1,95 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2013 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGPatternTest.hpp"
+
+using Base = double;
+using CGD = CppAD::cg::CG<Base>;
+using ADCGD = CppAD::AD<CGD>;
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+/**
+ * @test Model with 2 equations which share a temporary variable inside
+ *       each iteration (no dependencies between iterations)
+ */
+std::vector<ADCGD> modelLoopVectorization(const std::vector<ADCGD>& x, size_t repeat) {
+    size_t m = 2;
+    size_t n = 2;
+    size_t m2 = repeat * m;
+
+    // dependent variable vector
+    std::vector<ADCGD> y(m2);
+
+    for (size_t i = 0; i < repeat; i++) {
+        ADCGD a = x[i * n] * x[i * n + 1];
+        y[i * m] = a * sin(x[i * n]); // dep 0 2 4 ...
+        y[i * m + 1] = a + cos(x[i * n + 1]); // dep 1 3 5 ...
+    }
+
+    return y;
+}
+
+TEST_F(CppADCGPatternTest, LoopVectorizationSource) {
+    size_t m = 2;
+    size_t n = 2;
+    size_t repeat = 6;
+
+    std::vector<ADCGD> u(n * repeat);
+    for (size_t j = 0; j < u.size(); j++)
+        u[j] = 0.5 * (j + 1);
+    Independent(u);
+
+    std::vector<ADCGD> v = modelLoopVectorization(u, repeat);
+    ADFun<CGD> fun(u, v);
+
+    ModelCSourceGen<double> compHelp(fun, "modelLoopVectorization");
+    compHelp.setCreateForwardZero(true);
+    compHelp.setRelatedDependents(createRelatedDepCandidates(m, repeat));
+    compHelp.setLoopVectorization(true);
+
+    ModelLibraryCSourceGen<double> compDynHelp(compHelp);
+    ModelSourceCollector collector(compDynHelp);
+    const std::map<std::string, std::string>& sources = collector.getModelSources(compHelp);
+
+    auto it = sources.find("modelLoopVectorization_forward_zero.c");
+    ASSERT_TRUE(it != sources.end());
+    const std::string& code = it->second;
+
+    ASSERT_NE(code.find("#pragma GCC ivdep"), std::string::npos);
+    ASSERT_NE(code.find("__restrict"), std::string::npos);
+    // the shared temporary variable is a scalar declared inside the loop
+    ASSERT_NE(code.find("double v_"), std::string::npos);
+}
+
+TEST_F(CppADCGPatternTest, LoopVectorization) {
+    size_t m = 2;
+    size_t n = 2;
+    size_t repeat = 6;
+
+    std::vector<std::vector<std::set<size_t> > > loops(1);
+    loops[0].resize(2);
+    for (size_t i = 0; i < repeat; i++) {
+        loops[0][0].insert(i * m);
+        loops[0][1].insert(i * m + 1);
+    }
+
+    setModel(modelLoopVectorization);
+    loopVectorization_ = true;
+
+    testPatternDetection(m, n, repeat, loops);
+
+    testLibCreation("modelLoopVectorization", m, n, repeat);
+}
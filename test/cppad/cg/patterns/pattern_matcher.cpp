@@ -253,6 +253,20 @@ TEST_F(CppADCGPatternTest, CommonTmp3) {
     testLibCreation("modelCommonTmp3", m, n, 6);
 }
 
+TEST_F(CppADCGPatternTest, CommonTmp3LoopThreads) {
+    size_t m = 3;
+    size_t n = 3;
+
+    setModel(modelCommonTmp3);
+
+    // the loop and the equations outside the loop are prepared concurrently
+    loopThreads_ = 2;
+
+    testLibCreation("modelCommonTmp3Threads", m, n, 6);
+
+    testLoopThreadsSources("modelCommonTmp3Threads", m, n, 6, 2);
+}
+
 /**
  * @test All variables are indexed but keep the same index after a given
  *       iteration
@@ -416,6 +430,16 @@ TEST_F(CppADCGPatternTest, DependentPatternMatcher5) {
     testLibCreation("model5", m, n, 6);
 }
 
+TEST_F(CppADCGPatternTest, DependentPatternMatcher5LoopThreads) {
+    size_t m = 2;
+    size_t n = 2;
+
+    setModel(model5);
+
+    // two loops and the equations outside the loops
+    testLoopThreadsSources("model5Threads", m, n, 6, 3);
+}
+
 /**
  * @test using atomic functions
  */
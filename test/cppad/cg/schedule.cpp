@@ -0,0 +1,131 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGScheduleTest : public CppADCGTest {
+protected:
+    using CGD = CppADCGTest::CGD;
+    using ADCGD = CppADCGTest::ADCGD;
+public:
+
+    inline CppADCGScheduleTest(bool verbose = false,
+                               bool printValues = false) :
+        CppADCGTest(verbose, printValues) {
+    }
+
+    /**
+     * Generates source code and provides the maximum number of temporary
+     * variables simultaneously in use.
+     */
+    size_t generate(ADFun<CGD>& f,
+                    bool schedule,
+                    std::string& source) {
+        using CppAD::vector;
+
+        size_t n = f.Domain();
+
+        CodeHandler<double> handler(10 + n * n);
+        handler.setScheduleOperations(schedule);
+
+        vector<CGD> indVars(n);
+        handler.makeVariables(indVars);
+
+        vector<CGD> dep = f.Forward(0, indVars);
+
+        LanguageC<double> langC("double");
+        LangCDefaultVariableNameGenerator<double> nameGen;
+
+        std::ostringstream code;
+        handler.generateCode(code, langC, dep, nameGen);
+        source = code.str();
+
+        // when IDs are reused the peak of live variables defines the number of temporaries
+        EXPECT_EQ(handler.getMaximumLiveTemporaryVariables(), handler.getTemporaryVariableCount());
+        EXPECT_EQ(handler.getTemporaryArraySize(), 0u);
+
+        return handler.getMaximumLiveTemporaryVariables();
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGScheduleTest, DelayedUsage) {
+    size_t k = 5;
+
+    std::vector<ADCGD> x(k);
+    for (size_t i = 0; i < k; ++i)
+        x[i] = i + 1;
+    Independent(x);
+
+    std::vector<ADCGD> y(2 * k);
+
+    // the depth first order creates all t before any r
+    std::vector<ADCGD> t(k);
+    for (size_t i = 0; i < k; ++i) {
+        t[i] = sin(x[i]);
+        y[i] = t[i] * 2.0;
+    }
+    for (size_t i = 0; i < k; ++i) {
+        ADCGD r = cos(t[i]);
+        y[k + i] = r * r;
+    }
+
+    ADFun<CGD> f(x, y);
+
+    std::string source, sourceSchedule;
+    size_t live = generate(f, false, source);
+    size_t liveSchedule = generate(f, true, sourceSchedule);
+
+    ASSERT_EQ(live, k);
+    ASSERT_LE(liveSchedule, 2u);
+
+    // every dependent is still assigned
+    for (size_t i = 0; i < y.size(); ++i) {
+        std::string assign = "y[" + std::to_string(i) + "] = ";
+        ASSERT_NE(sourceSchedule.find(assign), std::string::npos);
+    }
+}
+
+TEST_F(CppADCGScheduleTest, NoChange) {
+    size_t n = 3;
+
+    std::vector<ADCGD> x(n);
+    x[0] = 1;
+    x[1] = 2;
+    x[2] = 3;
+    Independent(x);
+
+    std::vector<ADCGD> y(2);
+    ADCGD tmp = x[1] * x[2];
+    y[0] = tmp + tmp;
+    y[1] = y[0] * x[0];
+
+    ADFun<CGD> f(x, y);
+
+    std::string source, sourceSchedule;
+    size_t live = generate(f, false, source);
+    size_t liveSchedule = generate(f, true, sourceSchedule);
+
+    ASSERT_EQ(live, 1u);
+    ASSERT_EQ(liveSchedule, 1u);
+    ASSERT_EQ(source, sourceSchedule);
+}
@@ -0,0 +1,128 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGDynamicTest.hpp"
+#include "cppad/cg/support/cppadcg_eigen_model.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGEigenModelTest : public CppADCGDynamicTest {
+public:
+
+    explicit CppADCGEigenModelTest(const std::string& name,
+                                   SparseMatrixFormat format) :
+            CppADCGDynamicTest(name) {
+        _jacFormat = format;
+        _hessFormat = format;
+        // independent variables
+        _xTape = {1, 1, 1, 1};
+        _xRun = {1, 2, 0.5, 3};
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        std::vector<ADCGD> y(3);
+
+        y[0] = x[3] * x[0] + sin(x[2]);
+        y[1] = x[1] * x[1] * x[3];
+        y[2] = x[0] * x[2] + exp(x[1]) * x[0];
+
+        return y;
+    }
+
+    void testEigen(bool direct) {
+        using VectorXd = Eigen::Matrix<double, Eigen::Dynamic, 1>;
+
+        size_t n = _model->Domain();
+        size_t m = _model->Range();
+
+        Eigen::Map<const VectorXd> x(_xRun.data(), n);
+        VectorXd w = VectorXd::Ones(m);
+
+        /**
+         * forward zero
+         */
+        VectorXd y(m);
+        ForwardZero(*_model, x, y);
+
+        std::vector<double> yRef = _model->ForwardZero(_xRun);
+        for (size_t i = 0; i < m; ++i)
+            ASSERT_EQ(y[i], yRef[i]);
+
+        /**
+         * Jacobian
+         */
+        EigenSparseModelMatrix<double> jac;
+        jac.initJacobian(*_model);
+        ASSERT_EQ(jac.isDirect(), direct);
+
+        std::vector<double> jacRef(m * n);
+        _model->SparseJacobian(_xRun, jacRef);
+
+        for (size_t k = 0; k < 2; ++k) { // the second evaluation reuses the pattern
+            SparseJacobian(*_model, x, jac);
+
+            Eigen::MatrixXd jacDense(jac.matrix());
+            for (size_t i = 0; i < m; ++i)
+                for (size_t j = 0; j < n; ++j)
+                    ASSERT_EQ(jacDense(i, j), jacRef[i * n + j]);
+        }
+
+        /**
+         * Hessian
+         */
+        EigenSparseModelMatrix<double> hess;
+        hess.initHessian(*_model);
+        ASSERT_EQ(hess.isDirect(), direct);
+
+        std::vector<double> hessRef(n * n);
+        _model->SparseHessian(_xRun, std::vector<double>(m, 1.0), hessRef);
+
+        SparseHessian(*_model, x, w, hess);
+
+        Eigen::MatrixXd hessDense(hess.matrix());
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                ASSERT_EQ(hessDense(i, j), hessRef[i * n + j]);
+    }
+};
+
+class CppADCGEigenModelCscTest : public CppADCGEigenModelTest {
+public:
+    CppADCGEigenModelCscTest() :
+            CppADCGEigenModelTest("eigen_model_csc", SparseMatrixFormat::CSC) {
+    }
+};
+
+class CppADCGEigenModelCooTest : public CppADCGEigenModelTest {
+public:
+    CppADCGEigenModelCooTest() :
+            CppADCGEigenModelTest("eigen_model_coo", SparseMatrixFormat::Coordinate) {
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGEigenModelCscTest, EigenSparseDirect) {
+    this->testEigen(true);
+}
+
+TEST_F(CppADCGEigenModelCooTest, EigenSparsePermutation) {
+    // the model has row major element order
+    this->testEigen(false);
+}